@@ -1,6 +1,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <ctime>
 
 #include <TFile.h>
@@ -18,6 +19,7 @@
 #include "TPCReco/EventSourceFactory.h"
 
 #include "TPCReco/ConfigManager.h"
+#include "TPCReco/EntryRange.h"
 #include "TPCReco/RecoOutput.h"
 #include "TPCReco/RunIdParser.h"
 #include "TPCReco/InputFileHelper.h"
@@ -76,7 +78,11 @@ int makeTrackTree(boost::property_tree::ptree & aConfig) {
   }
 
   std::string dataFileName = aConfig.get("input.dataFile","");
-  std::string rootFileName = InputFileHelper::makeOutputFileName(dataFileName,"MCTrackTree");
+  // generated events: readNEvents is the total number of events of all shards
+  auto aRange = tpcreco::utilities::EntryRange(std::max(0, aConfig.get<int>("input.readNEvents")),
+					       aConfig.get<Long64_t>("input.firstEntry", 0), -1,
+					       aConfig.get<std::string>("input.shard", ""));
+  std::string rootFileName = aRange.decorate(InputFileHelper::makeOutputFileName(dataFileName,"MCTrackTree"));
   TFile outputROOTFile(rootFileName.c_str(),"RECREATE");
   TTree *tree = new TTree("trackTree", "Track tree");
   TrackData track_data;
@@ -108,8 +114,8 @@ int makeTrackTree(boost::property_tree::ptree & aConfig) {
   std::string fileName = InputFileHelper::tokenize(dataFileName)[0];
   std::size_t last_dot_position = fileName.find_last_of(".");
   std::size_t last_slash_position = fileName.find_last_of("//");
-  std::string recoFileName = MakeUniqueName("Reco_"+fileName.substr(last_slash_position+1,
-						     last_dot_position-last_slash_position-1)+".root");
+  std::string recoFileName = MakeUniqueName(aRange.decorate("Reco_"+fileName.substr(last_slash_position+1,
+									    last_dot_position-last_slash_position-1)+".root"));
   std::shared_ptr<eventraw::EventInfo> myEventInfo = std::make_shared<eventraw::EventInfo>();
   myRecoOutput.open(recoFileName);
  
@@ -117,12 +123,12 @@ int makeTrackTree(boost::property_tree::ptree & aConfig) {
   std::cout<<KBLU<<"File with "<<RST<<myEventSource->numberOfEntries()<<" frames loaded."<<std::endl;
 
   //Event loop
-  int nEntries = aConfig.get<int>("input.readNEvents");
-  if(nEntries<0 ) nEntries = 0;
+  int nEntries = aRange.size();
+  std::cout<<KBLU<<"Processing "<<RST<<aRange<<std::endl;
  
-  for(int iEntry=0;iEntry<nEntries;++iEntry){
-    if(nEntries>10 && iEntry%(nEntries/10)==0){
-      std::cout<<KBLU<<"Processed: "<<int(100*(double)iEntry/nEntries)<<" % events"<<RST<<std::endl;
+  for(Long64_t iEntry=aRange.first();iEntry<aRange.last();++iEntry){
+    if(nEntries>10 && (iEntry-aRange.first())%(nEntries/10)==0){
+      std::cout<<KBLU<<"Processed: "<<int(100*(double)(iEntry-aRange.first())/nEntries)<<" % events"<<RST<<std::endl;
     }
     myEventSource->loadFileEntry(iEntry);    
     *myEventInfo = myEventSource->getCurrentEvent()->GetEventInfo();    
@@ -25,8 +25,10 @@
 #include "TPCReco/RunIdParser.h"
 #include "TPCReco/InputFileHelper.h"
 #include "TPCReco/MakeUniqueName.h"
+#include "TPCReco/EntryRange.h"
 #include "TPCReco/colorText.h"
 #include "TPCReco/HistoManager.h"
+#include "TPCReco/PerfMonitor.h"
 
 #include "TPCReco/EventTPC.h"
 /////////////////////////////////////
@@ -43,6 +45,7 @@ int main(int argc, char **argv){
 
   ConfigManager cm;
   boost::property_tree::ptree myConfig = cm.getConfig(argc, argv);
+  tpcreco::utilities::PerfMonitor::instance().configure(myConfig);
  
   int nEntriesProcessed = makeTrackTree(myConfig);
 
@@ -50,6 +53,7 @@ int main(int argc, char **argv){
   std::cout<<KBLU<<"Real time:       "<<RST<<aStopwatch.RealTime()<<" s"<<std::endl;
   std::cout<<KBLU<<"CPU time:        "<<RST<<aStopwatch.CpuTime()<<" s"<<std::endl;
   std::cout<<KBLU<<"Processing rate: "<<RST<<nEntriesProcessed/aStopwatch.RealTime()<< " ev/s"<<std::endl;
+  tpcreco::utilities::PerfMonitor::instance().report(myConfig);
 
   return 0;
 }
@@ -73,11 +77,17 @@ typedef struct {Float_t eventId, frameId,
 /////////////////////////
 int makeTrackTree(boost::property_tree::ptree & aConfig) {
 		  
+  const auto typedConfig = tpcreco::config::TypedConfig::fromConfig(aConfig); // validated once, used inside the event loop
   std::shared_ptr<EventSourceBase> myEventSource = EventSourceFactory::makeEventSourceObject(aConfig);
-  myEventSource->getEventFilter().setConditions(aConfig); // initialize RAW event pre-filtering
+  myEventSource->getEventFilter().setConditions(typedConfig.eventFilter); // initialize RAW event pre-filtering
 
   std::string dataFileName = aConfig.get("input.dataFile","");
-  std::string rootFileName = InputFileHelper::makeOutputFileName(dataFileName,"TrackTree");
+  myEventSource->loadDataFile(dataFileName);
+  std::cout<<KBLU<<"File with "<<RST<<myEventSource->numberOfEntries()<<" frames loaded."<<std::endl;
+  auto aRange = tpcreco::utilities::EntryRange::fromConfig(myEventSource->numberOfEntries(), aConfig);
+  std::cout<<KBLU<<"Processing "<<RST<<aRange<<std::endl;
+
+  std::string rootFileName = aRange.decorate(InputFileHelper::makeOutputFileName(dataFileName,"TrackTree"));
   TFile outputROOTFile(rootFileName.c_str(),"RECREATE");
   TTree *tree = new TTree("trackTree", "Track tree");
   TrackData track_data;
@@ -96,22 +106,23 @@ int makeTrackTree(boost::property_tree::ptree & aConfig) {
   tree->Branch("track",&track_data,leafNames.c_str());
 
   std::string geometryFileName = aConfig.get("input.geometryFile","");
-  double pressure = aConfig.get<double>("conditions.pressure"); 
-  double temperature = aConfig.get<double>("conditions.temperature");
-  double samplingRate = aConfig.get<double>("conditions.samplingRate");
+  double pressure = typedConfig.conditions.pressure;
+  double temperature = typedConfig.conditions.temperature;
+  double samplingRate = typedConfig.conditions.samplingRate;
   boost::property_tree::ptree hitConfig;
   hitConfig.put_child("hitFilter", aConfig.get_child("hitFilter"));
     
   TrackBuilder myTkBuilder;
   myTkBuilder.setGeometry(myEventSource->getGeometry());
   myTkBuilder.setPressure(pressure);
+  if(aConfig.get<std::string>("trackFit.fitType")=="ANALYTIC") myTkBuilder.setFitType(definitions::fit_type::TANGENT_BIAS_ANALYTIC);
   IonRangeCalculator myRangeCalculator(gas_mixture_type::CO2,pressure,temperature);
   ////////////////////////////////////////////
   //
   // extra initialization for fit DEBUG plots
   const auto develMode = aConfig.get<bool>("display.develMode");
   HistoManager myHistoManager;
-  const std::string rootFileNameCanvas = "makeTrackTree_debug_histos.root";
+  const std::string rootFileNameCanvas = aRange.decorate("makeTrackTree_debug_histos.root");
   TFile *outputCanvasROOTFile = nullptr;
   TCanvas *outputCanvas = nullptr;
   if(develMode) {
@@ -139,31 +150,29 @@ int makeTrackTree(boost::property_tree::ptree & aConfig) {
   ////////////////////////////////////////////
 
   RecoOutput myRecoOutput;
-  std::string recoFileName = InputFileHelper::makeOutputFileName(dataFileName,"Reco");
+  std::string recoFileName = aRange.decorate(InputFileHelper::makeOutputFileName(dataFileName,"Reco"));
   std::shared_ptr<eventraw::EventInfo> myEventInfo = std::make_shared<eventraw::EventInfo>();
-  myRecoOutput.open(recoFileName);
- 
-  myEventSource->loadDataFile(dataFileName);
-  std::cout<<KBLU<<"File with "<<RST<<myEventSource->numberOfEntries()<<" frames loaded."<<std::endl;
+  myRecoOutput.open(recoFileName, aConfig.get<bool>("recoOutput.slim"), aConfig.get<bool>("recoOutput.storeRecHits"));
 
   //Event loop
-  int nEntries = aConfig.get<int>("input.readNEvents");
-  if(nEntries<0 || nEntries>myEventSource->numberOfEntries() ) nEntries = myEventSource->numberOfEntries();
+  int nEntries = aRange.size();
 
-  for(int iEntry=0;iEntry<nEntries;++iEntry){
-    if(nEntries>10 && iEntry%(nEntries/10)==0){
-      std::cout<<KBLU<<"Processed: "<<int(100*(double)iEntry/nEntries)<<" % events"<<RST<<std::endl;
+  for(Long64_t iEntry=aRange.first();iEntry<aRange.last();++iEntry){
+    if(nEntries>10 && (iEntry-aRange.first())%(nEntries/10)==0){
+      std::cout<<KBLU<<"Processed: "<<int(100*(double)(iEntry-aRange.first())/nEntries)<<" % events"<<RST<<std::endl;
     }
     myEventSource->loadFileEntry(iEntry);
+    TPCRECO_COUNT("events.loaded", 1);
 
     // pre-filtering
     if(myEventSource->getEventFilter().isEnabled() &&
        !myEventSource->getEventFilter().pass(*myEventSource->getCurrentEvent())) continue; // skip this event
+    TPCRECO_COUNT("events.reconstructed", 1);
 
     *myEventInfo = myEventSource->getCurrentEvent()->GetEventInfo();
-    if(!iEntry || develMode) { // initialize only once per session in non-debug mode and every time in debug mode
-      myEventSource->getCurrentEvent()->setHitFilterConfig(filter_type::threshold, hitConfig);
-      myEventSource->getCurrentEvent()->setHitFilterConfig(filter_type::fraction, hitConfig);
+    if(iEntry==aRange.first() || develMode) { // initialize only once per session in non-debug mode and every time in debug mode
+      myEventSource->getCurrentEvent()->setHitFilterConfig(filter_type::threshold, typedConfig.hitFilter);
+      myEventSource->getCurrentEvent()->setHitFilterConfig(filter_type::fraction, typedConfig.hitFilter);
     }
     myTkBuilder.setEvent(myEventSource->getCurrentEvent());
     myTkBuilder.setPressure(pressure);
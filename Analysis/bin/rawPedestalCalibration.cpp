@@ -0,0 +1,248 @@
+#ifdef WITH_GET
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/program_options.hpp>
+#include "TPCReco/colorText.h"
+#include <TROOT.h>
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/EventSourceGRAW.h"
+#include "TPCReco/EventSourceMultiGRAW.h"
+#include "TPCReco/PedestalTable.h"
+#include "TPCReco/RunIdParser.h"
+
+void calibratePedestalRuns(const boost::property_tree::ptree &aConfig);
+
+boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv){
+
+  boost::program_options::options_description cmdLineOptDesc("Allowed command line options");
+
+  cmdLineOptDesc.add_options()
+    ("help", "produce help message")
+    ("geometryFile",  boost::program_options::value<std::string>(), "string - path to TPC geometry file")
+    ("dataFile",  boost::program_options::value<std::string>(), "string - list of comma-separated raw data files of one or more pedestal runs (in multi-GRAW mode all files of each run)")
+    ("frameLoadRange", boost::program_options::value<unsigned int>(), "int - maximal number of frames to be read by event builder in single-GRAW mode")
+    ("singleAsadGrawFile", boost::program_options::bool_switch()->default_value(false), "flag indicating multi-GRAW mode (default=FALSE)")
+    ("pedestalDatabase", boost::program_options::value<std::string>(), "string - path to the pedestal database file, tables of existing runs are replaced")
+    ("maxNevents", boost::program_options::value<unsigned int>()->default_value(0), "int - number of events to process per run")
+    ("nThreads", boost::program_options::value<unsigned int>()->default_value(0), "int - number of runs processed in parallel (0=number of cores)");
+
+  boost::program_options::variables_map varMap;
+
+  try {
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, cmdLineOptDesc), varMap);
+    if (varMap.count("help")) {
+      std::cout << std::endl
+		<< "rawPedestalCalibration config.json [options]" << std::endl << std::endl;
+      std::cout << cmdLineOptDesc << std::endl;
+      exit(1);
+    }
+    boost::program_options::notify(varMap);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << '\n';
+    std::cout << cmdLineOptDesc << std::endl;
+    exit(1);
+  }
+
+  return varMap;
+}
+/////////////////////////////////////
+/////////////////////////////////////
+int main(int argc, char **argv){
+
+  boost::program_options::variables_map varMap = parseCmdLineArgs(argc, argv);
+  boost::property_tree::ptree tree;
+  if(argc<2){
+    std::cout << std::endl
+	      << "rawPedestalCalibration config.json [options]" << std::endl << std::endl;
+    return 0;
+  }
+  else {
+    std::cout<<"Using configFileName: "<<argv[1]<<std::endl;
+    boost::property_tree::read_json(argv[1], tree);
+  }
+
+  // optional overrides of the JSON config file
+  if (varMap.count("pedestalDatabase")) {
+    tree.put("pedestalDatabase", varMap["pedestalDatabase"].as<std::string>());
+  }
+  if (varMap.count("geometryFile")) {
+    tree.put("geometryFile", varMap["geometryFile"].as<std::string>());
+  }
+  if (varMap.count("dataFile")) {
+    tree.put("dataFile", varMap["dataFile"].as<std::string>());
+  }
+  if (varMap.count("maxNevents")) {
+    tree.put("maxNevents", varMap["maxNevents"].as<unsigned int>());
+  }
+  if (varMap.count("nThreads")) {
+    tree.put("nThreads", varMap["nThreads"].as<unsigned int>());
+  }
+  if( (tree.find("singleAsadGrawFile")==tree.not_found() || // if not present in config JSON
+       tree.get<bool>("singleAsadGrawFile")==false) && // or single-GRAW mode is FALSE
+      varMap.count("singleAsadGrawFile")){ // then allow to override JSON settings
+    tree.put("singleAsadGrawFile", varMap["singleAsadGrawFile"].as<bool>());
+  }
+  if( tree.get<bool>("singleAsadGrawFile")==false && // if in single-GRAW mode
+      varMap.count("frameLoadRange")) { // then allow to override JSON settings
+    tree.put("frameLoadRange", varMap["frameLoadRange"].as<unsigned int>());
+  }
+
+  //sanity checks
+  if(tree.find("dataFile")==tree.not_found() ||
+     tree.find("geometryFile")==tree.not_found() ||
+     tree.find("pedestalDatabase")==tree.not_found() ||
+     tree.find("singleAsadGrawFile")==tree.not_found() ||
+     (tree.get<bool>("singleAsadGrawFile")==false &&
+      tree.find("frameLoadRange")==tree.not_found()) ||
+     tree.find("maxNevents")==tree.not_found() ||
+     tree.find("pedestal")==tree.not_found()
+     ) {
+    std::cerr << std::endl
+	      << __FUNCTION__ << KRED << ": Some configuration options are missing!" << RST << std::endl << std::endl;
+    std::cout << "dataFile: " << tree.count("dataFile") << std::endl;
+    std::cout << "geometryFile: " << tree.count("geometryFile") << std::endl;
+    std::cout << "pedestalDatabase: " << tree.count("pedestalDatabase") << std::endl;
+    std::cout << "singleAsadGrawFile: " << tree.count("singleAsadGrawFile") << std::endl;
+    std::cout << "frameLoadRange: " << tree.count("frameLoadRange") << std::endl;
+    std::cout << "maxNevents:" << tree.count("maxNevents") << std::endl;
+    std::cout << "pedestal:" << tree.count("pedestal") << std::endl;
+    exit(1);
+  }
+
+  calibratePedestalRuns(tree);
+  return 0;
+}
+/////////////////////////////////////
+/////////////////////////////////////
+// Loops over all events of a single pedestal run and returns
+// the run averages of pedestals and FPN shapes.
+PedestalTable calibratePedestalRun(const boost::property_tree::ptree &aConfig,
+				   long runId, const std::set<std::string> &fileNameList){
+
+  auto geometryFileName = aConfig.get<std::string>("geometryFile");
+  auto singleAsadGrawFile = aConfig.get<bool>("singleAsadGrawFile");
+  auto maxNevents = aConfig.get<unsigned int>("maxNevents");
+
+  std::string dataFileName;
+  for(const auto &fileName: fileNameList) {
+    dataFileName += (dataFileName.empty() ? "" : ",") + fileName;
+  }
+
+  std::shared_ptr<EventSourceGRAW> myEventSource;
+  if(singleAsadGrawFile) {
+    myEventSource = std::make_shared<EventSourceMultiGRAW>(geometryFileName);
+  } else {
+    myEventSource = std::make_shared<EventSourceGRAW>(geometryFileName);
+    myEventSource->setFrameLoadRange(aConfig.get<unsigned int>("frameLoadRange"));
+  }
+
+  // pedestals are calculated per event, the table of the run is made from them
+  auto aPedestalConfig = tpcreco::config::PedestalConfig::fromConfig(aConfig);
+  aPedestalConfig.database.clear();
+  aPedestalConfig.runId = boost::none;
+  myEventSource->configurePedestal(aPedestalConfig);
+  myEventSource->setPedestalAccumulation(true);
+  myEventSource->loadDataFile(dataFileName);
+  myEventSource->resetRunPedestals();
+
+  // every load accumulates the event, so the loop stops before
+  // getNextEvent() would reload the last event of the file
+  myEventSource->loadFileEntry(0);
+  for(unsigned int counter=1; (!maxNevents || counter<maxNevents) && myEventSource->hasNextEvent(); ++counter) {
+    myEventSource->getNextEvent();
+  }
+
+  return myEventSource->getRunPedestalTable(runId);
+}
+/////////////////////////////////////
+/////////////////////////////////////
+void calibratePedestalRuns(const boost::property_tree::ptree &aConfig){
+
+  auto dataFileName = aConfig.get<std::string>("dataFile");
+  auto databaseFileName = aConfig.get<std::string>("pedestalDatabase");
+  auto nThreads = aConfig.get<unsigned int>("nThreads", 0);
+  if(!nThreads) nThreads = std::thread::hardware_concurrency();
+
+  // files grouped by run, each run is processed by a single thread
+  const char del = ','; // delimiter character
+  std::map<long, std::set<std::string> > runFileList;
+  std::stringstream sstream(dataFileName);
+  std::string fileName;
+  while (std::getline(sstream, fileName, del)) {
+    if(fileName.empty()) continue;
+    if(fileName.find(".graw") == std::string::npos) {
+      std::cerr << __FUNCTION__ << KRED << ": Wrong input file: " << RST << fileName << std::endl;
+      exit(1);
+    }
+    runFileList[RunIdParser(fileName).runId()].insert(fileName);
+  };
+  if(runFileList.empty()) {
+    std::cerr << __FUNCTION__ << KRED << ": No input files." << RST << std::endl;
+    exit(1);
+  }
+  nThreads = std::min<unsigned int>(nThreads, runFileList.size());
+
+  std::cout << std::endl << "calibratePedestalRuns: Parameter settings: " << std::endl << std::endl
+	    << "Number of pedestal runs  = " << runFileList.size() << std::endl
+	    << "Pedestal database file   = " << databaseFileName << std::endl
+	    << "Number of threads        = " << nThreads << std::endl;
+
+  PedestalDatabase myDatabase;
+  if(std::ifstream(databaseFileName).good()) { // tables of other runs are kept
+    myDatabase.Load(databaseFileName);
+  }
+
+  ROOT::EnableThreadSafety();
+  std::vector<std::pair<long, std::set<std::string> > > runs(runFileList.begin(), runFileList.end());
+  std::atomic<std::size_t> nextRun{0};
+  std::mutex databaseMutex;
+  std::vector<std::thread> threads;
+  // The event sources print to std::cout and silence it around GET calls.
+  // With several threads std::cout is silenced once for the whole parallel section,
+  // so that its state is not changed while other threads write to it.
+  // GET calls are serialized by the event sources, progress is reported on std::clog.
+  bool silenceOutput = nThreads>1;
+  if(silenceOutput) std::cout.setstate(std::ios_base::failbit);
+  for(auto ithread=0U; ithread<nThreads; ++ithread) {
+    threads.emplace_back([&]() {
+	for(auto iRun=nextRun++; iRun<runs.size(); iRun=nextRun++) {
+	  try {
+	    auto aTable = calibratePedestalRun(aConfig, runs[iRun].first, runs[iRun].second);
+	    std::lock_guard<std::mutex> lock(databaseMutex);
+	    myDatabase.Add(aTable);
+	    std::clog << "calibratePedestalRuns: Run " << runs[iRun].first << " done." << std::endl;
+	  } catch (const std::exception &e) {
+	    std::lock_guard<std::mutex> lock(databaseMutex);
+	    std::cerr << "calibratePedestalRuns: " << KRED << "Run " << runs[iRun].first << " skipped: " << RST
+		      << e.what() << std::endl;
+	  }
+	}
+      });
+  }
+  for(auto &aThread: threads) aThread.join();
+  if(silenceOutput) std::cout.clear();
+
+  myDatabase.Save(databaseFileName);
+  std::cout << "calibratePedestalRuns: " << myDatabase.size() << " pedestal table(s) saved to: "
+	    << databaseFileName << std::endl;
+}
+
+#else
+
+#include "TPCReco/colorText.h"
+#include <iostream>
+
+int main(){
+  std::cout<<KRED<<"TPCReco was compiled without GET libraries."<<RST
+	    <<" This application requires GET libraries."<<std::endl;
+  return -1;
+}
+#endif
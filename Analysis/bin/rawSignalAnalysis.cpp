@@ -12,6 +12,7 @@
 #include "TPCReco/EventSourceROOT.h"
 #include "TPCReco/RawSignal_tree_analysis.h"
 #include "TPCReco/RunIdParser.h"
+#include "TPCReco/EntryRange.h"
 
 int analyzeRawEvents(const boost::property_tree::ptree aConfig);
 
@@ -35,7 +36,9 @@ boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv){
     ("hitFilter.recoClusterDeltaStrips",  boost::program_options::value<int>(), "int - envelope in strip units around seed hits for clustering")
     ("hitFilter.recoClusterDeltaTimeCells",  boost::program_options::value<int>(), "int - envelope in time cell units around seed hits for clustering")
     ("outputFile", boost::program_options::value<std::string>(), "string - path to the output ROOT file")
-    ("input.readNEvents", boost::program_options::value<unsigned int>()->default_value(0), "int - number of events to process");
+    ("input.readNEvents", boost::program_options::value<unsigned int>()->default_value(0), "int - number of events to process")
+    ("input.firstEntry", boost::program_options::value<unsigned int>(), "int - position of the first input entry to process")
+    ("input.shard", boost::program_options::value<std::string>(), "string - process only i-th (0-based) out of N consecutive parts of input entries, in format i/N");
 
   boost::program_options::variables_map varMap;
 
@@ -85,6 +88,12 @@ int main(int argc, char **argv){
   if (varMap.count("input.readNEvents")) {
     tree.put("input.readNEvents", varMap["input.readNEvents"].as<unsigned int>());
   }
+  if (varMap.count("input.firstEntry")) {
+    tree.put("input.firstEntry", varMap["input.firstEntry"].as<unsigned int>());
+  }
+  if (varMap.count("input.shard")) {
+    tree.put("input.shard", varMap["input.shard"].as<std::string>());
+  }
   if(varMap.count("hitFilter.recoClusterEnable")) {
     tree.put("hitFilter.recoClusterEnable", varMap["hitFilter.recoClusterEnable"].as<bool>());
     if(tree.get<bool>("hitFilter.recoClusterEnable")==false) { // skip threshold, delta-strip, delta-timecells when clustering is disabled
@@ -159,6 +168,8 @@ int analyzeRawEvents(const boost::property_tree::ptree aConfig){
   auto geometryFileName = aConfig.get<std::string>("input.geometryFile");
   auto dataFileName = aConfig.get<std::string>("input.dataFile");
   auto outputFileName = aConfig.get<std::string>("outputFile");
+  auto firstEntry = aConfig.get<Long64_t>("input.firstEntry", 0);
+  auto shard = aConfig.get<std::string>("input.shard", "");
   auto clusterEnable = aConfig.get<bool>("hitFilter.recoClusterEnable");
   auto clusterThreshold = ( clusterEnable ? aConfig.get<float>("hitFilter.recoClusterThreshold") : 0 );
   auto clusterDeltaStrips = ( clusterEnable ? aConfig.get<unsigned int>("hitFilter.recoClusterDeltaStrips") : 0 );
@@ -247,6 +258,12 @@ int analyzeRawEvents(const boost::property_tree::ptree aConfig){
   std::cout << "File with " << myEventSource->numberOfEntries() << " frames loaded."
 	    << std::endl;
 
+  // events starting at input entries (frames) outside of this range are processed by other jobs
+  auto aRange = tpcreco::utilities::EntryRange(myEventSource->numberOfEntries(), firstEntry, -1, shard);
+  std::cout << "Processing " << aRange << std::endl;
+  outputFileName = aRange.decorate(outputFileName);
+  if(!aRange.size()) return 0;
+
 #ifdef WITH_GET
   if(dataFileName.find(".graw")!=std::string::npos) {
     auto id = RunIdParser(dataFileName);
@@ -274,8 +291,9 @@ int analyzeRawEvents(const boost::property_tree::ptree aConfig){
   do {
     // load first event
     if(currentEventIdx==-1) {
-      myEventSource->loadFileEntry(0);
+      myEventSource->loadFileEntry(aRange.first());
     }
+    if(!aRange.contains(myEventSource->currentEntryNumber())) break;
 
     std::cout << __FUNCTION__ << ": " << myEventSource->getCurrentEvent()->GetEventInfo() << std::endl;
 
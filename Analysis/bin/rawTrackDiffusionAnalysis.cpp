@@ -17,6 +17,8 @@
 #include "TPCReco/Track3D.h"
 #include "TPCReco/TrackDiffusion_tree_analysis.h"
 #include "TPCReco/RunIdParser.h"
+#include "TPCReco/EntryRange.h"
+#include "TPCReco/EventIndex.h"
 
 int analyzeTrackDiffusion(const boost::property_tree::ptree aConfig);
 
@@ -58,7 +60,9 @@ boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv){
     ("trackFractionEnd",  boost::program_options::value<float>(), "float - hit veto region at the end of the track as a fraction [0-1] of track length")
     ("trackDistanceMM",  boost::program_options::value<float>(), "float - maximal allowed hit distance [mm] from the track axis")
     ("outputFile", boost::program_options::value<std::string>(), "string - path to the output ROOT file")
-    ("maxNevents", boost::program_options::value<unsigned int>()->default_value(0), "int - number of events to process (0=all)");
+    ("maxNevents", boost::program_options::value<unsigned int>()->default_value(0), "int - number of events to process (0=all)")
+    ("firstEntry", boost::program_options::value<unsigned int>(), "int - position of the first RECO entry (sorted by run and event id) to process")
+    ("shard", boost::program_options::value<std::string>(), "string - process only i-th (0-based) out of N consecutive parts of RECO entries, in format i/N");
 
   boost::program_options::variables_map varMap;
 
@@ -111,6 +115,12 @@ int main(int argc, char **argv){
   if (varMap.count("maxNevents")) {
     tree.put("maxNevents", varMap["maxNevents"].as<unsigned int>());
   }
+  if (varMap.count("firstEntry")) {
+    tree.put("firstEntry", varMap["firstEntry"].as<unsigned int>());
+  }
+  if (varMap.count("shard")) {
+    tree.put("shard", varMap["shard"].as<std::string>());
+  }
   if(varMap.count("recoClusterEnable")) {
     tree.put("hitFilter.recoClusterEnable", varMap["recoClusterEnable"].as<bool>());
     if(tree.get<bool>("hitFilter.recoClusterEnable")==false) { // skip threshold, delta-strip, delta-timecells when clustering is disabled
@@ -213,6 +223,8 @@ int analyzeTrackDiffusion(const boost::property_tree::ptree aConfig){
   auto removePedestal = aConfig.get<bool>("removePedestal");
 #endif
   auto maxNevents = aConfig.get<unsigned int>("maxNevents");
+  auto firstEntry = aConfig.get<Long64_t>("firstEntry", 0);
+  auto shard = aConfig.get<std::string>("shard", "");
 
   std::cout << std::endl << "analyzeRawEvents: Parameter settings: " << std::endl << std::endl
 	    << "Reco file                    = " << recoFileName << std::endl
@@ -298,14 +310,16 @@ int analyzeTrackDiffusion(const boost::property_tree::ptree aConfig){
   aBranchInfo->SetAddress(&aEventInfo);
 
   const unsigned int nEntries = myTreePtr->GetEntries();
+  auto aRange = tpcreco::utilities::EntryRange(nEntries, firstEntry, (maxNevents<=0 ? -1 : (Long64_t)maxNevents), shard);
+  std::cout << "Processing " << aRange << std::endl;
+  outputFileName = aRange.decorate(outputFileName);
 
   // sort input tree in ascending order of {runID, eventID}
-  TTreeIndex *I=NULL;
-  Long64_t* index=NULL;
+  tpcreco::utilities::EventIndex aIndex;
+  const Long64_t* index=NULL;
   if(aBranchInfo) {
-    myTreePtr->BuildIndex("runId", "eventId");
-    I=(TTreeIndex*)myTreePtr->GetTreeIndex(); // get the tree index
-    index=I->GetIndex();
+    aIndex = tpcreco::utilities::EventIndex::attach(myTreePtr, "EventInfo.runId", "EventInfo.eventId");
+    index=aIndex.entries().data();
   }
 
   // initialize input EventSource  
@@ -377,8 +391,7 @@ int analyzeTrackDiffusion(const boost::property_tree::ptree aConfig){
   // loop over ALL events
   Long64_t currentEventIdx=-1;
   Long64_t counter=0;
-  Long64_t maxevents=(maxNevents<=0 ? nEntries : std::min((unsigned int)maxNevents, nEntries));
-  for(auto ievent=0; ievent<maxevents; ievent++) {
+  for(auto ievent=aRange.first(); ievent<aRange.last(); ievent++) {
     if(index) {
       ////// DEBUG
       //      std::cout << "GETENTRY: index=" << index << ", index[" << ievent << "]=" << index[ievent] << std::endl;
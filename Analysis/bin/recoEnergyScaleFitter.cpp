@@ -101,7 +101,8 @@ boost::program_options::variables_map parseCmdLineArgs(int argc, char **argv){
     ("scaleOnly", boost::program_options::bool_switch(), "(override flag) - force to use only multiplicative corrections instead of linear scale and offset")
     ("type", boost::program_options::value<std::string>()->required(), "string - type of correction [\"length\" xor \"energy_cms\" xor \"energy_lab\" xor \"zenek\"]")
   ("tolerance", boost::program_options::value<double>()->default_value(10), "float - ROOT minimizer TOLERANCE parameter")
-  ("precision", boost::program_options::value<double>()->default_value(3e-6), "float - ROOT minimizer PRECISION parameter");
+  ("precision", boost::program_options::value<double>()->default_value(3e-6), "float - ROOT minimizer PRECISION parameter")
+  ("nThreads", boost::program_options::value<unsigned int>()->default_value(0), "int - number of threads for excitation energy calculations (0 = all available cores)");
   boost::program_options::variables_map varMap;  
 
   try {     
@@ -161,6 +162,9 @@ int main(int argc, char **argv){
   if(varMap.count("precision")) {
     tree.put("precision", varMap["precision"].as<double>());
   }
+  if(varMap.count("nThreads")) {
+    tree.put("nThreads", varMap["nThreads"].as<unsigned int>());
+  }
 
   ///////////////////////
   //
@@ -207,7 +211,8 @@ int main(int argc, char **argv){
     tree.get<bool>("nominalBoost"),         // use nominal gamma energy for LAB-CMS boost?
     tree.get<bool>("correctPIDs"),          // use best guess for missing PIDs according to assumed reaction hypothesis?
     enumDict::GetEnergyScaleType(boost::algorithm::to_upper_copy(tree.get<std::string>("type"))), // type of energy scale correction
-    true // debug flag
+    true, // debug flag
+    tree.get<unsigned int>("nThreads") // number of threads for excitation energy calculations
   };
   
   ///////////////////////
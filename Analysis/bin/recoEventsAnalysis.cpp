@@ -4,9 +4,13 @@
 #include <TString.h>
 #include <TTree.h>
 #include <TTreeIndex.h>
+#include <TROOT.h>
 #include <boost/program_options.hpp>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include <TFile.h>
@@ -23,9 +27,13 @@
 #include "TPCReco/RequirementsCollection.h"
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/Track3D.h"
+#include "TPCReco/TrackFlatTree.h"
 #include "TPCReco/HIGGS_analysis.h"
 #include "TPCReco/HIGS_trees_analysis.h"
+#include "TPCReco/HistogramFillJournal.h"
 #include "TPCReco/ConfigManager.h"
+#include "TPCReco/EntryRange.h"
+#include "TPCReco/EventIndex.h"
 #include "TPCReco/colorText.h"
 
 enum class BeamDirection{
@@ -51,7 +59,9 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
 		      const  double & alphaMinCut, // [mm]
 		      const  double & alphaMaxCut, // [mm]
 		      const  double & carbonMinCut, // [mm]
-		      const  double & carbonMaxCut); // [mm]
+		      const  double & carbonMaxCut, // [mm]
+		      const  unsigned int & nThreads, // number of threads (0 = all available cores)
+		      const  boost::property_tree::ptree & rangeConfig); // input entry range and shard
 
 std::istream& operator>>(std::istream& in, BeamDirection& direction){
   std::string token;
@@ -105,11 +115,12 @@ int main(int argc, char **argv){
   auto alphaOffsetCorr = tree.get<float>("recoAnalysis.alphaOffsetCorr");
   auto carbonScaleCorr = tree.get<float>("recoAnalysis.carbonScaleCorr");
   auto carbonOffsetCorr = tree.get<float>("recoAnalysis.carbonOffsetCorr");
+  auto nThreads = tree.get<unsigned int>("recoAnalysis.nThreads");
 
   analyzeRecoEvents(geometryFileName, dataFileName, beamEnergy, beamDir, beamOffset, beamSlope, beamDiameter, pressure, temperature,
 		    makeTreeFlag, nominalBoostFlag,
 		    alphaScaleCorr, alphaOffsetCorr, carbonScaleCorr, carbonOffsetCorr,
-		    alphaMinCut, alphaMaxCut, carbonMinCut, carbonMaxCut);
+		    alphaMinCut, alphaMaxCut, carbonMinCut, carbonMaxCut, nThreads, tree);
 
   return 0;
 }
@@ -120,6 +131,108 @@ std::shared_ptr<GeometryTPC> loadGeometry(const std::string fileName){
 }
 ////////////////////////////
 ////////////////////////////
+// Multi-threaded version of the event loop from analyzeRecoEvents().
+// Sorted entries are processed in blocks. Within a block each thread handles a consecutive
+// range of entries read from its own copy of the input tree. Histogram fills and tree
+// entries are recorded in per-thread journals, which are replayed in entry order after
+// each block. This way the output is identical to the single-threaded loop.
+int analyzeRecoEventsMT(const std::string & dataFileName,
+			const std::string & treeName, // TPCRecoData or flat tree
+			std::shared_ptr<GeometryTPC> aGeometry,
+			const RequirementsCollection<std::function<bool(Track3D *)>> & cuts,
+			HIGGS_analysis & myAnalysis,
+			HIGS_trees_analysis *myTreesAnalysis, // optional
+			const Long64_t *index, // sorted entry numbers
+			Long64_t nEntries,
+			unsigned int nThreads){
+
+  ROOT::EnableThreadSafety();
+
+  struct Worker {
+    TFile *file{NULL};
+    TTree *tree{NULL};
+    Track3D *track{NULL};
+    eventraw::EventInfo *eventInfo{NULL};
+    TBranch *hitsBranch{NULL};
+    std::vector<Hit2DCollection> *recHits{NULL};
+    std::unique_ptr<TrackFlatTree> flatTree;
+    RequirementsCollection<std::function<bool(Track3D *)>> cuts;
+    HistogramFillJournal journal;
+    std::unique_ptr<HIGGS_analysis> analysis;
+  };
+  std::vector<std::unique_ptr<Worker>> workers;
+  auto aDirectory = gDirectory;
+  for(auto ithread=0U; ithread<nThreads; ++ithread) {
+    auto aWorker = std::make_unique<Worker>();
+    aWorker->file = new TFile(dataFileName.c_str());
+    aWorker->tree = (TTree*)aWorker->file->Get(treeName.c_str());
+    aWorker->track = new Track3D();
+    aWorker->eventInfo = new eventraw::EventInfo();
+    if(treeName==TrackFlatTree::treeName) {
+      aWorker->flatTree = std::make_unique<TrackFlatTree>();
+      aWorker->flatTree->setGeometry(aGeometry);
+      aWorker->flatTree->setBranchAddresses(aWorker->tree);
+    }
+    else {
+      aWorker->tree->GetBranch("RecoEvent")->SetAddress(&aWorker->track);
+      aWorker->tree->GetBranch("EventInfo")->SetAddress(&aWorker->eventInfo);
+      aWorker->hitsBranch = aWorker->tree->GetBranch("RecoHits");
+      if(aWorker->hitsBranch) {
+	aWorker->tree->SetBranchStatus("RecoHits", 0);
+	aWorker->hitsBranch->SetAddress(&aWorker->recHits);
+      }
+    }
+    aWorker->cuts = cuts;
+    aWorker->analysis = myAnalysis.makeWorker(aWorker->journal);
+    workers.push_back(std::move(aWorker));
+  }
+  aDirectory->cd();
+
+  const Long64_t entriesPerThread = 1000; // block size per thread, limits memory used by journals
+  for(Long64_t blockStart=0; blockStart<nEntries; blockStart+=entriesPerThread*nThreads) {
+    std::vector<std::thread> threads;
+    for(auto ithread=0U; ithread<nThreads; ++ithread) {
+      auto first = std::min(nEntries, blockStart+ithread*entriesPerThread);
+      auto last = std::min(nEntries, first+entriesPerThread);
+      threads.emplace_back([&, first, last](Worker &w) {
+	  static thread_local bool isFirst=false;
+	  for(auto iEntry=first; iEntry<last; ++iEntry){
+	    w.tree->GetEntry(index[iEntry]);
+	    if(w.flatTree) w.flatTree->get(*w.track, *w.eventInfo);
+
+	    for (auto & aSegment: w.track->getSegments())  aSegment.setGeometry(aGeometry); // need TPC geometry for track projections
+	    if(!w.cuts(w.track)){
+	      continue;
+	    }
+
+	    // charge histograms need the rec-hits of slim RecoOutput files
+	    if(w.hitsBranch) {
+	      w.hitsBranch->GetEntry(index[iEntry], 1);
+	      w.track->attachRecHits(*w.recHits);
+	    }
+	    w.analysis->fillHistos(w.track, w.eventInfo, isFirst);
+	    if(myTreesAnalysis) {
+	      auto aTrackCopy = std::make_shared<Track3D>(*w.track);
+	      auto aEventInfoCopy = std::make_shared<eventraw::EventInfo>(*w.eventInfo);
+	      w.journal.addAction([myTreesAnalysis, aTrackCopy, aEventInfoCopy]() {
+		  myTreesAnalysis->fillTrees(aTrackCopy.get(), aEventInfoCopy.get());
+		});
+	    }
+	  }
+	}, std::ref(*workers[ithread]));
+    }
+    for(auto &aThread: threads) aThread.join();
+    for(auto &aWorker: workers) aWorker->journal.replay(); // in entry order
+  }
+
+  for(auto &aWorker: workers) {
+    aWorker->analysis.reset();
+    delete aWorker->file;
+  }
+  return 0;
+}
+////////////////////////////
+////////////////////////////
 int analyzeRecoEvents(const  std::string & geometryFileName,
 		      const  std::string & dataFileName,
 		      const  float & beamEnergy, // [MeV]
@@ -138,7 +251,9 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
 		      const  double & alphaMinCut, // [mm]
 		      const  double & alphaMaxCut, // [mm]
 		      const  double & carbonMinCut, // [mm]
-		      const  double & carbonMaxCut){ // [mm]
+		      const  double & carbonMaxCut, // [mm]
+		      const  unsigned int & nThreads, // number of threads (0 = all available cores)
+		      const  boost::property_tree::ptree & rangeConfig){ // input entry range and shard
 
   std::cout << __FUNCTION__ << ": Input parameters:" << std::endl
 	    << "* geometry file: " << geometryFileName << std::endl
@@ -150,7 +265,8 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
 	    << "* ALPHA length correction: scale="<<alphaScaleCorr<<" / offset="<<alphaOffsetCorr<<" mm"<<std::endl
 	    << "* C-12 length correction: scale="<<carbonScaleCorr<<" / offset="<<carbonOffsetCorr<<" mm"<<std::endl
 	    << "* O-16 identification cuts: ALPHA length=["<<alphaMinCut<<", "<<alphaMaxCut<<"] mm / C-12 length=["<<carbonMinCut<<", "<<carbonMaxCut<<"] mm"<<std::endl
-	    << "* use nominal LAB gamma beam energy for LAB<->CMS boost: "<<nominalBoostFlag<<std::endl;
+	    << "* use nominal LAB gamma beam energy for LAB<->CMS boost: "<<nominalBoostFlag<<std::endl
+	    << "* number of threads: "<<(nThreads ? nThreads : std::thread::hardware_concurrency())<<std::endl;
 
   TFile *aFile = new TFile(dataFileName.c_str());
   if(!aFile || !aFile->IsOpen()){
@@ -262,35 +378,70 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
       myTreesAnalysis->setIonRangeCalculator(ionRangeCalculator);
   }
 
+  // flat input produced by recoEventsFlatten is read without Track3D streaming
+  std::unique_ptr<TrackFlatTree> aFlatTree;
   TTree *aTree = (TTree*)aFile->Get("TPCRecoData");
   if(!aTree) {
-    std::cerr<<KRED<<"ERROR: Cannot find 'TPCRecoData' tree!"<<RST<<std::endl;
-    return -1;
+    aTree = (TTree*)aFile->Get(TrackFlatTree::treeName.c_str());
+    if(aTree) aFlatTree = std::make_unique<TrackFlatTree>();
   }
-  
-  TBranch *aBranch  = aTree->GetBranch("RecoEvent");
-  if(!aBranch) {
-    std::cerr<<KRED<<"ERROR: Cannot find 'RecoEvent' branch!"<<RST<<std::endl;
+  if(!aTree) {
+    std::cerr<<KRED<<"ERROR: Cannot find 'TPCRecoData' or '"<<TrackFlatTree::treeName<<"' tree!"<<RST<<std::endl;
     return -1;
   }
   auto *aTrack = new Track3D();
-  aBranch->SetAddress(&aTrack);
+  auto *aEventInfo = new eventraw::EventInfo();
+  TBranch *aBranchHits = nullptr;
+  std::vector<Hit2DCollection> *aRecHits = nullptr;
+
+  if(aFlatTree) {
+    aFlatTree->setGeometry(aGeometry);
+    if(!aFlatTree->setBranchAddresses(aTree)) {
+      std::cerr<<KRED<<"ERROR: Wrong format of '"<<TrackFlatTree::treeName<<"' tree!"<<RST<<std::endl;
+      return -1;
+    }
+  }
+  else {
+    TBranch *aBranch  = aTree->GetBranch("RecoEvent");
+    if(!aBranch) {
+      std::cerr<<KRED<<"ERROR: Cannot find 'RecoEvent' branch!"<<RST<<std::endl;
+      return -1;
+    }
+    aBranch->SetAddress(&aTrack);
   
-  TBranch *aBranchInfo = aTree->GetBranch("EventInfo");
-  if(!aBranchInfo) {
-   std::cerr<<KRED<<"WARNING: "
-	    <<"Cannot find 'EventInfo' branch!"<<RST<<std::endl;
-    return -1;
+    TBranch *aBranchInfo = aTree->GetBranch("EventInfo");
+    if(!aBranchInfo) {
+      std::cerr<<KRED<<"WARNING: "
+	       <<"Cannot find 'EventInfo' branch!"<<RST<<std::endl;
+      return -1;
+    }
+    aBranchInfo->SetAddress(&aEventInfo);
+
+    // rec-hits of slim reco files are read only for events passing the cuts
+    aBranchHits = aTree->GetBranch("RecoHits");
+    if(aBranchHits) {
+      aTree->SetBranchStatus("RecoHits", 0);
+      aBranchHits->SetAddress(&aRecHits);
+    }
   }
-  auto *aEventInfo = new eventraw::EventInfo();
-  aBranchInfo->SetAddress(&aEventInfo);
   
-  std::cout << __FUNCTION__ << ": Starting to loop " << aTree->GetEntries() << " events with sorting by {runId, eventId}" << std::endl;
-  aTree->BuildIndex("runId", "eventId");
-  auto index =static_cast<TTreeIndex*>(aTree->GetTreeIndex())->GetIndex();
+  // shards are consecutive ranges of entries sorted by {runId, eventId}
+  auto aRange = tpcreco::utilities::EntryRange::fromConfig(aTree->GetEntries(), rangeConfig);
+  std::cout << __FUNCTION__ << ": Starting to loop " << aRange.size() << " events with sorting by {runId, eventId}, "
+	    << aRange << std::endl;
+  auto aIndex = aFlatTree ? tpcreco::utilities::EventIndex::attach(aTree, "runId", "eventId")
+                          : tpcreco::utilities::EventIndex::attach(aTree, "EventInfo.runId", "EventInfo.eventId");
+  auto index = aIndex.entries().data();
 
-  for(unsigned int iEntry=0;iEntry<aTree->GetEntries();++iEntry){
+  if(nThreads!=1) {
+    return analyzeRecoEventsMT(dataFileName, aTree->GetName(), aGeometry, cuts, myAnalysis, myTreesAnalysis.get(),
+			       index+aRange.first(), aRange.size(),
+			       (nThreads ? nThreads : std::thread::hardware_concurrency()));
+  }
+
+  for(Long64_t iEntry=aRange.first();iEntry<aRange.last();++iEntry){
     aTree->GetEntry(index[iEntry]);
+    if(aFlatTree) aFlatTree->get(*aTrack, *aEventInfo);
 
     for (auto & aSegment: aTrack->getSegments())  aSegment.setGeometry(aGeometry); // need TPC geometry for track projections
     if(!cuts(aTrack)){
@@ -298,8 +449,15 @@ int analyzeRecoEvents(const  std::string & geometryFileName,
     }
 
     static bool isFirst=false;
+    // charge histograms need the rec-hits of slim RecoOutput files
+    if(aBranchHits) {
+      aBranchHits->GetEntry(index[iEntry], 1);
+      aTrack->attachRecHits(*aRecHits);
+    }
     myAnalysis.fillHistos(aTrack, aEventInfo, isFirst);
-    if(makeTreeFlag) myTreesAnalysis->fillTrees(aTrack, aEventInfo);
+    if(makeTreeFlag) {
+      myTreesAnalysis->fillTrees(aTrack, aEventInfo);
+    }
   }
 
   return 0;
@@ -1,3 +1,5 @@
+#include "TPCReco/EntryRange.h"
+#include "TPCReco/EventIndex.h"
 #include "TPCReco/TTreeOps.h"
 #include <TFile.h>
 #include <TTree.h>
@@ -24,6 +26,14 @@ parseCmdLineArgs(int argc, char **argv) {
       "dry-run", "testing without modyfing files")(
       "inplace", "overwrites the input file,\nmutally exclusive "
                  "with 'output'")(
+      "firstEntry",
+      boost::program_options::value<Long64_t>()->default_value(0),
+      "position of the first entry sorted by run and event id")(
+      "nEntries", boost::program_options::value<Long64_t>()->default_value(-1),
+      "number of entries to process, -1 means all entries")(
+      "shard", boost::program_options::value<std::string>()->default_value(""),
+      "process only i-th (0-based) out of N consecutive parts of the entries, "
+      "in format i/N")(
       "input,i", boost::program_options::value<std::string>()->required(),
       "input root file")("output,o",
                          boost::program_options::value<std::string>(),
@@ -41,7 +51,8 @@ parseCmdLineArgs(int argc, char **argv) {
             .run(),
         varMap);
     if (varMap.count("help")) {
-      std::cout << "recoEventsClean [--help] [--verbose] [--dry-run] <input> "
+      std::cout << "recoEventsClean [--help] [--verbose] [--dry-run] "
+                   "[--firstEntry] [--nEntries] [--shard] <input> "
                    "[--inplace | output]"
                 << "\nRemove duplicated entries from reco TTrees\n"
                 << cmdLineOptDesc << '\n';
@@ -80,17 +91,34 @@ int main(int argc, char **argv) {
   }
   auto primaryKey = "EventInfo.runId";
   auto secondaryKey = "EventInfo.eventId";
-  auto values = inputTree->BuildIndex(primaryKey, secondaryKey);
-  if (values != inputTree->GetEntries()) {
+  auto index = tpcreco::utilities::EventIndex::attach(inputTree, primaryKey,
+                                                     secondaryKey);
+  if (index.size() != inputTree->GetEntries()) {
     std::cerr << "Can't build index on input tree using " << primaryKey
               << " and " << secondaryKey << '\n';
     return 1;
   }
+  // duplicates of an event are never split between shards
+  auto *treeIndex = static_cast<TTreeIndex *>(inputTree->GetTreeIndex());
+  auto *indexValues = treeIndex->GetIndexValuesMinor();
+  auto range =
+      tpcreco::utilities::EntryRange(
+          inputTree->GetEntries(), (*varMap)["firstEntry"].as<Long64_t>(),
+          (*varMap)["nEntries"].as<Long64_t>(),
+          (*varMap)["shard"].as<std::string>())
+          .alignedTo([indexValues](Long64_t a, Long64_t b) {
+            return indexValues[a] == indexValues[b];
+          });
+  std::cout << "Processing " << range << '\n';
+  if (varMap->count("inplace") && range.size() != inputTree->GetEntries()) {
+    std::cerr << "Option '--inplace' requires processing all entries\n";
+    return 1;
+  }
 
   if (varMap->count("dry-run")) {
     auto count = boost::size(tpcreco::utilities::filterDuplicates(
-        inputTree, varMap->count("verbose")));
-    std::cout << "Removed " << inputTree->GetEntries() - count
+        inputTree, range.first(), range.last(), varMap->count("verbose")));
+    std::cout << "Removed " << range.size() - count
               << " duplicated entries keeping the younger (dry run)\n";
     inputFile->Close();
     return 0;
@@ -98,20 +126,23 @@ int main(int argc, char **argv) {
 
   auto outputName = varMap->count("inplace")
                         ? inputName
-                        : varMap->at("output").as<std::string>();
+                        : range.decorate(varMap->at("output").as<std::string>());
   auto *outputFile = TFile::Open(outputName.c_str(), "RECREATE");
   if (!outputFile) {
     std::cerr << "Can't open output file " << outputName << '\n';
     return 1;
   }
-  auto *outputTree = tpcreco::utilities::cloneUnique(inputTree, outputFile,
-                                                     varMap->count("verbose"));
+  auto *outputTree = tpcreco::utilities::cloneUnique(
+      inputTree, outputFile, range.first(), range.last(),
+      varMap->count("verbose"));
   if (!outputTree) {
     std::cerr << "Clonning TTree failed\n";
     return 1;
   }
+  // index stored with the tree, see EventIndex::attach()
+  outputTree->BuildIndex(primaryKey, secondaryKey);
   outputFile->Write();
-  std::cout << "Removed " << inputTree->GetEntries() - outputTree->GetEntries()
+  std::cout << "Removed " << range.size() - outputTree->GetEntries()
             << " duplicated entries keeping the younger\n";
   outputFile->Close();
   inputFile->Close();
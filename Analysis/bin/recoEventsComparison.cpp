@@ -2,13 +2,15 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <memory>
+#include <thread>
 
 #include <TFile.h>
 #include <TTree.h>
 #include <TCanvas.h>
 #include <TLatex.h>
 #include <TString.h>
-#include <TTreeIndex.h>
+#include <TROOT.h>
 
 
 #include <boost/program_options.hpp>
@@ -17,7 +19,11 @@
 #include "TPCReco/Track3D.h"
 #include "TPCReco/EventInfo.h"
 #include "TPCReco/Comp_analysis.h"
+#include "TPCReco/HistogramFillJournal.h"
 #include "TPCReco/ConfigManager.h"
+#include "TPCReco/EntryRange.h"
+#include "TPCReco/EventIndex.h"
+#include "TPCReco/MergeJoin.h"
 
 #include "TPCReco/colorText.h"
 
@@ -25,7 +31,9 @@ int compareRecoEvents(const  std::string & geometryFileName,
 		      const  std::string & referenceDataFileName,
 		      const  std::string & testDataFileName,
 		      const  double & pressure, // [mbar]
-		      const  double & temperature // [K]
+		      const  double & temperature, // [K]
+		      const  unsigned int & nThreads, // number of threads (0 = all available cores)
+		      const  boost::property_tree::ptree & rangeConfig // input entry range and shard
 );
 /////////////////////////////////////
 /////////////////////////////////////
@@ -38,7 +46,8 @@ int main(int argc, char **argv){
   auto testDataFileName = tree.get<std::string>("testDataFile");
   auto pressure = tree.get<float>("pressure");
   auto temperature = tree.get<float>("temperature");
-  compareRecoEvents(geometryFileName, referenceDataFileName, testDataFileName,pressure,temperature);
+  auto nThreads = tree.get<unsigned int>("recoAnalysis.nThreads");
+  compareRecoEvents(geometryFileName, referenceDataFileName, testDataFileName,pressure,temperature,nThreads,tree);
   return 0;
 }
 /////////////////////////////
@@ -48,13 +57,13 @@ std::shared_ptr<GeometryTPC> loadGeometry(const std::string fileName){
 }
 ////////////////////////////
 ////////////////////////////
-std::vector<Long64_t> setBranchAdressesAndIndex(TTree *&aTree, eventraw::EventInfo *&aEventInfo, Track3D *&aTrack){
+bool setBranchAdresses(TTree *aTree, eventraw::EventInfo *&aEventInfo, Track3D *&aTrack){
   
  TBranch *aBranch  = aTree->GetBranch("RecoEvent");
  if(!aBranch) {
    std::cerr<<KRED<<"ERROR: "<<RST
 	    <<"Cannot find 'RecoEvent' branch!"<<std::endl;
-   return std::vector<Long64_t>();
+   return false;
  }
  aBranch->SetAddress(&aTrack);
  
@@ -62,15 +71,108 @@ std::vector<Long64_t> setBranchAdressesAndIndex(TTree *&aTree, eventraw::EventIn
  if(!aBranch) {
    std::cerr<<KRED<<"ERROR: "<<RST
 	    <<"Cannot find 'EventInfo' branch!"<<std::endl;
-   return std::vector<Long64_t>();
+   return false;
  }
  aBranch->SetAddress(&aEventInfo);
+ // entries are read in ascending order, see streamJoin()
+ tpcreco::utilities::enablePrefetch(aTree);
+ return true;
+}
+////////////////////////////
+////////////////////////////
+// copy of a single reco tree entry
+struct RecoEvent {
+  eventraw::EventInfo info;
+  Track3D track;
+};
+////////////////////////////
+////////////////////////////
+// Events missing in one of the files are passed as empty tracks
+// with reset event info, see Comp_analysis::fillHistos().
+void fillHistos(Comp_analysis & myAnalysis, std::shared_ptr<GeometryTPC> aGeometry,
+		RecoEvent *aRefEvent, RecoEvent *aTestEvent){
+
+  RecoEvent aMissingEvent;
+  aMissingEvent.info.reset();
+  if(!aRefEvent) aRefEvent = &aMissingEvent;
+  if(!aTestEvent) aTestEvent = &aMissingEvent;
+  for (auto & aSegment: aRefEvent->track.getSegments())  aSegment.setGeometry(aGeometry);
+  for (auto & aSegment: aTestEvent->track.getSegments())  aSegment.setGeometry(aGeometry);
+  myAnalysis.fillHistos(&aRefEvent->track, &aRefEvent->info,
+			&aTestEvent->track, &aTestEvent->info);
+}
+////////////////////////////
+////////////////////////////
+// Multi-threaded version of the event loop from compareRecoEvents().
+// Each thread processes a consecutive range of rows of the join plan
+// reading its own copies of the input trees. Histogram fills are recorded
+// in per-thread journals, which are replayed in the order of the plan after
+// each block of events.
+int compareRecoEventsMT(const  std::string & referenceDataFileName,
+			const  std::string & testDataFileName,
+			std::shared_ptr<GeometryTPC> aGeometry,
+			Comp_analysis & myAnalysis,
+			const std::vector<tpcreco::utilities::JoinRow> & plan,
+			unsigned int nThreads){
+
+  ROOT::EnableThreadSafety();
+
+  struct Worker {
+    TFile *refFile{NULL}, *testFile{NULL};
+    std::vector<TTree*> trees;
+    Track3D *refTrack{NULL}, *testTrack{NULL};
+    eventraw::EventInfo *refEventInfo{NULL}, *testEventInfo{NULL};
+    HistogramFillJournal journal;
+    std::unique_ptr<Comp_analysis> analysis;
+  };
+  std::vector<std::unique_ptr<Worker>> workers;
+  auto aDirectory = gDirectory;
+  for(auto ithread=0U; ithread<nThreads; ++ithread) {
+    auto aWorker = std::make_unique<Worker>();
+    aWorker->refFile = new TFile(referenceDataFileName.c_str());
+    aWorker->testFile = new TFile(testDataFileName.c_str());
+    TTree *aRefTree = (TTree*)aWorker->refFile->Get("TPCRecoData");
+    TTree *aTestTree = (TTree*)aWorker->testFile->Get("TPCRecoData");
+    aWorker->refTrack = new Track3D();
+    aWorker->testTrack = new Track3D();
+    aWorker->refEventInfo = new eventraw::EventInfo();
+    aWorker->testEventInfo = new eventraw::EventInfo();
+    setBranchAdresses(aRefTree, aWorker->refEventInfo, aWorker->refTrack);
+    setBranchAdresses(aTestTree, aWorker->testEventInfo, aWorker->testTrack);
+    aWorker->trees = {aRefTree, aTestTree};
+    aWorker->analysis = myAnalysis.makeWorker(aWorker->journal);
+    workers.push_back(std::move(aWorker));
+  }
+  aDirectory->cd();
+
+  const size_t entriesPerThread = 1000; // block size per thread, limits memory used by journals
+  const size_t nEntries = plan.size();
+  for(size_t blockStart=0; blockStart<nEntries; blockStart+=entriesPerThread*nThreads) {
+    std::vector<std::thread> threads;
+    for(auto ithread=0U; ithread<nThreads; ++ithread) {
+      auto first = std::min(nEntries, blockStart+ithread*entriesPerThread);
+      auto last = std::min(nEntries, first+entriesPerThread);
+      threads.emplace_back([&, first, last](Worker &w) {
+	  tpcreco::utilities::streamJoin(w.trees, plan.begin()+first, plan.begin()+last,
+					 [&w](unsigned int iTree){
+					   return iTree==0 ? RecoEvent{*w.refEventInfo, *w.refTrack}
+					                   : RecoEvent{*w.testEventInfo, *w.testTrack};
+					 },
+					 [&](const tpcreco::utilities::JoinRow &, const std::vector<RecoEvent*> & events){
+					   fillHistos(*w.analysis, aGeometry, events[0], events[1]);
+					 });
+	}, std::ref(*workers[ithread]));
+    }
+    for(auto &aThread: threads) aThread.join();
+    for(auto &aWorker: workers) aWorker->journal.replay(); // in event order
+  }
 
- aTree->BuildIndex("eventId");
- TTreeIndex *aIndex = (TTreeIndex*)aTree->GetTreeIndex();
- Long64_t *indexValues = aIndex->GetIndexValues();   
- std::vector<Long64_t> indexValuesVec(indexValues, indexValues+aTree->GetEntries());
- return indexValuesVec;
+  for(auto &aWorker: workers) {
+    aWorker->analysis.reset();
+    delete aWorker->refFile;
+    delete aWorker->testFile;
+  }
+  return 0;
 }
 ////////////////////////////
 ////////////////////////////
@@ -78,7 +180,9 @@ int compareRecoEvents(const  std::string & geometryFileName,
 		      const  std::string & referenceDataFileName,
 		      const  std::string & testDataFileName,
 		      const  double & pressure, // [mbar]
-		      const  double & temperature){ // [K]
+		      const  double & temperature, // [K]
+		      const  unsigned int & nThreads, // number of threads (0 = all available cores)
+		      const  boost::property_tree::ptree & rangeConfig){ // input entry range and shard
 
   TFile *aRefFile = new TFile(referenceDataFileName.c_str());
   if(!aRefFile || !aRefFile->IsOpen()){
@@ -122,11 +226,14 @@ int compareRecoEvents(const  std::string & geometryFileName,
   eventraw::EventInfo *aRefEventInfo = new eventraw::EventInfo();
   eventraw::EventInfo *aTestEventInfo = new eventraw::EventInfo();
 
-  std::vector<Long64_t> refTreeIndex = setBranchAdressesAndIndex(aRefTree, aRefEventInfo, aRefTrack);
-  if(!refTreeIndex.size()) return 1;
+  if(!setBranchAdresses(aRefTree, aRefEventInfo, aRefTrack)) return 1;
+  if(!setBranchAdresses(aTestTree, aTestEventInfo, aTestTrack)) return 1;
+
+  auto refTreeIndex = tpcreco::utilities::EventIndex::attach(aRefTree, "EventInfo.runId", "EventInfo.eventId");
+  if(refTreeIndex.empty()) return 1;
 
-  std::vector<Long64_t> testTreeIndex = setBranchAdressesAndIndex(aTestTree, aTestEventInfo, aTestTrack);
-  if(!testTreeIndex.size()) return 1;
+  auto testTreeIndex = tpcreco::utilities::EventIndex::attach(aTestTree, "EventInfo.runId", "EventInfo.eventId");
+  if(testTreeIndex.empty()) return 1;
 
   aRefTree->GetEntry(0);
   aTestTree->GetEntry(0);
@@ -139,35 +246,29 @@ int compareRecoEvents(const  std::string & geometryFileName,
     return -1;
   }
 
-  std::sort(refTreeIndex.begin(), refTreeIndex.end());
-  std::sort(testTreeIndex.begin(), testTreeIndex.end());
-  std::vector<Long64_t> mergedTreeIndex = refTreeIndex;
-  mergedTreeIndex.insert(mergedTreeIndex.end(), testTreeIndex.begin(), testTreeIndex.end());
-  std::sort(mergedTreeIndex.begin(), mergedTreeIndex.end());
-  mergedTreeIndex.erase(std::unique(mergedTreeIndex.begin(), mergedTreeIndex.end()), mergedTreeIndex.end());
-
-  TTree *theTree = aRefTree;
-  if(aTestTree->GetEntries()>aRefTree->GetEntries()){
-    theTree = aTestTree;
-    theTree->AddFriend(aRefTree,"TestEvents");
-  }
-  else{    
-    theTree->AddFriend(aTestTree,"TestEvents");
-  }
+  // merge-join of both files on {runId, eventId}, no entries are read here
+  auto plan = tpcreco::utilities::makeJoinPlan({refTreeIndex, testTreeIndex});
 
-  Comp_analysis myAnalysis(aGeometry, pressure, temperature);
-  for(auto entryIndex: mergedTreeIndex){
+  // shards are consecutive ranges of merged event ids
+  auto aRange = tpcreco::utilities::EntryRange::fromConfig(plan.size(), rangeConfig);
+  std::cout<<KBLU<<"Processing "<<RST<<aRange<<std::endl;
+  plan = std::vector<tpcreco::utilities::JoinRow>(plan.begin()+aRange.first(), plan.begin()+aRange.last());
+  // threads process consecutive ranges of entries of the reference file
+  tpcreco::utilities::sortByStorageOrder(plan);
 
-    aRefEventInfo->reset();
-    aTestEventInfo->reset();
-    
-    theTree->GetEntryWithIndex(entryIndex);    
-    for (auto & aSegment: aRefTrack->getSegments())  aSegment.setGeometry(aGeometry);
-    for (auto & aSegment: aTestTrack->getSegments())  aSegment.setGeometry(aGeometry);
-
-    myAnalysis.fillHistos(aRefTrack, aRefEventInfo,
-			  aTestTrack, aTestEventInfo);
+  Comp_analysis myAnalysis(aGeometry, pressure, temperature);
+  if(nThreads!=1) {
+    return compareRecoEventsMT(referenceDataFileName, testDataFileName, aGeometry, myAnalysis, plan,
+			       (nThreads ? nThreads : std::thread::hardware_concurrency()));
   }
+  tpcreco::utilities::streamJoin({aRefTree, aTestTree}, plan.begin(), plan.end(),
+				 [&](unsigned int iTree){
+				   return iTree==0 ? RecoEvent{*aRefEventInfo, *aRefTrack}
+				                   : RecoEvent{*aTestEventInfo, *aTestTrack};
+				 },
+				 [&](const tpcreco::utilities::JoinRow &, const std::vector<RecoEvent*> & events){
+				   fillHistos(myAnalysis, aGeometry, events[0], events[1]);
+				 });
   
   return 0;
 }
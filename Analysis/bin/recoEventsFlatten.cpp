@@ -0,0 +1,115 @@
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/Track3D.h"
+#include "TPCReco/TrackFlatTree.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+
+boost::optional<boost::program_options::variables_map>
+parseCmdLineArgs(int argc, char **argv) {
+
+  boost::program_options::options_description cmdLineOptDesc(
+      "Allowed command line options");
+
+  cmdLineOptDesc.add_options()("help", "produce help message")(
+      "geometryFile,g",
+      boost::program_options::value<std::string>()->required(),
+      "geometry file used for charge calculation")(
+      "input,i", boost::program_options::value<std::string>()->required(),
+      "input root file")("output,o",
+                         boost::program_options::value<std::string>()->required(),
+                         "output root file");
+
+  boost::program_options::positional_options_description cmdLinePosDesc;
+  cmdLinePosDesc.add("input", 1).add("output", 1);
+  boost::program_options::variables_map varMap;
+
+  try {
+    boost::program_options::store(
+        boost::program_options::command_line_parser(argc, argv)
+            .options(cmdLineOptDesc)
+            .positional(cmdLinePosDesc)
+            .run(),
+        varMap);
+    if (varMap.count("help")) {
+      std::cout << "recoEventsFlatten [--help] --geometryFile <geometry> "
+                   "<input> <output>"
+                << "\nConvert reco TTree to flat '" << TrackFlatTree::treeName
+                << "' TTree\n"
+                << cmdLineOptDesc << '\n';
+      return boost::none;
+    }
+    boost::program_options::notify(varMap);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << '\n' << cmdLineOptDesc << '\n';
+    return boost::none;
+  }
+  return varMap;
+}
+
+int main(int argc, char **argv) {
+  auto varMap = parseCmdLineArgs(argc, argv);
+  if (!varMap) {
+    return 1;
+  };
+
+  auto geometryName = (*varMap)["geometryFile"].as<std::string>();
+  auto aGeometry = std::make_shared<GeometryTPC>(geometryName.c_str(), false);
+  if (!aGeometry->IsOK()) {
+    std::cerr << "Can't load geometry file " << geometryName << '\n';
+    return 1;
+  }
+  auto inputName = (*varMap)["input"].as<std::string>();
+  auto *inputFile = TFile::Open(inputName.c_str(), "READ");
+  if (!inputFile) {
+    std::cerr << "Can't open input file " << inputName << '\n';
+    return 1;
+  }
+  auto *inputTree = static_cast<TTree *>(inputFile->Get("TPCRecoData"));
+  if (!inputTree) {
+    std::cerr << "No valid TTree in input file\n";
+    return 1;
+  }
+  auto *aTrack = new Track3D();
+  inputTree->SetBranchAddress("RecoEvent", &aTrack);
+  auto *aEventInfo = new eventraw::EventInfo();
+  inputTree->SetBranchAddress("EventInfo", &aEventInfo);
+  // rec-hits of slim reco files, see RecoOutput::open()
+  std::vector<Hit2DCollection> *aRecHits = nullptr;
+  bool hasRecHits = inputTree->GetBranch("RecoHits");
+  if (hasRecHits) {
+    inputTree->SetBranchAddress("RecoHits", &aRecHits);
+  }
+
+  auto outputName = (*varMap)["output"].as<std::string>();
+  auto *outputFile = TFile::Open(outputName.c_str(), "RECREATE");
+  if (!outputFile) {
+    std::cerr << "Can't open output file " << outputName << '\n';
+    return 1;
+  }
+  auto *outputTree = new TTree(TrackFlatTree::treeName.c_str(), "");
+  TrackFlatTree aFlatTree;
+  aFlatTree.createBranches(outputTree);
+
+  for (Long64_t iEntry = 0; iEntry < inputTree->GetEntries(); ++iEntry) {
+    inputTree->GetEntry(iEntry);
+    if (hasRecHits) {
+      aTrack->attachRecHits(*aRecHits);
+    }
+    for (auto &aSegment : aTrack->getSegments()) {
+      aSegment.setGeometry(aGeometry);
+    }
+    aFlatTree.fill(*aTrack, *aEventInfo);
+    outputTree->Fill();
+  }
+  // index stored with the tree, see EventIndex::attach()
+  outputTree->BuildIndex("runId", "eventId");
+  outputFile->Write();
+  std::cout << "Converted " << outputTree->GetEntries() << " entries\n";
+  outputFile->Close();
+  inputFile->Close();
+  return 0;
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include <TH1D.h>
 #include <TH2D.h>
@@ -12,6 +13,7 @@
 
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/IonRangeCalculator.h"
+#include "TPCReco/HistogramFillJournal.h"
 
 class TH1F;
 class TH2F;
@@ -34,9 +36,16 @@ public:
 
   void fillHistos(Track3D *aRefTrack, eventraw::EventInfo *aRefEventInfo,
 		  Track3D *aTestTrack, eventraw::EventInfo *aTestEventInfo);
+
+  // Worker instance for multi-threaded processing of consecutive entry ranges.
+  // Its histogram fills are recorded in the journal,
+  // HistogramFillJournal::replay() applies them to this instance.
+  std::unique_ptr<Comp_analysis> makeWorker(HistogramFillJournal &journal);
   
  private:
 
+  Comp_analysis(Comp_analysis &master, HistogramFillJournal &journal); // see makeWorker()
+
   void bookHistos();
 
   void finalize();
@@ -52,6 +61,7 @@ public:
   std::map<std::string, TProfile2D*> profiles2D;
   std::shared_ptr<GeometryTPC> myGeometryPtr;
   IonRangeCalculator myRangeCalculator;
+  bool isWorker{false};
 };
 
 #endif
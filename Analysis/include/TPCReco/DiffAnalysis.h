@@ -1,13 +1,17 @@
 #ifndef TPCRECO_ANALYSIS_DIFF_ANALYSIS_H_
 #define TPCRECO_ANALYSIS_DIFF_ANALYSIS_H_
+#include "TPCReco/EventIndex.h"
 #include "TPCReco/EventInfo.h"
-#include "TPCReco/TTreeOps.h"
+#include "TPCReco/MergeJoin.h"
 #include "TPCReco/Track3D.h"
 #include <TFile.h>
 #include <TTree.h>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 namespace tpcreco {
 namespace analysis {
 namespace diff {
@@ -37,27 +41,23 @@ void checkType(int entryIndex, eventraw::EventInfo *inputInfo, Track3D *,
 
 } // namespace checks
 
+// copy of a single tree entry
+struct Event {
+  eventraw::EventInfo info;
+  Track3D track;
+};
+
 class DetailSink {
 public:
-  DetailSink(TTree *inputTree, TTree *referenceTree,
-             const std::string &recoEventBranch,
-             const std::string &eventInfoBranch)
-      : inputTree(inputTree), referenceTree(referenceTree) {
-    inputTree->SetBranchAddress(recoEventBranch.c_str(), &inputTrack);
-    referenceTree->SetBranchAddress(recoEventBranch.c_str(), &referenceTrack);
-    inputTree->SetBranchAddress(eventInfoBranch.c_str(), &inputInfo);
-    referenceTree->SetBranchAddress(eventInfoBranch.c_str(), &referenceInfo);
+  DetailSink(TTree *inputTree, TTree *referenceTree) {
     treeInfo = std::string() + "\t(" + inputTree->GetDirectory()->GetName() +
                " vs " + referenceTree->GetDirectory()->GetName() + " / " +
                referenceTree->GetName() + ')';
   }
-  template <class T> void operator()(const T &lhs, const T &rhs) {
-    auto entryIndex = boost::get<1>(lhs);
-    loadEntry(inputTree, lhs);
-    loadEntry(referenceTree, rhs);
+  void operator()(Long64_t entryIndex, Event &input, Event &reference) {
     for (auto &check : checks) {
-      check(entryIndex, inputInfo, inputTrack, referenceInfo, referenceTrack,
-            treeInfo);
+      check(entryIndex, &input.info, &input.track, &reference.info,
+            &reference.track, treeInfo);
     }
   }
   void resetTreeInfo() { treeInfo.clear(); }
@@ -68,16 +68,6 @@ public:
   }
 
 private:
-  template <class T> void loadEntry(TTree *tree, const T &indices) {
-    auto entry = boost::get<0>(indices);
-    tree->GetEntry(entry);
-  }
-  TTree *inputTree;
-  TTree *referenceTree;
-  Track3D *inputTrack = new Track3D;
-  Track3D *referenceTrack = new Track3D;
-  eventraw::EventInfo *inputInfo = new eventraw::EventInfo;
-  eventraw::EventInfo *referenceInfo = new eventraw::EventInfo;
   std::string treeInfo;
   std::vector<
       std::function<void(int, eventraw::EventInfo *, Track3D *,
@@ -91,58 +81,57 @@ public:
     treeInfo = std::string() + "\t(" + tree->GetDirectory()->GetName() + " / " +
                tree->GetName() + ")";
   }
-  template <int N, class T>
-  void operator()(const tpcreco::utilities::Dispatched<N, T> &operand) {
-    if (disabled) {
-      return;
-    }
-    auto translation = translateDispatched(operand);
-    std::cout << translation.first << " > entry index "
-              << boost::get<1>(operand.data) << "\t" << translation.second
-              << treeInfo << '\n';
-  }
+  // event present only in the input, entry of the input tree
+  void extra(Long64_t entryIndex) { print('+', "extra", entryIndex); }
+  // event present only in the reference, entry of the reference tree
+  void missing(Long64_t entryIndex) { print('-', "missing", entryIndex); }
   void resetTreeInfo() { treeInfo.clear(); }
   void disable(bool disable) { disabled = disable; }
 
 private:
-  template <class T>
-  std::pair<char, std::string>
-  translateDispatched(const tpcreco::utilities::Dispatched<0, T> &) {
-    return std::make_pair('+', "extra");
-  }
-  template <class T>
-  std::pair<char, std::string>
-  translateDispatched(const tpcreco::utilities::Dispatched<1, T> &) {
-    return std::make_pair('-', "missing");
+  void print(char sign, const std::string &description, Long64_t entryIndex) {
+    if (disabled) {
+      return;
+    }
+    std::cout << sign << " > entry index " << entryIndex << "\t" << description
+              << treeInfo << '\n';
   }
   std::string treeInfo;
   bool disabled = false;
 };
 
+// Events of both files are matched on {runId, eventId} by a merge-join of
+// their indices. Entries are read in storage order, see streamJoin().
 class Analysis {
 public:
   Analysis(std::string inputName, std::string referenceName)
       : inputFile(openFile(inputName)), referenceFile(openFile(referenceName)) {
     std::string treeName = "TPCRecoData";
-    inputTree = openTree(inputFile, treeName.c_str());
-    referenceTree = openTree(referenceFile, treeName.c_str());
+    inputTree = openTree(inputFile, treeName.c_str(), inputIndex);
+    referenceTree = openTree(referenceFile, treeName.c_str(), referenceIndex);
+    setBranchAddresses(inputTree, 0);
+    setBranchAddresses(referenceTree, 1);
     extras = std::make_unique<ExtraSink>(inputTree);
-    details = std::make_unique<DetailSink>(inputTree, referenceTree,
-                                           "RecoEvent", "EventInfo");
+    details = std::make_unique<DetailSink>(inputTree, referenceTree);
   }
 
   void run() {
-    auto inputRange = tpcreco::utilities::getTreeIndexRange(inputTree);
-    auto referenceRange = tpcreco::utilities::getTreeIndexRange(referenceTree);
-    tpcreco::utilities::diffDispatcher(
-        inputRange, referenceRange,
-        [](const auto &lhs, const auto &rhs) {
-          return boost::get<1>(lhs) < boost::get<1>(rhs);
+    auto plan = tpcreco::utilities::makeJoinPlan({inputIndex, referenceIndex});
+    tpcreco::utilities::streamJoin(
+        {inputTree, referenceTree}, plan.begin(), plan.end(),
+        [this](unsigned int iTree) {
+          return Event{*infos[iTree], *tracks[iTree]};
         },
-        [](const auto &lhs, const auto &rhs) {
-          return boost::get<1>(lhs) == boost::get<1>(rhs);
-        },
-        *details, *extras);
+        [this](const tpcreco::utilities::JoinRow &row,
+               const std::vector<Event *> &events) {
+          if (events[0] && events[1]) {
+            (*details)(row.entries[0], *events[0], *events[1]);
+          } else if (events[0]) {
+            extras->extra(row.entries[0]);
+          } else {
+            extras->missing(row.entries[1]);
+          }
+        });
   }
 
   ExtraSink *getExtraSink() { return extras.get(); }
@@ -156,7 +145,8 @@ private:
     }
     return file;
   }
-  TTree *openTree(TFile *file, std::string name) {
+  TTree *openTree(TFile *file, std::string name,
+                  tpcreco::utilities::EventIndex &index) {
     auto *tree = static_cast<TTree *>(file->Get(name.c_str()));
     if (!tree) {
       throw std::logic_error("No valid TTree " + name + " in file " +
@@ -164,19 +154,30 @@ private:
     }
     std::string majorIndex = "EventInfo.runId";
     std::string minorIndex = "EventInfo.eventId";
-    auto ret = tree->BuildIndex(majorIndex.c_str(), minorIndex.c_str());
-    if (ret != tree->GetEntries()) {
+    index =
+        tpcreco::utilities::EventIndex::attach(tree, majorIndex, minorIndex);
+    if (index.size() != tree->GetEntries()) {
       throw std::logic_error("Can't build index: \"" + majorIndex + "\",\"" +
                              minorIndex + "\" on tree " + tree->GetName() +
                              " in file " + tree->GetDirectory()->GetName() +
                              "\n");
     }
+    tpcreco::utilities::enablePrefetch(tree);
     return tree;
   }
+  void setBranchAddresses(TTree *tree, int iTree) {
+    tree->SetBranchAddress("RecoEvent", &tracks[iTree]);
+    tree->SetBranchAddress("EventInfo", &infos[iTree]);
+  }
   TFile *inputFile;
   TFile *referenceFile;
   TTree *inputTree;
   TTree *referenceTree;
+  tpcreco::utilities::EventIndex inputIndex;
+  tpcreco::utilities::EventIndex referenceIndex;
+  Track3D *tracks[2] = {new Track3D, new Track3D};
+  eventraw::EventInfo *infos[2] = {new eventraw::EventInfo,
+                                   new eventraw::EventInfo};
   std::unique_ptr<ExtraSink> extras;
   std::unique_ptr<DetailSink> details;
 };
@@ -48,6 +48,7 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <TVector3.h>
@@ -121,6 +122,7 @@ class EnergyScale_analysis {
     bool assignMissingPIDs{true}; // TRUE = use best guess according to reaction hypothesis in case of mising PIDs
     escale_type correction_type{escale_type::NONE}; // scale track energy or length or none
     bool debug{false};
+    unsigned int nThreads{0}; // number of threads for excitation energy calculations (0 = all available cores)
   };
   struct ResidualsType {
     TH1D dataHist;     // data sample Ex spectrum [MeV]
@@ -129,6 +131,28 @@ class EnergyScale_analysis {
     bool enabled;      // TRUE = sample included in the global fit / FALSE = control sample not included in the global fit
   };
 
+  // _______________________________________
+  //
+  // helper struct for storing events of a given selection packed into contiguous arrays.
+  // Events incompatible with the reaction hypothesis are dropped while packing, so that
+  // all packed events have the same topology and the same PID of each track.
+  struct PackedEventCollection {
+    bool isPacked{false}; // TRUE = arrays below are filled
+    pid_type parentPID{pid_type::UNKNOWN}; // parent particle to be decayed
+    pid_type trailingPID{pid_type::UNKNOWN}; // next-to-leading particle from 2-body decay (UNKNOWN for 3-body decay)
+    std::vector<pid_type> trackPID; // [itrack] - PID of each track, leading track first
+    std::vector<size_t> eventIndex; // [ievent] - index of the event in EventCollection::events
+    std::vector<std::vector<double>> length; // [itrack][ievent] - uncorrected track length [mm]
+    std::vector<std::vector<double>> dirX; // [itrack][ievent] - unit vector along the track in BEAM/LAB frame
+    std::vector<std::vector<double>> dirY;
+    std::vector<std::vector<double>> dirZ;
+    std::vector<double> excitationEnergy; // [ievent] - buffer for excitation energy in CMS [MeV], refilled at each iteration
+    TH1D hExcitationEnergy; // histogram with optimized binning, reused at each iteration
+    std::shared_ptr<TF1> energyShapeGauss; // fit functions, reused at each iteration
+    std::shared_ptr<TF1> energyShapeGaussBifurcated;
+    size_t size() const { return eventIndex.size(); }
+  };
+
   EnergyScale_analysis(const FitOptionType &aOption,
 		       std::vector<EventCollection> &aSelection);
 
@@ -149,7 +173,11 @@ class EnergyScale_analysis {
   void reset();
   TVector3 getBetaVectorOfCMS_BEAM(double nucleusMassInMeV, double photonEnergyInMeV_LAB) const; // LAB reference frame, BEAM coordinate system
   double getBetaOfCMS(double nucleusMassInMeV, double photonEnergyInMeV_LAB) const; // LAB reference frame
-  TH1D getOptimizedExcitationEnergyHistogram(EventCollection &selection);
+  TH1D getOptimizedExcitationEnergyHistogram(EventCollection &selection, const std::vector<double> &excitationEnergies);
+  void packSelection(const EventCollection &selection, PackedEventCollection &packed) const;
+  void fillExcitationEnergies(const std::vector<size_t> &selectionIndices);
+  void fillExcitationEnergies(EventCollection &selection, PackedEventCollection &packed,
+			      size_t firstEvent, size_t lastEvent) const;
 
   std::tuple<double, double, bool> getEventExcitationEnergy(double nominalBeamEnergyInMeV_LAB,
 							    double expectedExcitationEnergyPeakInMeV_CMS,
@@ -159,7 +187,7 @@ class EnergyScale_analysis {
 							    TrackCollection &list) const;
   void initializeCorrections(const size_t npar, const double *par);
   double getCorrectionPerPID(pid_type pid, int ipar) const; // par[0]=offset [MeV] or [mm], par[1]=scale for LENGTH or ENERGY
-  std::tuple<double, size_t> getSelectionChi2(EventCollection &selection, bool debug_histos_flag=false);
+  std::tuple<double, size_t> getSelectionChi2(EventCollection &selection, PackedEventCollection &packed, bool debug_histos_flag=false);
   double applyLinearCorrectionPerPID(pid_type pid, double observable) const;
   
   size_t myNparams{2}; // number of parameters to be fitted (minimal=2)
@@ -175,6 +203,7 @@ class EnergyScale_analysis {
   std::map<pid_type, std::tuple<double, double>> myCorrectionMap; // index = PID, value={OFFSET, SCALE} for LENGTH or ENERGY
   std::map<std::string, ResidualsType> myExcitationEnergyFitMap; // index = unique selection name
   std::map<std::string, double> myExcitationEnergyBinSizeMap; // index = unique selection name
+  std::vector<PackedEventCollection> myPackedSelection; // index = same as in mySelection
   double myFactorChi2{1.0}; // additional scaling required by certain ROOT minimization algorithms
 };
 
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include <TH1F.h>
 #include <TH2F.h>
@@ -19,6 +20,7 @@
 #include "TPCReco/Track3D.h"
 #include "TPCReco/EventInfo.h"
 #include "TPCReco/CoordinateConverter.h"
+#include "TPCReco/HistogramFillJournal.h"
 
 class TH1F;
 class TH2F;
@@ -38,9 +40,20 @@ class HIGGS_analysis{
   ~HIGGS_analysis();
 
   void fillHistos(Track3D *aTrack, eventraw::EventInfo *aEventInfo, bool & isFirst);
+
+  // Worker instance for multi-threaded processing of consecutive entry ranges.
+  // Its histogram fills and other order-dependent operations are recorded in the journal,
+  // HistogramFillJournal::replay() applies them to this instance.
+  std::unique_ptr<HIGGS_analysis> makeWorker(HistogramFillJournal &journal);
   
  private:
 
+  HIGGS_analysis(HIGGS_analysis &master, HistogramFillJournal &journal); // see makeWorker()
+
+  long double getDeltaTime(long double unixTimeSec, bool hasEventInfo, bool &isFirst); // [s]
+  void fillDeltaTime(const std::string &name, long double deltaTimeSec);
+  void dumpEvent(Track3D *aTrack, eventraw::EventInfo *aEventInfo);
+
   void bookHistos();
 
   void finalize();
@@ -70,5 +83,10 @@ class HIGGS_analysis{
   eventraw::EventInfo *myDumpEventInfo{NULL};
   //
   ///////// DEBUG - special Reco file with selected events only
+
+  double myLastTimestamp{0}; // [s] time of the previous event for rate measurements
+  long double myDeltaTimeSec{-1}; // [s] time difference of the current event replayed from a worker
+  HIGGS_analysis *myMaster{NULL}; // for workers only
+  HistogramFillJournal *myJournal{NULL}; // for workers only
 };
 #endif
@@ -0,0 +1,80 @@
+#ifndef TPCRECO_ANALYSIS_HISTOGRAM_FILL_JOURNAL_H_
+#define TPCRECO_ANALYSIS_HISTOGRAM_FILL_JOURNAL_H_
+/////////////////////////////////////////////////////////
+//
+// Helper class for multi-threaded filling of booked histograms.
+//
+// Each worker thread gets its own set of stand-in histograms created
+// by makeRecorder(). Their Fill() methods only record the arguments.
+// Other order-dependent operations (e.g. filling of output trees)
+// can be queued with addAction(). After the workers are done, replay()
+// applies all fills and actions to the booked histograms in the recorded
+// order. When journals of consecutive entry ranges are replayed in turn,
+// every booked histogram receives exactly the same sequence of Fill()
+// calls as in the single-threaded loop, so the output is bit-identical.
+//
+/////////////////////////////////////////////////////////
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+
+class HistogramFillJournal {
+
+ public:
+
+  typedef std::function<void()> Action;
+
+  enum class FillType {
+    X,       // TH1::Fill(x)
+    XW,      // TH1::Fill(x, w)
+    XY,      // TH2::Fill(x, y), TProfile::Fill(x, y)
+    XYW_2D,  // TH2::Fill(x, y, w)
+    XYW_PROF,// TProfile::Fill(x, y, w)
+    XYZ,     // TProfile2D::Fill(x, y, z)
+    XYZW,    // TProfile2D::Fill(x, y, z, w)
+    ACTION   // queued action
+  };
+
+  HistogramFillJournal() = default;
+  HistogramFillJournal(const HistogramFillJournal &) = delete;
+  HistogramFillJournal &operator=(const HistogramFillJournal &) = delete;
+
+  // Stand-in histograms recording Fill() calls for a given booked histogram.
+  // The journal owns returned objects.
+  TH1F *makeRecorder(TH1F *target);
+  TH2F *makeRecorder(TH2F *target);
+  TProfile *makeRecorder(TProfile *target);
+  TProfile2D *makeRecorder(TProfile2D *target);
+
+  void addAction(Action action);
+
+  void record(FillType type, TH1 *target, double x, double y=0, double z=0, double w=0){
+    myRecords.push_back({type, target, x, y, z, w});
+  }
+
+  // applies all recorded fills and actions in the recorded order and clears the journal
+  void replay();
+
+  void clear();
+
+  size_t size() const { return myRecords.size(); }
+
+ private:
+
+  struct Record {
+    FillType type;
+    TH1 *target;
+    double x, y, z, w;
+  };
+  std::vector<Record> myRecords;
+  std::vector<Action> myActions;
+  std::vector<std::unique_ptr<TH1>> myRecorders;
+};
+
+#endif // TPCRECO_ANALYSIS_HISTOGRAM_FILL_JOURNAL_H_
@@ -34,6 +34,7 @@ public:
  private:
 
   ClusterConfig myClusterConfig;
+  tpcreco::config::HitFilterConfig myHitFilterConfig; // made once from myClusterConfig
   Event_rawsignal *event_rawsignal_ = new Event_rawsignal;
   std::string myOutputFileName;
   std::shared_ptr<TFile> myOutputFilePtr;
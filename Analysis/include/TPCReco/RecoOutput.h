@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "TPCReco/EventInfo.h"
+#include "TPCReco/Hit2D.h"
 
 class TTree;
 class TFile;
@@ -22,7 +23,10 @@ public:
 
   void setEventInfo(const eventraw::EventInfo & aEventInfo);
 
-  void open(const std::string & fileName);
+  /// In the slim mode rec-hits shared by all track segments are stored once per event
+  /// in a separate "RecoHits" branch (or dropped, if storeRecHits=false),
+  /// see Track3D::detachRecHits() and Track3D::attachRecHits().
+  void open(const std::string & fileName, bool slim=false, bool storeRecHits=true);
     
   void update();
 
@@ -35,6 +39,8 @@ private:
   std::shared_ptr<TFile> myOutputFilePtr;
   std::shared_ptr<TTree> myOutputTreePtr;
   std::shared_ptr<eventraw::EventInfo> myEventInfoPtr;
+  std::shared_ptr<std::vector<Hit2DCollection> > myRecHitsPtr;
+  bool mySlimFlag{false};
   
 };
 #endif
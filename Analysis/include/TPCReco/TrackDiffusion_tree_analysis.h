@@ -7,6 +7,7 @@
 
 #include "TPCReco/TrackDiffusion_tree_dataFormat.h"
 #include "TPCReco/TrackSegment3D.h"
+#include "TPCReco/TypedConfig.h"
 
 class GeometryTPC;
 class EventTPC;
@@ -48,6 +49,7 @@ class TrackDiffusion_tree_analysis{
  private:
 
   TrackDiffusionConfig myConfig;
+  tpcreco::config::HitFilterConfig myHitFilterConfig; // made once from myConfig
   Event_rawdiffusion event_rawdiffusion;
   std::string myOutputFileName;
   std::shared_ptr<TFile> myOutputFilePtr;
@@ -0,0 +1,83 @@
+#ifndef TPCRECO_ANALYSIS_TRACK_FLAT_TREE_H_
+#define TPCRECO_ANALYSIS_TRACK_FLAT_TREE_H_
+/////////////////////////////////////////////////////////
+//
+// Columnar (flat) representation of Track3D and EventInfo.
+//
+// Each event is stored as a set of plain scalar branches and
+// std::vector<double> branches with one element per track segment.
+// Reading does not require streaming of Track3D objects, and
+// individual columns can be disabled with TTree::SetBranchStatus().
+// The rec-hits are not stored. Integrated and maximal charge of each
+// segment are saved instead and restored with
+// TrackSegment3D::setChargeSummary(), so charge profiles along
+// the track are not available from the flat input.
+//
+/////////////////////////////////////////////////////////
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Rtypes.h>
+
+#include "TPCReco/EventInfo.h"
+
+class TTree;
+class Track3D;
+class GeometryTPC;
+
+class TrackFlatTree {
+
+ public:
+
+  static const std::string treeName;
+
+  TrackFlatTree();
+  TrackFlatTree(const TrackFlatTree &) = delete;
+  TrackFlatTree &operator=(const TrackFlatTree &) = delete;
+
+  /// Geometry assigned to restored track segments.
+  void setGeometry(std::shared_ptr<GeometryTPC> aGeometryPtr) { myGeometryPtr = aGeometryPtr;}
+
+  void createBranches(TTree *aTree);
+
+  /// Returns false if any of the branches is missing.
+  bool setBranchAddresses(TTree *aTree);
+
+  /// Segments of the track need a valid geometry for charge calculation.
+  void fill(const Track3D & aTrack, const eventraw::EventInfo & aEventInfo);
+
+  /// Restore track and event info from the current entry.
+  void get(Track3D & aTrack, eventraw::EventInfo & aEventInfo) const;
+
+ private:
+
+  enum column {
+    START_X, START_Y, START_Z,
+    END_X, END_Y, END_Z,
+    DIFFUSION,
+    LOSS_U, LOSS_V, LOSS_W,
+    CHARGE, MAX_CHARGE,
+    N_COLUMNS
+  };
+  static const char *columnNames[N_COLUMNS];
+
+  std::shared_ptr<GeometryTPC> myGeometryPtr;
+
+  Long64_t runId{0};
+  UInt_t eventId{0};
+  ULong64_t timestamp{0};
+  ULong64_t eventType{0};
+  Bool_t pedestalSubtracted{false};
+  Int_t nSegments{0};
+  Double_t length{0}, loss{0}, hypothesisFitLoss{0};
+  Double_t charge{0}, maxCharge{0};
+
+  std::vector<int> segPID;
+  std::vector<int> *segPIDPtr;
+  std::vector<double> myColumns[N_COLUMNS];
+  std::vector<double> *myColumnPtrs[N_COLUMNS];
+};
+
+#endif // TPCRECO_ANALYSIS_TRACK_FLAT_TREE_H_
@@ -36,8 +36,26 @@ Comp_analysis::Comp_analysis(std::shared_ptr<GeometryTPC> aGeometryPtr,
 }
 ///////////////////////////////
 ///////////////////////////////
+Comp_analysis::Comp_analysis(Comp_analysis &master, HistogramFillJournal &journal)
+  : outputFile(NULL),
+    myGeometryPtr(master.myGeometryPtr),
+    myRangeCalculator(master.myRangeCalculator),
+    isWorker(true) {
+  for(auto &h: master.histos1D) histos1D[h.first]=journal.makeRecorder(h.second);
+  for(auto &h: master.histos2D) histos2D[h.first]=journal.makeRecorder(h.second);
+  for(auto &p: master.profiles1D) profiles1D[p.first]=journal.makeRecorder(p.second);
+  for(auto &p: master.profiles2D) profiles2D[p.first]=journal.makeRecorder(p.second);
+}
+///////////////////////////////
+///////////////////////////////
+std::unique_ptr<Comp_analysis> Comp_analysis::makeWorker(HistogramFillJournal &journal){
+  return std::unique_ptr<Comp_analysis>(new Comp_analysis(*this, journal));
+}
+///////////////////////////////
+///////////////////////////////
 Comp_analysis::~Comp_analysis(){
 
+  if(isWorker) return; // worker does not own output file
   finalize();
   delete outputFile;
 }
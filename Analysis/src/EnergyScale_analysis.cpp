@@ -75,6 +75,8 @@
 #include <cassert>
 #include <tuple>
 #include <string>
+#include <thread>
+#include <atomic>
 #include <boost/bimap.hpp> // TEMPORARY FOR enumDict ENERGY_SCALE - TO BE DELETED
 #include <boost/assign.hpp> // TEMPORARY FOR enumDict ENERGY_SCALE - TO BE DELETED
 #include <boost/algorithm/string.hpp>
@@ -165,6 +167,10 @@ void EnergyScale_analysis::reset() {
   // clear optimal Ex bin sizes 
   myExcitationEnergyBinSizeMap.clear();
 
+  // clear packed events, histograms and fit functions (to be filled on first use)
+  myPackedSelection.clear();
+  myPackedSelection.resize(mySelection.size());
+
   // clear debug Ex histograms
   myExcitationEnergyFitMap.clear();
   for(auto &it: mySelection) {
@@ -889,12 +895,288 @@ std::tuple<double, double, bool> EnergyScale_analysis::getEventExcitationEnergy(
   return std::make_tuple(excitation_E_CMS, average_excitation_E_CMS, false); // [MeV]
 }
 
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+//
+// helper function to pack events of a given selection into contiguous arrays.
+// Called once per selection, the topology check and the PID resolution
+// of getEventExcitationEnergy() are not repeated at each fit iteration.
+void EnergyScale_analysis::packSelection(const EventCollection &selection, PackedEventCollection &packed) const {
+
+  // determine parent nucleus and expected list of PIDs, same as in getEventExcitationEnergy()
+  switch(selection.reaction) {
+  case reaction_type::C12_ALPHA:
+    packed.parentPID=pid_type::OXYGEN_16; // O-16 breakup
+    packed.trackPID={pid_type::ALPHA, pid_type::CARBON_12};
+    packed.trailingPID=pid_type::CARBON_12;
+    break;
+  case reaction_type::C14_ALPHA:
+    packed.parentPID=pid_type::OXYGEN_18; // O-18 breakup
+    packed.trackPID={pid_type::ALPHA, pid_type::CARBON_14};
+    packed.trailingPID=pid_type::CARBON_14;
+    break;
+  case reaction_type::THREE_ALPHA_BE:
+    packed.parentPID=pid_type::CARBON_12;
+    packed.trackPID={pid_type::ALPHA, pid_type::ALPHA, pid_type::ALPHA};
+    packed.trailingPID=pid_type::BERYLLIUM_8; // C-12 breakup via intermediate Be-8 ground/excited state
+    break;
+  case reaction_type::THREE_ALPHA_DEMOCRATIC:
+    packed.parentPID=pid_type::CARBON_12;
+    packed.trackPID={pid_type::ALPHA, pid_type::ALPHA, pid_type::ALPHA};
+    packed.trailingPID=pid_type::UNKNOWN; // not a 2-body decay
+    break;
+  default:
+    packed.trackPID.clear(); // no compatible events
+  };
+
+  const auto ntracks = packed.trackPID.size();
+  packed.eventIndex.clear();
+  packed.length.assign(ntracks, std::vector<double>());
+  packed.dirX.assign(ntracks, std::vector<double>());
+  packed.dirY.assign(ntracks, std::vector<double>());
+  packed.dirZ.assign(ntracks, std::vector<double>());
+  for(auto itrack=0U; itrack<ntracks; itrack++) {
+    packed.length[itrack].reserve(selection.events.size());
+    packed.dirX[itrack].reserve(selection.events.size());
+    packed.dirY[itrack].reserve(selection.events.size());
+    packed.dirZ[itrack].reserve(selection.events.size());
+  }
+
+  for(auto ievent=0U; ievent<selection.events.size(); ievent++) {
+    auto &list = selection.events[ievent];
+    auto compatible = (ntracks>0 && list.size()==ntracks);
+    for(auto itrack=0U; compatible && itrack<ntracks; itrack++) {
+      compatible = (list[itrack].pid==packed.trackPID[itrack]);
+    }
+    if(!compatible) {
+      ////// DEBUG
+      std::cout << __FUNCTION__ << ": WARNING: Incompatible reaction type=" << enumDict::GetReactionName(selection.reaction)
+		<< " with PID list:";
+      for(auto &it: list) {
+	std::cout << " " << enumDict::GetPidName(it.pid);
+      }
+      std::cout << std::endl;
+      ////// DEBUG
+      continue;
+    }
+    packed.eventIndex.push_back(ievent);
+    for(auto itrack=0U; itrack<ntracks; itrack++) {
+      TVector3 dir;
+      dir.SetMagThetaPhi(1.0, list[itrack].theta_BEAM_LAB, list[itrack].phi_BEAM_LAB);
+      packed.length[itrack].push_back(list[itrack].length_uncorrected);
+      packed.dirX[itrack].push_back(dir.X());
+      packed.dirY[itrack].push_back(dir.Y());
+      packed.dirZ[itrack].push_back(dir.Z());
+    }
+  }
+  packed.excitationEnergy.assign(packed.size(), 0.0);
+  packed.isPacked = true;
+
+  if(myOptions.debug) {
+    std::cout << __FUNCTION__ << ": selection=\"" << selection.description << "\"  packed "
+	      << packed.size() << " out of " << selection.events.size() << " events" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+//
+// helper function to fill excitation energy buffers of the requested selections.
+// Events of all selections are split into chunks processed by a pool of threads.
+void EnergyScale_analysis::fillExcitationEnergies(const std::vector<size_t> &selectionIndices) {
+
+  const size_t chunkSize = 4096; // events per chunk
+  struct Chunk {
+    size_t iselection;
+    size_t firstEvent;
+    size_t lastEvent;
+  };
+  std::vector<Chunk> chunks;
+  for(auto isel: selectionIndices) {
+    auto &packed = myPackedSelection.at(isel);
+    if(!packed.isPacked) {
+      packSelection(mySelection.at(isel), packed);
+    }
+    for(size_t first=0; first<packed.size(); first+=chunkSize) {
+      chunks.push_back({isel, first, std::min(first+chunkSize, packed.size())});
+    }
+  }
+
+  unsigned int nThreads = (myOptions.nThreads ? myOptions.nThreads : std::thread::hardware_concurrency());
+#if(TOY_MC_TESTSCALE || DEBUG_ENERGY)
+  nThreads = 1; // reference implementation is not thread-safe
+#endif
+  nThreads = std::max(1U, std::min(nThreads, (unsigned int)chunks.size()));
+
+  std::atomic<size_t> nextChunk{0};
+  auto worker = [&]() {
+    for(auto ichunk=nextChunk++; ichunk<chunks.size(); ichunk=nextChunk++) {
+      auto &chunk = chunks[ichunk];
+      fillExcitationEnergies(mySelection[chunk.iselection], myPackedSelection[chunk.iselection],
+			     chunk.firstEvent, chunk.lastEvent);
+    }
+  };
+  std::vector<std::thread> threads;
+  for(auto ithread=1U; ithread<nThreads; ithread++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for(auto &thread: threads) {
+    thread.join();
+  }
+}
+
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+//
+// Reconstructs excitation energy of packed events [firstEvent, lastEvent) of a given selection
+// and stores results in the excitation energy buffer. Same algorithm as in getEventExcitationEnergy(),
+// but corrections and constants are resolved once per chunk instead of once per track.
+// NOTE: Only read access to IonRangeCalculator is needed, so chunks can be processed concurrently.
+void EnergyScale_analysis::fillExcitationEnergies(EventCollection &selection, PackedEventCollection &packed,
+						  size_t firstEvent, size_t lastEvent) const {
+#if(TOY_MC_TESTSCALE || DEBUG_ENERGY)
+  // reference implementation with toy MC re-scaling and debug printouts
+  for(auto ievent=firstEvent; ievent<lastEvent; ievent++) {
+    auto result = getEventExcitationEnergy(selection.photonEnergyInMeV_LAB,
+					   selection.expectedExcitationEnergyPeakInMeV,
+					   selection.reaction,
+					   selection.excitedMassDiffInMeV, // mass difference for excited states (e.g. Be-8)
+					   selection.rangeCalc,
+					   selection.events[packed.eventIndex[ievent]]);
+    packed.excitationEnergy[ievent] = std::get<0>(result); // [MeV] - excitation energy in CMS
+  }
+#else
+  // current corrections for a given PID, same as applyLinearCorrectionPerPID() and getCorrectionPerPID()
+  struct TrackCorrection {
+    pid_type pid{pid_type::UNKNOWN};
+    bool enabled{false}; // TRUE = PID is being tuned
+    double offset{0.0}; // [mm] or [MeV]
+    double scale{1.0};
+    double zenekFactor{0.0}; // p0/p * T/T0
+    double mass{0.0}; // [MeV/c^2]
+    double apply(double observable) const {
+      return (enabled ? std::max( observable * scale + offset, 0.0) : observable);
+    }
+  };
+  auto rangeCalc = selection.rangeCalc;
+  auto getCorrection = [&](pid_type pid) {
+    TrackCorrection corr;
+    corr.pid = pid;
+    auto it = myCorrectionMap.find(pid);
+    if(it!=myCorrectionMap.end()) {
+      corr.enabled = true;
+      corr.offset = std::get<0>(it->second);
+      corr.scale = std::get<1>(it->second);
+    }
+    return corr;
+  };
+  const auto ntracks = packed.trackPID.size();
+  std::vector<TrackCorrection> trackCorr;
+  for(auto &pid: packed.trackPID) {
+    trackCorr.push_back(getCorrection(pid));
+    trackCorr.back().mass = rangeCalc->getIonMassMeV(pid);
+    if(myOptions.correction_type==escale_type::ZENEK) {
+      trackCorr.back().zenekFactor =
+	rangeCalc->getGasRangeReferencePressure(pid)/rangeCalc->getGasPressure()
+	* rangeCalc->getGasTemperature()/rangeCalc->getGasRangeReferencePressure(pid);
+    }
+  }
+  const auto &leadingCorr = trackCorr.front();
+  const auto trailingCorr = getCorrection(packed.trailingPID); // for corrections in CMS
+  const auto parentMassGroundState = rangeCalc->getIonMassMeV(packed.parentPID); // MeV/c^2, isotopic mass
+  const auto trailingMass = (packed.trailingPID!=pid_type::UNKNOWN ?
+			     rangeCalc->getIonMassMeV(packed.trailingPID) // [MeV/c^2] - ground state mass
+			     + selection.excitedMassDiffInMeV : 0.0);     // addition for excited state mass (e.g. Be-8)
+
+  // kinetic energy in LAB with current corrections for track length or energy in LAB
+  auto getEnergyLAB = [&](const TrackCorrection &corr, double length) {
+    if(myOptions.correction_type==escale_type::LENGTH) {
+      return rangeCalc->getIonEnergyMeV(corr.pid, corr.apply(length));
+    }
+    if(myOptions.correction_type==escale_type::ENERGY_LAB) {
+      return corr.apply(rangeCalc->getIonEnergyMeV(corr.pid, length));
+    }
+    if(myOptions.correction_type==escale_type::ZENEK) {
+      auto length_rescaled = std::max(0.0, length + corr.offset * corr.zenekFactor);
+      return corr.scale * rangeCalc->getIonEnergyMeV(corr.pid, length_rescaled);
+    }
+    return rangeCalc->getIonEnergyMeV(corr.pid, length);
+  };
+
+  for(auto ievent=firstEvent; ievent<lastEvent; ievent++) {
+
+    // get momentum and energy of the leading particle from 2- or 3-body decay in BEAM/LAB frame
+    auto leading_T_LAB = getEnergyLAB(leadingCorr, packed.length[0][ievent]);
+    auto leading_p_LAB = sqrt(leading_T_LAB*(leading_T_LAB+2*leadingCorr.mass));
+    TLorentzVector leadingP4_BEAM_LAB(leading_p_LAB*packed.dirX[0][ievent],
+				      leading_p_LAB*packed.dirY[0][ievent],
+				      leading_p_LAB*packed.dirZ[0][ievent],
+				      leadingCorr.mass+leading_T_LAB);
+
+    // get invariant mass and sum of momenta of all but the leading particle in this event
+    auto trailing_mass = trailingMass;
+    TLorentzVector trailingP4_BEAM_LAB{0,0,0,0};
+    if(ntracks==3) { // 3-body decay
+      for(auto itrack=1U; itrack<ntracks; itrack++) {
+	auto &corr = trackCorr[itrack];
+	auto T_LAB = getEnergyLAB(corr, packed.length[itrack][ievent]);
+	auto p_LAB = sqrt(T_LAB*(T_LAB+2*corr.mass));
+	TLorentzVector p4_BEAM_LAB;
+	p4_BEAM_LAB.SetXYZM(p_LAB*packed.dirX[itrack][ievent],
+			    p_LAB*packed.dirY[itrack][ievent],
+			    p_LAB*packed.dirZ[itrack][ievent], corr.mass);
+	trailingP4_BEAM_LAB += p4_BEAM_LAB;
+      }
+      if(selection.reaction==reaction_type::THREE_ALPHA_DEMOCRATIC) trailing_mass = trailingP4_BEAM_LAB.M(); // get inv. mass from two alphas
+    } else { // 2-body decay
+      auto trailing_T_LAB = getEnergyLAB(trackCorr[1], packed.length[1][ievent]);
+      auto trailing_p_LAB = sqrt(trailing_T_LAB*(trailing_T_LAB+2*trailing_mass));
+      trailingP4_BEAM_LAB.SetXYZM(trailing_p_LAB*packed.dirX[1][ievent],
+				  trailing_p_LAB*packed.dirY[1][ievent],
+				  trailing_p_LAB*packed.dirZ[1][ievent], trailing_mass);
+    }
+
+    // boost P4 from BEAM/LAB frame to BEAM/CMS frame (see TLorentzVector::Boost() convention!)
+    auto beta = getBetaOfCMS(parentMassGroundState,
+			     (myOptions.use_nominal_beam_energy ? selection.photonEnergyInMeV_LAB : // nominal gamma beam energy
+			      (leadingP4_BEAM_LAB+trailingP4_BEAM_LAB).E()-parentMassGroundState)); // reconstructed gamma beam energy
+    auto &leadingP4_BEAM_CMS = leadingP4_BEAM_LAB;
+    auto &trailingP4_BEAM_CMS = trailingP4_BEAM_LAB;
+    leadingP4_BEAM_CMS.Boost(0, 0, -beta);
+    trailingP4_BEAM_CMS.Boost(0, 0, -beta);
+    auto leading_T_CMS = leadingP4_BEAM_CMS.E()-leadingCorr.mass; // [MeV] - kinetic energy in CMS
+
+    // on demand, apply current corrections to track energies in CMS
+    if(myOptions.correction_type==escale_type::ENERGY_CMS) {
+      leading_T_CMS = leadingCorr.apply(leading_T_CMS); // corrected Ekin
+      auto leading_p_CMS = sqrt(leading_T_CMS*(leading_T_CMS+2*leadingCorr.mass)); // corrected momentum
+      leadingP4_BEAM_CMS.SetVectM(leading_p_CMS*leadingP4_BEAM_CMS.Vect().Unit(), leadingCorr.mass);
+      auto trailing_T_CMS = trailingCorr.apply(trailingP4_BEAM_CMS.E()-trailing_mass); // corrected Ekin
+      auto trailing_p_CMS = sqrt(trailing_T_CMS*(trailing_T_CMS+2*trailing_mass)); // corrected momentum
+      trailingP4_BEAM_CMS.SetVectM(trailing_p_CMS*trailingP4_BEAM_CMS.Vect().Unit(), trailing_mass);
+    }
+
+    // on demand, calculate properties of the 2nd particle from momentum conservation in CMS
+    if(myOptions.use_leading_track_only) {
+      trailingP4_BEAM_CMS.SetVectM(-leadingP4_BEAM_CMS.Vect(), trailing_mass);
+    }
+
+    auto excitation_E_CMS = (leadingP4_BEAM_CMS+trailingP4_BEAM_CMS).E()-parentMassGroundState; // [MeV]
+    if(myOptions.use_leading_track_only && selection.reaction!=reaction_type::THREE_ALPHA_DEMOCRATIC) {
+      excitation_E_CMS = leading_T_CMS*(1+leadingCorr.mass/trailing_mass)+leadingCorr.mass+trailing_mass-parentMassGroundState;
+    }
+    packed.excitationEnergy[ievent] = excitation_E_CMS;
+  }
+#endif
+}
+
 /////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////// - IMPLEMENTATION #8
 //
 // helper function to calculate optimal bin size [MeV] for excitation energy histogram
 // rounded off to the nearest: 1keV (for bin<10keV) or 2 keV (for 10<bin<20keV) or 5 keV (for 20<bin<50keV) or 10 keV (otherwise)
-TH1D EnergyScale_analysis::getOptimizedExcitationEnergyHistogram(EventCollection &selection) {
+TH1D EnergyScale_analysis::getOptimizedExcitationEnergyHistogram(EventCollection &selection, const std::vector<double> &excitationEnergies) {
 
   const double minEnergyBinSize = 0.002; // MeV
   const double maxEnergyBinSize = 0.05; // MeV
@@ -915,21 +1197,9 @@ TH1D EnergyScale_analysis::getOptimizedExcitationEnergyHistogram(EventCollection
   // find best bin size
   if(!fixed_bins) {
 
-    size_t npassed = 0U;
-    for(auto &event: selection.events) {
-      auto result = getEventExcitationEnergy(selection.photonEnergyInMeV_LAB,
-					     selection.expectedExcitationEnergyPeakInMeV,
-					     selection.reaction,
-					     selection.excitedMassDiffInMeV, // mass difference for excited states (e.g. Be-8)
-					     selection.rangeCalc,
-					     event);
-      auto error = std::get<2>(result);
-      if(error) continue;
-      htemp.Fill( std::get<0>(result) ); // [MeV] - ExcitationEnergy in CMS
-      npassed++;
+    for(auto &energy: excitationEnergies) {
+      htemp.Fill( energy ); // [MeV] - ExcitationEnergy in CMS
     }
-
-    // rebin to get reasonable peak height
     TH1D htemp_copy=htemp;
     int rebin=2;
     while(htemp.GetMaximum()<25 && energyBinSize<maxEnergyBinSize) {
@@ -966,38 +1236,44 @@ TH1D EnergyScale_analysis::getOptimizedExcitationEnergyHistogram(EventCollection
 ///////////////////////////////////////////////////////// - IMPLEMENTATION #8
 //
 // helper function to calculate global chi^2
-std::tuple<double, size_t> EnergyScale_analysis::getSelectionChi2(EventCollection &selection, bool debug_histos_flag) {
+std::tuple<double, size_t> EnergyScale_analysis::getSelectionChi2(EventCollection &selection, PackedEventCollection &packed, bool debug_histos_flag) {
 
   const double fitPeakFraction = 0.6; // in the 2nd pass limit fit range to the vicinity of the peak at a certain level
-  TH1D hExcitationEnergy, hExcitationEnergyAve;
-  getOptimizedExcitationEnergyHistogram(selection).Copy(hExcitationEnergy);
-  hExcitationEnergy.SetName("hExcitationEnergy");
-  hExcitationEnergy.Copy(hExcitationEnergyAve);
-  hExcitationEnergyAve.SetName("hExcitationEnergyAve");
-  hExcitationEnergy.StatOverflows(true);    // for proper mean value calculations
-  hExcitationEnergyAve.StatOverflows(true);
+  auto &hExcitationEnergy = packed.hExcitationEnergy;
+
+  // on first call, optimize histogram binning and create fit functions to be reused in subsequent iterations
+  if(!packed.energyShapeGauss) {
+    getOptimizedExcitationEnergyHistogram(selection, packed.excitationEnergy).Copy(hExcitationEnergy);
+    hExcitationEnergy.SetName("hExcitationEnergy");
+    hExcitationEnergy.StatOverflows(true);    // for proper mean value calculations
+    const double xmin = hExcitationEnergy.GetXaxis()->GetXmin();
+    const double xmax = hExcitationEnergy.GetXaxis()->GetXmax();
+    packed.energyShapeGaussBifurcated =
+      std::make_shared<TF1>(("f_energyShapeGaussBifurcated_"+selection.description).c_str(), [](double *x, double *p) {
+	  const double xx = x[0] - p[1]; // [MeV]
+	  const double sigmaLeft = p[2]; // [MeV]
+	  const double sigmaRight = p[3]; // [MeV]
+	  if(xx<0) return p[0] * exp( - 0.5 * xx * xx / sigmaLeft / sigmaLeft );
+	  return p[0] * exp( - 0.5 * xx * xx / sigmaRight / sigmaRight );
+	}, xmin, xmax, 4, 1); // 4 parameters, 1 dimension
+    packed.energyShapeGauss =
+      std::make_shared<TF1>(("f_energyShapeGauss_"+selection.description).c_str(), [](double *x, double *p) {
+	  const double xx = x[0] - p[1]; // [MeV]
+	  const double sigma = p[2]; // [MeV]
+	  return p[0] * exp( - 0.5 * xx * xx / sigma / sigma );
+	}, xmin, xmax, 3, 1); // 3 parameters, 1 dimension
+  } else {
+    hExcitationEnergy.Reset(); // clears contents, statistics and functions from previous fits
+  }
   const double xmin = hExcitationEnergy.GetXaxis()->GetXmin();
   const double xmax = hExcitationEnergy.GetXaxis()->GetXmax();
 
-  size_t npassed = 0U;
-  for(auto &event: selection.events) {
-    auto result = getEventExcitationEnergy(selection.photonEnergyInMeV_LAB,
-					   selection.expectedExcitationEnergyPeakInMeV,
-					   selection.reaction,
-					   selection.excitedMassDiffInMeV, // mass difference for excited states (e.g. Be-8)
-					   selection.rangeCalc,
-					   event);
-    auto error = std::get<2>(result);
-    if(error) continue;
-
-    hExcitationEnergy.Fill( std::get<0>(result) ); // [MeV] - excitation energy in CMS
-    hExcitationEnergyAve.Fill( std::get<1>(result) ); // [MeV] - average/expected excitation energy in CMS (=const)
-    npassed++;
-  }
+  const size_t npassed = packed.size();
+  hExcitationEnergy.FillN((int)npassed, packed.excitationEnergy.data(), NULL); // [MeV] - excitation energy in CMS
   auto ExcitationEnergy_mean = hExcitationEnergy.GetMean();
   auto ExcitationEnergy_mean_err = hExcitationEnergy.GetMeanError();
-  auto ExcitationEnergy_expected = hExcitationEnergyAve.GetMean();
-  auto ExcitationEnergy_expected_err = hExcitationEnergyAve.GetMeanError();
+  auto ExcitationEnergy_expected = (npassed ? selection.expectedExcitationEnergyPeakInMeV : 0.0); // average/expected excitation energy in CMS (=const)
+  auto ExcitationEnergy_expected_err = 0.0;
   auto ExcitationEnergy_RMS = hExcitationEnergy.GetRMS();
 
   // post-fill fitting using bifurcated gaussian shape
@@ -1005,25 +1281,14 @@ std::tuple<double, size_t> EnergyScale_analysis::getSelectionChi2(EventCollectio
   //  const bool hasEnoughEvents = true;
   const bool hasEnoughEvents = (hExcitationEnergy.Integral() > 500); // arbitrary cut
   const bool use_bifurcated_gauss = hasEnoughEvents && USE_SHAPE_ASYMMETRY;
-  TF1 energyShapeGaussBifurcated("f_energyShapeGaussBifurcated", [](double *x, double *p) {
-      const double xx = x[0] - p[1]; // [MeV]
-      const double sigmaLeft = p[2]; // [MeV]
-      const double sigmaRight = p[3]; // [MeV]
-      if(xx<0) return p[0] * exp( - 0.5 * xx * xx / sigmaLeft / sigmaLeft );
-      return p[0] * exp( - 0.5 * xx * xx / sigmaRight / sigmaRight );
-    }, xmin, xmax, 4, 1); // 4 parameters, 1 dimension
-  TF1 energyShapeGauss("f_energyShapeGauss", [](double *x, double *p) {
-      const double xx = x[0] - p[1]; // [MeV]
-      const double sigma = p[2]; // [MeV]
-      return p[0] * exp( - 0.5 * xx * xx / sigma / sigma );
-    }, xmin, xmax, 3, 1); // 3 parameters, 1 dimension
   TF1* funcPtr = NULL;
   
   if(use_bifurcated_gauss) {
-    funcPtr = &energyShapeGaussBifurcated;
+    funcPtr = packed.energyShapeGaussBifurcated.get();
   } else {
-    funcPtr = &energyShapeGauss;
+    funcPtr = packed.energyShapeGauss.get();
   }
+  funcPtr->SetRange(xmin, xmax); // restore full range after previous iteration
   // set parameter constraints depending on CHI2 calculation strategy
   funcPtr->SetParLimits(0, 0.5*hExcitationEnergy.GetMaximum(), 2.0*hExcitationEnergy.GetMaximum());
   funcPtr->SetParLimits(2, 0.1*ExcitationEnergy_RMS, 10*ExcitationEnergy_RMS); // [MeV]
@@ -1236,12 +1501,22 @@ double EnergyScale_analysis::getChi2(const bool debug_histos_flag) {
   double sumW=0.0;
   int sumN=0;
 
-  for(auto &selection: mySelection) {
+  // reconstruct excitation energies of all requested selections in parallel,
+  // histogram fits below are performed sequentially (ROOT fitting is not thread-safe)
+  std::vector<size_t> selectionIndices;
+  for(auto isel=0U; isel<mySelection.size(); isel++) {
+    if(mySelection[isel].enabled || debug_histos_flag) selectionIndices.push_back(isel);
+  }
+  fillExcitationEnergies(selectionIndices);
+
+  for(auto isel=0U; isel<mySelection.size(); isel++) {
+    auto &selection = mySelection[isel];
+    auto &packed = myPackedSelection[isel];
     if(selection.enabled) {
       size_t npoints = 0U;
       double chi2 = 0.0;
       double W = 1.0;
-      std::tie(chi2, npoints) = getSelectionChi2(selection, debug_histos_flag);
+      std::tie(chi2, npoints) = getSelectionChi2(selection, packed, debug_histos_flag);
       assert(npoints>0);
       
       if(stat_weights_flag) {
@@ -1260,7 +1535,7 @@ double EnergyScale_analysis::getChi2(const bool debug_histos_flag) {
     } else if(debug_histos_flag) { // on demand, fill excitation energy histograms for non-active x-check data samples
       size_t npoints = 0U;
       double chi2 = 0.0;
-      std::tie(chi2, npoints) = getSelectionChi2(selection, debug_histos_flag);      
+      std::tie(chi2, npoints) = getSelectionChi2(selection, packed, debug_histos_flag);      
       assert(npoints>0);
     }
   }
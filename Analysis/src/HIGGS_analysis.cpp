@@ -38,8 +38,30 @@ HIGGS_analysis::HIGGS_analysis(std::shared_ptr<GeometryTPC> aGeometryPtr, // def
 }
 ///////////////////////////////
 ///////////////////////////////
+HIGGS_analysis::HIGGS_analysis(HIGGS_analysis &master, HistogramFillJournal &journal)
+  : outputFile(NULL),
+    myGeometryPtr(master.myGeometryPtr),
+    myRangeCalculator(master.myRangeCalculator),
+    coordinateConverter(master.coordinateConverter),
+    photonUnitVec_DET_LAB(master.photonUnitVec_DET_LAB),
+    photonEnergyInMeV_LAB(master.photonEnergyInMeV_LAB),
+    useNominalPhotonEnergyForBoost(master.useNominalPhotonEnergyForBoost),
+    myMaster(&master),
+    myJournal(&journal) {
+  for(auto &h: master.histos1D) histos1D[h.first]=journal.makeRecorder(h.second);
+  for(auto &h: master.histos2D) histos2D[h.first]=journal.makeRecorder(h.second);
+  for(auto &p: master.profiles1D) profiles1D[p.first]=journal.makeRecorder(p.second);
+}
+///////////////////////////////
+///////////////////////////////
+std::unique_ptr<HIGGS_analysis> HIGGS_analysis::makeWorker(HistogramFillJournal &journal){
+  return std::unique_ptr<HIGGS_analysis>(new HIGGS_analysis(*this, journal));
+}
+///////////////////////////////
+///////////////////////////////
 HIGGS_analysis::~HIGGS_analysis(){
 
+  if(myMaster) return; // worker does not own output files
   finalize();
   delete outputFile;
 }
@@ -765,13 +787,17 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack, eventraw::EventInfo *aEventInfo
     (aEventInfo ? duration_cast<duration<long double>>(tpcreco::eventAbsoluteTime(*aEventInfo).time_since_epoch()).count() : -1); // absolute Unix time [s]
   long double runTimeSec =
     (aEventInfo ? duration_cast<duration<long double>>(tpcreco::eventRelativeTime(*aEventInfo)).count() : -1); // [s]
-  static double last_timestamp = 0;
-  if(isFirst) {
-    last_timestamp=unixTimeSec;
+  long double deltaTimeSec=-1; // [s] time difference for rate measurements
+  if(myMaster) { // worker: previous event is known only when fills are replayed in entry order
+    bool hasEventInfo=(aEventInfo!=NULL);
+    bool first=isFirst;
     isFirst=false;
+    myJournal->addAction([master=myMaster, unixTimeSec, hasEventInfo, first]() mutable {
+	master->myDeltaTimeSec=master->getDeltaTime(unixTimeSec, hasEventInfo, first);
+      });
+  } else {
+    deltaTimeSec=getDeltaTime(unixTimeSec, aEventInfo!=NULL, isFirst);
   }
-  long double deltaTimeSec= (aEventInfo ? unixTimeSec - last_timestamp : -1); // [s] time difference for rate measurements
-  last_timestamp=unixTimeSec;
   ///// DEBUG - elapsed run time
 
   const int ntracks = aTrack->getSegments().size();
@@ -1049,13 +1075,13 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack, eventraw::EventInfo *aEventInfo
     histos1D["h_2prong_excitation_E_CMS_fromAlpha"]->Fill(oxygenExcitationEnergy_fromAlpha);
     histos1D["h_2prong_gamma_E_LAB_fromAlpha"]->Fill(photon_E_LAB_fromAlpha);
     histos1D["h_2prong_runTime"]->Fill(runTimeSec);
-      histos1D["h_2prong_deltaTime"]->Fill(deltaTimeSec);
+      fillDeltaTime("h_2prong_deltaTime", deltaTimeSec);
     // DEBUG - after additional ID cuts
     if(passed_O16_idCut) {
       histos1D["h_2prong_excitation_E_CMS_fromAlpha_CutO16"]->Fill(oxygenExcitationEnergy_fromAlpha);
       histos1D["h_2prong_gamma_E_LAB_fromAlpha_CutO16"]->Fill(photon_E_LAB_fromAlpha);
       histos1D["h_2prong_runTime_CutO16"]->Fill(runTimeSec);
-      histos1D["h_2prong_deltaTime_CutO16"]->Fill(deltaTimeSec);
+      fillDeltaTime("h_2prong_deltaTime_CutO16", deltaTimeSec);
     }
     //
     ///////////// DEBUG
@@ -1166,11 +1192,7 @@ void HIGGS_analysis::fillHistos(Track3D *aTrack, eventraw::EventInfo *aEventInfo
     ///////// DEBUG - special Reco file with selected events only
     //
     if(passed_O16_idCut) {
-      //      myDumpRecoFile->cd();
-      *myDumpTrack=*aTrack;
-      *myDumpEventInfo=*aEventInfo;
-      myDumpTree->Fill();
-      //      outputFile->cd();
+      dumpEvent(aTrack, aEventInfo);
     }
     //
     ///////// DEBUG - special Reco file with selected events only
@@ -1438,6 +1460,46 @@ void HIGGS_analysis::finalize(){
 }
 ///////////////////////////////
 ///////////////////////////////
+// time difference [s] wrt previous event for rate measurements
+long double HIGGS_analysis::getDeltaTime(long double unixTimeSec, bool hasEventInfo, bool &isFirst){
+  if(isFirst) {
+    myLastTimestamp=unixTimeSec;
+    isFirst=false;
+  }
+  long double deltaTimeSec= (hasEventInfo ? unixTimeSec - myLastTimestamp : -1); // [s]
+  myLastTimestamp=unixTimeSec;
+  return deltaTimeSec;
+}
+///////////////////////////////
+///////////////////////////////
+void HIGGS_analysis::fillDeltaTime(const std::string &name, long double deltaTimeSec){
+  if(myMaster) { // worker: value is known only when fills are replayed in entry order
+    myJournal->addAction([master=myMaster, name]() {
+	master->histos1D[name]->Fill(master->myDeltaTimeSec);
+      });
+    return;
+  }
+  histos1D[name]->Fill(deltaTimeSec);
+}
+///////////////////////////////
+///////////////////////////////
+void HIGGS_analysis::dumpEvent(Track3D *aTrack, eventraw::EventInfo *aEventInfo){
+  if(myMaster) { // worker: keep a copy for the replay in entry order
+    auto aTrackCopy=std::make_shared<Track3D>(*aTrack);
+    auto aEventInfoCopy=std::make_shared<eventraw::EventInfo>(*aEventInfo);
+    myJournal->addAction([master=myMaster, aTrackCopy, aEventInfoCopy]() {
+	master->dumpEvent(aTrackCopy.get(), aEventInfoCopy.get());
+      });
+    return;
+  }
+  //      myDumpRecoFile->cd();
+  *myDumpTrack=*aTrack;
+  *myDumpEventInfo=*aEventInfo;
+  myDumpTree->Fill();
+  //      outputFile->cd();
+}
+///////////////////////////////
+///////////////////////////////
 void HIGGS_analysis::setGeometry(std::shared_ptr<GeometryTPC> aGeometryPtr){
   myGeometryPtr = aGeometryPtr;
   if(!myGeometryPtr) {
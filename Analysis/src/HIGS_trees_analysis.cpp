@@ -43,6 +43,10 @@ HIGS_trees_analysis::HIGS_trees_analysis(std::shared_ptr<GeometryTPC> aGeometryP
 ///////////////////////////////
 ///////////////////////////////
 HIGS_trees_analysis::~HIGS_trees_analysis(){
+  // indices stored with the trees, see EventIndex::attach()
+  Output1prongTreePtr->BuildIndex("runId", "eventId");
+  Output2prongTreePtr->BuildIndex("runId", "eventId");
+  Output3prongTreePtr->BuildIndex("runId", "eventId");
   Output1prongTreePtr->Write("", TObject::kOverwrite);
   Output2prongTreePtr->Write("", TObject::kOverwrite);
   Output3prongTreePtr->Write("", TObject::kOverwrite);
@@ -0,0 +1,152 @@
+#include "TPCReco/HistogramFillJournal.h"
+
+namespace {
+
+  ///////////////////////////////
+  ///////////////////////////////
+  class TH1FRecorder : public TH1F {
+  public:
+    TH1FRecorder(HistogramFillJournal *journal, TH1F *target) : myJournal(journal), myTarget(target) { }
+    using TH1F::Fill;
+    Int_t Fill(Double_t x) override {
+      myJournal->record(HistogramFillJournal::FillType::X, myTarget, x);
+      return -1;
+    }
+    Int_t Fill(Double_t x, Double_t w) override {
+      myJournal->record(HistogramFillJournal::FillType::XW, myTarget, x, 0, 0, w);
+      return -1;
+    }
+  private:
+    HistogramFillJournal *myJournal;
+    TH1F *myTarget;
+  };
+
+  ///////////////////////////////
+  ///////////////////////////////
+  class TH2FRecorder : public TH2F {
+  public:
+    TH2FRecorder(HistogramFillJournal *journal, TH2F *target) : myJournal(journal), myTarget(target) { }
+    using TH2F::Fill;
+    Int_t Fill(Double_t x, Double_t y) override {
+      myJournal->record(HistogramFillJournal::FillType::XY, myTarget, x, y);
+      return -1;
+    }
+    Int_t Fill(Double_t x, Double_t y, Double_t w) override {
+      myJournal->record(HistogramFillJournal::FillType::XYW_2D, myTarget, x, y, 0, w);
+      return -1;
+    }
+  private:
+    HistogramFillJournal *myJournal;
+    TH2F *myTarget;
+  };
+
+  ///////////////////////////////
+  ///////////////////////////////
+  class TProfileRecorder : public TProfile {
+  public:
+    TProfileRecorder(HistogramFillJournal *journal, TProfile *target) : myJournal(journal), myTarget(target) { }
+    using TProfile::Fill;
+    Int_t Fill(Double_t x, Double_t y) override {
+      myJournal->record(HistogramFillJournal::FillType::XY, myTarget, x, y);
+      return -1;
+    }
+    Int_t Fill(Double_t x, Double_t y, Double_t w) override {
+      myJournal->record(HistogramFillJournal::FillType::XYW_PROF, myTarget, x, y, 0, w);
+      return -1;
+    }
+  private:
+    HistogramFillJournal *myJournal;
+    TProfile *myTarget;
+  };
+
+  ///////////////////////////////
+  ///////////////////////////////
+  class TProfile2DRecorder : public TProfile2D {
+  public:
+    TProfile2DRecorder(HistogramFillJournal *journal, TProfile2D *target) : myJournal(journal), myTarget(target) { }
+    using TProfile2D::Fill;
+    Int_t Fill(Double_t x, Double_t y, Double_t z) override {
+      myJournal->record(HistogramFillJournal::FillType::XYZ, myTarget, x, y, z);
+      return -1;
+    }
+    Int_t Fill(Double_t x, Double_t y, Double_t z, Double_t w) override {
+      myJournal->record(HistogramFillJournal::FillType::XYZW, myTarget, x, y, z, w);
+      return -1;
+    }
+  private:
+    HistogramFillJournal *myJournal;
+    TProfile2D *myTarget;
+  };
+}
+
+///////////////////////////////
+///////////////////////////////
+TH1F *HistogramFillJournal::makeRecorder(TH1F *target){
+  myRecorders.emplace_back(new TH1FRecorder(this, target));
+  return static_cast<TH1F*>(myRecorders.back().get());
+}
+///////////////////////////////
+///////////////////////////////
+TH2F *HistogramFillJournal::makeRecorder(TH2F *target){
+  myRecorders.emplace_back(new TH2FRecorder(this, target));
+  return static_cast<TH2F*>(myRecorders.back().get());
+}
+///////////////////////////////
+///////////////////////////////
+TProfile *HistogramFillJournal::makeRecorder(TProfile *target){
+  myRecorders.emplace_back(new TProfileRecorder(this, target));
+  return static_cast<TProfile*>(myRecorders.back().get());
+}
+///////////////////////////////
+///////////////////////////////
+TProfile2D *HistogramFillJournal::makeRecorder(TProfile2D *target){
+  myRecorders.emplace_back(new TProfile2DRecorder(this, target));
+  return static_cast<TProfile2D*>(myRecorders.back().get());
+}
+///////////////////////////////
+///////////////////////////////
+void HistogramFillJournal::addAction(Action action){
+  myActions.push_back(std::move(action));
+  myRecords.push_back({FillType::ACTION, NULL, 0, 0, 0, 0});
+}
+///////////////////////////////
+///////////////////////////////
+void HistogramFillJournal::replay(){
+
+  auto nextAction = myActions.begin();
+  for(auto &r: myRecords) {
+    switch(r.type) {
+    case FillType::X:
+      r.target->Fill(r.x);
+      break;
+    case FillType::XW:
+      r.target->Fill(r.x, r.w);
+      break;
+    case FillType::XY: // TH2::Fill(x, y) and TProfile::Fill(x, y) override TH1::Fill(x, w)
+      r.target->Fill(r.x, r.y);
+      break;
+    case FillType::XYW_2D:
+      static_cast<TH2*>(r.target)->Fill(r.x, r.y, r.w);
+      break;
+    case FillType::XYW_PROF:
+      static_cast<TProfile*>(r.target)->Fill(r.x, r.y, r.w);
+      break;
+    case FillType::XYZ:
+      static_cast<TProfile2D*>(r.target)->Fill(r.x, r.y, r.z);
+      break;
+    case FillType::XYZW:
+      static_cast<TProfile2D*>(r.target)->Fill(r.x, r.y, r.z, r.w);
+      break;
+    case FillType::ACTION:
+      (*nextAction++)();
+      break;
+    };
+  }
+  clear();
+}
+///////////////////////////////
+///////////////////////////////
+void HistogramFillJournal::clear(){
+  myRecords.clear();
+  myActions.clear();
+}
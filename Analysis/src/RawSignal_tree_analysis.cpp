@@ -27,6 +27,10 @@ RawSignal_tree_analysis::RawSignal_tree_analysis(std::shared_ptr<GeometryTPC> aG
 { // definition of LAB detector coordinates
   setGeometry(aGeometryPtr);
   myClusterConfig = aClusterConfig;
+  myHitFilterConfig.enable = myClusterConfig.clusterEnable;
+  myHitFilterConfig.threshold = myClusterConfig.clusterThreshold;
+  myHitFilterConfig.deltaStrips = myClusterConfig.clusterDeltaStrips;
+  myHitFilterConfig.deltaTimeCells = myClusterConfig.clusterDeltaTimeCells;
   myOutputFileName = aOutputFileName;
   initialize();
 }
@@ -69,6 +73,8 @@ void RawSignal_tree_analysis::finalize(){
 
   std::cout << __FUNCTION__ << ": TTree current TFile ptr=" << myOutputTreePtr->GetCurrentFile() << std::endl;
 
+  // index stored with the tree, see EventIndex::attach()
+  myOutputTreePtr->BuildIndex("runId", "eventId");
   myOutputFilePtr->Write("", TObject::kOverwrite);
   //  std::cout << __FUNCTION__ << ": TTree current TFile ptr=" << myOutputTreePtr->GetCurrentFile() << std::endl;
   // myOutputTreePtr->Write("", TObject::kOverwrite);
@@ -122,11 +128,7 @@ void RawSignal_tree_analysis::fillTree(std::shared_ptr<EventTPC> aEventTPC, bool
   filter_type filterType = filter_type::none;
   if(myClusterConfig.clusterEnable) { // CLUSTER
     filterType = filter_type::threshold;
-    boost::property_tree::ptree config;
-    config.put("recoClusterThreshold", myClusterConfig.clusterThreshold);
-    config.put("recoClusterDeltaStrips",myClusterConfig.clusterDeltaStrips);
-    config.put("recoClusterDeltaTimeCells",myClusterConfig.clusterDeltaTimeCells);  
-    aEventTPC->setHitFilterConfig(filterType, config);    
+    aEventTPC->setHitFilterConfig(filterType, myHitFilterConfig);
   }
   
   // MAKE A CLUSTER AND COMPUTE SOME STATISTICS
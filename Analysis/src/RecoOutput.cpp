@@ -13,6 +13,7 @@ RecoOutput::RecoOutput() {
 
   myEventInfoPtr = std::make_shared<eventraw::EventInfo>();
   myTrackPtr = std::make_shared<Track3D>();
+  myRecHitsPtr = std::make_shared<std::vector<Hit2DCollection> >();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -36,7 +37,7 @@ void RecoOutput::setEventInfo(const eventraw::EventInfo & aEventInfo){
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
-void RecoOutput::open(const std::string & fileName){
+void RecoOutput::open(const std::string & fileName, bool slim, bool storeRecHits){
 
   if(!myTrackPtr){
     std::cout<<KRED<<"RecoOutput::open"<<RST
@@ -53,6 +54,8 @@ void RecoOutput::open(const std::string & fileName){
   
   myOutputTreePtr->Branch("RecoEvent", myTrackPtr.get());
   myOutputTreePtr->Branch("EventInfo", myEventInfoPtr.get());
+  mySlimFlag = slim;
+  if(mySlimFlag && storeRecHits) myOutputTreePtr->Branch("RecoHits", myRecHitsPtr.get());
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -65,6 +68,8 @@ void RecoOutput::close(){
      return;
   }
   myOutputFilePtr->cd();
+  // index stored with the tree, see EventIndex::attach()
+  myOutputTreePtr->BuildIndex("EventInfo.runId", "EventInfo.eventId");
   myOutputTreePtr->Write("", TObject::kOverwrite);
   myOutputFilePtr->Close();
 }
@@ -78,6 +83,7 @@ void RecoOutput::update(){
 	     <<std::endl;
      return;
   }
+  if(mySlimFlag) *myRecHitsPtr = myTrackPtr->detachRecHits();
   myOutputTreePtr->Fill();
   myOutputFilePtr->cd();
   //myOutputTreePtr->Write("", TObject::kOverwrite);
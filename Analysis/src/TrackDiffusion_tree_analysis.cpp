@@ -29,6 +29,10 @@ TrackDiffusion_tree_analysis::TrackDiffusion_tree_analysis(const std::shared_ptr
 							   const std::string aOutputFileName){
   setGeometry(aGeometryPtr);
   myConfig = aConfig;
+  myHitFilterConfig.enable = myConfig.clusterEnable;
+  myHitFilterConfig.threshold = myConfig.clusterThreshold;
+  myHitFilterConfig.deltaStrips = myConfig.clusterDeltaStrips;
+  myHitFilterConfig.deltaTimeCells = myConfig.clusterDeltaTimeCells;
   myOutputFileName = aOutputFileName;
   initialize();
 }
@@ -65,6 +69,8 @@ void TrackDiffusion_tree_analysis::finalize(){
   	     <<std::endl;
     return;
   }
+  // index stored with the tree, see EventIndex::attach()
+  myOutputTreePtr->BuildIndex("runId", "eventId");
   myOutputFilePtr->Write("", TObject::kOverwrite);
   ////// DEBUG
   // std::cout << __FUNCTION__ << ": TTree current TFile ptr=" << myOutputTreePtr->GetCurrentFile() << std::endl;
@@ -94,11 +100,7 @@ void TrackDiffusion_tree_analysis::fillTree(const std::shared_ptr<EventTPC> aEve
   filter_type filterType = filter_type::none;
   if(myConfig.clusterEnable) { // CLUSTER
     filterType = filter_type::threshold;
-    boost::property_tree::ptree config;
-    config.put("recoClusterThreshold", myConfig.clusterThreshold);
-    config.put("recoClusterDeltaStrips",myConfig.clusterDeltaStrips);
-    config.put("recoClusterDeltaTimeCells",myConfig.clusterDeltaTimeCells);  
-    aEventTPC->setHitFilterConfig(filterType, config);
+    aEventTPC->setHitFilterConfig(filterType, myHitFilterConfig);
   }
   
   // MAKE A CLUSTER AND EXTRACT 2D PROJECTIONS IN MM
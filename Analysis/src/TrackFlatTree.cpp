@@ -0,0 +1,137 @@
+#include <iostream>
+
+#include <TTree.h>
+#include <TVector3.h>
+
+#include "TPCReco/Track3D.h"
+#include "TPCReco/TrackFlatTree.h"
+#include "TPCReco/colorText.h"
+
+const std::string TrackFlatTree::treeName = "TPCRecoFlat";
+
+const char *TrackFlatTree::columnNames[TrackFlatTree::N_COLUMNS] = {
+  "segStartX", "segStartY", "segStartZ",
+  "segEndX", "segEndY", "segEndZ",
+  "segDiffusion",
+  "segLossU", "segLossV", "segLossW",
+  "segCharge", "segMaxCharge"
+};
+///////////////////////////////
+///////////////////////////////
+TrackFlatTree::TrackFlatTree(){
+
+  segPIDPtr = &segPID;
+  for(int iColumn=0;iColumn<N_COLUMNS;++iColumn) myColumnPtrs[iColumn] = &myColumns[iColumn];
+}
+///////////////////////////////
+///////////////////////////////
+void TrackFlatTree::createBranches(TTree *aTree){
+
+  aTree->Branch("runId", &runId, "runId/L");
+  aTree->Branch("eventId", &eventId, "eventId/i");
+  aTree->Branch("timestamp", &timestamp, "timestamp/l");
+  aTree->Branch("eventType", &eventType, "eventType/l");
+  aTree->Branch("pedestalSubtracted", &pedestalSubtracted, "pedestalSubtracted/O");
+  aTree->Branch("nSegments", &nSegments, "nSegments/I");
+  aTree->Branch("length", &length, "length/D");
+  aTree->Branch("loss", &loss, "loss/D");
+  aTree->Branch("hypothesisFitLoss", &hypothesisFitLoss, "hypothesisFitLoss/D");
+  aTree->Branch("charge", &charge, "charge/D");
+  aTree->Branch("maxCharge", &maxCharge, "maxCharge/D");
+  aTree->Branch("segPID", &segPID);
+  for(int iColumn=0;iColumn<N_COLUMNS;++iColumn) aTree->Branch(columnNames[iColumn], &myColumns[iColumn]);
+}
+///////////////////////////////
+///////////////////////////////
+bool TrackFlatTree::setBranchAddresses(TTree *aTree){
+
+  std::vector<std::string> names = {"runId", "eventId", "timestamp", "eventType", "pedestalSubtracted",
+				    "nSegments", "length", "loss", "hypothesisFitLoss", "charge", "maxCharge", "segPID"};
+  names.insert(names.end(), columnNames, columnNames+N_COLUMNS);
+  for(const auto & aName: names){
+    if(!aTree->GetBranch(aName.c_str())){
+      std::cerr<<KRED<<"TrackFlatTree::setBranchAddresses: "<<RST
+	       <<"missing branch: "<<aName<<std::endl;
+      return false;
+    }
+  }
+  aTree->SetBranchAddress("runId", &runId);
+  aTree->SetBranchAddress("eventId", &eventId);
+  aTree->SetBranchAddress("timestamp", &timestamp);
+  aTree->SetBranchAddress("eventType", &eventType);
+  aTree->SetBranchAddress("pedestalSubtracted", &pedestalSubtracted);
+  aTree->SetBranchAddress("nSegments", &nSegments);
+  aTree->SetBranchAddress("length", &length);
+  aTree->SetBranchAddress("loss", &loss);
+  aTree->SetBranchAddress("hypothesisFitLoss", &hypothesisFitLoss);
+  aTree->SetBranchAddress("charge", &charge);
+  aTree->SetBranchAddress("maxCharge", &maxCharge);
+  aTree->SetBranchAddress("segPID", &segPIDPtr);
+  for(int iColumn=0;iColumn<N_COLUMNS;++iColumn) aTree->SetBranchAddress(columnNames[iColumn], &myColumnPtrs[iColumn]);
+  return true;
+}
+///////////////////////////////
+///////////////////////////////
+void TrackFlatTree::fill(const Track3D & aTrack, const eventraw::EventInfo & aEventInfo){
+
+  runId = aEventInfo.GetRunId();
+  eventId = aEventInfo.GetEventId();
+  timestamp = aEventInfo.GetEventTimestamp();
+  eventType = aEventInfo.GetEventType().to_ulong();
+  pedestalSubtracted = aEventInfo.GetPedestalSubtracted();
+
+  const TrackSegment3DCollection & aSegments = aTrack.getSegments();
+  nSegments = aSegments.size();
+  length = aTrack.getLength();
+  loss = aTrack.getLoss();
+  hypothesisFitLoss = aTrack.getHypothesisFitLoss();
+  charge = aTrack.getIntegratedCharge(aTrack.getLength());
+  maxCharge = aTrack.getMaxCharge();
+
+  segPID.clear();
+  for(auto & aColumn: myColumns) aColumn.clear();
+  for(const auto & aSegment: aSegments){
+    segPID.push_back(aSegment.getPID());
+    myColumns[START_X].push_back(aSegment.getStart().X());
+    myColumns[START_Y].push_back(aSegment.getStart().Y());
+    myColumns[START_Z].push_back(aSegment.getStart().Z());
+    myColumns[END_X].push_back(aSegment.getEnd().X());
+    myColumns[END_Y].push_back(aSegment.getEnd().Y());
+    myColumns[END_Z].push_back(aSegment.getEnd().Z());
+    myColumns[DIFFUSION].push_back(aSegment.getDiffusion());
+    // losses stored with the segment, the rec-hits of slim files are not available
+    myColumns[LOSS_U].push_back(aSegment.getLoss(definitions::projection_type::DIR_U));
+    myColumns[LOSS_V].push_back(aSegment.getLoss(definitions::projection_type::DIR_V));
+    myColumns[LOSS_W].push_back(aSegment.getLoss(definitions::projection_type::DIR_W));
+    myColumns[CHARGE].push_back(aSegment.getIntegratedCharge(aSegment.getLength()));
+    myColumns[MAX_CHARGE].push_back(aSegment.getMaxCharge());
+  }
+}
+///////////////////////////////
+///////////////////////////////
+void TrackFlatTree::get(Track3D & aTrack, eventraw::EventInfo & aEventInfo) const{
+
+  aEventInfo.reset();
+  aEventInfo.SetRunId(runId);
+  aEventInfo.SetEventId(eventId);
+  aEventInfo.SetEventTimestamp(timestamp);
+  aEventInfo.SetEventType(eventType);
+  aEventInfo.SetPedestalSubtracted(pedestalSubtracted);
+
+  TrackSegment3DCollection aSegments(segPID.size());
+  for(unsigned int iSegment=0;iSegment<aSegments.size();++iSegment){
+    TrackSegment3D & aSegment = aSegments[iSegment];
+    aSegment.setGeometry(myGeometryPtr);
+    aSegment.setStartEnd(TVector3(myColumns[START_X][iSegment], myColumns[START_Y][iSegment], myColumns[START_Z][iSegment]),
+			 TVector3(myColumns[END_X][iSegment], myColumns[END_Y][iSegment], myColumns[END_Z][iSegment]));
+    aSegment.setPID(static_cast<pid_type>(segPID[iSegment]));
+    aSegment.setDiffusion(myColumns[DIFFUSION][iSegment]);
+    aSegment.setProjectionsLoss({myColumns[LOSS_U][iSegment], myColumns[LOSS_V][iSegment], myColumns[LOSS_W][iSegment]});
+    aSegment.setChargeSummary(myColumns[CHARGE][iSegment], myColumns[MAX_CHARGE][iSegment]);
+  }
+  aTrack = Track3D();
+  aTrack.setSegments(aSegments);
+  aTrack.setHypothesisFitLoss(hypothesisFitLoss);
+}
+///////////////////////////////
+///////////////////////////////
@@ -0,0 +1,152 @@
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/Track3D.h"
+#include "TPCReco/TrackFlatTree.h"
+#include "gtest/gtest.h"
+#include <TTree.h>
+#include <TVector3.h>
+#include <memory>
+#include <string>
+
+class TrackFlatTreeTest : public ::testing::Test {
+public:
+  static std::shared_ptr<GeometryTPC> myGeometryPtr;
+
+  static void SetUpTestSuite() {
+    myGeometryPtr = std::make_shared<GeometryTPC>(
+        (std::string(TPCRECO_RESOURCE_DIR) +
+         "geometry_ELITPC_250mbar_12.5MHz.dat")
+            .c_str(),
+        false);
+  }
+  static void TearDownTestSuite() { myGeometryPtr.reset(); }
+
+  Track3D makeTrack() const {
+    Track3D aTrack;
+    std::vector<std::pair<TVector3, TVector3>> endPoints = {
+        {TVector3(0, 0, 0), TVector3(30, 10, 5)},
+        {TVector3(0, 0, 0), TVector3(-10, -5, 2)}};
+    std::vector<pid_type> pids = {pid_type::ALPHA, pid_type::CARBON_12};
+    for (unsigned int i = 0; i < endPoints.size(); ++i) {
+      TrackSegment3D aSegment;
+      aSegment.setGeometry(myGeometryPtr);
+      aSegment.setStartEnd(endPoints[i].first, endPoints[i].second);
+      aSegment.setPID(pids[i]);
+      aSegment.setDiffusion(0.5 + i);
+      std::vector<Hit2DCollection> aRecHits(3);
+      for (int dir = definitions::projection_type::DIR_U;
+           dir <= definitions::projection_type::DIR_W; ++dir) {
+        auto a2DProjection = aSegment.get2DProjection(dir, 0, 1);
+        for (int step = 0; step < 10; ++step) {
+          auto aPoint = a2DProjection.getStart() +
+                        step * a2DProjection.getTangent();
+          aRecHits[dir].push_back(Hit2D(aPoint.X(), aPoint.Y(), 10 + step));
+        }
+      }
+      aSegment.setRecHits(aRecHits);
+      aTrack.addSegment(aSegment);
+    }
+    return aTrack;
+  }
+};
+
+std::shared_ptr<GeometryTPC> TrackFlatTreeTest::myGeometryPtr;
+
+TEST_F(TrackFlatTreeTest, RoundTrip) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  Track3D aTrack = makeTrack();
+  aTrack.setHypothesisFitLoss(1.5);
+  eventraw::EventInfo aEventInfo;
+  aEventInfo.SetRunId(20220412);
+  aEventInfo.SetEventId(42);
+  aEventInfo.SetEventTimestamp(123456789);
+  aEventInfo.SetEventType(3);
+
+  TTree aTree(TrackFlatTree::treeName.c_str(), "");
+  aTree.SetDirectory(nullptr);
+  TrackFlatTree aWriter;
+  aWriter.createBranches(&aTree);
+  aWriter.fill(aTrack, aEventInfo);
+  aTree.Fill();
+
+  TrackFlatTree aReader;
+  aReader.setGeometry(myGeometryPtr);
+  ASSERT_TRUE(aReader.setBranchAddresses(&aTree));
+  ASSERT_GT(aTree.GetEntry(0), 0);
+  Track3D aRestoredTrack;
+  eventraw::EventInfo aRestoredEventInfo;
+  aReader.get(aRestoredTrack, aRestoredEventInfo);
+
+  EXPECT_EQ(aRestoredEventInfo.GetRunId(), aEventInfo.GetRunId());
+  EXPECT_EQ(aRestoredEventInfo.GetEventId(), aEventInfo.GetEventId());
+  EXPECT_EQ(aRestoredEventInfo.GetEventTimestamp(),
+            aEventInfo.GetEventTimestamp());
+  EXPECT_EQ(aRestoredEventInfo.GetEventType(), aEventInfo.GetEventType());
+
+  ASSERT_EQ(aRestoredTrack.getSegments().size(), aTrack.getSegments().size());
+  EXPECT_DOUBLE_EQ(aRestoredTrack.getLength(), aTrack.getLength());
+  EXPECT_DOUBLE_EQ(aRestoredTrack.getLoss(), aTrack.getLoss());
+  EXPECT_DOUBLE_EQ(aRestoredTrack.getHypothesisFitLoss(), 1.5);
+  EXPECT_DOUBLE_EQ(aRestoredTrack.getIntegratedCharge(aTrack.getLength()),
+                   aTrack.getIntegratedCharge(aTrack.getLength()));
+  EXPECT_DOUBLE_EQ(aRestoredTrack.getMaxCharge(), aTrack.getMaxCharge());
+  for (unsigned int i = 0; i < aTrack.getSegments().size(); ++i) {
+    const auto &aSegment = aTrack.getSegments()[i];
+    const auto &aRestoredSegment = aRestoredTrack.getSegments()[i];
+    EXPECT_EQ(aRestoredSegment.getPID(), aSegment.getPID());
+    EXPECT_EQ(aRestoredSegment.getStart(), aSegment.getStart());
+    EXPECT_EQ(aRestoredSegment.getEnd(), aSegment.getEnd());
+    EXPECT_DOUBLE_EQ(aRestoredSegment.getDiffusion(), aSegment.getDiffusion());
+    EXPECT_DOUBLE_EQ(aRestoredSegment.getTangent().Theta(),
+                     aSegment.getTangent().Theta());
+  }
+}
+
+TEST_F(TrackFlatTreeTest, LossWithoutRecHits) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  Track3D aTrack = makeTrack();
+  eventraw::EventInfo aEventInfo;
+
+  // tracks read back from flat trees, as those of slim files, have no rec-hits
+  TTree aTree(TrackFlatTree::treeName.c_str(), "");
+  aTree.SetDirectory(nullptr);
+  TrackFlatTree aWriter;
+  aWriter.createBranches(&aTree);
+  aWriter.fill(aTrack, aEventInfo);
+  aTree.Fill();
+  TrackFlatTree aReader;
+  aReader.setGeometry(myGeometryPtr);
+  ASSERT_TRUE(aReader.setBranchAddresses(&aTree));
+  ASSERT_GT(aTree.GetEntry(0), 0);
+  Track3D aRestoredTrack;
+  aReader.get(aRestoredTrack, aEventInfo);
+  for (const auto &aSegment : aRestoredTrack.getSegments()) {
+    for (const auto &aHits : aSegment.getRecHits()) {
+      ASSERT_TRUE(aHits.empty());
+    }
+  }
+
+  // flattened again, the stored losses are kept
+  TTree aSecondTree(TrackFlatTree::treeName.c_str(), "");
+  aSecondTree.SetDirectory(nullptr);
+  TrackFlatTree aSecondWriter;
+  aSecondWriter.createBranches(&aSecondTree);
+  aSecondWriter.fill(aRestoredTrack, aEventInfo);
+  aSecondTree.Fill();
+  TrackFlatTree aSecondReader;
+  aSecondReader.setGeometry(myGeometryPtr);
+  ASSERT_TRUE(aSecondReader.setBranchAddresses(&aSecondTree));
+  ASSERT_GT(aSecondTree.GetEntry(0), 0);
+  Track3D aSecondTrack;
+  aSecondReader.get(aSecondTrack, aEventInfo);
+
+  ASSERT_EQ(aSecondTrack.getSegments().size(), aTrack.getSegments().size());
+  EXPECT_DOUBLE_EQ(aSecondTrack.getLoss(), aTrack.getLoss());
+  for (unsigned int i = 0; i < aTrack.getSegments().size(); ++i) {
+    for (int dir = definitions::projection_type::DIR_U;
+         dir <= definitions::projection_type::DIR_W; ++dir) {
+      EXPECT_DOUBLE_EQ(aSecondTrack.getSegments()[i].getLoss(dir),
+                       aTrack.getSegments()[i].getLoss(dir))
+          << "segment " << i << " DIR=" << dir;
+    }
+  }
+}
@@ -16,6 +16,8 @@
 #pragma link C++ class eventraw::EventInfo::global_properties+;
 
 #pragma link C++ class Hit2D+;
+#pragma link C++ class std::vector<Hit2D>+;
+#pragma link C++ class std::vector<std::vector<Hit2D> >+;
 #pragma link C++ class TrackSegment2D+;
 #pragma link C++ class TrackSegment3D+;
 #pragma link C++ class Track3D+;
@@ -3,6 +3,7 @@
 
 #include "TPCReco/RequirementsCollection.h"
 #include "TPCReco/Filters.h"
+#include "TPCReco/TypedConfig.h"
 #include <boost/property_tree/ptree.hpp>
 
 template <class T> class EventFilter {
@@ -10,7 +11,9 @@ public:
   template <class Event> bool pass(Event &event) {
     return enabled ? filters(event) : true;
   }
+  // reads the "eventFilter" node, no change if the node is missing
   void setConditions(const boost::property_tree::ptree &conditions);
+  void setConditions(const tpcreco::config::EventFilterConfig &conditions);
   void setEnabled(bool enabled) { this->enabled = enabled; }
   void setDisabled(bool disabled) { enabled = !disabled; }
   bool isEnabled() const { return enabled; }
@@ -24,41 +27,43 @@ private:
 template <class Event>
 void EventFilter<Event>::setConditions(
     const boost::property_tree::ptree &conditions) {
-  auto nodeIt = conditions.find("eventFilter");
-  if (nodeIt == conditions.not_found()) {
+  if (conditions.find("eventFilter") == conditions.not_found()) {
     return;
   }
+  setConditions(tpcreco::config::EventFilterConfig::fromConfig(conditions));
+}
 
+template <class Event>
+void EventFilter<Event>::setConditions(
+    const tpcreco::config::EventFilterConfig &conditions) {
   filters.clear();
-  auto node = nodeIt->second;
 
-  enabled = node.get("enabled", false);
+  enabled = conditions.enabled;
 
-  auto value = node.get_optional<double>("maxChargeUpperBound");
-  if (value) {
-    filters.push_back(tpcreco::filters::MaxChargeUpperBound{*value});
+  if (conditions.maxChargeUpperBound) {
+    filters.push_back(
+        tpcreco::filters::MaxChargeUpperBound{*conditions.maxChargeUpperBound});
   }
 
-  value = node.get_optional<double>("maxChargeLowerBound");
-  if (value) {
-    filters.push_back(tpcreco::filters::MaxChargeLowerBound{*value});
+  if (conditions.maxChargeLowerBound) {
+    filters.push_back(
+        tpcreco::filters::MaxChargeLowerBound{*conditions.maxChargeLowerBound});
   }
 
-  value = node.get_optional<double>("totalChargeLowerBound");
-  if (value) {
-    filters.push_back(tpcreco::filters::TotalChargeLowerBound{*value});
+  if (conditions.totalChargeLowerBound) {
+    filters.push_back(tpcreco::filters::TotalChargeLowerBound{
+        *conditions.totalChargeLowerBound});
   }
 
-  value = node.get_optional<double>("totalChargeUpperBound");
-  if (value) {
-    filters.push_back(tpcreco::filters::TotalChargeUpperBound{*value});
+  if (conditions.totalChargeUpperBound) {
+    filters.push_back(tpcreco::filters::TotalChargeUpperBound{
+        *conditions.totalChargeUpperBound});
   }
 
-  auto events = nodeIt->second.get_child_optional("events");
-  if (events) {
+  if (!conditions.events.empty()) {
     tpcreco::filters::IndexInSet set;
-    for (const auto &index : *events) {
-      set.insert(index.second.get_value<size_t>());
+    for (auto index : conditions.events) {
+      set.insert(index);
     }
     filters.push_back(std::move(set));
   }
@@ -17,6 +17,8 @@
 #include "TPCReco/EventInfo.h"
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/PEventTPC.h"
+#include "TPCReco/TypedConfig.h"
+#include "TPCReco/PoolAllocator.h"
 
 class EventTPC {
   
@@ -31,6 +33,10 @@ class EventTPC {
   void SetEventInfo(const eventraw::EventInfo & aEvInfo);
   void SetGeoPtr(std::shared_ptr<GeometryTPC> aPtr);
 
+  // hit filter parameters, the filtered hits are recalculated only when the parameters change
+  void setHitFilterConfig(filter_type filterType, const tpcreco::config::HitFilterConfig &config);
+
+  // reads the "hitFilter" node of the configuration tree
   void setHitFilterConfig(filter_type filterType, const boost::property_tree::ptree &config);
 
   // valid range [0-2][X-Y][1-1024][0-511] 
@@ -87,8 +93,15 @@ class EventTPC {
 
   void filterHits(filter_type filterType);
 
+  // transient containers with nodes recycled between events
+  typedef PEventTPC::chargeMapType::key_type keyType;
+  typedef std::map<keyType, double, std::less<keyType>,
+		   tpcreco::utilities::PoolAllocator<std::pair<const keyType, double> > > pooledChargeMapType;
+  typedef std::set<keyType, std::less<keyType>,
+		   tpcreco::utilities::PoolAllocator<keyType> > keyListType;
+
   void addEnvelope(PEventTPC::chargeMapType::key_type key,
-		   std::set<PEventTPC::chargeMapType::key_type> & keyList,
+		   keyListType & keyList,
 		   int delta_strips,
 		   int delta_timecells);
 
@@ -117,11 +130,13 @@ class EventTPC {
   std::shared_ptr<GeometryTPC> myGeometryPtr;  
 
   // key=(STRIP_DIR [0-2], SECTION [0-2], STRIP_NUM [1-1024], TIME_CELL [0-511])
-  PEventTPC::chargeMapType chargeMapWithSections;
+  pooledChargeMapType chargeMapWithSections;
 
-  std::map<filter_type, std::set<PEventTPC::chargeMapType::key_type> > keyLists;
+  // hits passing a given filter, also the bins filled in a3DHistoRawMap
+  std::map<filter_type, keyListType> keyLists;
+  keyListType keyListBuffer;
 
-  std::map<filter_type, boost::property_tree::ptree> filterConfigs;
+  std::map<filter_type, tpcreco::config::HitFilterConfig> filterConfigs;
 
   friend std::ostream& operator<<(std::ostream& os, const EventTPC& e);
  
@@ -6,6 +6,7 @@
 
 #include <cstdlib>
 #include <cstddef> 
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <memory>
@@ -71,16 +72,37 @@ class GeometryTPC {
   bool isOK_TH2Poly;               // is TH2Poly already initialized?
   bool _debug;                     // debug/verbose info flag
   TH2PolyBin* tp_convex;           // for internal storage of the convex hull for UVW active area
+  std::vector<double> hull_planes;  //! convex hull of UVW active area as half-planes {a, b, c}: a*x+b*y+c>=0 inside
+  double loc_xmin{0}, loc_xmax{0}, loc_ymin{0}, loc_ymax{0}; //! XY range [mm] of TH2Poly used for point location
+  double loc_dx{0}, loc_dy{0};     //! grid cell size [mm] used for point location
+  int loc_nx{0}, loc_ny{0};        //! grid size used for point location
+  std::vector<int> loc_cellStart;  //! first entry in loc_cellPoly for each grid cell (size: loc_nx*loc_ny+1)
+  std::vector<int> loc_cellPoly;   //! strip polygons overlapping grid cells, in ascending TH2Poly bin order
+  std::vector<int> loc_polyStart;  //! first vertex of each strip polygon (size: number of polygons+1)
+  std::vector<double> loc_polyX;   //! X coordinates [mm] of strip polygon vertices
+  std::vector<double> loc_polyY;   //! Y coordinates [mm] of strip polygon vertices
+  std::vector<double> loc_polyBox; //! bounding box {xmin, xmax, ymin, ymax} [mm] of each strip polygon
+  std::vector<int> loc_polyBin;    //! TH2Poly bin index of each strip polygon
 
   // Setter methods 
   
-  bool Load(const char *fname);                 // loads geometry from TXT config file
+  bool Load(const char *fname);                 // loads geometry from TXT config file (or its compiled version, if available)
   bool LoadAnalog(std::istream &f);                            //subrutine. Loads analog channels from geometry TXT config file
+  bool LoadCompiled(const std::string &fname, uint64_t checksum); // loads strip table, parameters and TH2Poly lookups from compiled geometry file
+  void WriteCompiled(const std::string &fname, uint64_t checksum, std::map<int, double> angle,
+                     const std::string &strips) const;  // stores strip table, parameters and TH2Poly lookups in compiled geometry file
+  bool FinishLoad(const char *fname);           // common part of TXT and compiled geometry loading
+  void SetStripUnitVectors(std::map<int, double> angle); // sets strip unit vectors from U/V/W angles [deg]
+  bool AddStrip(int dir, int section, int strip_num, int cobo, int asad, int aget, int chan_num,
+                double offset_in_pads, double offset_in_strips, double length_in_pads); // adds single U/V/W strip
   bool InitTH2Poly();                           // define bins for the underlying TH2Poly histogram
+  bool RestoreTH2Poly(const std::vector<std::shared_ptr<StripTPC> > &polyStrips, TGraph *hull); // define TH2Poly bins from restored point location polygons
 
   void SetTH2PolyStrip(int ibin, std::shared_ptr<StripTPC> s);  // maps TH2Poly bin to a given StripTPC object
 
   bool InitActiveAreaConvexHull(TGraph *g);     // calculates convex hull from cloud of 2D points [mm]
+  void SetActiveAreaConvexHull(TGraph *hull);   // stores closed convex hull polygon [mm], takes ownership
+  bool InitPointLocation();                     // builds uniform grid over TH2Poly strip polygons for FindTH2PolyBin()
   
  public:
   void Debug();
@@ -93,6 +115,7 @@ class GeometryTPC {
   inline int GetTH2PolyPartitionX() const{ return grid_nx; }
   inline int GetTH2PolyPartitionY() const{ return grid_ny; }
   inline void SetDebug(bool flag) { _debug = flag; }
+  static void SetCompiledGeometryDir(const std::string &dir); // directory for compiled geometry files, empty = no caching (default: $TPCRECO_CACHE_DIR, if set)
 
   void setDriftVelocity(double v);
   void setSamplingRate(double r);
@@ -103,6 +126,8 @@ class GeometryTPC {
 
   inline TH2Poly *GetTH2Poly() const{ return tp; }   // returns pointer to the underlying TH2Poly
   std::shared_ptr<StripTPC> GetTH2PolyStrip(int ibin)const;          // returns pointer to StripTPC object corresponding to TH2Poly bin 
+  int FindTH2PolyBin(double x, double y) const; // same as GetTH2Poly()->FindBin(x, y) [mm], but const and thread-safe
+  std::shared_ptr<StripTPC> FindStrip(double x, double y) const; // returns pointer to StripTPC object containing 2D point [mm]
   
   inline bool IsOK() const{ return initOK; }
   
@@ -218,11 +243,14 @@ class GeometryTPC {
 
   TGraph GetActiveAreaConvexHull(double vetoBand=0) const; // get convex hull [mm] of the entire UVW active area
                                                      // with (optionally) excluded outer VETO band [mm]
-  bool IsInsideActiveVolume(TVector3 point); // checks if 3D point [mm] has X,Y inside
-                                             // UVW active area and Z within [zmin, zmax] range
-  bool IsInsideActiveArea(TVector2 point); // checks if 2D point [mm] is inside UVW active area
-  bool IsInsideElectronicsRange(double z); // checks if Z coordinate [mm] is inside Z-slice covered by the GET electronics
-  bool IsInsideElectronicsRange(TVector3 point); // checks 3D point [mm] is inside Z-slice covered by the GET electronics
+  bool IsInsideActiveVolume(TVector3 point) const; // checks if 3D point [mm] has X,Y inside
+                                                   // UVW active area and Z within [zmin, zmax] range
+  bool IsInsideActiveVolume(double x, double y, double z) const; // checks if 3D point [mm] has X,Y inside
+                                                               // UVW active area and Z within [zmin, zmax] range
+  bool IsInsideActiveArea(TVector2 point) const; // checks if 2D point [mm] is inside UVW active area
+  bool IsInsideActiveArea(double x, double y) const; // checks if 2D point [mm] is inside UVW active area
+  bool IsInsideElectronicsRange(double z) const; // checks if Z coordinate [mm] is inside Z-slice covered by the GET electronics
+  bool IsInsideElectronicsRange(TVector3 point) const; // checks 3D point [mm] is inside Z-slice covered by the GET electronics
 
   std::tuple<double, double> rangeX() const; //min/max X [mm] cartesian coordinates covered by UVW active area
   std::tuple<double, double> rangeY() const; //min/max Y [mm] cartesian coordinates covered by UVW active area
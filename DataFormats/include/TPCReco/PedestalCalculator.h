@@ -5,6 +5,7 @@
 // Author: Artur Kalinowski
 // Mon Jun 17 13:31:58 CEST 2019
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 #include <map>
@@ -19,6 +20,7 @@
 
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/EventRaw.h"
+#include "TPCReco/PedestalTable.h"
 
 class PedestalCalculatorGRAW;
 
@@ -34,12 +36,18 @@ class PedestalCalculator {
 
   //  double GetPedestalCorrection(int iChannelGlobal, int agentId, int iCell);
   double GetPedestalCorrection(int coboId, int asadId, int agetId, int chanId, int iCell);
+  // RMS of the FPN corrected samples in the pedestal time-window, i.e. the channel noise
+  double GetPedestalRMS(int coboId, int asadId, int agetId, int chanId) const;
   void CalculateEventPedestals(const std::shared_ptr<eventraw::EventRaw> eRaw);
 
   int GetMinSignalCell() const {return minSignalCell;}
   int GetMaxSignalCell() const {return maxSignalCell;}
   int GetMinPedestalCell() const {return minPedestalCell;}
   int GetMaxPedestalCell() const {return maxPedestalCell;}
+  // time cells of the signal time-window with FPN correction,
+  // the first and the last 2 time cells are always skipped
+  int GetFirstSignalCell() const {return std::max(2, minSignalCell);}
+  int GetLastSignalCell() const {return std::min(509, maxSignalCell);}
   std::shared_ptr<TProfile> GetPedestalProfilePerAsad(int coboId, int asadId);
   std::shared_ptr<TH1D> GetFpnProfilePerAget(int coboId, int asadId, int agetId);
 
@@ -48,6 +56,23 @@ class PedestalCalculator {
   void SetMinPedestalCell(int minPedestalCell) {this->minPedestalCell=minPedestalCell;}
   void SetMaxPedestalCell(int maxPedestalCell) {this->maxPedestalCell=maxPedestalCell;}
 
+  // Replaces pedestals and FPN shapes by the values of a table made from a pedestal run.
+  // Afterwards GetPedestalCorrection() returns the table values and the per-event
+  // pedestal calculation is not needed. Throws std::runtime_error when the table
+  // does not match the geometry or when the FPN shape of the table is not calibrated
+  // in the whole signal time-window.
+  void LoadPedestalTable(const PedestalTable & aTable);
+  bool HasPedestalTable() const {return hasPedestalTable;}
+  void ClearPedestalTable() {hasPedestalTable=false;}
+
+  // Averages of the event pedestals and FPN shapes over a run, used to make pedestal tables.
+  // AddToRunAverages() is called after the pedestals of a given {COBO, ASAD} frame are calculated.
+  // Frames of different {COBO, ASAD} pairs can be added concurrently.
+  void ResetRunAverages();
+  void AddToRunAverages(int coboId, int asadId);
+  // The FPN shape of the table is calibrated in the signal time-window only.
+  PedestalTable GetRunAverages(long runId) const;
+
  private:
 
   friend class PedestalCalculatorGRAW;
@@ -69,6 +94,7 @@ class PedestalCalculator {
   //  std::vector<double> pedestals;
   // array index: [cobo(>=0)][asad(0-3)[channel(0-255)]
   std::vector< std::vector< std::vector<double> > > pedestals;
+  std::vector< std::vector< std::vector<double> > > pedestalRMS;
 
   // array index: [aget(0-3)][cell(0-511)]
   //  std::vector< std::vector<uint> > FPN_entries_pedestal;
@@ -80,6 +106,14 @@ class PedestalCalculator {
   std::vector< std::vector< std::vector< std::vector<double> > > > FPN_ave_pedestal;
   std::vector< std::vector< std::vector< std::vector<uint32_t> > > > FPN_entries_signal;
   std::vector< std::vector< std::vector< std::vector<double> > > > FPN_ave_signal;
+
+  bool hasPedestalTable{false};
+
+  // sums over frames of a run, array index: [cobo(>=0)][asad(0-3)]...
+  std::vector< std::vector<unsigned long> > run_frames;
+  std::vector< std::vector< std::vector<double> > > run_pedestal_sum;          // ...[channel(0-255)]
+  std::vector< std::vector< std::vector<double> > > run_RMS_sum;               // ...[channel(0-255)]
+  std::vector< std::vector< std::vector< std::vector<double> > > > run_FPN_sum; // ...[aget(0-3)][cell(0-511)]
   
   // GLOBAL - PEDESTAL CONTROL HISTOGRAMS  
   // Up to 1024*(NCobos) channels with pedestal (offset)
@@ -0,0 +1,102 @@
+#ifndef __PEDESTAL_TABLE_H__
+#define __PEDESTAL_TABLE_H__
+
+// Pedestal table of a single pedestal run and a database of such tables.
+// For every {COBO, ASAD} pair the table holds the pedestal of each normal
+// channel relative to the average FPN shape of its AGET chip, and the FPN
+// shape itself (per AGET chip and time cell), both averaged over all frames
+// of the run. The pedestal correction of a sample is pedestal + FPN shape,
+// see PedestalCalculator::LoadPedestalTable. The noise of a channel is the
+// RMS of its FPN corrected samples in the pedestal time window.
+// The FPN shape is calibrated only within a range of time cells, the
+// signal time window of the pedestal run, and is 0 elsewhere.
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class PedestalTable {
+
+ public:
+
+  PedestalTable() = default;
+
+  PedestalTable(long runId, int nAgets, int nChannels, int nCells);
+
+  long GetRunId() const { return runId; }
+  int GetAgetNchips() const { return nAgets; }
+  int GetAgetNchannels() const { return nChannels; }
+  int GetAgetNtimecells() const { return nCells; }
+  unsigned long GetNFrames(int coboId, int asadId) const;
+  bool HasAsad(int coboId, int asadId) const;
+
+  // range of time cells with calibrated FPN shape, the full range for tables of format version 1 and 2
+  int GetMinCell() const { return minCell; }
+  int GetMaxCell() const { return maxCell; }
+  void SetCellRange(int minCell, int maxCell);
+
+  // asadChannel = aget * GetAgetNchannels() + channel, valid range [0-255]
+  void SetPedestal(int coboId, int asadId, int asadChannel, float value);
+  void SetNoise(int coboId, int asadId, int asadChannel, float value);
+  void SetFpn(int coboId, int asadId, int agetId, int cellId, float value);
+  void SetNFrames(int coboId, int asadId, unsigned long nFrames);
+
+  float GetPedestal(int coboId, int asadId, int asadChannel) const;
+  float GetNoise(int coboId, int asadId, int asadChannel) const; // 0 for tables of format version 1
+  float GetFpn(int coboId, int asadId, int agetId, int cellId) const;
+
+  static const unsigned int formatVersion = 3;
+
+  void Write(std::ostream &out) const;
+  static PedestalTable Read(std::istream &in, unsigned int version = formatVersion);
+
+ private:
+
+  struct AsadTable {
+    unsigned long nFrames{0};
+    std::vector<float> pedestals; // [aget*nChannels+channel]
+    std::vector<float> noise;     // [aget*nChannels+channel]
+    std::vector<float> fpn;       // [aget*nCells+cell]
+  };
+
+  AsadTable &asadAt(int coboId, int asadId);
+  const AsadTable &asadAt(int coboId, int asadId) const;
+
+  long runId{0};
+  int nAgets{0}, nChannels{0}, nCells{0};
+  int minCell{0}, maxCell{-1};
+  std::map<std::pair<int, int>, AsadTable> asads; // key=[coboId, asadId]
+};
+
+// Pedestal tables indexed by run id, stored in a single binary file.
+class PedestalDatabase {
+
+ public:
+
+  // replaces a table with the same run id
+  void Add(const PedestalTable &aTable);
+
+  // table of a given run or nullptr
+  std::shared_ptr<const PedestalTable> Find(long runId) const;
+
+  // table of the last pedestal run taken not later than a given run or nullptr
+  std::shared_ptr<const PedestalTable> FindLatest(long runId) const;
+
+  std::size_t size() const { return tables.size(); }
+
+  // file is overwritten
+  void Save(const std::string &fileName) const;
+
+  // tables from the file are added to the database, throws std::runtime_error on I/O or format errors
+  void Load(const std::string &fileName);
+
+ private:
+
+  std::map<long, std::shared_ptr<const PedestalTable> > tables;
+};
+
+#endif
@@ -18,6 +18,10 @@ class Track3D{
 
   void addSegment(const TrackSegment3D & aSegment3D);
 
+  /// Replace all segments. Segment losses are taken as stored in the segments,
+  /// without recalculation from the rec-hits.
+  void setSegments(const TrackSegment3DCollection & aSegments);
+
   const TrackSegment3DCollection & getSegments() const { return mySegments;}
   TrackSegment3DCollection & getSegments() { return mySegments;}
 
@@ -47,10 +51,19 @@ class Track3D{
 
   void removeEmptySegments();
 
+  /// Move rec-hits shared by all segments out of the track.
+  /// Returns empty collection and leaves the track unchanged if segments have different hits.
+  std::vector<Hit2DCollection> detachRecHits();
+
+  /// Restore rec-hits of segments stored without hits, see detachRecHits().
+  void attachRecHits(const std::vector<Hit2DCollection> & aRecHits);
+
   void enableProjectionForLoss(int iProjection);
 
   void setFitMode(definitions::fit_type fitType);
 
+  definitions::fit_type getFitMode() const { return myFitType;}
+
   void setHypothesisFitLoss(double Loss){ hypothesisFitLoss = Loss;};
 
   double getHypothesisFitLoss() const {return hypothesisFitLoss;}
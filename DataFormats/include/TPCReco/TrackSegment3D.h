@@ -38,7 +38,7 @@ class TrackSegment3D{
 
   void setRecHits(const std::vector<TH2D> & aRecHits);
 
-  void setRecHits(const std::vector<Hit2DCollection> & aRecHits) {myRecHits = aRecHits;}
+  void setRecHits(const std::vector<Hit2DCollection> & aRecHits) {myRecHits = aRecHits; mySummaryCharge = mySummaryMaxCharge = -1; isChargeProfileValid = false;}
 
   void setPID(pid_type aPID){ pid = aPID;}
 
@@ -46,6 +46,13 @@ class TrackSegment3D{
 
   void setLossType(definitions::fit_type lossType){ myLossType = lossType; calculateLoss();}
 
+  ///Set loss per projection directly, e.g. when restoring a segment stored without rec-hits.
+  void setProjectionsLoss(const std::vector<double> & aLoss) { myProjectionsLoss = aLoss;}
+
+  ///Set charge summary used by getIntegratedCharge()/getMaxCharge() when no rec-hits are present.
+  ///The charge along the segment is assumed uniform.
+  void setChargeSummary(double aCharge, double aMaxCharge);
+
   ///Unit tangential vector along segment.
   const TVector3 & getTangent() const { return myTangent;}
 
@@ -95,7 +102,15 @@ class TrackSegment3D{
   ///Return the particle identification.
   pid_type getPID() const { return pid;}
 
-  ///Return charge profile along the track.
+  ///Return charge profile along the track: charge/mm normalised to the maximum,
+  ///in bins of equal width covering [-0.2, 1.2]*getLength().
+  ///The profile is cached until the segment position, geometry or rec-hits change.
+  const std::vector<double> & getChargeProfileValues() const;
+
+  ///Position along the segment of a charge profile bin centre. Bins are numbered from 1, as in TH1F.
+  double getChargeProfileBinCenter(int iBin) const;
+
+  ///Return charge profile along the track as a histogram, see getChargeProfileValues().
   TH1F getChargeProfile() const;
 
   double getIntegratedCharge(double lambda) const;
@@ -105,6 +120,8 @@ class TrackSegment3D{
   const std::vector<Hit2DCollection> & getRecHits() const { return myRecHits;}
 
   double getLoss(int iProjection=-1) const;
+
+  const std::vector<double> & getProjectionsLoss() const { return myProjectionsLoss;}
   
   ///Operator needed for fitting.
   double operator() (const double *par);
@@ -120,7 +137,8 @@ class TrackSegment3D{
   ///Calculate and store loss for all projections.
   void calculateLoss();
 
-  void addProjection(TH1F &histo, TGraphErrors &graph) const;
+  ///Project rec-hits of all projections on the segment and fill the charge profile cache.
+  void calculateChargeProfile() const;
 
   std::shared_ptr<GeometryTPC> myGeometryPtr; //! transient data member
   TVector3 myTangent, myBias;
@@ -132,6 +150,11 @@ class TrackSegment3D{
 
   std::vector<Hit2DCollection> myRecHits;
   std::vector<double> myProjectionsLoss;
+  double mySummaryCharge{-1}; //! transient data member
+  double mySummaryMaxCharge{-1}; //! transient data member
+  mutable std::vector<double> myChargeProfileSums; //! transient data member, charge per bin
+  mutable std::vector<double> myChargeProfile; //! transient data member, normalised charge/mm
+  mutable bool isChargeProfileValid{false}; //! transient data member
 };
 
 std::ostream & operator << (std::ostream &out, const TrackSegment3D &aSegment);
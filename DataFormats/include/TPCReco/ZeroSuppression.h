@@ -0,0 +1,61 @@
+#ifndef __ZERO_SUPPRESSION_H__
+#define __ZERO_SUPPRESSION_H__
+
+// Zero suppression of the samples of a single channel, modelled on the
+// zero-suppressed readout of the GET electronics: a time cell is kept when
+// its pedestal subtracted value is above the threshold of the channel,
+// together with guardCells time cells on each side of it. Kept cells form
+// runs of consecutive time cells, touching or overlapping runs are merged.
+
+#include <vector>
+
+namespace tpcreco {
+
+// inclusive range of time cells
+struct CellRange {
+  int first;
+  int last;
+
+  bool operator==(const CellRange &other) const {
+    return first == other.first && last == other.last;
+  }
+};
+
+// sample of a single channel: time cell and value
+struct CellSample {
+  int cell;
+  double value;
+
+  bool operator==(const CellSample &other) const {
+    return cell == other.cell && value == other.value;
+  }
+};
+
+// buffers of zeroSuppressChannel(), reused between channels
+struct ZeroSuppressionBuffers {
+  std::vector<double> values; // pedestal subtracted values of all time cells
+  std::vector<char> present;  // time cells present in the readout
+  std::vector<CellRange> runs;
+};
+
+// Finds the runs of kept time cells. values[cell] are the pedestal subtracted
+// samples, only cells within [minCell, maxCell] are considered.
+// The result replaces the content of runs, which can be reused between channels.
+void findZeroSuppressedRuns(const std::vector<double> &values, int minCell,
+                            int maxCell, double threshold, int guardCells,
+                            std::vector<CellRange> &runs);
+
+// Zero suppression of the raw samples of a single channel, in any cell order.
+// pedestals[cell] are subtracted from the raw values, only cells of the samples
+// are read. The threshold of the channel is max(nSigma * pedestalRMS, threshold).
+// The kept samples, pedestal subtracted, replace the content of kept in
+// ascending cell order. Cells absent in the readout are not added.
+void zeroSuppressChannel(const std::vector<CellSample> &samples,
+                         const std::vector<double> &pedestals,
+                         double pedestalRMS, int minCell, int maxCell,
+                         double nSigma, double threshold, int guardCells,
+                         ZeroSuppressionBuffers &buffers,
+                         std::vector<CellSample> &kept);
+
+} // namespace tpcreco
+#endif
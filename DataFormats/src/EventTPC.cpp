@@ -11,6 +11,7 @@
 
 #include "TPCReco/EventTPC.h"
 #include "TPCReco/TrackSegmentTPC.h"
+#include "TPCReco/PerfMonitor.h"
 
 #include "TPCReco/colorText.h"
 
@@ -20,11 +21,7 @@ EventTPC::EventTPC(){
 
   Clear();
   
-  boost::property_tree::ptree hitConfig_default;
-  hitConfig_default.put("hitFilter.recoClusterThreshold", 35.0);
-  hitConfig_default.put("hitFilter.recoClusterConstantFractionThreshold", 0.1); // 10%
-  hitConfig_default.put("hitFilter.recoClusterDeltaStrips",2);
-  hitConfig_default.put("hitFilter.recoClusterDeltaTimeCells",5);
+  tpcreco::config::HitFilterConfig hitConfig_default; // threshold=35, fraction=10%, deltaStrips=2, deltaTimeCells=5
   filterConfigs[filter_type::threshold] = hitConfig_default;
   filterConfigs[filter_type::fraction] = hitConfig_default;
 }
@@ -35,8 +32,8 @@ EventTPC::~EventTPC(){ }
 ///////////////////////////////////////////////////////////////////////
 void EventTPC::Clear(){
 
+  // keyLists are kept, they mark the bins to be reset in the cached histograms
   chargeMapWithSections.clear();
-  keyLists.clear();
   for(auto & item: histoCacheUpdated) item.second = false;
 }
 ///////////////////////////////////////////////////////////////////////
@@ -65,18 +62,27 @@ void EventTPC::SetGeoPtr(std::shared_ptr<GeometryTPC> aPtr) {
 }
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
-void EventTPC::setHitFilterConfig(filter_type filterType, const boost::property_tree::ptree &config){
+void EventTPC::setHitFilterConfig(filter_type filterType, const tpcreco::config::HitFilterConfig &config){
 
-  filterConfigs[filterType] = config;
-  histoCacheUpdated.at(filterType) = false;
+  auto it = filterConfigs.find(filterType);
+  if(it==filterConfigs.end() || it->second!=config){
+    filterConfigs[filterType] = config;
+    histoCacheUpdated.at(filterType) = false;
+  }
   filterHits(filterType);
 }
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
+void EventTPC::setHitFilterConfig(filter_type filterType, const boost::property_tree::ptree &config){
+
+  setHitFilterConfig(filterType, tpcreco::config::HitFilterConfig::fromConfig(config));
+}
+///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////
 void EventTPC::SetChargeMap(const PEventTPC::chargeMapType & aChargeMap){
 
   Clear();
-  chargeMapWithSections = aChargeMap;
+  chargeMapWithSections.insert(aChargeMap.begin(), aChargeMap.end());
 }
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
@@ -85,14 +91,17 @@ void EventTPC::filterHits(filter_type filterType){
   if(histoCacheUpdated.at(filterType)) return;
   else histoCacheUpdated.at(filterType)=true;
 
-  std::set<PEventTPC::chargeMapType::key_type> keyList;
+  TPCRECO_TIME_SCOPE("EventTPC::filterHits");
+
+  auto & keyList = keyListBuffer;
+  keyList.clear();
 
   switch(filterType){
   case filter_type::threshold: {
     const auto & config = filterConfigs.at(filter_type::threshold);
-    double chargeThreshold = config.get<double>("hitFilter.recoClusterThreshold");
-    int delta_strips = config.get<int>("hitFilter.recoClusterDeltaStrips");
-    int delta_timecells = config.get<int>("hitFilter.recoClusterDeltaTimeCells");
+    double chargeThreshold = config.threshold;
+    int delta_strips = config.deltaStrips;
+    int delta_timecells = config.deltaTimeCells;
     for(const auto & item: chargeMapWithSections){
       auto key = item.first;
       auto value = item.second;
@@ -109,9 +118,9 @@ void EventTPC::filterHits(filter_type filterType){
     break;
   case filter_type::fraction: {
     const auto & config = filterConfigs.at(filter_type::fraction);
-    double chargeFractionThreshold = config.get<double>("hitFilter.recoClusterConstantFractionThreshold");
-    int delta_strips = config.get<int>("hitFilter.recoClusterDeltaStrips");
-    int delta_timecells = config.get<int>("hitFilter.recoClusterDeltaTimeCells");
+    double chargeFractionThreshold = config.fractionThreshold;
+    int delta_strips = config.deltaStrips;
+    int delta_timecells = config.deltaTimeCells;
     // 1st PASS
     std::vector<double> maxChargePerDir(3, 0.0);
     for(const auto & item: chargeMapWithSections){
@@ -134,13 +143,12 @@ void EventTPC::filterHits(filter_type filterType){
   default:;
   }
 
- keyLists[filterType] = keyList;
  updateHistosCache(filterType);
 }
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
 void EventTPC::addEnvelope(PEventTPC::chargeMapType::key_type key,
-			   std::set<PEventTPC::chargeMapType::key_type> & keyList,
+			   keyListType & keyList,
 			   int delta_strips,
 			   int delta_timecells){
 
@@ -200,12 +208,31 @@ void EventTPC::create3DHistoTemplate(){
 ///////////////////////////////////////////////////////////////////////
 void EventTPC::updateHistosCache(filter_type filterType){
 
-  std::shared_ptr<TH3D> aHisto((TH3D*)a3DHistoRawPtr->Clone());
-  aHisto->SetDirectory(0);
+  // new hits are in keyListBuffer
+  auto & keyList = keyLists[filterType];
+  std::shared_ptr<TH3D> aHisto;
+  auto it = a3DHistoRawMap.find(filterType);
+  if(it!=a3DHistoRawMap.end() && it->second.use_count()==1){
+    // not shared with a caller: reset bins of the previous hits in place
+    aHisto = it->second;
+    for(const auto & key: keyList){
+      aHisto->SetBinContent(std::get<3>(key) + 1, std::get<2>(key) + 0, std::get<0>(key) + 1, 0.0);
+    }
+    aHisto->SetEntries(0);
+    aHisto->GetXaxis()->SetRange();
+    aHisto->GetYaxis()->SetRange();
+    aHisto->GetZaxis()->SetRange();
+  }
+  else{
+    aHisto.reset((TH3D*)a3DHistoRawPtr->Clone());
+    aHisto->SetDirectory(0);
+    a3DHistoRawMap[filterType] = aHisto;
+  }
+  keyList.swap(keyListBuffer);
 
   double x = 0.0, y = 0.0, z = 0.0, value=0.0;
 
-  for(const auto & key: keyLists.at(filterType)){
+  for(const auto & key: keyList){
     value = chargeMapWithSections.at(key);
     x = std::get<3>(key) + 1;
     y = std::get<2>(key) + 0;
@@ -213,7 +240,6 @@ void EventTPC::updateHistosCache(filter_type filterType){
     value +=aHisto->GetBinContent(x, y, z);
     aHisto->SetBinContent(x, y, z, value);
   }
-  a3DHistoRawMap[filterType] = aHisto;
 }
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
@@ -342,7 +368,7 @@ long EventTPC::GetMultiplicity(bool countHits,
     }
   }
   else{
-    std::set<int> strips;
+    std::set<int, std::less<int>, tpcreco::utilities::PoolAllocator<int> > strips;
     long int multiplexedPos = 0;
     int strip_dir=0, strip_section=0, strip_number=0, time_cell=0; 
     for(const auto & key: keyLists.at(filterType)){
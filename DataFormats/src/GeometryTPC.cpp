@@ -1,7 +1,10 @@
+#include <cstdint>
 #include <cstdio> // for: NULL
 #include <cstdlib>
 #include <fstream>
 #include <iostream> // for: cout, cerr, endl
+#include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <map>
 #include <set>
@@ -11,6 +14,10 @@
 #include <vector>
 #include <tuple>
 
+#include <sys/stat.h> // for: fchmod
+#include <unistd.h> // for: close
+#include <boost/filesystem.hpp>
+
 #include <TGraph.h>
 #include <TH2Poly.h>
 #include <TMath.h>
@@ -24,6 +31,93 @@
 #include "TPCReco/MultiKey.h"
 #include "TPCReco/UtilsMath.h" 
 
+namespace {
+
+  // compiled geometry file: header, strip table records in the order of the TXT config file,
+  // followed by the lookup block: strip polygons in TH2Poly bin order, point location grid
+  // and the active area convex hull. With the lookup block the TH2Poly bins are added from
+  // the stored polygons, the pad corners, the convex hull and the grid are not recomputed.
+  // A file without a valid lookup block falls back to InitTH2Poly().
+  const uint32_t compiledGeometryMagic = 0x4f454754;
+  const uint32_t compiledGeometryVersion = 2;
+
+  struct CompiledHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t checksum;      // FNV-1a hash of the TXT config file
+    double angle[3];        // U/V/W strip angles [deg]
+    double pad_size;        // [mm]
+    double reference_point[2]; // [mm]
+    double drift_velocity;  // [cm/us]
+    double sampling_rate;   // [MHz]
+    double trigger_delay;   // [us]
+    double drift_zmin;      // [mm]
+    double drift_zmax;      // [mm]
+    uint64_t nStrips;
+  };
+
+  struct CompiledStrip {
+    int32_t dir, section, strip_num, cobo, asad, aget, chan_num, padding;
+    double offset_in_pads, offset_in_strips, length_in_pads;
+  };
+
+  struct CompiledLookup {
+    double loc_range[4];    // point location XY range {xmin, xmax, ymin, ymax} [mm]
+    int32_t loc_nx, loc_ny; // point location grid size
+    uint64_t nPolygons;     // strip polygons
+    uint64_t nVertices;     // strip polygon vertices
+    uint64_t nCellEntries;  // strip polygons overlapping grid cells
+    uint64_t nHullPoints;   // closed convex hull vertices
+  };
+
+  struct CompiledPolygon {
+    int32_t dir, section, strip_num, bin; // strip of TH2Poly bin
+  };
+
+  template <typename T> void WriteArray(std::ostream &out, const std::vector<T> &v) {
+    out.write((const char *)v.data(), v.size() * sizeof(T));
+  }
+
+  template <typename T> bool ReadArray(std::istream &in, std::vector<T> &v, uint64_t n) {
+    v.resize(n);
+    in.read((char *)v.data(), n * sizeof(T));
+    return bool(in);
+  }
+
+  // start offsets must be ascending from 0 to the total size
+  bool IsValidStart(const std::vector<int> &start, uint64_t total) {
+    if (start.empty() || start.front() != 0 || (uint64_t)start.back() != total) return false;
+    return std::is_sorted(start.begin(), start.end());
+  }
+
+  // caching is disabled unless enabled by TPCRECO_CACHE_DIR or SetCompiledGeometryDir()
+  std::string &compiledGeometryDir() {
+    static std::string dir(std::getenv("TPCRECO_CACHE_DIR") ? std::getenv("TPCRECO_CACHE_DIR") : "");
+    return dir;
+  }
+
+  uint64_t GetConfigChecksum(const std::string &text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  std::string GetCompiledFileName(uint64_t checksum) {
+    if (compiledGeometryDir().empty()) return "";
+    std::ostringstream name;
+    name << compiledGeometryDir() << "/geometry_" << std::hex << checksum << ".bin";
+    return name.str();
+  }
+}
+
+// directory for compiled geometry files, empty = always parse the TXT config file
+void GeometryTPC::SetCompiledGeometryDir(const std::string &dir) {
+  compiledGeometryDir() = dir;
+}
+
 GeometryTPC::GeometryTPC(const char *fname, bool debug)
     : initOK(false), COBO_N(0), AGET_Nchips(4), AGET_Nchan(64),
       AGET_Nchan_fpn(-1), AGET_Nchan_raw(-1), AGET_Ntimecells(512),
@@ -89,12 +183,29 @@ bool GeometryTPC::Load(const char *fname) {
   stripN.clear();
   ASAD_N.clear();
   fStripMap.clear();
+  isOK_TH2Poly = false;
 
   std::string line;
-  std::ifstream f(fname);
+  std::ifstream fin(fname, std::ios::binary);
   std::map<int, double> angle;
-
-  if (f.is_open()) {
+  std::string compiledStrips; // strip table records for the compiled geometry cache
+  std::string compiledFile;
+  uint64_t checksum = 0;
+
+  if (fin.is_open()) {
+
+    // read the whole config file once, it is parsed from memory below
+    std::stringstream f;
+    f << fin.rdbuf();
+    fin.close();
+
+    // try compiled geometry first
+    checksum = GetConfigChecksum(f.str());
+    compiledFile = GetCompiledFileName(checksum);
+    if (!compiledFile.empty() && LoadCompiled(compiledFile, checksum)) {
+      std::cout << "Compiled geometry = " << compiledFile << std::endl;
+      return FinishLoad(fname);
+    }
 
     // set U,V,W angles
     f.seekg(0, f.beg);
@@ -266,21 +377,7 @@ bool GeometryTPC::Load(const char *fname) {
       }
     }
 
-    // set unit vectors (along strips) and strip pitch vectors (perpendicular to
-    // strips)
-    strip_unit_vec[definitions::projection_type::DIR_U].Set(TMath::Cos(angle[definitions::projection_type::DIR_U] * TMath::DegToRad()),
-                              TMath::Sin(angle[definitions::projection_type::DIR_U] * TMath::DegToRad()));
-    strip_unit_vec[definitions::projection_type::DIR_V].Set(TMath::Cos(angle[definitions::projection_type::DIR_V] * TMath::DegToRad()),
-                              TMath::Sin(angle[definitions::projection_type::DIR_V] * TMath::DegToRad()));
-    strip_unit_vec[definitions::projection_type::DIR_W].Set(TMath::Cos(angle[definitions::projection_type::DIR_W] * TMath::DegToRad()),
-                              TMath::Sin(angle[definitions::projection_type::DIR_W] * TMath::DegToRad()));
-
-    pitch_unit_vec[definitions::projection_type::DIR_U] =
-        -1.0 * (strip_unit_vec[definitions::projection_type::DIR_W] + strip_unit_vec[definitions::projection_type::DIR_V]).Unit();
-    pitch_unit_vec[definitions::projection_type::DIR_V] =
-        (strip_unit_vec[definitions::projection_type::DIR_U] + strip_unit_vec[definitions::projection_type::DIR_W]).Unit();
-    pitch_unit_vec[definitions::projection_type::DIR_W] =
-        (strip_unit_vec[definitions::projection_type::DIR_V] - strip_unit_vec[definitions::projection_type::DIR_U]).Unit();
+    SetStripUnitVectors(angle);
 
     bool found = false;
     f.seekg(0, f.beg);
@@ -330,86 +427,15 @@ bool GeometryTPC::Load(const char *fname) {
                     << " / AGET=" << aget << " / CHANNUM=" << chan_num << "\n";
         }
         // DEBUG
-        if (mapByAget.find(MultiKey4(cobo, asad, aget, chan_num)) ==
-            mapByAget.end()) {
-
-          // create new strip
-          int chan_num_raw = Aget_normal2raw(chan_num);
-          TVector2 offset =
-              offset_in_strips * strip_pitch * pitch_unit_vec[dir] +
-              offset_in_pads * pad_pitch * strip_unit_vec[dir];
-          double length = length_in_pads * pad_pitch;
-          std::shared_ptr<StripTPC> strip(new StripTPC(
-						       dir, section, strip_num, cobo, asad, aget, chan_num, chan_num_raw,
-						       strip_unit_vec[dir], offset, length_in_pads, this));
-
-          // update map (by: COBO board, ASAD board, AGET chip, AGET normal/raw
-          // channel)
-          mapByAget[MultiKey4(cobo, asad, aget, chan_num)] = strip; 
-          mapByAget_raw[MultiKey4(cobo, asad, aget, chan_num_raw)] = strip; 
-
-          // update reverse map (by: strip direction, strip number)
-          if (dir == definitions::projection_type::DIR_U || dir == definitions::projection_type::DIR_V || dir == definitions::projection_type::DIR_W) {
-            mapByStrip[MultiKey3(dir, section, strip_num)] =
-                strip; // Global_normal2normal(aget, chan_num);
-          }
-
-          // update maximal ASAD index (by: COBO board)
-          if (ASAD_N.find(cobo) == ASAD_N.end()) {
-            ASAD_N[cobo] = asad + 1; // ASAD indexing starts from 0
-            if (cobo >= COBO_N)
-              COBO_N = cobo + 1; // COBO indexing starts from 0
-          } else {
-            if (asad >= ASAD_N[cobo])
-              ASAD_N[cobo] = asad + 1; // ASAD indexing starts from 0
-          }
-
-          // update number of strips in each direction
-          if (stripN.find(dir) == stripN.end())
-            stripN[dir] = 1;
-          else
-            stripN[dir]++;
-
-	  geometryStats.Fill(dir, section, strip_num, strip->Start(), strip->End());
-
-          // DEBUG
-          if (_debug) {
-            std::cout
-                << ">>> ADDED NEW STRIP:"
-                << "KEY=[COBO=" << cobo << ", ASAD=" << asad
-                << ", AGET=" << aget << ", CHAN=" << chan_num
-                << "]  VAL=[DIR=" << dir << ", SECTION=" << section
-                << ", STRIP=" << strip_num << "], "
-                << "NSTRIPS[DIR=" << dir << "]=" << stripN[dir] << ", "
-                << "   map_by_AGET=("
-                << mapByAget[MultiKey4(cobo, asad, aget, chan_num)]->Dir()
-                << ","
-                << mapByAget[MultiKey4(cobo, asad, aget, chan_num)]->Num()
-                << "), "
-                << "   map_by_STRIP=("
-                << mapByStrip[MultiKey3(dir, section, strip_num)]->CoboId()
-                << ","
-                << mapByStrip[MultiKey3(dir, section, strip_num)]->AsadId()
-                << ","
-                << mapByStrip[MultiKey3(dir, section, strip_num)]->AgetId()
-                << ","
-                << mapByStrip[MultiKey3(dir, section, strip_num)]->AgetCh()
-                << ")"
-                << "\n";
-            std::cout << offset_in_pads << " " << offset_in_strips << " "
-                      << length_in_pads << " " << length << std::endl;
-          }
-          // DEBUG
-
-        } else {
-          std::cout << "WARNING: Ignored duplicated keyword: COBO=" << cobo
-                    << ", ASAD=" << asad << ", AGET=" << aget
-                    << ", CHANNEL=" << chan_num << " !!!\n";
+        if (AddStrip(dir, section, strip_num, cobo, asad, aget, chan_num,
+                     offset_in_pads, offset_in_strips, length_in_pads)) {
+          const CompiledStrip record{dir, section, strip_num, cobo, asad, aget, chan_num, 0,
+                                     offset_in_pads, offset_in_strips, length_in_pads};
+          compiledStrips.append((const char *)&record, sizeof(record));
         }
       }
     }
     auto retv = LoadAnalog(f);
-    f.close();
     if (!retv) {
       return retv;
     }
@@ -422,13 +448,121 @@ bool GeometryTPC::Load(const char *fname) {
     return initOK;
   }
 
+  if (FinishLoad(fname) && !compiledFile.empty()) {
+    WriteCompiled(compiledFile, checksum, angle, compiledStrips);
+  }
+  return initOK;
+}
+
+// adds a single U/V/W strip, returns false for duplicated electronics channels
+bool GeometryTPC::AddStrip(int dir, int section, int strip_num, int cobo, int asad, int aget, int chan_num,
+                           double offset_in_pads, double offset_in_strips, double length_in_pads) {
+
+  if (mapByAget.find(MultiKey4(cobo, asad, aget, chan_num)) != mapByAget.end()) {
+    std::cout << "WARNING: Ignored duplicated keyword: COBO=" << cobo
+              << ", ASAD=" << asad << ", AGET=" << aget
+              << ", CHANNEL=" << chan_num << " !!!\n";
+    return false;
+  }
+
+  // create new strip
+  int chan_num_raw = Aget_normal2raw(chan_num);
+  TVector2 offset =
+      offset_in_strips * strip_pitch * pitch_unit_vec[dir] +
+      offset_in_pads * pad_pitch * strip_unit_vec[dir];
+  double length = length_in_pads * pad_pitch;
+  std::shared_ptr<StripTPC> strip(new StripTPC(
+      dir, section, strip_num, cobo, asad, aget, chan_num, chan_num_raw,
+      strip_unit_vec[dir], offset, length_in_pads, this));
+
+  // update map (by: COBO board, ASAD board, AGET chip, AGET normal/raw
+  // channel)
+  mapByAget[MultiKey4(cobo, asad, aget, chan_num)] = strip; 
+  mapByAget_raw[MultiKey4(cobo, asad, aget, chan_num_raw)] = strip; 
+
+  // update reverse map (by: strip direction, strip number)
+  if (dir == definitions::projection_type::DIR_U || dir == definitions::projection_type::DIR_V || dir == definitions::projection_type::DIR_W) {
+    mapByStrip[MultiKey3(dir, section, strip_num)] =
+        strip; // Global_normal2normal(aget, chan_num);
+  }
+
+  // update maximal ASAD index (by: COBO board)
+  if (ASAD_N.find(cobo) == ASAD_N.end()) {
+    ASAD_N[cobo] = asad + 1; // ASAD indexing starts from 0
+    if (cobo >= COBO_N)
+      COBO_N = cobo + 1; // COBO indexing starts from 0
+  } else {
+    if (asad >= ASAD_N[cobo])
+      ASAD_N[cobo] = asad + 1; // ASAD indexing starts from 0
+  }
+
+  // update number of strips in each direction
+  if (stripN.find(dir) == stripN.end())
+    stripN[dir] = 1;
+  else
+    stripN[dir]++;
+
+  geometryStats.Fill(dir, section, strip_num, strip->Start(), strip->End());
+
+  // DEBUG
+  if (_debug) {
+    std::cout
+        << ">>> ADDED NEW STRIP:"
+        << "KEY=[COBO=" << cobo << ", ASAD=" << asad
+        << ", AGET=" << aget << ", CHAN=" << chan_num
+        << "]  VAL=[DIR=" << dir << ", SECTION=" << section
+        << ", STRIP=" << strip_num << "], "
+        << "NSTRIPS[DIR=" << dir << "]=" << stripN[dir] << ", "
+        << "   map_by_AGET=("
+        << mapByAget[MultiKey4(cobo, asad, aget, chan_num)]->Dir()
+        << ","
+        << mapByAget[MultiKey4(cobo, asad, aget, chan_num)]->Num()
+        << "), "
+        << "   map_by_STRIP=("
+        << mapByStrip[MultiKey3(dir, section, strip_num)]->CoboId()
+        << ","
+        << mapByStrip[MultiKey3(dir, section, strip_num)]->AsadId()
+        << ","
+        << mapByStrip[MultiKey3(dir, section, strip_num)]->AgetId()
+        << ","
+        << mapByStrip[MultiKey3(dir, section, strip_num)]->AgetCh()
+        << ")"
+        << "\n";
+    std::cout << offset_in_pads << " " << offset_in_strips << " "
+              << length_in_pads << " " << length << std::endl;
+  }
+  // DEBUG
+  return true;
+}
+
+// sets unit vectors (along strips) and strip pitch vectors (perpendicular to strips)
+void GeometryTPC::SetStripUnitVectors(std::map<int, double> angle) {
+
+  strip_unit_vec[definitions::projection_type::DIR_U].Set(TMath::Cos(angle[definitions::projection_type::DIR_U] * TMath::DegToRad()),
+                            TMath::Sin(angle[definitions::projection_type::DIR_U] * TMath::DegToRad()));
+  strip_unit_vec[definitions::projection_type::DIR_V].Set(TMath::Cos(angle[definitions::projection_type::DIR_V] * TMath::DegToRad()),
+                            TMath::Sin(angle[definitions::projection_type::DIR_V] * TMath::DegToRad()));
+  strip_unit_vec[definitions::projection_type::DIR_W].Set(TMath::Cos(angle[definitions::projection_type::DIR_W] * TMath::DegToRad()),
+                            TMath::Sin(angle[definitions::projection_type::DIR_W] * TMath::DegToRad()));
+
+  pitch_unit_vec[definitions::projection_type::DIR_U] =
+      -1.0 * (strip_unit_vec[definitions::projection_type::DIR_W] + strip_unit_vec[definitions::projection_type::DIR_V]).Unit();
+  pitch_unit_vec[definitions::projection_type::DIR_V] =
+      (strip_unit_vec[definitions::projection_type::DIR_U] + strip_unit_vec[definitions::projection_type::DIR_W]).Unit();
+  pitch_unit_vec[definitions::projection_type::DIR_W] =
+      (strip_unit_vec[definitions::projection_type::DIR_V] - strip_unit_vec[definitions::projection_type::DIR_U]).Unit();
+}
+
+// checks consistency of the loaded strip table, adds FPN channels and initializes TH2Poly
+bool GeometryTPC::FinishLoad(const char *fname) {
+
   // sanity checks
   for (int icobo = 0; icobo < COBO_N; icobo++) {
     if (ASAD_N.find(icobo) == ASAD_N.end()) {
       std::cerr << "ERROR: Number of ASAD boards for COBO " << icobo
                 << " is not defined !!!" << std::endl;
       if (_debug) {
-        std::cout << "GeometryTPC::Load - Abort (8)" << std::flush << std::endl;
+        std::cout << "GeometryTPC::FinishLoad - Abort (1)" << std::flush << std::endl;
       }
       return initOK;
     }
@@ -477,16 +611,16 @@ bool GeometryTPC::Load(const char *fname) {
 
   geometryStats.print();
 
-  // now initialize TH2Poly (while initOK=true) and set initOK flag according to
-  // the result
-  initOK = InitTH2Poly();
+  // now initialize TH2Poly (while initOK=true), unless already restored from
+  // a compiled geometry file, and set initOK flag according to the result
+  initOK = isOK_TH2Poly || InitTH2Poly();
 
   std::cout << "\n==== INITIALIZING TPC GEOMETRY - END ====\n\n";
 
   if (!initOK) {
     std::cerr << "ERROR: Cannot initialize TH2Poly !!!" << std::endl;
     if (_debug) {
-      std::cout << "GeometryTPC::Load - Abort (9)" << std::flush << std::endl;
+      std::cout << "GeometryTPC::FinishLoad - Abort (2)" << std::flush << std::endl;
     }
     return initOK;
   }
@@ -497,6 +631,167 @@ bool GeometryTPC::Load(const char *fname) {
   return initOK;
 }
 
+// restores strip table and geometry parameters from a compiled geometry file
+bool GeometryTPC::LoadCompiled(const std::string &fname, uint64_t checksum) {
+
+  std::ifstream file(fname, std::ios::binary);
+  if (!file) return false;
+  CompiledHeader header;
+  file.read((char *)&header, sizeof(header));
+  if (!file || header.magic != compiledGeometryMagic ||
+      header.version != compiledGeometryVersion ||
+      header.checksum != checksum || header.nStrips > 1000000) {
+    return false;
+  }
+  std::vector<CompiledStrip> strips(header.nStrips);
+  file.read((char *)strips.data(), header.nStrips * sizeof(CompiledStrip));
+  if (!file) return false;
+
+  std::map<int, double> angle;
+  angle[definitions::projection_type::DIR_U] = header.angle[0];
+  angle[definitions::projection_type::DIR_V] = header.angle[1];
+  angle[definitions::projection_type::DIR_W] = header.angle[2];
+  pad_size = header.pad_size;
+  pad_pitch = pad_size * TMath::Sqrt(3.);
+  strip_pitch = pad_size * 1.5;
+  reference_point.Set(header.reference_point[0], header.reference_point[1]);
+  setDriftVelocity(header.drift_velocity);
+  setSamplingRate(header.sampling_rate);
+  setTriggerDelay(header.trigger_delay);
+  drift_zmin = header.drift_zmin;
+  drift_zmax = header.drift_zmax;
+  SetStripUnitVectors(angle);
+
+  for (auto &aStrip : strips) {
+    AddStrip(aStrip.dir, aStrip.section, aStrip.strip_num, aStrip.cobo,
+             aStrip.asad, aStrip.aget, aStrip.chan_num, aStrip.offset_in_pads,
+             aStrip.offset_in_strips, aStrip.length_in_pads);
+  }
+
+  // lookup block, on any inconsistency FinishLoad() rebuilds the lookups from the strips
+  CompiledLookup lookup;
+  file.read((char *)&lookup, sizeof(lookup));
+  if (!file || lookup.nPolygons != header.nStrips || lookup.loc_nx < 1 || lookup.loc_ny < 1 ||
+      (uint64_t)lookup.loc_nx * lookup.loc_ny > 1000000 || lookup.nVertices > 10000000 ||
+      lookup.nCellEntries > 10000000 || lookup.nHullPoints < 4 || lookup.nHullPoints > 1000000) {
+    return true;
+  }
+  std::vector<CompiledPolygon> polygons;
+  std::vector<double> hullX, hullY;
+  const uint64_t nCells = (uint64_t)lookup.loc_nx * lookup.loc_ny;
+  if (!ReadArray(file, polygons, lookup.nPolygons) ||
+      !ReadArray(file, loc_polyStart, lookup.nPolygons + 1) ||
+      !ReadArray(file, loc_polyX, lookup.nVertices) ||
+      !ReadArray(file, loc_polyY, lookup.nVertices) ||
+      !ReadArray(file, loc_polyBox, 4 * lookup.nPolygons) ||
+      !ReadArray(file, loc_cellStart, nCells + 1) ||
+      !ReadArray(file, loc_cellPoly, lookup.nCellEntries) ||
+      !ReadArray(file, hullX, lookup.nHullPoints) ||
+      !ReadArray(file, hullY, lookup.nHullPoints) ||
+      !IsValidStart(loc_polyStart, lookup.nVertices) ||
+      !IsValidStart(loc_cellStart, lookup.nCellEntries)) {
+    return true;
+  }
+  for (auto ipoly : loc_cellPoly) {
+    if (ipoly < 0 || (uint64_t)ipoly >= lookup.nPolygons) return true;
+  }
+  std::vector<std::shared_ptr<StripTPC> > polyStrips;
+  loc_polyBin.clear();
+  for (auto &aPolygon : polygons) {
+    auto it = mapByStrip.find(MultiKey3(aPolygon.dir, aPolygon.section, aPolygon.strip_num));
+    polyStrips.push_back(it == mapByStrip.end() ? std::shared_ptr<StripTPC>() : it->second);
+    loc_polyBin.push_back(aPolygon.bin);
+  }
+  loc_xmin = lookup.loc_range[0];
+  loc_xmax = lookup.loc_range[1];
+  loc_ymin = lookup.loc_range[2];
+  loc_ymax = lookup.loc_range[3];
+  loc_nx = lookup.loc_nx;
+  loc_ny = lookup.loc_ny;
+  loc_dx = (loc_xmax - loc_xmin) / loc_nx;
+  loc_dy = (loc_ymax - loc_ymin) / loc_ny;
+  RestoreTH2Poly(polyStrips, new TGraph(lookup.nHullPoints, hullX.data(), hullY.data()));
+  return true;
+}
+
+void GeometryTPC::WriteCompiled(const std::string &fname, uint64_t checksum,
+                                std::map<int, double> angle,
+                                const std::string &strips) const {
+
+  CompiledHeader header;
+  header.magic = compiledGeometryMagic;
+  header.version = compiledGeometryVersion;
+  header.checksum = checksum;
+  header.angle[0] = angle[definitions::projection_type::DIR_U];
+  header.angle[1] = angle[definitions::projection_type::DIR_V];
+  header.angle[2] = angle[definitions::projection_type::DIR_W];
+  header.pad_size = pad_size;
+  header.reference_point[0] = reference_point.X();
+  header.reference_point[1] = reference_point.Y();
+  header.drift_velocity = runConditions.getDriftVelocity();
+  header.sampling_rate = runConditions.getSamplingRate();
+  header.trigger_delay = runConditions.getTriggerDelay();
+  header.drift_zmin = drift_zmin;
+  header.drift_zmax = drift_zmax;
+  header.nStrips = strips.size() / sizeof(CompiledStrip);
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(boost::filesystem::path(fname).parent_path(), ec);
+
+  // write to a temporary file first, concurrent jobs may read the same file.
+  // The temporary name is unique for every writer, also for threads of the same job.
+  std::string tmpName = fname + ".XXXXXX";
+  int fd = ::mkstemp(&tmpName[0]);
+  if (fd < 0) return;
+  ::fchmod(fd, 0644); // readable as a file written by ofstream
+  ::close(fd);
+  {
+    std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      std::remove(tmpName.c_str());
+      return;
+    }
+    file.write((const char *)&header, sizeof(header));
+    file.write(strips.data(), strips.size());
+    TGraph *hull = (TGraph *)tp_convex->GetPolygon();
+    if (isOK_TH2Poly && hull) {
+      CompiledLookup lookup;
+      lookup.loc_range[0] = loc_xmin;
+      lookup.loc_range[1] = loc_xmax;
+      lookup.loc_range[2] = loc_ymin;
+      lookup.loc_range[3] = loc_ymax;
+      lookup.loc_nx = loc_nx;
+      lookup.loc_ny = loc_ny;
+      lookup.nPolygons = loc_polyBin.size();
+      lookup.nVertices = loc_polyX.size();
+      lookup.nCellEntries = loc_cellPoly.size();
+      lookup.nHullPoints = hull->GetN();
+      std::vector<CompiledPolygon> polygons;
+      for (auto ibin : loc_polyBin) {
+        auto s = GetTH2PolyStrip(ibin);
+        polygons.push_back(CompiledPolygon{s ? s->Dir() : ERROR, s ? s->Section() : ERROR,
+                                           s ? s->Num() : ERROR, ibin});
+      }
+      file.write((const char *)&lookup, sizeof(lookup));
+      WriteArray(file, polygons);
+      WriteArray(file, loc_polyStart);
+      WriteArray(file, loc_polyX);
+      WriteArray(file, loc_polyY);
+      WriteArray(file, loc_polyBox);
+      WriteArray(file, loc_cellStart);
+      WriteArray(file, loc_cellPoly);
+      file.write((const char *)hull->GetX(), hull->GetN() * sizeof(double));
+      file.write((const char *)hull->GetY(), hull->GetN() * sizeof(double));
+    }
+    if (!file) {
+      file.close();
+      std::remove(tmpName.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpName.c_str(), fname.c_str()) != 0) std::remove(tmpName.c_str());
+}
+
 bool GeometryTPC::LoadAnalog(std::istream &f) {
   std::string line;
   bool found = false;
@@ -706,7 +1001,7 @@ bool GeometryTPC::InitTH2Poly() {
   }
 
   // final result
-  if (fStripMap.size()>0 && InitActiveAreaConvexHull(gr))
+  if (fStripMap.size()>0 && InitActiveAreaConvexHull(gr) && InitPointLocation())
     isOK_TH2Poly = true;
 
   if (_debug) {
@@ -737,6 +1032,47 @@ void GeometryTPC::SetTH2PolyStrip(int ibin, std::shared_ptr<StripTPC> s) {
   if (s) fStripMap[ibin] = s;
 }
 
+// defines TH2Poly bins from strip polygons restored by LoadCompiled(), the
+// point location grid is already restored and the convex hull is taken as is
+bool GeometryTPC::RestoreTH2Poly(const std::vector<std::shared_ptr<StripTPC> > &polyStrips, TGraph *hull) {
+
+  isOK_TH2Poly = false;
+  fStripMap.clear();
+  if (tp) {
+    tp->Delete();
+    tp = NULL;
+  }
+  tp = new TH2Poly("h_uvw", "GeometryTPC::TH2Poly;X;Y;Charge", grid_nx, loc_xmin,
+                   loc_xmax, grid_ny, loc_ymin, loc_ymax);
+  tp->SetFloat(true); // same as in InitTH2Poly(), the range already covers all strips
+  for (size_t ipoly = 0; ipoly < polyStrips.size(); ipoly++) {
+    const int first = loc_polyStart[ipoly];
+    TGraph *g = new TGraph(loc_polyStart[ipoly + 1] - first, loc_polyX.data() + first, loc_polyY.data() + first);
+    // same bin indexing workaround as in InitTH2Poly()
+    const int nbins_old = tp->GetNumberOfBins();
+    int ibin = tp->AddBin(g);
+    const int nbins_new = tp->GetNumberOfBins();
+    if (nbins_new > nbins_old) {
+      TH2PolyBin *bin =
+          (TH2PolyBin *)tp->GetBins()->At(tp->GetNumberOfBins() - 1);
+      if (bin)
+        ibin = bin->GetBinNumber();
+    }
+    if (ibin != loc_polyBin[ipoly] || !polyStrips[ipoly]) {
+      if (_debug) {
+        std::cout << "GeometryTPC::RestoreTH2Poly - Abort (1)" << std::flush
+                  << std::endl;
+      }
+      delete hull;
+      return false;
+    }
+    SetTH2PolyStrip(ibin, polyStrips[ipoly]);
+  }
+  SetActiveAreaConvexHull(hull);
+  isOK_TH2Poly = true;
+  return isOK_TH2Poly;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // Computes a convex hull of the entire UVW active area.
@@ -930,6 +1266,24 @@ bool GeometryTPC::InitActiveAreaConvexHull(TGraph *g) {
 	      << "and starting point (X0=" << x0 << "mm, Y0="<< y0 << "mm)" << std::endl;
   } // DEBUG
   */
+  SetActiveAreaConvexHull(gr4);
+
+  if(_debug) { // DEBUG
+    std::cout << __FUNCTION__ << ": Created TH2PolyBin with " << gr4->GetN() << " points, "
+	      << "and starting point (X0=" << x0 << "mm, Y0="<< y0 << "mm)" << std::endl;
+  } // DEBUG
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Stores closed convex hull polygon of the UVW active area (last point equal
+// to the first one, counter-clockwise order), takes ownership of the TGraph.
+//
+////////////////////////////////////////////////////////////////////////////////
+void GeometryTPC::SetActiveAreaConvexHull(TGraph *gr4) {
+
   // store convex hull as TH2PolyBin (easily convertible to TGraph)
   if(tp_convex) {
     tp_convex->Delete();
@@ -937,12 +1291,104 @@ bool GeometryTPC::InitActiveAreaConvexHull(TGraph *g) {
   }
   tp_convex = new TH2PolyBin(gr4, 1);
 
+  // store convex hull also as a set of half-planes for fast const queries,
+  // for counter-clockwise ordered vertices the interior is on the left side of each edge
+  hull_planes.clear();
+  for(auto ipoint=0; ipoint<gr4->GetN()-1; ++ipoint) {
+    const double ex=gr4->GetX()[ipoint+1]-gr4->GetX()[ipoint];
+    const double ey=gr4->GetY()[ipoint+1]-gr4->GetY()[ipoint];
+    if(ex==0.0 && ey==0.0) continue; // skip duplicated points
+    hull_planes.push_back(-ey);
+    hull_planes.push_back(ex);
+    hull_planes.push_back(ey*gr4->GetX()[ipoint]-ex*gr4->GetY()[ipoint]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Builds uniform XY grid over strip polygons of the TH2Poly.
+//
+// Each grid cell holds the list of strip polygons that overlap with it.
+// Strips are narrower than one strip pitch, therefore with cells larger than
+// that no cell can lie entirely inside a strip polygon and it is sufficient
+// to register polygon edges in the cells they cross.
+//
+////////////////////////////////////////////////////////////////////////////////
+bool GeometryTPC::InitPointLocation() {
+
+  loc_nx=0;
+  loc_ny=0;
+  loc_cellStart.clear();
+  loc_cellPoly.clear();
+  loc_polyStart.assign(1, 0);
+  loc_polyX.clear();
+  loc_polyY.clear();
+  loc_polyBox.clear();
+  loc_polyBin.clear();
+  if(!tp || !tp->GetBins()) return false;
+
+  // same range as used by TH2Poly::FindBin
+  loc_xmin=tp->GetXaxis()->GetXmin();
+  loc_xmax=tp->GetXaxis()->GetXmax();
+  loc_ymin=tp->GetYaxis()->GetXmin();
+  loc_ymax=tp->GetYaxis()->GetXmax();
+  const int maxCells=1000; // per axis
+  const double cellSize=std::max(2.0*strip_pitch, std::max(loc_xmax-loc_xmin, loc_ymax-loc_ymin)/maxCells);
+  if(!(cellSize>0.0)) return false;
+  loc_nx=std::max(1, (int)std::ceil((loc_xmax-loc_xmin)/cellSize));
+  loc_ny=std::max(1, (int)std::ceil((loc_ymax-loc_ymin)/cellSize));
+  loc_dx=(loc_xmax-loc_xmin)/loc_nx;
+  loc_dy=(loc_ymax-loc_ymin)/loc_ny;
+
+  // bins are stored in ascending order of bin numbers, which is also
+  // the order of TH2Poly::FindBin search within a partition cell
+  std::vector<std::vector<int> > cells(loc_nx*loc_ny);
+  TIter next(tp->GetBins());
+  while(TH2PolyBin *bin = (TH2PolyBin*)next()) {
+    TGraph *g = dynamic_cast<TGraph*>(bin->GetPolygon());
+    if(!g || g->GetN()<1) continue;
+    const int ipoly=loc_polyBin.size();
+    const int n=g->GetN();
+    const double *gx=g->GetX();
+    const double *gy=g->GetY();
+    loc_polyBin.push_back(bin->GetBinNumber());
+    loc_polyX.insert(loc_polyX.end(), gx, gx+n);
+    loc_polyY.insert(loc_polyY.end(), gy, gy+n);
+    loc_polyStart.push_back(loc_polyX.size());
+    loc_polyBox.push_back(*std::min_element(gx, gx+n));
+    loc_polyBox.push_back(*std::max_element(gx, gx+n));
+    loc_polyBox.push_back(*std::min_element(gy, gy+n));
+    loc_polyBox.push_back(*std::max_element(gy, gy+n));
+
+    // register closed polygon edges in all cells overlapping their bounding boxes
+    auto cellX=[this](double x) { return std::min(loc_nx-1, std::max(0, (int)std::floor((x-loc_xmin)/loc_dx))); };
+    auto cellY=[this](double y) { return std::min(loc_ny-1, std::max(0, (int)std::floor((y-loc_ymin)/loc_dy))); };
+    for(int i=0, j=n-1; i<n; j=i++) {
+      const int ix1=cellX(std::min(gx[i], gx[j])), ix2=cellX(std::max(gx[i], gx[j]));
+      const int iy1=cellY(std::min(gy[i], gy[j])), iy2=cellY(std::max(gy[i], gy[j]));
+      for(int ix=ix1; ix<=ix2; ++ix) {
+	for(int iy=iy1; iy<=iy2; ++iy) {
+	  auto &cell=cells[ix+iy*loc_nx];
+	  if(cell.empty() || cell.back()!=ipoly) cell.push_back(ipoly);
+	}
+      }
+    }
+  }
+
+  // flatten
+  loc_cellStart.reserve(cells.size()+1);
+  loc_cellStart.push_back(0);
+  for(auto &cell: cells) {
+    loc_cellPoly.insert(loc_cellPoly.end(), cell.begin(), cell.end());
+    loc_cellStart.push_back(loc_cellPoly.size());
+  }
+
   if(_debug) { // DEBUG
-    std::cout << __FUNCTION__ << ": Created TH2PolyBin with " << gr4->GetN() << " points, "
-	      << "and starting point (X0=" << x0 << "mm, Y0="<< y0 << "mm)" << std::endl;
+    std::cout << __FUNCTION__ << ": Created " << loc_nx << "x" << loc_ny << " grid for "
+	      << loc_polyBin.size() << " strip polygons, " << loc_cellPoly.size() << " entries" << std::endl;
   } // DEBUG
 
-  return true;
+  return loc_polyBin.size()>0;
 }
 
 ////////////////////////////////////////////////////////////
@@ -1111,19 +1557,37 @@ TGraph GeometryTPC::GetActiveAreaConvexHull(double vetoBand) const{
 // Checks if 3D point [mm] has X,Y inside
 // UVW active area and Z within [zmin, zmax] drift cage range
 //
-bool GeometryTPC::IsInsideActiveVolume(TVector3 point) { // [mm]
-  if(!isOK_TH2Poly || point.Z()<drift_zmin || point.Z()>drift_zmax ||
-     !tp_convex->IsInside(point.X(), point.Y())) return false;
-  return true;
+bool GeometryTPC::IsInsideActiveVolume(TVector3 point) const { // [mm]
+  return IsInsideActiveVolume(point.X(), point.Y(), point.Z());
+}
+
+////////////////////////////////////////////////////////////
+//
+// Checks if 3D point [mm] has X,Y inside
+// UVW active area and Z within [zmin, zmax] drift cage range
+//
+bool GeometryTPC::IsInsideActiveVolume(double x, double y, double z) const { // [mm]
+  if(z<drift_zmin || z>drift_zmax) return false;
+  return IsInsideActiveArea(x, y);
+}
+
+////////////////////////////////////////////////////////////
+//
+// Checks if 2D point [mm] is inside UVW active area
+//
+bool GeometryTPC::IsInsideActiveArea(TVector2 point) const { // [mm]
+  return IsInsideActiveArea(point.X(), point.Y());
 }
 
 ////////////////////////////////////////////////////////////
 //
 // Checks if 2D point [mm] is inside UVW active area
 //
-bool GeometryTPC::IsInsideActiveArea(TVector2 point) { // [m]]
-  if(!isOK_TH2Poly ||
-     !tp_convex->IsInside(point.X(), point.Y())) return false;
+bool GeometryTPC::IsInsideActiveArea(double x, double y) const { // [mm]
+  if(!isOK_TH2Poly) return false;
+  for(size_t i=0; i<hull_planes.size(); i+=3) {
+    if(hull_planes[i]*x+hull_planes[i+1]*y+hull_planes[i+2]<0.0) return false;
+  }
   return true;
 }
 
@@ -1131,7 +1595,7 @@ bool GeometryTPC::IsInsideActiveArea(TVector2 point) { // [m]]
 //
 // Checks if Z coordinate [mm] is inside Z-slice covered by the GET electronics
 //
-bool GeometryTPC::IsInsideElectronicsRange(double z) { // [mm]
+bool GeometryTPC::IsInsideElectronicsRange(double z) const { // [mm]
   bool isOutside_flag=false;
   Pos2timecell(z, isOutside_flag);
   return !isOutside_flag;
@@ -1141,7 +1605,7 @@ bool GeometryTPC::IsInsideElectronicsRange(double z) { // [mm]
 //
 // Checks if 3D point [mm] is inside Z-slice covered by the GET electronics
 //
-bool GeometryTPC::IsInsideElectronicsRange(TVector3 point) { // [mm]
+bool GeometryTPC::IsInsideElectronicsRange(TVector3 point) const { // [mm]
   return IsInsideElectronicsRange(point.Z());
 }
 
@@ -1161,6 +1625,43 @@ std::shared_ptr<StripTPC> GeometryTPC::GetTH2PolyStrip(int ibin) const{
   return (fStripMap.find(ibin) == fStripMap.end() ? std::shared_ptr<StripTPC>() : fStripMap.at(ibin));
 }
 
+////////////////////////////////////////////////////////////
+//
+// Returns TH2Poly bin containing 2D point [mm] with the same conventions
+// as TH2Poly::FindBin: negative values for overflow bins, -5 for points
+// inside TH2Poly range, but outside of all strips.
+// Unlike TH2Poly::FindBin it does not modify the histogram.
+//
+int GeometryTPC::FindTH2PolyBin(double x, double y) const {
+  int overflow=0;
+  if(y>loc_ymax) overflow+=-1;
+  else if(y>loc_ymin) overflow+=-4;
+  else overflow+=-7;
+  if(x>loc_xmax) overflow+=-2;
+  else if(x>loc_xmin) overflow+=-1;
+  if(overflow!=-5 || loc_nx<1) return overflow;
+
+  const int ix=std::min(loc_nx-1, (int)((x-loc_xmin)/loc_dx));
+  const int iy=std::min(loc_ny-1, (int)((y-loc_ymin)/loc_dy));
+  const int icell=ix+iy*loc_nx;
+  for(int i=loc_cellStart[icell]; i<loc_cellStart[icell+1]; ++i) {
+    const int ipoly=loc_cellPoly[i];
+    const double *box=&loc_polyBox[4*ipoly];
+    if(x<box[0] || x>box[1] || y<box[2] || y>box[3]) continue;
+    const int first=loc_polyStart[ipoly];
+    const int n=loc_polyStart[ipoly+1]-first;
+    // same test as TH2PolyBin::IsInside(), TMath::IsInside does not modify its input arrays
+    if(TMath::IsInside(x, y, n, const_cast<double*>(&loc_polyX[first]), const_cast<double*>(&loc_polyY[first]))) {
+      return loc_polyBin[ipoly];
+    }
+  }
+  return -5;
+}
+
+std::shared_ptr<StripTPC> GeometryTPC::FindStrip(double x, double y) const {
+  return GetTH2PolyStrip(FindTH2PolyBin(x, y));
+}
+
 int GeometryTPC::GetDirNstrips(int dir) const{
   if (!IsOK())
     return -1;
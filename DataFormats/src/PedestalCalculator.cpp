@@ -3,6 +3,7 @@
 // Mon Jun 17 13:31:58 CEST 2019
 
 #include <iostream>
+#include <stdexcept>
 
 #include "TPCReco/PedestalCalculator.h"
 
@@ -115,8 +116,11 @@ void PedestalCalculator::InitializeTables(){
       v3_average(myGeometryPtr->GetAsadNboards(coboId),
 		   std::vector<double>(myGeometryPtr->GetAgetNchips()*myGeometryPtr->GetAgetNchannels(), 0.0));
     pedestals.push_back(v3_average);
+    pedestalRMS.push_back(v3_average);
   }
 
+  ResetRunAverages();
+
   /////// DEBUG
   //  std::cout << __FUNCTION__ << " - END"
   //	    << std::endl << std::flush;
@@ -235,6 +239,12 @@ double PedestalCalculator::GetPedestalCorrection(int coboId, int asadId, int age
 }
 ///////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////
+double PedestalCalculator::GetPedestalRMS(int coboId, int asadId, int agetId, int chanId) const{
+
+  return pedestalRMS[coboId][asadId].at(myGeometryPtr->Asad_normal2normal(agetId, chanId));
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
 /*
 void PedestalCalculator::CalculateEventPedestals(const GET::GDataFrame & dataFrame){
 
@@ -293,8 +303,10 @@ void PedestalCalculator::CalculateEventPedestals(const std::shared_ptr<eventraw:
       auto it=prof_pedestal_map.find(mkey);
       if(it==prof_pedestal_map.end()) continue;
       pedestals[coboId][asadId].clear();
+      pedestalRMS[coboId][asadId].clear();
       for(Int_t ibin=1; ibin<=(it->second)->GetNbinsX(); ibin++) {
 	pedestals[coboId][asadId].push_back( (it->second)->GetBinContent(ibin) ); //mean
+	pedestalRMS[coboId][asadId].push_back( (it->second)->GetBinError(ibin) ); //rms
       }
     }
   }
@@ -424,4 +436,104 @@ std::shared_ptr<TH1D> PedestalCalculator::GetFpnProfilePerAget(int coboId, int a
   }
   return result;
 }
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalCalculator::LoadPedestalTable(const PedestalTable & aTable){
+
+  if(aTable.GetAgetNchips()!=myGeometryPtr->GetAgetNchips() ||
+     aTable.GetAgetNchannels()!=myGeometryPtr->GetAgetNchannels() ||
+     aTable.GetAgetNtimecells()!=myGeometryPtr->GetAgetNtimecells()) {
+    throw std::runtime_error("PedestalCalculator: pedestal table of run "+std::to_string(aTable.GetRunId())+
+			     " does not match the geometry");
+  }
+  if(GetFirstSignalCell()<aTable.GetMinCell() || GetLastSignalCell()>aTable.GetMaxCell()) {
+    throw std::runtime_error("PedestalCalculator: FPN shape of the pedestal table of run "+std::to_string(aTable.GetRunId())+
+			     " is calibrated in time cells "+std::to_string(aTable.GetMinCell())+"-"+std::to_string(aTable.GetMaxCell())+
+			     ", signal time-window is "+std::to_string(GetFirstSignalCell())+"-"+std::to_string(GetLastSignalCell()));
+  }
+  for(int coboId = 0; coboId < myGeometryPtr->GetCoboNboards(); coboId++) {
+    for(int asadId = 0; asadId < myGeometryPtr->GetAsadNboards(coboId); asadId++) {
+      if(!aTable.HasAsad(coboId, asadId)) {
+	throw std::runtime_error("PedestalCalculator: pedestal table of run "+std::to_string(aTable.GetRunId())+
+				 " has no entry for COBO="+std::to_string(coboId)+", ASAD="+std::to_string(asadId));
+      }
+      pedestals[coboId][asadId].assign(nchan, 0.0);
+      pedestalRMS[coboId][asadId].assign(nchan, 0.0);
+      for(int ichan=0; ichan<nchan; ++ichan) {
+	pedestals[coboId][asadId][ichan] = aTable.GetPedestal(coboId, asadId, ichan);
+	pedestalRMS[coboId][asadId][ichan] = aTable.GetNoise(coboId, asadId, ichan);
+      }
+      for (int agetId = 0; agetId < myGeometryPtr->GetAgetNchips(); ++agetId) {
+	for(int cellId=0; cellId<myGeometryPtr->GetAgetNtimecells(); ++cellId) {
+	  FPN_ave_signal[coboId][asadId][agetId][cellId] = aTable.GetFpn(coboId, asadId, agetId, cellId);
+	}
+      }
+    }
+  }
+  hasPedestalTable = true;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalCalculator::ResetRunAverages(){
+
+  run_frames.clear();
+  run_pedestal_sum.clear();
+  run_RMS_sum.clear();
+  run_FPN_sum.clear();
+  for(int coboId = 0; coboId < myGeometryPtr->GetCoboNboards(); coboId++) {
+    auto nAsads = myGeometryPtr->GetAsadNboards(coboId);
+    run_frames.push_back(std::vector<unsigned long>(nAsads, 0));
+    run_pedestal_sum.push_back(std::vector< std::vector<double> >(nAsads, std::vector<double>(nchan, 0.0)));
+    run_RMS_sum.push_back(run_pedestal_sum.back());
+    run_FPN_sum.push_back(std::vector< std::vector< std::vector<double> > >
+			  (nAsads, std::vector< std::vector<double> >
+			   (myGeometryPtr->GetAgetNchips(), std::vector<double>(myGeometryPtr->GetAgetNtimecells(), 0.0))));
+  }
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalCalculator::AddToRunAverages(int coboId, int asadId){
 
+  run_frames.at(coboId).at(asadId)++;
+  const auto & framePedestals = pedestals[coboId][asadId];
+  auto & pedestalSum = run_pedestal_sum[coboId][asadId];
+  for(size_t ichan=0; ichan<framePedestals.size() && ichan<pedestalSum.size(); ++ichan) {
+    pedestalSum[ichan] += framePedestals[ichan];
+  }
+  const auto & frameRMS = pedestalRMS[coboId][asadId];
+  auto & RMSSum = run_RMS_sum[coboId][asadId];
+  for(size_t ichan=0; ichan<frameRMS.size() && ichan<RMSSum.size(); ++ichan) {
+    RMSSum[ichan] += frameRMS[ichan];
+  }
+  // FPN shape is known within the signal time-window only
+  for (int agetId = 0; agetId < myGeometryPtr->GetAgetNchips(); ++agetId) {
+    for(int cellId=minSignalCell; cellId<=maxSignalCell; ++cellId) {
+      run_FPN_sum[coboId][asadId][agetId][cellId] += FPN_ave_signal[coboId][asadId][agetId][cellId];
+    }
+  }
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+PedestalTable PedestalCalculator::GetRunAverages(long runId) const{
+
+  PedestalTable aTable(runId, myGeometryPtr->GetAgetNchips(), myGeometryPtr->GetAgetNchannels(),
+		       myGeometryPtr->GetAgetNtimecells());
+  aTable.SetCellRange(GetFirstSignalCell(), GetLastSignalCell());
+  for(size_t coboId = 0; coboId < run_frames.size(); coboId++) {
+    for(size_t asadId = 0; asadId < run_frames[coboId].size(); asadId++) {
+      auto nFrames = run_frames[coboId][asadId];
+      if(!nFrames) continue;
+      aTable.SetNFrames(coboId, asadId, nFrames);
+      for(int ichan=0; ichan<nchan; ++ichan) {
+	aTable.SetPedestal(coboId, asadId, ichan, run_pedestal_sum[coboId][asadId][ichan]/nFrames);
+	aTable.SetNoise(coboId, asadId, ichan, run_RMS_sum[coboId][asadId][ichan]/nFrames);
+      }
+      for (int agetId = 0; agetId < myGeometryPtr->GetAgetNchips(); ++agetId) {
+	for(int cellId=0; cellId<myGeometryPtr->GetAgetNtimecells(); ++cellId) {
+	  aTable.SetFpn(coboId, asadId, agetId, cellId, run_FPN_sum[coboId][asadId][agetId][cellId]/nFrames);
+	}
+      }
+    }
+  }
+  return aTable;
+}
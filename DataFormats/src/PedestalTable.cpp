@@ -0,0 +1,241 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "TPCReco/PedestalTable.h"
+
+namespace {
+// file layout: magic, version, number of tables, tables in the order of run id
+// all numbers are stored in the native byte order
+const char magic[8] = {'T', 'P', 'C', 'P', 'E', 'D', 'D', 'B'};
+
+template <class T> void writeValue(std::ostream &out, T value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T> T readValue(std::istream &in) {
+  T value;
+  if (!in.read(reinterpret_cast<char *>(&value), sizeof(T))) {
+    throw std::runtime_error("PedestalTable: unexpected end of data");
+  }
+  return value;
+}
+
+void writeArray(std::ostream &out, const std::vector<float> &values) {
+  out.write(reinterpret_cast<const char *>(values.data()),
+            values.size() * sizeof(float));
+}
+
+void readArray(std::istream &in, std::vector<float> &values) {
+  if (!in.read(reinterpret_cast<char *>(values.data()),
+               values.size() * sizeof(float))) {
+    throw std::runtime_error("PedestalTable: unexpected end of data");
+  }
+}
+} // namespace
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+PedestalTable::PedestalTable(long runId, int nAgets, int nChannels, int nCells)
+    : runId(runId), nAgets(nAgets), nChannels(nChannels), nCells(nCells),
+      minCell(0), maxCell(nCells - 1) {
+  if (nAgets <= 0 || nChannels <= 0 || nCells <= 0) {
+    throw std::invalid_argument("PedestalTable: wrong dimensions");
+  }
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+PedestalTable::AsadTable &PedestalTable::asadAt(int coboId, int asadId) {
+  auto &aAsad = asads[std::make_pair(coboId, asadId)];
+  if (aAsad.pedestals.empty()) {
+    aAsad.pedestals.assign(nAgets * nChannels, 0.0);
+    aAsad.noise.assign(nAgets * nChannels, 0.0);
+    aAsad.fpn.assign(nAgets * nCells, 0.0);
+  }
+  return aAsad;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+const PedestalTable::AsadTable &PedestalTable::asadAt(int coboId,
+                                                      int asadId) const {
+  auto it = asads.find(std::make_pair(coboId, asadId));
+  if (it == asads.end()) {
+    throw std::out_of_range("PedestalTable: no entry for COBO=" +
+                            std::to_string(coboId) +
+                            ", ASAD=" + std::to_string(asadId));
+  }
+  return it->second;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+bool PedestalTable::HasAsad(int coboId, int asadId) const {
+  return asads.find(std::make_pair(coboId, asadId)) != asads.end();
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalTable::SetCellRange(int minCell, int maxCell) {
+  if (minCell < 0 || maxCell >= nCells || minCell > maxCell) {
+    throw std::out_of_range("PedestalTable: wrong time cell range");
+  }
+  this->minCell = minCell;
+  this->maxCell = maxCell;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+unsigned long PedestalTable::GetNFrames(int coboId, int asadId) const {
+  return HasAsad(coboId, asadId) ? asadAt(coboId, asadId).nFrames : 0;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalTable::SetPedestal(int coboId, int asadId, int asadChannel,
+                                float value) {
+  asadAt(coboId, asadId).pedestals.at(asadChannel) = value;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalTable::SetNoise(int coboId, int asadId, int asadChannel,
+                             float value) {
+  asadAt(coboId, asadId).noise.at(asadChannel) = value;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalTable::SetFpn(int coboId, int asadId, int agetId, int cellId,
+                           float value) {
+  if (cellId < 0 || cellId >= nCells) {
+    throw std::out_of_range("PedestalTable: wrong time cell");
+  }
+  asadAt(coboId, asadId).fpn.at(agetId * nCells + cellId) = value;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalTable::SetNFrames(int coboId, int asadId, unsigned long nFrames) {
+  asadAt(coboId, asadId).nFrames = nFrames;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+float PedestalTable::GetPedestal(int coboId, int asadId,
+                                 int asadChannel) const {
+  return asadAt(coboId, asadId).pedestals.at(asadChannel);
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+float PedestalTable::GetNoise(int coboId, int asadId, int asadChannel) const {
+  return asadAt(coboId, asadId).noise.at(asadChannel);
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+float PedestalTable::GetFpn(int coboId, int asadId, int agetId,
+                            int cellId) const {
+  if (cellId < 0 || cellId >= nCells) {
+    throw std::out_of_range("PedestalTable: wrong time cell");
+  }
+  return asadAt(coboId, asadId).fpn.at(agetId * nCells + cellId);
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalTable::Write(std::ostream &out) const {
+  writeValue<std::int64_t>(out, runId);
+  writeValue<std::int32_t>(out, nAgets);
+  writeValue<std::int32_t>(out, nChannels);
+  writeValue<std::int32_t>(out, nCells);
+  writeValue<std::int32_t>(out, minCell);
+  writeValue<std::int32_t>(out, maxCell);
+  writeValue<std::uint32_t>(out, asads.size());
+  for (const auto &it : asads) {
+    writeValue<std::int32_t>(out, it.first.first);
+    writeValue<std::int32_t>(out, it.first.second);
+    writeValue<std::uint64_t>(out, it.second.nFrames);
+    writeArray(out, it.second.pedestals);
+    writeArray(out, it.second.noise);
+    writeArray(out, it.second.fpn);
+  }
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+PedestalTable PedestalTable::Read(std::istream &in, unsigned int version) {
+  auto aRunId = readValue<std::int64_t>(in);
+  auto aNAgets = readValue<std::int32_t>(in);
+  auto aNChannels = readValue<std::int32_t>(in);
+  auto aNCells = readValue<std::int32_t>(in);
+  PedestalTable aTable(aRunId, aNAgets, aNChannels, aNCells);
+  if (version >= 3) {
+    auto aMinCell = readValue<std::int32_t>(in);
+    auto aMaxCell = readValue<std::int32_t>(in);
+    if (aMinCell < 0 || aMaxCell >= aNCells || aMinCell > aMaxCell) {
+      throw std::runtime_error("PedestalTable: wrong time cell range");
+    }
+    aTable.SetCellRange(aMinCell, aMaxCell);
+  }
+  auto nAsads = readValue<std::uint32_t>(in);
+  for (std::uint32_t iAsad = 0; iAsad < nAsads; ++iAsad) {
+    auto coboId = readValue<std::int32_t>(in);
+    auto asadId = readValue<std::int32_t>(in);
+    auto &aAsad = aTable.asadAt(coboId, asadId);
+    aAsad.nFrames = readValue<std::uint64_t>(in);
+    readArray(in, aAsad.pedestals);
+    if (version >= 2) {
+      readArray(in, aAsad.noise);
+    }
+    readArray(in, aAsad.fpn);
+  }
+  return aTable;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalDatabase::Add(const PedestalTable &aTable) {
+  tables[aTable.GetRunId()] = std::make_shared<const PedestalTable>(aTable);
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+std::shared_ptr<const PedestalTable> PedestalDatabase::Find(long runId) const {
+  auto it = tables.find(runId);
+  return it == tables.end() ? nullptr : it->second;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+std::shared_ptr<const PedestalTable>
+PedestalDatabase::FindLatest(long runId) const {
+  auto it = tables.upper_bound(runId);
+  return it == tables.begin() ? nullptr : std::prev(it)->second;
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalDatabase::Save(const std::string &fileName) const {
+  std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("PedestalDatabase: cannot open " + fileName);
+  }
+  out.write(magic, sizeof(magic));
+  writeValue<std::uint32_t>(out, PedestalTable::formatVersion);
+  writeValue<std::uint32_t>(out, tables.size());
+  for (const auto &it : tables) {
+    it.second->Write(out);
+  }
+  if (!out) {
+    throw std::runtime_error("PedestalDatabase: cannot write " + fileName);
+  }
+}
+///////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+void PedestalDatabase::Load(const std::string &fileName) {
+  std::ifstream in(fileName, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("PedestalDatabase: cannot open " + fileName);
+  }
+  char aMagic[sizeof(magic)];
+  if (!in.read(aMagic, sizeof(aMagic)) ||
+      std::memcmp(aMagic, magic, sizeof(magic)) != 0) {
+    throw std::runtime_error("PedestalDatabase: " + fileName +
+                             " is not a pedestal database");
+  }
+  auto version = readValue<std::uint32_t>(in);
+  if (version < 1 || version > PedestalTable::formatVersion) {
+    throw std::runtime_error("PedestalDatabase: unsupported version of " +
+                             fileName);
+  }
+  auto nTables = readValue<std::uint32_t>(in);
+  for (std::uint32_t iTable = 0; iTable < nTables; ++iTable) {
+    Add(PedestalTable::Read(in, version));
+  }
+}
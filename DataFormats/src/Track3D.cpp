@@ -29,6 +29,18 @@ void Track3D::addSegment(const TrackSegment3D & aSegment3D){
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void Track3D::setSegments(const TrackSegment3DCollection & aSegments){
+
+  mySegments = aSegments;
+  myLenght = 0.0;
+  segmentLoss.clear();
+  for(const auto &aSegment: mySegments){
+    myLenght += aSegment.getLength();
+    segmentLoss.push_back(aSegment.getLoss(iProjectionForLoss));
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 void Track3D::update(){
 
   myLenght = 0.0;
@@ -180,20 +192,29 @@ void Track3D::shrinkToHits(){
   TrackSegment3D & aFirstSegment = mySegments.front();
   TrackSegment3D & aLastSegment = mySegments.back();
 
-  TH1F hChargeProfileStart = aFirstSegment.getChargeProfile();
-  TH1F hChargeProfileEnd = aLastSegment.getChargeProfile();
+  // profiles are cached in the segments, the same profile is used for a single segment track
+  const std::vector<double> & aChargeProfileStart = aFirstSegment.getChargeProfileValues();
+  const std::vector<double> & aChargeProfileEnd = aLastSegment.getChargeProfileValues();
+  auto getMaximum = [](const std::vector<double> & aProfile){
+    return aProfile.empty() ? 0.0 : *std::max_element(aProfile.begin(), aProfile.end());
+  };
   double chargeCut = 0.0;
   
+  // bins numbered from 1, -1 if no bin above the cut, as in TH1::FindFirstBinAbove()
   int startBin = 0;
   int endBin = 1E6;
   int binTmp = 0;
-  chargeCut = 0.05*hChargeProfileStart.GetMaximum();
-  binTmp = hChargeProfileStart.FindFirstBinAbove(chargeCut);
+  chargeCut = 0.05*getMaximum(aChargeProfileStart);
+  auto itFirst = std::find_if(aChargeProfileStart.begin(), aChargeProfileStart.end(),
+			      [chargeCut](double aValue){ return aValue>chargeCut;});
+  binTmp = itFirst==aChargeProfileStart.end() ? -1 : itFirst - aChargeProfileStart.begin() + 1;
 
   if(binTmp>startBin) startBin = binTmp;
     ///
-  chargeCut = 0.05*hChargeProfileEnd.GetMaximum();
-  binTmp = hChargeProfileEnd.FindLastBinAbove(chargeCut);
+  chargeCut = 0.05*getMaximum(aChargeProfileEnd);
+  auto itLast = std::find_if(aChargeProfileEnd.rbegin(), aChargeProfileEnd.rend(),
+			     [chargeCut](double aValue){ return aValue>chargeCut;});
+  binTmp = itLast==aChargeProfileEnd.rend() ? -1 : aChargeProfileEnd.rend() - itLast;
   if(binTmp<endBin) endBin = binTmp;
 
   if(endBin-startBin<2){
@@ -201,8 +222,8 @@ void Track3D::shrinkToHits(){
     endBin+=1;
   }
 
-  double lambdaStart = hChargeProfileStart.GetBinCenter(startBin);
-  double lambdaEnd = hChargeProfileEnd.GetBinCenter(endBin);
+  double lambdaStart = aFirstSegment.getChargeProfileBinCenter(startBin);
+  double lambdaEnd = aLastSegment.getChargeProfileBinCenter(endBin);
 
   TVector3 aStart = aFirstSegment.getStart() + getSegmentLambda(lambdaStart, 0)*aFirstSegment.getTangent();
   TVector3 aEnd = aLastSegment.getStart() + getSegmentLambda(lambdaEnd, mySegments.size()-1)*aLastSegment.getTangent();
@@ -238,6 +259,38 @@ void Track3D::removeEmptySegments(){
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+std::vector<Hit2DCollection> Track3D::detachRecHits(){
+
+  if(mySegments.empty()) return std::vector<Hit2DCollection>();
+  
+  auto isSameHit = [](const Hit2D &a, const Hit2D &b){
+    return a.getPosTime()==b.getPosTime() && a.getPosStrip()==b.getPosStrip() && a.getCharge()==b.getCharge();
+  };
+  const std::vector<Hit2DCollection> & aRecHits = mySegments.front().getRecHits();
+  for(const auto & aSegment: mySegments){
+    const std::vector<Hit2DCollection> & aSegmentHits = aSegment.getRecHits();
+    if(aSegmentHits.size()!=aRecHits.size()) return std::vector<Hit2DCollection>();
+    for(unsigned int iDir=0;iDir<aRecHits.size();++iDir){
+      if(!std::equal(aSegmentHits[iDir].begin(), aSegmentHits[iDir].end(),
+		     aRecHits[iDir].begin(), aRecHits[iDir].end(), isSameHit)) return std::vector<Hit2DCollection>();
+    }
+  }
+  std::vector<Hit2DCollection> result = aRecHits;
+  for(auto & aSegment: mySegments) aSegment.setRecHits(std::vector<Hit2DCollection>(result.size()));
+  return result;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void Track3D::attachRecHits(const std::vector<Hit2DCollection> & aRecHits){
+
+  for(auto & aSegment: mySegments){
+    const std::vector<Hit2DCollection> & aSegmentHits = aSegment.getRecHits();
+    bool isEmpty = std::all_of(aSegmentHits.begin(), aSegmentHits.end(), [](const Hit2DCollection &aItem){return aItem.empty();});
+    if(isEmpty) aSegment.setRecHits(aRecHits);
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 double Track3D::updateAndGetLoss(const double *par){
   
   for(unsigned int iSegment=0;iSegment<mySegments.size();++iSegment){
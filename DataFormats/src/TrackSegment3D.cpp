@@ -2,6 +2,8 @@
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/colorText.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 /////////////////////////////////////////////////////////
@@ -18,6 +20,7 @@ TrackSegment3D::TrackSegment3D(){
 void TrackSegment3D::setGeometry(std::shared_ptr<GeometryTPC> aGeometryPtr){
   
   myGeometryPtr = aGeometryPtr;
+  isChargeProfileValid = false;
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -78,6 +81,8 @@ void TrackSegment3D::setRecHits(const std::vector<TH2D> & aRecHits){
 
   myRecHits.clear();
   myRecHits.resize(3);
+  mySummaryCharge = mySummaryMaxCharge = -1;
+  isChargeProfileValid = false;
   
   double x=-999.0, y=-999.0, charge=-999.0;
   for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
@@ -107,6 +112,7 @@ void TrackSegment3D::initialize(){
   myBiasAtZ0 = myBias + lambda*myTangent;
 
   myLenght = (myEnd - myStart).Mag();
+  isChargeProfileValid = false;
 
   calculateLoss();
 }
@@ -179,8 +185,19 @@ TrackSegment2D TrackSegment3D::get2DProjection(int strip_dir, double lambdaStart
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void TrackSegment3D::setChargeSummary(double aCharge, double aMaxCharge){
+
+  mySummaryCharge = aCharge;
+  mySummaryMaxCharge = aMaxCharge;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 double TrackSegment3D::getIntegratedCharge(double lambda) const{
   if(lambda<0) return 0;
+  if(mySummaryCharge>=0){
+    if(lambda>=getLength() || getLength()<=0) return mySummaryCharge;
+    return mySummaryCharge*lambda/getLength();
+  }
   double charge = 0.0;
   for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
     TrackSegment2D aTrack2DProjection = get2DProjection(strip_dir, 0, lambda);
@@ -193,6 +210,7 @@ double TrackSegment3D::getIntegratedCharge(double lambda) const{
 /////////////////////////////////////////////////////////
 double TrackSegment3D::getMaxCharge() const {
 
+  if(mySummaryMaxCharge>=0) return mySummaryMaxCharge;
   double maxCharge = 0.0;
   for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
     const Hit2DCollection & aRecHits = myRecHits.at(strip_dir);
@@ -236,31 +254,7 @@ double TrackSegment3D::operator() (const double *par) {
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
-void TrackSegment3D::addProjection(TH1F &histo, TGraphErrors &graph) const{
-
-  double x, y, ex;
-  double value=0, binCoverage=0.0;
-  int binLow, binHigh;
-  double binWidth = histo.GetBinWidth(1);
-  for(int iPoint=0;iPoint<graph.GetN();++iPoint){
-    graph.GetPoint(iPoint, x,y);
-    ex = graph.GetErrorX(iPoint);
-    binLow = histo.FindBin((x-ex)*getLength());
-    binHigh = histo.FindBin((x+ex)*getLength());
-    y *= binWidth/getLength();
-    for(int iBin=binLow;iBin<=binHigh;++iBin){
-      if(iBin==binLow) binCoverage = histo.GetXaxis()->GetBinUpEdge(iBin) - (x-ex)*getLength();
-      else if(iBin==binHigh) binCoverage = (x+ex)*getLength() - histo.GetXaxis()->GetBinLowEdge(iBin);
-      else binCoverage = histo.GetBinWidth(iBin);
-      binCoverage /=histo.GetBinWidth(iBin);
-      value = histo.GetBinContent(iBin);
-      histo.SetBinContent(iBin, value+y*binCoverage);
-    }
-  }
-}
-/////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////
-TH1F TrackSegment3D::getChargeProfile() const{
+void TrackSegment3D::calculateChargeProfile() const{
 
   // Maximum hit distance from 2D projection
   double radiusCut = 2; //parameter to be put into configuration
@@ -272,43 +266,112 @@ TH1F TrackSegment3D::getChargeProfile() const{
   int nBins = 1024;
   double minX = -0.2*getLength();
   double maxX = 1.2*getLength();
-  TH1F hChargeProfile("hChargeProfile",";d [mm];charge/mm",nBins, minX, maxX);
-  hChargeProfile.SetDirectory(0);
-  if(getLength()<1) return hChargeProfile;
+  double binWidth = (maxX - minX)/nBins;
+
+  isChargeProfileValid = true;
+  myChargeProfileSums.clear();
+  myChargeProfile.clear();
+  if(getLength()<1 || !myGeometryPtr) return;
+
+  // charge of each hit is spread uniformly over the hit cell projection on the segment
+  std::vector<double> sums(nBins+2, 0.0); // with underflow and overflow bins
+  auto findBin = [&](double x){
+    if(x<minX) return 0;
+    if(x>=maxX) return nBins+1;
+    return 1 + int(nBins*(x-minX)/(maxX-minX));
+  };
 
   for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
-    TrackSegment2D aTrack2DProjection = get2DProjection(strip_dir, 0, getLength()); 
-    const Hit2DCollection & aRecHits = myRecHits.at(strip_dir);
-    TGraphErrors aGraph = aTrack2DProjection.getChargeProfile(aRecHits, radiusCut);
-    double projLength = aTrack2DProjection.getLength();
-    //double graphLength = aGraph.GetXaxis()->GetXmax() - aGraph.GetXaxis()->GetXmin();
+    const TVector3 stripPitchDirection = myGeometryPtr->GetStripPitchVector3D(strip_dir);
+    // segment projection on the (time, strip) plane, as in get2DProjection(strip_dir, 0, getLength())
+    TVector3 start2D(getStart().Z(), getStart()*stripPitchDirection, 0.0);
+    TVector3 end2D(getEnd().Z(), getEnd()*stripPitchDirection, 0.0);
+    double projLength = (end2D - start2D).Mag();
 
-    double segmentAlongStrip = getTangent().Dot(myGeometryPtr->GetStripPitchVector3D(strip_dir).Unit())/sin(getTangent().Theta());
+    double segmentAlongStrip = getTangent().Dot(stripPitchDirection.Unit())/sin(getTangent().Theta());
     ///do not consider short projections unless the track is very long
     ///very long track is a track seed before shrinking to hits range
-    /*
-    std::cout<<KGRN<<"strip_dir: "<<strip_dir<<" along strip: "<<segmentAlongStrip
-            <<" projLength: "<<projLength
-            <<" graphLength: "<<graphLength
-            <<"projLength*graphLength: "<<projLength*graphLength
-            <<RST<<std::endl;
-     */
     if(projLength<minProjLength ||   //short projection 
     (getLength()>200 && std::abs(cos(getTangent().Theta()))<0.95 && std::abs(segmentAlongStrip)<0.2)) { //initial track with "infinite" length. Horizontal track do not have well defined phi
       continue;
     }
-    
-    /*
-    if(graphLength*projLength<minProjLength && std::abs(segmentAlongStrip)<0.2 && getLength()<200) {
-      continue;
-    }*/
-    
-    addProjection(hChargeProfile, aGraph);
+    TVector3 tangent2D = (end2D - start2D).Unit();
+
+    TVector3 cellDiagonal(myGeometryPtr->GetTimeBinWidth(), myGeometryPtr->GetStripPitch(), 0);
+    TVector3 cellDiagonal1(myGeometryPtr->GetTimeBinWidth(), -myGeometryPtr->GetStripPitch(), 0);
+    double cellProjection = std::abs(std::max(cellDiagonal.Dot(tangent2D), cellDiagonal1.Dot(tangent2D)));
+    // hit cell projection scaled to the 3D segment length
+    double halfWidth = 0.5*cellProjection*getLength()/projLength;
+    if(halfWidth<=0) continue;
+
+    for(const auto & aHit: myRecHits.at(strip_dir)){
+      TVector3 delta(aHit.getPosTime() - start2D.X(), aHit.getPosStrip() - start2D.Y(), 0.0);
+      double lambda = delta*tangent2D;
+      double distance = (delta - lambda*tangent2D).Mag();
+      if(distance>=radiusCut) continue;
+      double position = lambda*getLength()/projLength;
+      double low = position - halfWidth;
+      double high = position + halfWidth;
+      int binLow = findBin(low);
+      int binHigh = findBin(high);
+      double density = aHit.getCharge()/(2*halfWidth);
+      for(int iBin=binLow;iBin<=binHigh;++iBin){
+	double coverage = binWidth;
+	if(iBin==binLow) coverage = minX + iBin*binWidth - low;
+	else if(iBin==binHigh) coverage = high - (minX + (iBin-1)*binWidth);
+	sums[iBin] += density*coverage;
+      }
+    }
   }
 
   int rebinFactor = log(4.0*nBins/(maxX - minX))/log(2); //bin width is around 2 mm
-  rebinFactor = std::pow(2, rebinFactor);
-  hChargeProfile.Rebin(rebinFactor);
+  rebinFactor = std::max(1, (int)std::pow(2, rebinFactor));
+  int nRebinned = nBins/rebinFactor;
+  myChargeProfileSums.assign(nRebinned, 0.0);
+  for(int iBin=0;iBin<nRebinned*rebinFactor;++iBin) myChargeProfileSums[iBin/rebinFactor] += sums[iBin+1];
+
+  double scale = 1.0/(rebinFactor*binWidth);
+  double max = 0.0;
+  for(auto aValue: myChargeProfileSums) max = std::max(max, aValue*scale);
+  if(max<1) max = 1.0;
+  myChargeProfile.resize(nRebinned);
+  for(int iBin=0;iBin<nRebinned;++iBin) myChargeProfile[iBin] = myChargeProfileSums[iBin]*scale/max;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+const std::vector<double> & TrackSegment3D::getChargeProfileValues() const{
+
+  if(!isChargeProfileValid) calculateChargeProfile();
+  return myChargeProfile;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+double TrackSegment3D::getChargeProfileBinCenter(int iBin) const{
+
+  int nBins = getChargeProfileValues().size();
+  if(!nBins) nBins = 1024;
+  double minX = -0.2*getLength();
+  double binWidth = 1.4*getLength()/nBins;
+  return minX + (iBin-0.5)*binWidth;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+TH1F TrackSegment3D::getChargeProfile() const{
+
+  if(!isChargeProfileValid) calculateChargeProfile();
+
+  double minX = -0.2*getLength();
+  double maxX = 1.2*getLength();
+  if(myChargeProfileSums.empty()){
+    TH1F hChargeProfile("hChargeProfile",";d [mm];charge/mm", 1024, minX, maxX);
+    hChargeProfile.SetDirectory(0);
+    return hChargeProfile;
+  }
+  TH1F hChargeProfile("hChargeProfile",";d [mm];charge/mm", myChargeProfileSums.size(), minX, maxX);
+  hChargeProfile.SetDirectory(0);
+  for(unsigned int iBin=0;iBin<myChargeProfileSums.size();++iBin){
+    hChargeProfile.SetBinContent(iBin+1, myChargeProfileSums[iBin]);
+  }
   double scale = 1.0/hChargeProfile.GetBinWidth(1);
   hChargeProfile.Scale(scale); 
   double max = hChargeProfile.GetMaximum();
@@ -0,0 +1,57 @@
+#include <algorithm>
+
+#include "TPCReco/ZeroSuppression.h"
+
+namespace tpcreco {
+
+void findZeroSuppressedRuns(const std::vector<double> &values, int minCell,
+                            int maxCell, double threshold, int guardCells,
+                            std::vector<CellRange> &runs) {
+  runs.clear();
+  minCell = std::max(minCell, 0);
+  maxCell = std::min<int>(maxCell, values.size() - 1);
+  for (int cell = minCell; cell <= maxCell; ++cell) {
+    if (values[cell] <= threshold) {
+      continue;
+    }
+    int first = std::max(minCell, cell - guardCells);
+    int last = std::min(maxCell, cell + guardCells);
+    if (!runs.empty() && first <= runs.back().last + 1) {
+      runs.back().last = last;
+    } else {
+      runs.push_back({first, last});
+    }
+  }
+}
+
+void zeroSuppressChannel(const std::vector<CellSample> &samples,
+                         const std::vector<double> &pedestals,
+                         double pedestalRMS, int minCell, int maxCell,
+                         double nSigma, double threshold, int guardCells,
+                         ZeroSuppressionBuffers &buffers,
+                         std::vector<CellSample> &kept) {
+  kept.clear();
+  const int nCells = pedestals.size();
+  buffers.values.assign(nCells, 0.0);
+  buffers.present.assign(nCells, 0);
+  for (const auto &aSample : samples) {
+    if (aSample.cell < std::max(minCell, 0) ||
+        aSample.cell > std::min(maxCell, nCells - 1)) {
+      continue;
+    }
+    buffers.values[aSample.cell] = aSample.value - pedestals[aSample.cell];
+    buffers.present[aSample.cell] = 1;
+  }
+  findZeroSuppressedRuns(buffers.values, minCell, maxCell,
+                         std::max(nSigma * pedestalRMS, threshold), guardCells,
+                         buffers.runs);
+  for (const auto &aRun : buffers.runs) {
+    for (int cell = aRun.first; cell <= aRun.last; ++cell) {
+      if (buffers.present[cell]) {
+        kept.push_back({cell, buffers.values[cell]});
+      }
+    }
+  }
+}
+
+} // namespace tpcreco
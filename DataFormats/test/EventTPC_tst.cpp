@@ -0,0 +1,102 @@
+#include "AllocationCounter.h"
+#include "TPCReco/EventTPC.h"
+#include "TPCReco/GeometryTPC.h"
+#include "gtest/gtest.h"
+#include <TRandom3.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+const std::string geometryFile =
+    std::string(TPCRECO_RESOURCE_DIR) + "geometry_ELITPC_250mbar_12.5MHz.dat";
+} // namespace
+
+class EventTPCTest : public ::testing::Test {
+public:
+  static std::shared_ptr<GeometryTPC> myGeometryPtr;
+  static std::vector<PEventTPC::chargeMapType> myChargeMaps;
+
+  static void SetUpTestSuite() {
+    GeometryTPC::SetCompiledGeometryDir("");
+    myGeometryPtr = std::make_shared<GeometryTPC>(geometryFile.c_str(), false);
+    // a few tracks per event, with charge spread around the track cells
+    TRandom3 aRndm(1);
+    for (int iEvent = 0; iEvent < 5; ++iEvent) {
+      PEventTPC::chargeMapType aChargeMap;
+      for (int strip_dir = definitions::projection_type::DIR_U;
+           strip_dir <= definitions::projection_type::DIR_W; ++strip_dir) {
+        int section = *myGeometryPtr->GetDirSectionIndexList(strip_dir).begin();
+        int minStrip = myGeometryPtr->GetDirMinStrip(strip_dir, section);
+        int maxStrip = myGeometryPtr->GetDirMaxStrip(strip_dir, section);
+        int nHits = 200 + 100 * iEvent;
+        for (int iHit = 0; iHit < nHits; ++iHit) {
+          int strip = aRndm.Integer(maxStrip - minStrip + 1) + minStrip;
+          int cell = aRndm.Integer(myGeometryPtr->GetAgetNtimecells());
+          aChargeMap[std::make_tuple(strip_dir, section, strip, cell)] +=
+              aRndm.Uniform(0, 100 + 50 * iEvent);
+        }
+      }
+      myChargeMaps.push_back(aChargeMap);
+    }
+  }
+  static void TearDownTestSuite() {
+    myGeometryPtr.reset();
+    myChargeMaps.clear();
+  }
+
+  struct Summary {
+    double totalCharge;
+    double maxCharge;
+    long nHits;
+  };
+
+  static Summary process(EventTPC &aEvent,
+                         const PEventTPC::chargeMapType &aChargeMap) {
+    aEvent.SetChargeMap(aChargeMap);
+    Summary aSummary;
+    aSummary.totalCharge =
+        aEvent.GetTotalCharge(-1, -1, -1, -1, filter_type::threshold);
+    aSummary.maxCharge = aEvent.GetMaxCharge(-1, -1, -1, filter_type::threshold);
+    aSummary.nHits = aEvent.GetMultiplicity(true, -1, -1, -1, filter_type::none);
+    return aSummary;
+  }
+};
+
+std::shared_ptr<GeometryTPC> EventTPCTest::myGeometryPtr;
+std::vector<PEventTPC::chargeMapType> EventTPCTest::myChargeMaps;
+
+TEST_F(EventTPCTest, ReusedEventMatchesNewEvent) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  EventTPC aReusedEvent;
+  aReusedEvent.SetGeoPtr(myGeometryPtr);
+  // events in decreasing and increasing size
+  std::vector<int> order = {4, 0, 3, 1, 2, 0, 4};
+  for (auto iEvent : order) {
+    EventTPC aNewEvent;
+    aNewEvent.SetGeoPtr(myGeometryPtr);
+    auto expected = process(aNewEvent, myChargeMaps[iEvent]);
+    auto result = process(aReusedEvent, myChargeMaps[iEvent]);
+    EXPECT_DOUBLE_EQ(result.totalCharge, expected.totalCharge) << iEvent;
+    EXPECT_DOUBLE_EQ(result.maxCharge, expected.maxCharge) << iEvent;
+    EXPECT_EQ(result.nHits, expected.nHits) << iEvent;
+    EXPECT_EQ(result.nHits, (long)myChargeMaps[iEvent].size());
+  }
+}
+
+TEST_F(EventTPCTest, SteadyStateWithoutAllocations) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  EventTPC aEvent;
+  aEvent.SetGeoPtr(myGeometryPtr);
+  // warm-up: histogram cache and node pools sized by the largest event
+  for (const auto &aChargeMap : myChargeMaps) {
+    process(aEvent, aChargeMap);
+  }
+  tpcreco::test::startCountingAllocations();
+  for (int iLoop = 0; iLoop < 3; ++iLoop) {
+    for (const auto &aChargeMap : myChargeMaps) {
+      process(aEvent, aChargeMap);
+    }
+  }
+  EXPECT_EQ(tpcreco::test::stopCountingAllocations(), 0);
+}
@@ -0,0 +1,188 @@
+#include "TPCReco/GeometryTPC.h"
+#include "gtest/gtest.h"
+#include <TMath.h>
+#include <TRandom3.h>
+#include <boost/filesystem.hpp>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace {
+const std::string geometryFile =
+    std::string(TPCRECO_RESOURCE_DIR) + "geometry_ELITPC_250mbar_12.5MHz.dat";
+}
+
+class GeometryTPCTest : public ::testing::Test {
+public:
+  static std::shared_ptr<GeometryTPC> myGeometryPtr;
+
+  static void SetUpTestSuite() {
+    GeometryTPC::SetCompiledGeometryDir("");
+    myGeometryPtr = std::make_shared<GeometryTPC>(geometryFile.c_str(), false);
+  }
+  static void TearDownTestSuite() { myGeometryPtr.reset(); }
+};
+
+std::shared_ptr<GeometryTPC> GeometryTPCTest::myGeometryPtr;
+
+TEST_F(GeometryTPCTest, FindTH2PolyBinMatchesTH2Poly) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  double xmin, xmax, ymin, ymax;
+  std::tie(xmin, xmax, ymin, ymax) = myGeometryPtr->rangeXY();
+  TRandom3 aRndm(1);
+  for (int i = 0; i < 100000; ++i) {
+    double x = aRndm.Uniform(xmin - 10, xmax + 10);
+    double y = aRndm.Uniform(ymin - 10, ymax + 10);
+    int ibin = myGeometryPtr->FindTH2PolyBin(x, y);
+    int ibinRef = myGeometryPtr->GetTH2Poly()->FindBin(x, y);
+    ASSERT_EQ(ibin, ibinRef) << "x=" << x << " y=" << y;
+    EXPECT_EQ(myGeometryPtr->FindStrip(x, y),
+              myGeometryPtr->GetTH2PolyStrip(ibinRef));
+  }
+}
+
+TEST_F(GeometryTPCTest, IsInsideActiveAreaMatchesConvexHull) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  auto hull = myGeometryPtr->GetActiveAreaConvexHull();
+  double xmin, xmax, ymin, ymax;
+  std::tie(xmin, xmax, ymin, ymax) = myGeometryPtr->rangeXY();
+  TRandom3 aRndm(2);
+  for (int i = 0; i < 100000; ++i) {
+    double x = aRndm.Uniform(xmin - 10, xmax + 10);
+    double y = aRndm.Uniform(ymin - 10, ymax + 10);
+    bool isInsideRef =
+        TMath::IsInside(x, y, hull.GetN(), hull.GetX(), hull.GetY());
+    // points within numerical tolerance of the hull boundary may differ
+    bool nearEdge = false;
+    for (int dx = -1; dx <= 1; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        nearEdge |= TMath::IsInside(x + 1e-6 * dx, y + 1e-6 * dy, hull.GetN(),
+                                    hull.GetX(), hull.GetY()) != isInsideRef;
+      }
+    }
+    if (nearEdge) {
+      continue;
+    }
+    EXPECT_EQ(myGeometryPtr->IsInsideActiveArea(x, y), isInsideRef)
+        << "x=" << x << " y=" << y;
+  }
+}
+
+TEST(GeometryTPCCompiled, SameStripTable) {
+  auto cacheDir = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("GeometryTPC_tst_%%%%%%%%");
+  GeometryTPC::SetCompiledGeometryDir(cacheDir.string());
+  GeometryTPC aTextGeometry(geometryFile.c_str(), false);
+  GeometryTPC aCompiledGeometry(geometryFile.c_str(), false);
+  GeometryTPC::SetCompiledGeometryDir("");
+  boost::filesystem::remove_all(cacheDir);
+
+  ASSERT_TRUE(aTextGeometry.IsOK());
+  ASSERT_TRUE(aCompiledGeometry.IsOK());
+  EXPECT_EQ(aTextGeometry.GetDriftVelocity(),
+            aCompiledGeometry.GetDriftVelocity());
+  EXPECT_EQ(aTextGeometry.GetSamplingRate(),
+            aCompiledGeometry.GetSamplingRate());
+  EXPECT_EQ(aTextGeometry.GetPadSize(), aCompiledGeometry.GetPadSize());
+  EXPECT_EQ(aTextGeometry.GetCoboNboards(), aCompiledGeometry.GetCoboNboards());
+  for (int dir = definitions::projection_type::DIR_U;
+       dir <= definitions::projection_type::DIR_W; ++dir) {
+    ASSERT_EQ(aTextGeometry.GetDirNstrips(dir),
+              aCompiledGeometry.GetDirNstrips(dir));
+    for (int num = 1; num <= aTextGeometry.GetDirNstrips(dir); ++num) {
+      auto strip = aTextGeometry.GetStripByDir(dir, 0, num);
+      auto compiledStrip = aCompiledGeometry.GetStripByDir(dir, 0, num);
+      ASSERT_EQ(bool(strip), bool(compiledStrip));
+      if (!strip) {
+        continue;
+      }
+      EXPECT_EQ(strip->Offset().X(), compiledStrip->Offset().X());
+      EXPECT_EQ(strip->Offset().Y(), compiledStrip->Offset().Y());
+      EXPECT_EQ(strip->Npads(), compiledStrip->Npads());
+      EXPECT_EQ(strip->CoboId(), compiledStrip->CoboId());
+      EXPECT_EQ(strip->AgetCh(), compiledStrip->AgetCh());
+    }
+  }
+}
+
+TEST(GeometryTPCCompiled, SameLookups) {
+  auto cacheDir = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("GeometryTPC_tst_%%%%%%%%");
+  GeometryTPC::SetCompiledGeometryDir(cacheDir.string());
+  GeometryTPC aTextGeometry(geometryFile.c_str(), false); // writes the cache
+  auto nFiles = std::distance(boost::filesystem::directory_iterator(cacheDir),
+                              boost::filesystem::directory_iterator());
+  GeometryTPC aCompiledGeometry(geometryFile.c_str(), false);
+  GeometryTPC::SetCompiledGeometryDir("");
+  boost::filesystem::remove_all(cacheDir);
+  EXPECT_EQ(nFiles, 1); // no temporary file left
+
+  ASSERT_TRUE(aTextGeometry.IsOK());
+  ASSERT_TRUE(aCompiledGeometry.IsOK());
+  EXPECT_EQ(aTextGeometry.rangeXY(), aCompiledGeometry.rangeXY());
+  ASSERT_EQ(aTextGeometry.GetTH2Poly()->GetNumberOfBins(),
+            aCompiledGeometry.GetTH2Poly()->GetNumberOfBins());
+  auto hull = aTextGeometry.GetActiveAreaConvexHull();
+  auto compiledHull = aCompiledGeometry.GetActiveAreaConvexHull();
+  ASSERT_EQ(hull.GetN(), compiledHull.GetN());
+  for (int i = 0; i < hull.GetN(); ++i) {
+    EXPECT_EQ(hull.GetX()[i], compiledHull.GetX()[i]);
+    EXPECT_EQ(hull.GetY()[i], compiledHull.GetY()[i]);
+  }
+  double xmin, xmax, ymin, ymax;
+  std::tie(xmin, xmax, ymin, ymax) = aTextGeometry.rangeXY();
+  TRandom3 aRndm(3);
+  for (int i = 0; i < 100000; ++i) {
+    double x = aRndm.Uniform(xmin - 10, xmax + 10);
+    double y = aRndm.Uniform(ymin - 10, ymax + 10);
+    int ibin = aCompiledGeometry.FindTH2PolyBin(x, y);
+    ASSERT_EQ(ibin, aCompiledGeometry.GetTH2Poly()->FindBin(x, y))
+        << "x=" << x << " y=" << y;
+    EXPECT_EQ(aCompiledGeometry.FindStrip(x, y),
+              aCompiledGeometry.GetTH2PolyStrip(ibin));
+    auto strip = aTextGeometry.FindStrip(x, y);
+    auto compiledStrip = aCompiledGeometry.FindStrip(x, y);
+    ASSERT_EQ(bool(strip), bool(compiledStrip)) << "x=" << x << " y=" << y;
+    if (strip) {
+      EXPECT_EQ(strip->Dir(), compiledStrip->Dir());
+      EXPECT_EQ(strip->Section(), compiledStrip->Section());
+      EXPECT_EQ(strip->Num(), compiledStrip->Num());
+    }
+    EXPECT_EQ(aTextGeometry.IsInsideActiveArea(x, y),
+              aCompiledGeometry.IsInsideActiveArea(x, y))
+        << "x=" << x << " y=" << y;
+  }
+}
+
+TEST(GeometryTPCCompiled, TruncatedLookups) {
+  auto cacheDir = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("GeometryTPC_tst_%%%%%%%%");
+  GeometryTPC::SetCompiledGeometryDir(cacheDir.string());
+  GeometryTPC aTextGeometry(geometryFile.c_str(), false); // writes the cache
+  // drop the end of the convex hull, the lookups are rebuilt from the strips
+  for (auto &entry : boost::filesystem::directory_iterator(cacheDir)) {
+    boost::filesystem::resize_file(entry.path(),
+                                   boost::filesystem::file_size(entry.path()) - 8);
+  }
+  GeometryTPC aCompiledGeometry(geometryFile.c_str(), false);
+  GeometryTPC::SetCompiledGeometryDir("");
+  boost::filesystem::remove_all(cacheDir);
+
+  ASSERT_TRUE(aTextGeometry.IsOK());
+  ASSERT_TRUE(aCompiledGeometry.IsOK());
+  EXPECT_EQ(aTextGeometry.GetTH2Poly()->GetNumberOfBins(),
+            aCompiledGeometry.GetTH2Poly()->GetNumberOfBins());
+  double xmin, xmax, ymin, ymax;
+  std::tie(xmin, xmax, ymin, ymax) = aTextGeometry.rangeXY();
+  TRandom3 aRndm(4);
+  for (int i = 0; i < 10000; ++i) {
+    double x = aRndm.Uniform(xmin - 10, xmax + 10);
+    double y = aRndm.Uniform(ymin - 10, ymax + 10);
+    EXPECT_EQ(aTextGeometry.FindTH2PolyBin(x, y),
+              aCompiledGeometry.FindTH2PolyBin(x, y))
+        << "x=" << x << " y=" << y;
+    EXPECT_EQ(aTextGeometry.IsInsideActiveArea(x, y),
+              aCompiledGeometry.IsInsideActiveArea(x, y))
+        << "x=" << x << " y=" << y;
+  }
+}
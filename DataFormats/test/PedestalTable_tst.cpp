@@ -0,0 +1,148 @@
+#include "TPCReco/PedestalTable.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+PedestalTable makeTable(long runId, float offset) {
+  PedestalTable aTable(runId, 4, 64, 512);
+  for (int asadId = 0; asadId < 2; ++asadId) {
+    for (int channel = 0; channel < 256; ++channel) {
+      aTable.SetPedestal(0, asadId, channel, offset + channel);
+      aTable.SetNoise(0, asadId, channel, 0.01 * channel);
+    }
+    for (int agetId = 0; agetId < 4; ++agetId) {
+      for (int cellId = 0; cellId < 512; ++cellId) {
+        aTable.SetFpn(0, asadId, agetId, cellId,
+                      offset + 0.5 * cellId + agetId);
+      }
+    }
+    aTable.SetNFrames(0, asadId, 100 + asadId);
+  }
+  aTable.SetCellRange(2, 500);
+  return aTable;
+}
+} // namespace
+
+TEST(PedestalTableTest, Content) {
+  auto aTable = makeTable(20220412080344, 300);
+  EXPECT_TRUE(aTable.HasAsad(0, 1));
+  EXPECT_FALSE(aTable.HasAsad(0, 2));
+  EXPECT_FLOAT_EQ(aTable.GetPedestal(0, 1, 70), 370);
+  EXPECT_FLOAT_EQ(aTable.GetFpn(0, 1, 2, 10), 307);
+  EXPECT_FLOAT_EQ(aTable.GetNoise(0, 1, 200), 2);
+  EXPECT_EQ(aTable.GetNFrames(0, 1), 101u);
+  EXPECT_EQ(aTable.GetNFrames(1, 0), 0u);
+  EXPECT_THROW(aTable.GetPedestal(0, 2, 0), std::out_of_range);
+  EXPECT_THROW(aTable.GetFpn(0, 0, 0, 512), std::out_of_range);
+  EXPECT_THROW(PedestalTable(1, 0, 64, 512), std::invalid_argument);
+}
+
+TEST(PedestalTableTest, CellRange) {
+  PedestalTable aTable(1, 4, 64, 512);
+  EXPECT_EQ(aTable.GetMinCell(), 0);
+  EXPECT_EQ(aTable.GetMaxCell(), 511);
+  aTable.SetCellRange(2, 500);
+  EXPECT_EQ(aTable.GetMinCell(), 2);
+  EXPECT_EQ(aTable.GetMaxCell(), 500);
+  EXPECT_THROW(aTable.SetCellRange(-1, 500), std::out_of_range);
+  EXPECT_THROW(aTable.SetCellRange(2, 512), std::out_of_range);
+  EXPECT_THROW(aTable.SetCellRange(300, 200), std::out_of_range);
+}
+
+TEST(PedestalTableTest, ReadWrite) {
+  auto aTable = makeTable(20220412080344, 300);
+  std::stringstream aStream;
+  aTable.Write(aStream);
+  auto aCopy = PedestalTable::Read(aStream);
+  EXPECT_EQ(aCopy.GetRunId(), aTable.GetRunId());
+  EXPECT_EQ(aCopy.GetAgetNtimecells(), 512);
+  EXPECT_EQ(aCopy.GetMinCell(), 2);
+  EXPECT_EQ(aCopy.GetMaxCell(), 500);
+  EXPECT_EQ(aCopy.GetNFrames(0, 0), 100u);
+  for (int channel = 0; channel < 256; ++channel) {
+    EXPECT_EQ(aCopy.GetPedestal(0, 1, channel),
+              aTable.GetPedestal(0, 1, channel));
+    EXPECT_EQ(aCopy.GetNoise(0, 1, channel), aTable.GetNoise(0, 1, channel));
+  }
+  EXPECT_EQ(aCopy.GetFpn(0, 0, 3, 511), aTable.GetFpn(0, 0, 3, 511));
+}
+
+TEST(PedestalTableTest, Database) {
+  PedestalDatabase aDatabase;
+  aDatabase.Add(makeTable(200, 2));
+  aDatabase.Add(makeTable(100, 1));
+  aDatabase.Add(makeTable(200, 3)); // replaces the first table
+  EXPECT_EQ(aDatabase.size(), 2u);
+  EXPECT_FALSE(aDatabase.Find(150));
+  EXPECT_FALSE(aDatabase.FindLatest(99));
+  ASSERT_TRUE(aDatabase.FindLatest(150));
+  EXPECT_EQ(aDatabase.FindLatest(150)->GetRunId(), 100);
+  ASSERT_TRUE(aDatabase.FindLatest(1000));
+  EXPECT_FLOAT_EQ(aDatabase.FindLatest(1000)->GetPedestal(0, 0, 0), 3);
+
+  const std::string fileName = "PedestalTable_tst.pdb";
+  aDatabase.Save(fileName);
+  PedestalDatabase aLoaded;
+  aLoaded.Load(fileName);
+  std::remove(fileName.c_str());
+  EXPECT_EQ(aLoaded.size(), 2u);
+  ASSERT_TRUE(aLoaded.Find(200));
+  EXPECT_FLOAT_EQ(aLoaded.Find(200)->GetFpn(0, 1, 1, 4), 6);
+  EXPECT_EQ(aLoaded.Find(200)->GetMaxCell(), 500);
+
+  std::ofstream(fileName) << "not a database";
+  EXPECT_THROW(aLoaded.Load(fileName), std::runtime_error);
+  std::remove(fileName.c_str());
+  EXPECT_THROW(aLoaded.Load(fileName), std::runtime_error);
+}
+
+TEST(PedestalTableTest, ReadVersion1) {
+  // version 1 tables have no noise values and no time cell range
+  std::stringstream aStream;
+  auto write32 = [&aStream](std::int32_t value) {
+    aStream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  std::int64_t runId = 5;
+  aStream.write(reinterpret_cast<const char *>(&runId), sizeof(runId));
+  write32(1); // AGET chips
+  write32(2); // channels
+  write32(3); // time cells
+  write32(1); // ASAD boards
+  write32(0); // COBO
+  write32(1); // ASAD
+  std::uint64_t nFrames = 7;
+  aStream.write(reinterpret_cast<const char *>(&nFrames), sizeof(nFrames));
+  std::vector<float> values{1, 2, 10, 11, 12};
+  aStream.write(reinterpret_cast<const char *>(values.data()),
+                values.size() * sizeof(float));
+  auto aTable = PedestalTable::Read(aStream, 1);
+  EXPECT_EQ(aTable.GetRunId(), 5);
+  EXPECT_EQ(aTable.GetNFrames(0, 1), 7u);
+  EXPECT_FLOAT_EQ(aTable.GetPedestal(0, 1, 1), 2);
+  EXPECT_FLOAT_EQ(aTable.GetNoise(0, 1, 1), 0);
+  EXPECT_FLOAT_EQ(aTable.GetFpn(0, 1, 0, 2), 12);
+  EXPECT_EQ(aTable.GetMinCell(), 0);
+  EXPECT_EQ(aTable.GetMaxCell(), 2);
+}
+
+TEST(PedestalTableTest, WrongCellRange) {
+  std::stringstream aStream;
+  auto write32 = [&aStream](std::int32_t value) {
+    aStream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  std::int64_t runId = 5;
+  aStream.write(reinterpret_cast<const char *>(&runId), sizeof(runId));
+  write32(1); // AGET chips
+  write32(2); // channels
+  write32(3); // time cells
+  write32(1); // first calibrated time cell
+  write32(3); // last calibrated time cell
+  write32(0); // ASAD boards
+  EXPECT_THROW(PedestalTable::Read(aStream, 3), std::runtime_error);
+}
@@ -0,0 +1,187 @@
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/Track3D.h"
+#include "TPCReco/TrackSegment3D.h"
+#include "gtest/gtest.h"
+#include <TH1F.h>
+#include <TRandom3.h>
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace {
+const std::string geometryFile =
+    std::string(TPCRECO_RESOURCE_DIR) + "geometry_ELITPC_250mbar_12.5MHz.dat";
+
+// charge profile built from TGraphErrors of TrackSegment2D projections,
+// as done before the profile caching
+TH1F referenceChargeProfile(const TrackSegment3D &aSegment) {
+  double radiusCut = 2;
+  double minProjLength = 30;
+  int nBins = 1024;
+  double length = aSegment.getLength();
+  double minX = -0.2 * length;
+  double maxX = 1.2 * length;
+  TH1F histo("hReference", "", nBins, minX, maxX);
+  histo.SetDirectory(nullptr);
+  auto aGeometryPtr = aSegment.getGeometry();
+  for (int strip_dir = definitions::projection_type::DIR_U;
+       strip_dir <= definitions::projection_type::DIR_W; ++strip_dir) {
+    TrackSegment2D aProjection =
+        aSegment.get2DProjection(strip_dir, 0, length);
+    TGraphErrors graph = aProjection.getChargeProfile(
+        aSegment.getRecHits().at(strip_dir), radiusCut);
+    double segmentAlongStrip =
+        aSegment.getTangent().Dot(
+            aGeometryPtr->GetStripPitchVector3D(strip_dir).Unit()) /
+        sin(aSegment.getTangent().Theta());
+    if (aProjection.getLength() < minProjLength ||
+        (length > 200 && std::abs(cos(aSegment.getTangent().Theta())) < 0.95 &&
+         std::abs(segmentAlongStrip) < 0.2)) {
+      continue;
+    }
+    double x, y, ex;
+    double binWidth = histo.GetBinWidth(1);
+    for (int iPoint = 0; iPoint < graph.GetN(); ++iPoint) {
+      graph.GetPoint(iPoint, x, y);
+      ex = graph.GetErrorX(iPoint);
+      int binLow = histo.FindBin((x - ex) * length);
+      int binHigh = histo.FindBin((x + ex) * length);
+      y *= binWidth / length;
+      for (int iBin = binLow; iBin <= binHigh; ++iBin) {
+        double binCoverage = 0;
+        if (iBin == binLow)
+          binCoverage = histo.GetXaxis()->GetBinUpEdge(iBin) - (x - ex) * length;
+        else if (iBin == binHigh)
+          binCoverage = (x + ex) * length - histo.GetXaxis()->GetBinLowEdge(iBin);
+        else
+          binCoverage = histo.GetBinWidth(iBin);
+        binCoverage /= histo.GetBinWidth(iBin);
+        histo.SetBinContent(iBin, histo.GetBinContent(iBin) + y * binCoverage);
+      }
+    }
+  }
+  int rebinFactor = log(4.0 * nBins / (maxX - minX)) / log(2);
+  rebinFactor = std::pow(2, rebinFactor);
+  histo.Rebin(rebinFactor);
+  histo.Scale(1.0 / histo.GetBinWidth(1));
+  double max = histo.GetMaximum();
+  if (max < 1)
+    max = 1.0;
+  histo.Scale(1.0 / max);
+  return histo;
+}
+} // namespace
+
+class TrackSegment3DTest : public ::testing::Test {
+public:
+  static std::shared_ptr<GeometryTPC> myGeometryPtr;
+
+  static void SetUpTestSuite() {
+    GeometryTPC::SetCompiledGeometryDir("");
+    myGeometryPtr = std::make_shared<GeometryTPC>(geometryFile.c_str(), false);
+  }
+  static void TearDownTestSuite() { myGeometryPtr.reset(); }
+
+  // rec-hits of a straight track, on a time-strip grid of 1 mm cells
+  TrackSegment3D makeSegment(const TVector3 &aStart, const TVector3 &aEnd,
+                             unsigned int seed) {
+    TrackSegment3D aSegment;
+    aSegment.setGeometry(myGeometryPtr);
+    TRandom3 aRndm(seed);
+    std::vector<Hit2DCollection> aRecHits(3);
+    TVector3 aStep = (aEnd - aStart).Unit() * 0.5;
+    int nSteps = (aEnd - aStart).Mag() / 0.5;
+    for (int strip_dir = definitions::projection_type::DIR_U;
+         strip_dir <= definitions::projection_type::DIR_W; ++strip_dir) {
+      TVector3 stripPitchDirection =
+          myGeometryPtr->GetStripPitchVector3D(strip_dir);
+      for (int iStep = 0; iStep <= nSteps; ++iStep) {
+        TVector3 aPoint = aStart + iStep * aStep;
+        aRecHits[strip_dir].push_back(
+            Hit2D(std::round(aPoint.Z() + aRndm.Gaus(0, 0.5)),
+                  std::round(aPoint * stripPitchDirection + aRndm.Gaus(0, 0.5)),
+                  aRndm.Uniform(10, 100)));
+      }
+    }
+    aSegment.setRecHits(aRecHits);
+    aSegment.setStartEnd(aStart, aEnd);
+    return aSegment;
+  }
+};
+
+std::shared_ptr<GeometryTPC> TrackSegment3DTest::myGeometryPtr;
+
+TEST_F(TrackSegment3DTest, ChargeProfileMatchesReference) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  TRandom3 aRndm(1);
+  for (unsigned int iTrack = 0; iTrack < 20; ++iTrack) {
+    TVector3 aStart(aRndm.Uniform(-50, 50), aRndm.Uniform(-50, 50),
+                    aRndm.Uniform(-50, 50));
+    TVector3 aDirection;
+    aRndm.Sphere(aDirection, aRndm.Uniform(20, 150));
+    auto aSegment = makeSegment(aStart, aStart + aDirection, iTrack);
+    TH1F hReference = referenceChargeProfile(aSegment);
+    TH1F hProfile = aSegment.getChargeProfile();
+    const auto &aValues = aSegment.getChargeProfileValues();
+    ASSERT_EQ(hProfile.GetNbinsX(), hReference.GetNbinsX());
+    ASSERT_EQ((int)aValues.size(), hReference.GetNbinsX());
+    for (int iBin = 1; iBin <= hReference.GetNbinsX(); ++iBin) {
+      EXPECT_NEAR(hProfile.GetBinContent(iBin), hReference.GetBinContent(iBin),
+                  1E-4)
+          << "track " << iTrack << " bin " << iBin;
+      EXPECT_NEAR(aValues[iBin - 1], hReference.GetBinContent(iBin), 1E-4);
+      EXPECT_DOUBLE_EQ(aSegment.getChargeProfileBinCenter(iBin),
+                       hReference.GetBinCenter(iBin));
+    }
+  }
+}
+
+TEST_F(TrackSegment3DTest, ChargeProfileCacheFollowsSegment) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  TVector3 aStart(-30, 10, -20), aEnd(40, -20, 30);
+  auto aSegment = makeSegment(aStart, aEnd, 1);
+  auto aProfile = aSegment.getChargeProfileValues();
+  EXPECT_EQ(&aSegment.getChargeProfileValues(),
+            &aSegment.getChargeProfileValues());
+
+  // shorter segment on the same hits
+  aSegment.setStartEnd(aStart, 0.5 * (aStart + aEnd));
+  EXPECT_NE(aSegment.getChargeProfileValues(), aProfile);
+  TH1F hReference = referenceChargeProfile(aSegment);
+  const auto &aValues = aSegment.getChargeProfileValues();
+  ASSERT_EQ((int)aValues.size(), hReference.GetNbinsX());
+  for (int iBin = 1; iBin <= hReference.GetNbinsX(); ++iBin) {
+    EXPECT_NEAR(aValues[iBin - 1], hReference.GetBinContent(iBin), 1E-4);
+  }
+
+  // no hits
+  aSegment.setRecHits(std::vector<Hit2DCollection>(3));
+  for (auto aValue : aSegment.getChargeProfileValues()) {
+    EXPECT_EQ(aValue, 0.0);
+  }
+}
+
+TEST_F(TrackSegment3DTest, ChargeAfterReattachedRecHits) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  TVector3 aStart(-30, 10, -20), aMiddle(10, -5, 0), aEnd(40, -20, 30);
+  auto aFirstSegment = makeSegment(aStart, aEnd, 1);
+  auto aSecondSegment = aFirstSegment;
+  aFirstSegment.setStartEnd(aStart, aMiddle);
+  aSecondSegment.setStartEnd(aMiddle, aEnd);
+  Track3D aTrack;
+  aTrack.addSegment(aFirstSegment);
+  aTrack.addSegment(aSecondSegment);
+  double charge = aTrack.getIntegratedCharge(aTrack.getLength());
+  double maxCharge = aTrack.getMaxCharge();
+  ASSERT_GT(charge, 0.0);
+  ASSERT_GT(maxCharge, 0.0);
+
+  // as stored by slim RecoOutput
+  auto aRecHits = aTrack.detachRecHits();
+  ASSERT_EQ(aRecHits.size(), 3U);
+  EXPECT_EQ(aTrack.getIntegratedCharge(aTrack.getLength()), 0.0);
+
+  aTrack.attachRecHits(aRecHits);
+  EXPECT_DOUBLE_EQ(aTrack.getIntegratedCharge(aTrack.getLength()), charge);
+  EXPECT_DOUBLE_EQ(aTrack.getMaxCharge(), maxCharge);
+}
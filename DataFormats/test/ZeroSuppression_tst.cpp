@@ -0,0 +1,145 @@
+#include "TPCReco/ZeroSuppression.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+using tpcreco::CellRange;
+using tpcreco::CellSample;
+using tpcreco::findZeroSuppressedRuns;
+
+TEST(ZeroSuppressionTest, NoiseOnly) {
+  std::vector<double> values(512, 2.0);
+  std::vector<CellRange> runs{{1, 2}};
+  findZeroSuppressedRuns(values, 0, 511, 10.0, 3, runs);
+  EXPECT_TRUE(runs.empty());
+}
+
+TEST(ZeroSuppressionTest, GuardBand) {
+  std::vector<double> values(512, 0.0);
+  values[100] = 50;
+  values[101] = 60;
+  values[300] = 20;
+  std::vector<CellRange> runs;
+  findZeroSuppressedRuns(values, 0, 511, 10.0, 3, runs);
+  EXPECT_EQ(runs, (std::vector<CellRange>{{97, 104}, {297, 303}}));
+}
+
+TEST(ZeroSuppressionTest, MergedRuns) {
+  std::vector<double> values(512, 0.0);
+  values[100] = 50;
+  values[107] = 50; // guard bands touch
+  values[120] = 50;
+  std::vector<CellRange> runs;
+  findZeroSuppressedRuns(values, 0, 511, 10.0, 3, runs);
+  EXPECT_EQ(runs, (std::vector<CellRange>{{97, 110}, {117, 123}}));
+}
+
+TEST(ZeroSuppressionTest, CellWindow) {
+  std::vector<double> values(512, 0.0);
+  values[3] = 50;
+  values[4] = 50;
+  values[509] = 50;
+  values[511] = 50; // outside of the window
+  std::vector<CellRange> runs;
+  findZeroSuppressedRuns(values, 2, 509, 10.0, 5, runs);
+  EXPECT_EQ(runs, (std::vector<CellRange>{{2, 9}, {504, 509}}));
+  findZeroSuppressedRuns(values, 0, 600, 10.0, 0, runs);
+  EXPECT_EQ(runs, (std::vector<CellRange>{{3, 4}, {509, 509}, {511, 511}}));
+}
+
+namespace {
+// raw samples of a channel: pedestal, noise within +-noise and the given signals
+std::vector<CellSample> makeChannel(const std::vector<double> &pedestals,
+                                    const std::vector<CellSample> &signals,
+                                    double noise) {
+  std::vector<CellSample> samples;
+  for (int cell = 0; cell < (int)pedestals.size(); ++cell) {
+    samples.push_back({cell, pedestals[cell] + noise * ((cell * 37) % 21 - 10) / 10.0});
+  }
+  for (const auto &aSignal : signals) {
+    samples[aSignal.cell].value += aSignal.value;
+  }
+  return samples;
+}
+
+std::vector<double> makePedestals() {
+  std::vector<double> pedestals(512);
+  for (int cell = 0; cell < 512; ++cell) {
+    pedestals[cell] = 250 + 20 * (cell % 7);
+  }
+  return pedestals;
+}
+
+std::vector<int> keptCells(const std::vector<CellSample> &kept) {
+  std::vector<int> cells;
+  for (const auto &aSample : kept) {
+    cells.push_back(aSample.cell);
+  }
+  return cells;
+}
+
+std::vector<int> cellRange(int first, int last) {
+  std::vector<int> cells;
+  for (int cell = first; cell <= last; ++cell) {
+    cells.push_back(cell);
+  }
+  return cells;
+}
+} // namespace
+
+TEST(ZeroSuppressionTest, ChannelGuardBand) {
+  auto pedestals = makePedestals();
+  auto samples = makeChannel(pedestals, {{150, 100}, {151, 80}, {152, 40}}, 3.0);
+  tpcreco::ZeroSuppressionBuffers buffers;
+  std::vector<CellSample> kept;
+  tpcreco::zeroSuppressChannel(samples, pedestals, 2.0, 2, 509, 4.0, 10.0, 3,
+                               buffers, kept);
+  EXPECT_EQ(keptCells(kept), cellRange(147, 155));
+  for (const auto &aSample : kept) {
+    EXPECT_DOUBLE_EQ(aSample.value,
+                     samples[aSample.cell].value - pedestals[aSample.cell]);
+  }
+}
+
+TEST(ZeroSuppressionTest, ChannelThreshold) {
+  auto pedestals = makePedestals();
+  // 15 above the pedestal, noise up to 3
+  auto samples = makeChannel(pedestals, {{300, 15}}, 3.0);
+  tpcreco::ZeroSuppressionBuffers buffers;
+  std::vector<CellSample> kept;
+  // threshold = max(4*2, 10) = 10
+  tpcreco::zeroSuppressChannel(samples, pedestals, 2.0, 2, 509, 4.0, 10.0, 2,
+                               buffers, kept);
+  EXPECT_EQ(keptCells(kept), cellRange(298, 302));
+  // threshold = max(4*5, 10) = 20
+  tpcreco::zeroSuppressChannel(samples, pedestals, 5.0, 2, 509, 4.0, 10.0, 2,
+                               buffers, kept);
+  EXPECT_TRUE(kept.empty());
+  // threshold = max(4*3, 0) = 12, noise alone stays below
+  tpcreco::zeroSuppressChannel(samples, pedestals, 3.0, 2, 509, 4.0, 0.0, 2,
+                               buffers, kept);
+  EXPECT_EQ(keptCells(kept), cellRange(298, 302));
+  // threshold = max(0*3, 0) = 0, noise is kept
+  tpcreco::zeroSuppressChannel(samples, pedestals, 3.0, 2, 509, 0.0, 0.0, 0,
+                               buffers, kept);
+  EXPECT_GT(kept.size(), 100U);
+}
+
+TEST(ZeroSuppressionTest, ChannelReadout) {
+  auto pedestals = makePedestals();
+  auto samples =
+      makeChannel(pedestals, {{3, 100}, {200, 100}, {508, 100}}, 3.0);
+  // cells absent in the readout, in any order
+  samples.erase(samples.begin() + 202);
+  samples.erase(samples.begin() + 197);
+  std::reverse(samples.begin(), samples.end());
+  tpcreco::ZeroSuppressionBuffers buffers;
+  std::vector<CellSample> kept;
+  tpcreco::zeroSuppressChannel(samples, pedestals, 2.0, 2, 509, 4.0, 10.0, 3,
+                               buffers, kept);
+  auto cells = cellRange(2, 6);
+  for (int cell : {198, 199, 200, 201, 203, 505, 506, 507, 508, 509}) {
+    cells.push_back(cell);
+  }
+  EXPECT_EQ(keptCells(kept), cells);
+}
@@ -79,7 +79,7 @@ namespace EventSourceFactory {
 			myEventSource = std::make_shared<EventSourceROOT>(geometryFileName);
 			myConfig.put("transient.eventType", event_type::EventSourceROOT);
 			EventSourceROOT* aRootEventSrc = dynamic_cast<EventSourceROOT*>(myEventSource.get());
-			aRootEventSrc->configurePedestal(myConfig.find("pedestal")->second);
+			aRootEventSrc->configurePedestal(tpcreco::config::PedestalConfig::fromConfig(myConfig));
 		}
 		else if (dataFileVec.size() == 1 && dataFileName.find("_MC_") != std::string::npos) {
 			myEventSource = std::make_shared<EventSourceMC>(geometryFileName);
@@ -103,7 +103,7 @@ namespace EventSourceFactory {
 				}
 			}
 			EventSourceGRAW* aGrawEventSrc = dynamic_cast<EventSourceGRAW*>(myEventSource.get());
-			aGrawEventSrc->configurePedestal(myConfig.find("pedestal")->second);
+			aGrawEventSrc->configurePedestal(tpcreco::config::PedestalConfig::fromConfig(myConfig));
 		}
 		else if (dataFileVec.size() == 1 && boost::filesystem::is_directory(dataFileVec[0])) {
 			myConfig.put("transient.onlineFlag", true);
@@ -117,7 +117,7 @@ namespace EventSourceFactory {
 				dynamic_cast<EventSourceGRAW*>(myEventSource.get())->setFrameLoadRange(myConfig.get<int>("input.frameLoadRange"));
 			}
 			EventSourceGRAW* aGrawEventSrc = dynamic_cast<EventSourceGRAW*>(myEventSource.get());
-			aGrawEventSrc->configurePedestal(myConfig.find("pedestal")->second);
+			aGrawEventSrc->configurePedestal(tpcreco::config::PedestalConfig::fromConfig(myConfig));
 		}
 
 #endif
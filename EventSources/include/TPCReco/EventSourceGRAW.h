@@ -4,6 +4,7 @@
 #ifdef WITH_GET
 
 #include <map>
+#include <mutex>
 #include <set>
 
 #include <get/TGrawFile.h>
@@ -13,6 +14,7 @@
 #include "TPCReco/EventSourceBase.h"
 #include "TPCReco/EventRaw.h"
 #include "TPCReco/PedestalCalculatorGRAW.h"
+#include "TPCReco/ZeroSuppression.h"
 #include <boost/property_tree/json_parser.hpp>
 
 class EventSourceGRAW: public EventSourceBase {
@@ -25,16 +27,33 @@ public:
   
   ~EventSourceGRAW();
 
+  void configurePedestal(const tpcreco::config::PedestalConfig &config);
+
+  // reads the content of the "pedestal" node
   void configurePedestal(const boost::property_tree::ptree &config);
 
   std::shared_ptr<TProfile> getPedestalProfilePerAsad(int coboId, int asadId) { return myPedestalCalculator.GetPedestalProfilePerAsad(coboId, asadId); }
 
   std::shared_ptr<TH1D> getFpnProfilePerAget(int coboId, int asadId, int agetId) { return myPedestalCalculator.GetFpnProfilePerAget(coboId, asadId, agetId); }
 
+  // Pedestal calibration mode: pedestals and FPN shapes of decoded frames are averaged
+  // over the run, also when pedestals are not subtracted. Ignored with a pedestal table loaded.
+  void setPedestalAccumulation(bool enable) { accumulatePedestals = enable; }
+
+  void resetRunPedestals() { myPedestalCalculator.ResetRunAverages(); }
+
+  PedestalTable getRunPedestalTable(long runId) const { return myPedestalCalculator.GetRunAverages(runId); }
+
+  // pedestal table in use, nullptr when pedestals are calculated per event
+  std::shared_ptr<const PedestalTable> getPedestalTable() const { return myPedestalTable; }
+
   std::shared_ptr<EventTPC> getNextEvent();
   
   std::shared_ptr<EventTPC> getPreviousEvent();
 
+  // false when getNextEvent() would reload the current event (end of file)
+  virtual bool hasNextEvent() const;
+
   std::shared_ptr<eventraw::EventRaw> getCurrentEventRaw() { return myCurrentEventRaw; }
 
   virtual unsigned long int numberOfEvents() const { return nEntries/GRAW_EVENT_FRAGMENTS;} /// BEWARE: THIS METHOD IS WRONG !!!
@@ -57,9 +76,47 @@ private:
 
 protected: // needed for EventSourceMultiGRAW
 
+  // The GET readers are not known to be thread safe and print to std::cout.
+  // All GET calls of the process are serialized by this guard; std::cout is
+  // silenced while the guard is held, unless the caller silenced it already.
+  class GrawReadGuard {
+  public:
+    GrawReadGuard();
+    ~GrawReadGuard();
+  private:
+    std::lock_guard<std::mutex> myLock;
+    bool isSilenced;
+  };
+
+  // charge of a single strip and time cell decoded from a GRAW frame
+  struct StripSample {
+    std::shared_ptr<StripTPC> strip;
+    int cell;
+    double value;
+  };
+
   void fillEventFromFrame(GET::GDataFrame & aGrawFrame);
+  // Calculates pedestals of the frame {COBO, ASAD} and decodes the frame samples
+  // without touching the current event. Frames of different {COBO, ASAD} pairs
+  // can be decoded concurrently. Returns false for frames not matching the geometry.
+  bool decodeFrame(GET::GDataFrame & aGrawFrame, std::vector<StripSample> & aSamples);
+  // buffers of decodeZeroSuppressedChannel(), reused between channels
+  struct ChannelBuffers {
+    std::vector<double> pedestals; // pedestal corrections of the channel, by time cell
+    std::vector<tpcreco::CellSample> samples, kept;
+    tpcreco::ZeroSuppressionBuffers zeroSuppression;
+  };
+  // Keeps only the samples of a channel above the zero suppression threshold,
+  // with guard cells, see tpcreco::zeroSuppressChannel().
+  void decodeZeroSuppressedChannel(GET::GDataChannel & aChannel, const std::shared_ptr<StripTPC> & aStrip,
+				   int COBO_idx, int ASAD_idx, int agetId, int chanId,
+				   ChannelBuffers & aBuffers, std::vector<StripSample> & aSamples);
+  void addSamples(const std::vector<StripSample> & aSamples);
+  void reportSkippedFrame(const GET::GDataFrame & aGrawFrame) const;
   void fillEventRawFromFrame(GET::GDataFrame & aGrawFrame);
   void checkEntryForFragments(unsigned int iEntry);
+  // picks the table for the data run from the pedestal database, if any
+  void selectPedestalTable(const std::string & dataFileName);
 
 private:
 
@@ -73,6 +130,7 @@ protected: // needed for EventSourceMultiGRAW
   Graw2DataFrame myFrameLoader;
   GET::GDataFrame myDataFrame;
   std::shared_ptr<eventraw::EventRaw> myCurrentEventRaw{std::make_shared<eventraw::EventRaw>()};
+  std::vector<GET::GDataChannel*> myRawChannelBuffer; //! transient data member, reused between frames
 
 private:
 
@@ -86,6 +144,17 @@ private:
 protected: // needed for EventSourceMultiGRAW
 
   bool removePedestal{true};
+  bool accumulatePedestals{false};
+  struct {
+    bool enable{false};
+    double nSigma{4.0};
+    double threshold{0.0};
+    int guardCells{3};
+  } zeroSuppression;
+  std::shared_ptr<PedestalDatabase> myPedestalDatabase;
+  std::shared_ptr<const PedestalTable> myPedestalTable;
+  boost::optional<long> myPedestalRunId;
+  std::string myPedestalDataFile; // file used to find the run id of data
 
 private:
   unsigned long int startingEventIndex{0};
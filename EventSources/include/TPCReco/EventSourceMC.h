@@ -38,6 +38,9 @@ public:
 
   pid_type getGeneratedEventType() const {return myGenEventType;}
 
+  ///fixed seed gives reproducible event sequence, 0 means random seed
+  void setRandomSeed(unsigned int aSeed) {myRndm.SetSeed(aSeed);}
+
   unsigned long int numberOfEvents() const;
 
   void loadGeometry(const std::string & fileName);
@@ -45,6 +48,7 @@ public:
  private:
 
   TGraph* braggGraph_alpha, *braggGraph_12C;
+  std::shared_ptr<const IonRangeCalculator::LookupTable> braggTable_alpha, braggTable_12C; // for fast Eval()
   double braggGraph_alpha_energy, braggGraph_12C_energy;
   double keVToChargeScale{1.0};
 
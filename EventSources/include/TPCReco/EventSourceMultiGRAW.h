@@ -4,6 +4,7 @@
 #ifdef WITH_GET
 
 #include <map>
+#include <memory>
 #include <set>
 
 #include <get/TGrawFile.h>
@@ -30,6 +31,8 @@ public:
   
   std::shared_ptr<EventTPC> getPreviousEvent(); // OVERLOADED
 
+  bool hasNextEvent() const; // OVERLOADED
+
   unsigned long int numberOfEvents() const { return nEntries; } // the lowest number of frames among all GRAW_EVENT_FRAGMENTS files
 
   void loadDataFile(const std::string & commaSeparatedFileNames); // OVERLOADED to accept list of comma separated files (one file per ASAD)
@@ -41,10 +44,14 @@ public:
   void loadEventId(unsigned long int eventIdx); // OVERLOADED
   
   unsigned int getMaxNumberOfStreams() { return GRAW_EVENT_FRAGMENTS; }
+
+  // frames of different streams are decoded in parallel threads (default), the result does not depend on it
+  void setParallelDecoding(bool enable) { parallelDecoding = enable; }
   
 private:
 
   bool loadGrawFrame(unsigned int iEntry, bool readFullEvent, unsigned int streamIndex); // OVERLOADED
+  bool readStreamFrame(unsigned int iEntry, unsigned int streamIndex, std::string & filePath); // NEW, full frame into myStreamFrameList[streamIndex], GET calls serialized
   void collectEventFragments(unsigned int eventIdx); // OVERLOADED
   void checkEntryForFragments(unsigned int iEntry, unsigned int streamIndex); // OVERLOADED
   std::string getNextFilePath(unsigned int streamIndex); // OVERLOADED
@@ -55,6 +62,9 @@ private:
   std::vector<std::map<unsigned int, unsigned int> > myAsadMapList; // NEW [streamIndex, eventId, AsadId]
   std::vector<std::map<unsigned int, unsigned int> > myCoboMapList; // NEW [streamIndex, eventId, CoboId]
   std::vector<std::set<unsigned int> > myReadEntriesSetList; // NEW [streamIndex, {iEntry, iEntry, ...}]
+  std::vector<std::unique_ptr<GET::GDataFrame> > myStreamFrameList; // NEW [streamIndex], frames decoded in parallel
+  std::vector<std::unique_ptr<Graw2DataFrame> > myStreamLoaderList; // NEW [streamIndex], frame loader of each stream
+  bool parallelDecoding{true};
   
   unsigned int frameLoadRange{1}; // OVERLOADED
 
@@ -4,6 +4,7 @@
 #include "TPCReco/EventSourceBase.h"
 #include "TPCReco/EventRaw.h"
 #include "TPCReco/PedestalCalculator.h"
+#include "TPCReco/EventIndex.h"
 #include <boost/property_tree/json_parser.hpp>
 
 class TFile;
@@ -35,6 +36,9 @@ public:
 
   void setRemovePedestal(bool aFlag);
 
+  void configurePedestal(const tpcreco::config::PedestalConfig &config);
+
+  // reads the content of the "pedestal" node
   void configurePedestal(const boost::property_tree::ptree &config);
 
   void loadGeometry(const std::string & fileName);
@@ -49,6 +53,7 @@ public:
   std::string treeName;
   std::shared_ptr<TFile> myFile;
   std::shared_ptr<TTree> myTree;
+  tpcreco::utilities::EventIndex myEventIndex; // {runId, eventId} -> entry
   bool removePedestal{true};
 
   PedestalCalculator myPedestalCalculator;  
@@ -6,6 +6,8 @@
 
 #include <cstdlib>
 #include <cstddef> // for: NULL
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <map>
 
@@ -30,7 +32,9 @@ class UVWprojector {
   // Setter methods 
   
   UVWprojector(std::shared_ptr<GeometryTPC> geo, int n=100, int nx=25, int ny=25);
-  void SetAreaNpoints(int n); // change number of points used for random probing of TH2Poly bins
+  void SetAreaNpoints(int n); // obsolete: area mapping is exact, kept for backward compatibility
+  void SetAreaCacheDir(const std::string &dir); // directory for cached area mappings, empty = no caching (default: $TPCRECO_CACHE_DIR, if set)
+  void SetNthreads(unsigned int n); // number of threads used for area mapping, 0 = all available cores
   void SetEvent3D(TH3D &h3); // 3D ionization map: (x [mm], y [mm], z [mm], Q [arb.u.])
   void SetEvent2D(TH2D &h2); // 2D ionization map: (x [mm], y [mm], Q [arb.u.])
   inline void SetDebug(bool flag) { _debug = flag; }
@@ -53,6 +57,9 @@ class UVWprojector {
   // Setter methods
 
   bool InitAreaMapping();
+  uint64_t GetAreaMappingKey(); // hash of TH2Poly strip polygons and XY binning of the input histogram
+  bool ReadAreaMapping(const std::string &fname, uint64_t key);
+  void WriteAreaMapping(const std::string &fname, uint64_t key);
   bool InitTimeMapping();
   virtual void AddBinContent(Int_t bin, Double_t val);
   virtual void SetBinContent(Int_t bin, Double_t val);
@@ -64,6 +71,8 @@ class UVWprojector {
   bool CheckBinsZ(TH3D *h1, TH3D *h2);
   
   int area_npoints;
+  std::string area_cache_dir;
+  unsigned int area_nthreads;
   bool isOK_AreaMapping;
   bool isOK_TimeMapping;
   std::shared_ptr<GeometryTPC> geo_ptr; // pointer to the existing TPC geometry
@@ -72,6 +81,19 @@ class UVWprojector {
   
   std::map<MultiKey2 /* TH2 bin index [1..NX*NY] */, BinFracMap> fAreaFractionMap;
   std::map<int /* TH1 bin index [1..NX] */, BinFracMap> fTimeFractionMap; 
+
+  // Compressed sparse row (CSR) copies of fAreaFractionMap and fTimeFractionMap used by fillPEventTPC(),
+  // rebuilt after any change of the area or time mapping
+  bool InitProjectionMatrix();
+  bool isOK_ProjectionMatrix;
+  int proj_nybins; // number of Y bins used for XY row index = IX*NY+IY
+  std::vector<std::shared_ptr<StripTPC> > fProjStrips; // strips of mapped TH2Poly bins
+  std::vector<int> fAreaRowStart, fAreaStrip; // XY row -> index in fProjStrips
+  std::vector<double> fAreaWeight;
+  std::vector<int> fTimeRowStart, fTimeCell;  // Z-slice -> time cell
+  std::vector<double> fTimeWeight;
+  std::vector<double> fStripTimeBuffer; // dense [strip index][time cell] accumulator
+  std::vector<int> fStripTimeTouched;   // non-empty cells of fStripTimeBuffer
   
  private: 
   bool _debug;
@@ -4,6 +4,7 @@
 
 #include "TPCReco/colorText.h"
 #include "TPCReco/EventSourceBase.h"
+#include "TPCReco/PerfMonitor.h"
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 EventSourceBase::EventSourceBase() {
@@ -116,6 +117,7 @@ std::shared_ptr<EventTPC> EventSourceBase::getPreviousEventLoop(){
 /////////////////////////////////////////////////////////
 void EventSourceBase::fillEventTPC(){
 
+  TPCRECO_TIME_SCOPE("EventSource::fillEventTPC");
   myCurrentEvent->Clear();
   myCurrentEvent->SetGeoPtr(myGeometryPtr);
   myCurrentEvent->SetChargeMap(myCurrentPEvent->GetChargeMap());
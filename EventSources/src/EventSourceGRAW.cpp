@@ -6,7 +6,11 @@
 #include <iomanip>
 #include <iterator>
 #include <map>
+#include <array>
+#include <algorithm>
 #include <cstdint>
+#include <mutex>
+#include <stdexcept>
 
 #include <TCollection.h>
 #include <TClonesArray.h>
@@ -14,9 +18,28 @@
 
 #include "TPCReco/EventSourceGRAW.h"
 #include "TPCReco/RunIdParser.h"
+#include "TPCReco/ZeroSuppression.h"
+#include "TPCReco/PerfMonitor.h"
 #include "TPCReco/colorText.h"
 
 #include <get/graw2dataframe.h>
+namespace {
+  std::mutex grawReadMutex;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+EventSourceGRAW::GrawReadGuard::GrawReadGuard() : myLock(grawReadMutex) {
+
+  // only read here: the caller may silence std::cout for a parallel section
+  isSilenced = !std::cout.fail();
+  if(isSilenced) std::cout.setstate(std::ios_base::failbit);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+EventSourceGRAW::GrawReadGuard::~GrawReadGuard() {
+
+  if(isSilenced) std::cout.clear();
+}
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 EventSourceGRAW::EventSourceGRAW(const std::string & geometryFileName) {
@@ -26,6 +49,7 @@ EventSourceGRAW::EventSourceGRAW(const std::string & geometryFileName) {
   myPedestalCalculator.SetGeometryAndInitialize(myGeometryPtr);
 
   std::string formatsFilePath = "./CoboFormats.xcfg";
+  GrawReadGuard aGuard;
   myFrameLoader.initialize(formatsFilePath);
 }
 /////////////////////////////////////////////////////////
@@ -44,6 +68,15 @@ std::shared_ptr<EventTPC> EventSourceGRAW::getNextEvent(){
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+bool EventSourceGRAW::hasNextEvent() const{
+
+  auto currentEventId = myCurrentEvent->GetEventInfo().GetEventId();
+  auto it = myFramesMap.find(currentEventId);
+  if(it==myFramesMap.end() || it->second.empty()) return false;
+  return *it->second.rbegin()<nEntries-1;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 std::shared_ptr<EventTPC> EventSourceGRAW::getPreviousEvent(){
 
   auto currentEventId = myCurrentEvent->GetEventInfo().GetEventId();
@@ -59,12 +92,15 @@ void EventSourceGRAW::loadDataFile(const std::string & fileName){
 
   EventSourceBase::loadDataFile(fileName);
 
-  myFile =  std::make_shared<TGrawFile>(fileName.c_str());
+  {
+    GrawReadGuard aGuard;
+    myFile =  std::make_shared<TGrawFile>(fileName.c_str());
+    if(myFile) nEntries = myFile->GetGrawFramesNumber();
+  }
   if(!myFile){
     std::cerr<<KRED<<"Can not open file: "<<fileName<<"!"<<RST<<std::endl;
     exit(1);
   }
-  nEntries = myFile->GetGrawFramesNumber();
   
   const int firstEventSize=10;
   if(fileName!=myFilePath || nEntries<firstEventSize){
@@ -77,20 +113,24 @@ void EventSourceGRAW::loadDataFile(const std::string & fileName){
   myASADMap.clear();
   myReadEntriesSet.clear();
   isFullFileScanned = false;
+  selectPedestalTable(fileName);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 bool EventSourceGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent){
 
+  TPCRECO_TIME_SCOPE("EventSourceGRAW::loadGrawFrame");
   std::string tmpFilePath = myFilePath;
 #ifndef EVENTSOURCEGRAW_NEXT_FILE_DISABLE  
   if(iEntry>=nEntries){
     tmpFilePath = myNextFilePath;
     iEntry -= nEntries;
   }
-  std::cout.setstate(std::ios_base::failbit);
-  bool dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrame, readFullEvent);///FIXME getGrawFrame counts frames from 1 (WRRR!)
-  std::cout.clear();
+  bool dataFrameRead = false;
+  {
+    GrawReadGuard aGuard;
+    dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrame, readFullEvent);///FIXME getGrawFrame counts frames from 1 (WRRR!)
+  }
 
   if(!dataFrameRead){
     std::cerr <<KRED<<std::endl<<"ERROR: cannot read file entry: " <<RST<<iEntry<<std::endl
@@ -107,9 +147,8 @@ bool EventSourceGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent){
 #else
   bool dataFrameRead = false;
   if(iEntry<nEntries) {
-    std::cout.setstate(std::ios_base::failbit);
+    GrawReadGuard aGuard;
     dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrame, readFullEvent);///FIXME getGrawFrame counts frames from 1 (WRRR!)
-    std::cout.clear();
   }
     
   if(!dataFrameRead){
@@ -150,6 +189,7 @@ void EventSourceGRAW::loadEventId(unsigned long int eventId){
 /////////////////////////////////////////////////////////
 void EventSourceGRAW::loadFileEntry(unsigned long int iEntry){
 
+  TPCRECO_TIME_SCOPE("EventSourceGRAW::loadFileEntry");
   myCurrentEntry = iEntry;
   loadGrawFrame(iEntry, false);
   
@@ -283,26 +323,50 @@ void EventSourceGRAW::collectEventFragments(unsigned int eventId){
 /////////////////////////////////////////////////////////
 void EventSourceGRAW::fillEventFromFrame(GET::GDataFrame & aGrawFrame){
 
-  if(removePedestal) myPedestalCalculator.CalculateEventPedestals(aGrawFrame);
+  TPCRECO_TIME_SCOPE("EventSourceGRAW::fillEventFromFrame");
   myCurrentEventInfo.SetPedestalSubtracted(removePedestal);
+  std::vector<StripSample> aSamples;
+  if(!decodeFrame(aGrawFrame, aSamples)){
+    reportSkippedFrame(aGrawFrame);
+    return;
+  }
+  addSamples(aSamples);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+bool EventSourceGRAW::decodeFrame(GET::GDataFrame & aGrawFrame, std::vector<StripSample> & aSamples){
 
+  TPCRECO_TIME_SCOPE("EventSourceGRAW::decodeFrame");
   int  COBO_idx = aGrawFrame.fHeader.fCoboIdx;
   int  ASAD_idx = aGrawFrame.fHeader.fAsadIdx;
+  if(ASAD_idx >= myGeometryPtr->GetAsadNboards()) return false;
 
-  if(ASAD_idx >= myGeometryPtr->GetAsadNboards()){
-    std::cout<<KRED<<__FUNCTION__
-	     <<": Data format mismatch! ASAD="<<ASAD_idx
-	     <<", number of ASAD boards in geometry="<<myGeometryPtr->GetAsadNboards()
-	     <<". Frame skipped."
-	     <<RST<<std::endl;
-    return;
+  // with a pedestal table loaded the corrections are fixed for the run
+  if((removePedestal || accumulatePedestals) && !myPedestalCalculator.HasPedestalTable()){
+    TPCRECO_TIME_SCOPE("PedestalCalculatorGRAW::CalculateEventPedestals");
+    myPedestalCalculator.CalculateEventPedestals(aGrawFrame);
+    if(accumulatePedestals) myPedestalCalculator.AddToRunAverages(COBO_idx, ASAD_idx);
   }
-  
+
+  // zero suppression needs pedestal subtracted samples of the whole channel,
+  // buffers are local, frames can be decoded concurrently
+  bool suppressZeros = zeroSuppression.enable && removePedestal;
+  ChannelBuffers aBuffers;
+  if(suppressZeros) aBuffers.pedestals.resize(myGeometryPtr->GetAgetNtimecells());
+
   for (Int_t agetId = 0; agetId < myGeometryPtr->GetAgetNchips(); ++agetId){
     for (Int_t chanId = 0; chanId < myGeometryPtr->GetAgetNchannels(); ++chanId){
       GET::GDataChannel* channel = aGrawFrame.SearchChannel(agetId, myGeometryPtr->Aget_normal2raw(chanId));
       if (!channel) continue;
-	  
+      std::shared_ptr<StripTPC> aStrip(myGeometryPtr->GetStripByAget(COBO_idx, ASAD_idx, agetId, chanId));
+      if (!aStrip) continue;
+
+      if(suppressZeros){
+	decodeZeroSuppressedChannel(*channel, aStrip, COBO_idx, ASAD_idx, agetId, chanId,
+				    aBuffers, aSamples);
+	continue;
+      }
+
       for (Int_t i = 0; i < channel->fNsamples; ++i){
 	GET::GDataSample* sample = (GET::GDataSample*) channel->fSamples.At(i);
 	// skip cells outside signal time-window
@@ -316,15 +380,60 @@ void EventSourceGRAW::fillEventFromFrame(GET::GDataFrame & aGrawFrame){
 	if(removePedestal){
 	  corrVal -= myPedestalCalculator.GetPedestalCorrection(COBO_idx, ASAD_idx, agetId, chanId, icell);
 	}
-	std::shared_ptr<StripTPC> aStrip(myGeometryPtr->GetStripByAget(COBO_idx, ASAD_idx, agetId, chanId));
-	if(aStrip) myCurrentPEvent->AddValByStrip(aStrip, icell, corrVal);
+	aSamples.push_back({aStrip, icell, corrVal});
       }
     }
   }
+  return true;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAW::decodeZeroSuppressedChannel(GET::GDataChannel & aChannel,
+						  const std::shared_ptr<StripTPC> & aStrip,
+						  int COBO_idx, int ASAD_idx, int agetId, int chanId,
+						  ChannelBuffers & aBuffers,
+						  std::vector<StripSample> & aSamples){
+
+  int minCell = myPedestalCalculator.GetFirstSignalCell();
+  int maxCell = myPedestalCalculator.GetLastSignalCell();
+  aBuffers.samples.clear();
+  for (Int_t i = 0; i < aChannel.fNsamples; ++i){
+    GET::GDataSample* sample = (GET::GDataSample*) aChannel.fSamples.At(i);
+    Int_t icell = sample->fBuckIdx;
+    if(icell<minCell || icell>maxCell || icell>=(Int_t)aBuffers.pedestals.size()) continue;
+    aBuffers.pedestals[icell] = myPedestalCalculator.GetPedestalCorrection(COBO_idx, ASAD_idx, agetId, chanId, icell);
+    aBuffers.samples.push_back({icell, (double)sample->fValue});
+  }
+
+  tpcreco::zeroSuppressChannel(aBuffers.samples, aBuffers.pedestals,
+			       myPedestalCalculator.GetPedestalRMS(COBO_idx, ASAD_idx, agetId, chanId),
+			       minCell, maxCell, zeroSuppression.nSigma, zeroSuppression.threshold,
+			       zeroSuppression.guardCells, aBuffers.zeroSuppression, aBuffers.kept);
+  for(const auto & aSample: aBuffers.kept){
+    aSamples.push_back({aStrip, aSample.cell, aSample.value});
+  }
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAW::addSamples(const std::vector<StripSample> & aSamples){
+
+  for(const auto & aSample: aSamples){
+    myCurrentPEvent->AddValByStrip(aSample.strip, aSample.cell, aSample.value);
+  }
   myCurrentPEvent->SetEventInfo(myCurrentEventInfo);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void EventSourceGRAW::reportSkippedFrame(const GET::GDataFrame & aGrawFrame) const{
+
+  std::cout<<KRED<<__FUNCTION__
+	   <<": Data format mismatch! ASAD="<<(int)aGrawFrame.fHeader.fAsadIdx
+	   <<", number of ASAD boards in geometry="<<myGeometryPtr->GetAsadNboards()
+	   <<". Frame skipped."
+	   <<RST<<std::endl;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 void EventSourceGRAW::fillEventRawFromFrame(GET::GDataFrame & aGrawFrame){
 
   // fills raw data container class per: COBO, ASAD, AGET, CHANNEL_RAW, TIME_CELL 
@@ -346,75 +455,67 @@ void EventSourceGRAW::fillEventRawFromFrame(GET::GDataFrame & aGrawFrame){
   }
 
   // reset EventRaw.channelData for given {COBO, ASAD} pair
-  eventraw::AgetRawMap_t::iterator a_it;
-  for(a_it=(myCurrentEventRaw->data).begin(); a_it!=(myCurrentEventRaw->data).end(); a_it++) {
-    MultiKey2 aKey(COBO_idx, ASAD_idx);
-    if(std::get<0>(a_it->first)==COBO_idx &&
-       std::get<1>(a_it->first)==ASAD_idx) (a_it->second).channelData.resize(0);
+  // ChannelRaw elements are overwritten in place to keep the capacity of their vectors
+  std::array<std::size_t, 256> nChannelsPerAget{};
+  for(auto & item: myCurrentEventRaw->data){
+    if(std::get<0>(item.first)==COBO_idx &&
+       std::get<1>(item.first)==ASAD_idx) std::fill((item.second).channelMask.begin(), (item.second).channelMask.end(), 0u);
   }
-  
-  // temporary map of AGET channels
-  std::map< MultiKey2, eventraw::ChannelRaw> map2; // index={agetIdx[0-3], channelIdx[0-67]}, val=ChannelRaw
-  std::map< MultiKey2, eventraw::ChannelRaw>::iterator map2_it;
 
+  // AGET channels sorted by {agetIdx[0-3], channelIdx[0-67]}
+  myRawChannelBuffer.clear();
   TClonesArray* channels = aGrawFrame.GetChannels();
   GET::GDataChannel* channel = 0;
   TIter iter(channels->begin());
   while ((channel = (GET::GDataChannel*) iter.Next())) {
-    
-    if (!channel) continue;	  
+    if (!channel) continue;
+    myRawChannelBuffer.push_back(channel);
+  }
+  auto channelKey = [](const GET::GDataChannel *aChannel){
+    return std::make_pair((uint8_t)aChannel->fAgetIdx, (uint8_t)aChannel->fChanIdx);
+  };
+  std::stable_sort(myRawChannelBuffer.begin(), myRawChannelBuffer.end(),
+		   [&channelKey](const GET::GDataChannel *a, const GET::GDataChannel *b){ return channelKey(a)<channelKey(b); });
+
+  std::array<uint16_t, 512> cellValues{}; // index=cell[0-511], val=value[0-4096]
+  eventraw::AgetRawMap_t::iterator a_it = (myCurrentEventRaw->data).end();
+  for(auto ch_it=myRawChannelBuffer.begin(); ch_it!=myRawChannelBuffer.end(); ++ch_it){
+
+    channel = *ch_it;
+    // the first channel of duplicates is used
+    if(ch_it!=myRawChannelBuffer.begin() && channelKey(*std::prev(ch_it))==channelKey(channel)) continue;
     uint8_t AGET_idx = (uint8_t)channel->fAgetIdx;
     uint8_t CHAN_idx = (uint8_t)channel->fChanIdx;
+    MultiKey3_uint8 mkey(COBO_idx, ASAD_idx, AGET_idx);
 
-    // temporary map of samples per channel
-    static std::map< uint16_t, uint16_t> map1; // index=cell[0-511], val=value[0-4096] 
-    static std::map< uint16_t, uint16_t>::iterator map1_it;
-    map1.clear();
-
+    // add new AGET to map if necessary
+    if(a_it==(myCurrentEventRaw->data).end() || std::get<2>(a_it->first)!=AGET_idx){
+      a_it=(myCurrentEventRaw->data).find(mkey);
+      if(a_it==(myCurrentEventRaw->data).end()) {
+	eventraw::AgetRaw a;
+	a_it=std::get<0>((myCurrentEventRaw->data).insert( std::pair< MultiKey3_uint8, eventraw::AgetRaw >(mkey, a)));
+      }
+    }
+    auto & aAget = a_it->second;
+    auto & nChannels = nChannelsPerAget[AGET_idx];
+    if(nChannels==aAget.channelData.size()) aAget.channelData.emplace_back();
+    eventraw::ChannelRaw & c = aAget.channelData[nChannels++];
+    std::fill(c.cellMask.begin(), c.cellMask.end(), 0u);
+    c.cellData.clear();
+
+    // samples per channel, the last sample of a given cell is used
     for (int i = 0; i < channel->fNsamples; ++i){
       GET::GDataSample* sample = (GET::GDataSample*) channel->fSamples.At(i);
       uint16_t icell = (uint16_t) sample->fBuckIdx;
-      uint16_t rawVal = (uint16_t) sample->fValue;
-      map1[icell] = rawVal;      
-    }
-
-    // filling ChannelRaw from temporary CHANNEL map
-    // NOTE: map1 is sorted by KEY=cell[0-511]
-    eventraw::ChannelRaw c;
-    for(map1_it=map1.begin(); map1_it!=map1.end(); map1_it++) {
-      c.cellMask[ map1_it->first/8 ] |= (1 << (map1_it->first % 8)); // update bit mask
-      c.cellData.push_back(map1_it->second); // correct order should be preserved for map1 sorted by KEY
-
-      //#ifdef DEBUG
-      //// DEBUG
-      //      std::cout << __FUNCTION__
-      //      		<< ": Adding sample point: coboIdx=" << (int)COBO_idx << ", asadIdx=" << (int)ASAD_idx << ", agetIdx=" << (int)AGET_idx << ", chanIdx=" << (int)CHAN_idx << ", cellIdx=" << map1_it->first << std::endl;
-      //// DEBUG
-      //#endif
+      if(icell>=cellValues.size()) continue;
+      c.cellMask[ icell/8 ] |= (1 << (icell % 8)); // update bit mask
+      cellValues[icell] = (uint16_t) sample->fValue;
     }
-
-    // adding ChannelRaw to temporary AGET map
-    MultiKey2 mkey(AGET_idx, CHAN_idx);
-    map2.insert( std::pair< MultiKey2, eventraw::ChannelRaw >( mkey, c ) );
-    //[mkey]=c;
-  };
-  
-  // filling AgetRaw from temporary AGET map
-  // NOTE: map2 is sorted by KEY={aget[0-3], chan[0-67]}
-  for(map2_it=map2.begin(); map2_it!=map2.end(); map2_it++) {
-
-    uint8_t AGET_idx = std::get<0>(map2_it->first);
-    uint8_t CHAN_idx = std::get<1>(map2_it->first);
-    MultiKey3_uint8 mkey(COBO_idx, ASAD_idx, AGET_idx);
-
-    // add new AGET to map if necessary
-    if( (a_it=(myCurrentEventRaw->data).find(mkey))==(myCurrentEventRaw->data).end()) {
-      eventraw::AgetRaw a;
-      a_it=std::get<0>((myCurrentEventRaw->data).insert( std::pair< MultiKey3_uint8, eventraw::AgetRaw >(mkey, a)));
+    // filling ChannelRaw in the order of cells
+    for(uint16_t icell=0; icell<cellValues.size(); ++icell) {
+      if(c.cellMask[ icell/8 ] & (1 << (icell % 8))) c.cellData.push_back(cellValues[icell]);
     }
-    // fill data for already existing AGET
-    (a_it->second).channelMask[ CHAN_idx/8 ] |= (1 << (CHAN_idx % 8)); // update bit mask
-    (a_it->second).channelData.push_back(map2_it->second); // correct order should be preserved for map2 sorted by KEY
+    aAget.channelMask[ CHAN_idx/8 ] |= (1 << (CHAN_idx % 8)); // update bit mask
 
 #ifdef DEBUG
     //// DEBUG
@@ -423,7 +524,12 @@ void EventSourceGRAW::fillEventRawFromFrame(GET::GDataFrame & aGrawFrame){
     //// DEBUG
 #endif
   }
-  
+
+  // drop channels left from the previous event
+  for(auto & item: myCurrentEventRaw->data){
+    if(std::get<0>(item.first)==COBO_idx &&
+       std::get<1>(item.first)==ASAD_idx) (item.second).channelData.resize(nChannelsPerAget[std::get<2>(item.first)]);
+  }
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -433,6 +539,7 @@ void EventSourceGRAW::findStartingIndex(unsigned long int size){
   } else {
     auto preloadSize=std::min(nEntries,size);
     startingEventIndex=std::numeric_limits<UInt_t>::max();
+    GrawReadGuard aGuard;
     for(unsigned long int i=0; i<preloadSize; ++i){
       myFile->GetGrawFrame(myDataFrame,i);
       startingEventIndex=std::min(startingEventIndex, static_cast<unsigned long int>(myDataFrame.fHeader.fEventIdx));
@@ -441,19 +548,65 @@ void EventSourceGRAW::findStartingIndex(unsigned long int size){
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void EventSourceGRAW::configurePedestal(const tpcreco::config::PedestalConfig &config){
+
+  removePedestal = config.remove;
+
+  myPedestalCalculator.SetMinPedestalCell(config.minPedestalCell);
+  myPedestalCalculator.SetMaxPedestalCell(config.maxPedestalCell);
+  myPedestalCalculator.SetMinSignalCell(config.minSignalCell);
+  myPedestalCalculator.SetMaxSignalCell(config.maxSignalCell);
+
+  zeroSuppression.enable = config.zeroSuppression;
+  zeroSuppression.nSigma = config.zeroSuppressionNSigma;
+  zeroSuppression.threshold = config.zeroSuppressionThreshold;
+  zeroSuppression.guardCells = config.zeroSuppressionGuardCells;
+  if(zeroSuppression.enable && !removePedestal){
+    std::cout<<KRED<<__FUNCTION__<<": Zero suppression requires pedestal removal, it is disabled."<<RST<<std::endl;
+  }
+
+  myPedestalRunId = config.runId;
+  myPedestalTable.reset();
+  myPedestalCalculator.ClearPedestalTable();
+  myPedestalDatabase.reset();
+  if(!config.database.empty()){
+    myPedestalDatabase = std::make_shared<PedestalDatabase>();
+    myPedestalDatabase->Load(config.database);
+    std::cout<<__FUNCTION__<<": Loaded "<<myPedestalDatabase->size()
+	     <<" pedestal table(s) from: "<<config.database<<std::endl;
+  }
+  selectPedestalTable(myPedestalDataFile);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventSourceGRAW::selectPedestalTable(const std::string & dataFileName){
+
+  myPedestalDataFile = dataFileName;
+  if(!myPedestalDatabase || !removePedestal) return;
+
+  std::shared_ptr<const PedestalTable> aTable;
+  if(myPedestalRunId) {
+    aTable = myPedestalDatabase->Find(*myPedestalRunId);
+  }
+  else if(!dataFileName.empty()) {
+    aTable = myPedestalDatabase->FindLatest(RunIdParser(dataFileName).runId());
+  }
+  else return; // data run is not known yet
+  if(!aTable) {
+    throw std::runtime_error("EventSourceGRAW: no pedestal table for data file "+dataFileName);
+  }
+  if(aTable==myPedestalTable) return;
+  myPedestalCalculator.LoadPedestalTable(*aTable);
+  myPedestalTable = aTable;
+  std::cout<<__FUNCTION__<<": Using pedestals of run "<<aTable->GetRunId()<<std::endl;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 void EventSourceGRAW::configurePedestal(const boost::property_tree::ptree &config){
-  auto parser=[this, &config](std::string &&parameter, void (PedestalCalculator::*setter)(int)){
-    if(config.find(parameter)!=config.not_found()){
-      (this->myPedestalCalculator.*setter)(config.get<int>(parameter));
-    }
-  };
-  
-  removePedestal = config.get<bool>("remove");
-  
-  parser("minPedestalCell", &PedestalCalculator::SetMinPedestalCell);
-  parser("maxPedestalCell", &PedestalCalculator::SetMaxPedestalCell);
-  parser("minSignalCell", &PedestalCalculator::SetMinSignalCell);
-  parser("maxSignalCell", &PedestalCalculator::SetMaxSignalCell);
+
+  boost::property_tree::ptree aConfig;
+  aConfig.put_child("pedestal", config);
+  configurePedestal(tpcreco::config::PedestalConfig::fromConfig(aConfig));
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
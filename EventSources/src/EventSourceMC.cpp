@@ -2,6 +2,7 @@
 
 #include "TPCReco/colorText.h"
 #include "TPCReco/EventSourceMC.h"
+#include "TPCReco/PerfMonitor.h"
 
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -13,8 +14,11 @@ EventSourceMC::EventSourceMC(const std::string & geometryFileName) {
   double xmin=-150,  ymin=-100, zmin=-100;
   double xmax=150,  ymax=100,  zmax=100;
 
-  braggGraph_alpha = new TGraph("dEdx_corr_alpha_10MeV_CO2_250mbar.dat", "%lg %lg");
-  braggGraph_12C = new TGraph("dEdx_corr_12C_5MeV_CO2_250mbar.dat", "%lg %lg");
+  std::string resources(TPCRECO_RESOURCE_DIR);
+  braggGraph_alpha = new TGraph((resources+"dEdx_corr_alpha_10MeV_CO2_250mbar.dat").c_str(), "%lg %lg");
+  braggGraph_12C = new TGraph((resources+"dEdx_corr_12C_5MeV_CO2_250mbar.dat").c_str(), "%lg %lg");
+  braggTable_alpha = std::make_shared<const IonRangeCalculator::LookupTable>(*braggGraph_alpha);
+  braggTable_12C = std::make_shared<const IonRangeCalculator::LookupTable>(*braggGraph_12C);
   double nominalPressure = 250.0; //[mbar]
   braggGraph_alpha_energy = 10; // [MeV]
   braggGraph_12C_energy = 5; // [MeV]
@@ -40,6 +44,7 @@ void EventSourceMC::loadDataFile(const std::string & fileName){ }
 /////////////////////////////////////////////////////////
 void EventSourceMC::loadFileEntry(unsigned long int iEntry){
 
+  TPCRECO_TIME_SCOPE("EventSourceMC::loadFileEntry");
   generateEvent();
   myCurrentEntry = iEntry;
   
@@ -152,16 +157,16 @@ TrackSegment3D EventSourceMC::createSegment(const TVector3 vertexPos, pid_type i
 TH1F EventSourceMC::createChargeProfile(double ion_range, pid_type ion_id) const{
   
   double dEdx_max_energy =0.0, graph_range = 0.0;
-  TGraph *dEdx_graph=0;
+  const IonRangeCalculator::LookupTable *dEdx_graph=0;
   
   if(ion_id==pid_type::ALPHA){
     dEdx_max_energy = braggGraph_alpha_energy;
-    dEdx_graph=braggGraph_alpha;
+    dEdx_graph=braggTable_alpha.get();
     graph_range = 299;
   }
     else if(ion_id==pid_type::CARBON_12){
       dEdx_max_energy = braggGraph_12C_energy;
-      dEdx_graph = braggGraph_12C;
+      dEdx_graph = braggTable_12C.get();
       graph_range = 23.5;
     }
   
@@ -244,7 +249,7 @@ void EventSourceMC::fillPEventTPC(const TH3D & h3DChargeCloud, const Track3D & a
       smearedPosition = TVector3(myRndm.Gaus(depositPosition.X(), sigma),
 				                         myRndm.Gaus(depositPosition.Y(), sigma),
 				                         myRndm.Gaus(depositPosition.Z(), sigma));
-      iPolyBin = myGeometryPtr->GetTH2Poly()->FindBin(smearedPosition.X(), smearedPosition.Y());
+      iPolyBin = myGeometryPtr->FindTH2PolyBin(smearedPosition.X(), smearedPosition.Y());
       iCell = myGeometryPtr->Pos2timecell(smearedPosition.Z(), err_flag);
       std::shared_ptr<StripTPC> aStrip = myGeometryPtr->GetTH2PolyStrip(iPolyBin);
       if(aStrip && !err_flag){
@@ -8,14 +8,17 @@
 #include <map>
 #include <cstdint>
 #include <string>
+#include <thread>
 #include <vector>
 #include <sstream>
 
+#include <TROOT.h>
 #include <TCollection.h>
 #include <TClonesArray.h>
 
 #include "TPCReco/RunIdParser.h"
 #include "TPCReco/EventSourceMultiGRAW.h"
+#include "TPCReco/PerfMonitor.h"
 #include "TPCReco/colorText.h"
 
 #include <get/graw2dataframe.h>
@@ -52,6 +55,21 @@ std::shared_ptr<EventTPC> EventSourceMultiGRAW::getNextEvent(){
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+bool EventSourceMultiGRAW::hasNextEvent() const{
+
+  // same frame counting as in getNextEvent()
+  auto currentEventId = myCurrentEvent->GetEventInfo().GetEventId();
+  for( unsigned int streamIndex=0; streamIndex<myFramesMapList.size(); streamIndex++ ) {
+    auto it = myFramesMapList[streamIndex].find(currentEventId);
+    auto it2 = myAsadMapList[streamIndex].find(currentEventId);
+    auto it3 = myCoboMapList[streamIndex].find(currentEventId);
+    if( it==myFramesMapList[streamIndex].end() || it2==myAsadMapList[streamIndex].end() || it3==myCoboMapList[streamIndex].end() ) continue;
+    if( it2->second==0 && it3->second==0) return it->second<nEntries-1;
+  }
+  return false;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 std::shared_ptr<EventTPC> EventSourceMultiGRAW::getPreviousEvent(){
 
   auto currentEventId = myCurrentEvent->GetEventInfo().GetEventId();  
@@ -110,6 +128,8 @@ void EventSourceMultiGRAW::loadDataFileList(const std::set<std::string> & fileNa
   myCoboMapList.clear();
   myFramesMapList.clear();
   myReadEntriesSetList.clear();
+  myStreamFrameList.clear();
+  myStreamLoaderList.clear();
 
   unsigned int streamIndex=0;
   for(auto fileName: fileNameList) {
@@ -118,10 +138,19 @@ void EventSourceMultiGRAW::loadDataFileList(const std::set<std::string> & fileNa
     myAsadMapList.push_back(std::map<unsigned int, unsigned int>{});
     myCoboMapList.push_back(std::map<unsigned int, unsigned int>{});
     myReadEntriesSetList.push_back(std::set<unsigned int>{});
+    myStreamFrameList.push_back(std::make_unique<GET::GDataFrame>());
+    myStreamLoaderList.push_back(std::make_unique<Graw2DataFrame>());
 
     EventSourceBase::loadDataFile(fileName);
 
-    auto myFile = std::make_shared<TGrawFile>(fileName.c_str());
+    std::shared_ptr<TGrawFile> myFile;
+    unsigned int nFrames = 0;
+    {
+      GrawReadGuard aGuard;
+      myFile = std::make_shared<TGrawFile>(fileName.c_str());
+      if(myFile) nFrames = myFile->GetGrawFramesNumber();
+      myStreamLoaderList.back()->initialize("./CoboFormats.xcfg");
+    }
     if(!myFile){
       std::cerr<<KRED<<__FUNCTION__
 	       <<": ERROR: Can not open file: "<<RST<<fileName<<std::endl;
@@ -129,7 +158,6 @@ void EventSourceMultiGRAW::loadDataFileList(const std::set<std::string> & fileNa
     }
     myFileList.push_back(myFile);
     
-    unsigned int nFrames = myFile->GetGrawFramesNumber();
     if(streamIndex==0 || nFrames<nEntries) nEntries=nFrames; // take the lowest number of frames
 		     
     myFilePathList.push_back(fileName);
@@ -141,6 +169,9 @@ void EventSourceMultiGRAW::loadDataFileList(const std::set<std::string> & fileNa
 
     streamIndex++;
   }
+  // frames of all streams are read and decoded in parallel, see collectEventFragments()
+  if(myFilePathList.size()>1) ROOT::EnableThreadSafety();
+  selectPedestalTable(myFilePathList.front());
 #ifdef DEBUG
   std::cout<<__FUNCTION__<<": Number of GRAW streams: "<<myFramesMapList.size()
 	   <<". Expected: "<<GRAW_EVENT_FRAGMENTS
@@ -153,6 +184,7 @@ void EventSourceMultiGRAW::loadDataFileList(const std::set<std::string> & fileNa
 /////////////////////////////////////////////////////////
 bool EventSourceMultiGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent, unsigned int streamIndex){
 
+  TPCRECO_TIME_SCOPE("EventSourceMultiGRAW::loadGrawFrame");
   #ifdef DEBUG
   std::cout<<__FUNCTION__<<KBLU<<": Start loading the file entry: "<<RST<<iEntry
 	   <<KBLU<<" from the GRAW stream id: "<<RST<<streamIndex
@@ -171,7 +203,6 @@ bool EventSourceMultiGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent
   //  std::cout<<__FUNCTION__<<": AFTER tmpFilePath ---> stream="<<streamIndex<<", frame_check="<<iEntry<<", readFull="<<readFullEvent<<std::endl<<std::flush;
   //#endif
 
-  std::cout.setstate(std::ios_base::failbit);
 #ifndef EVENTSOURCEGRAW_NEXT_FILE_DISABLE  
 
   if(iEntry>=nEntries){
@@ -181,8 +212,12 @@ bool EventSourceMultiGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent
 
   
   //  bool dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrameList[streamIndex], readFullEvent);///FIXME getGrawFrame counts frames from 1 (WRRR!)
-  bool dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrame, readFullEvent); // HOTFIX!!!!! => fills myDataFrame 
-  ///FIXME getGrawFrame counts frames from 1 (WRRR!)
+  bool dataFrameRead = false;
+  {
+    GrawReadGuard aGuard;
+    dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrame, readFullEvent); // HOTFIX!!!!! => fills myDataFrame 
+    ///FIXME getGrawFrame counts frames from 1 (WRRR!)
+  }
 
   
 #else
@@ -190,6 +225,7 @@ bool EventSourceMultiGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent
 
   if(iEntry<nEntries) {
     //  dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrameList[streamIndex], readFullEvent);///FIXME getGrawFrame counts frames from 1 (WRRR!)
+    GrawReadGuard aGuard;
     dataFrameRead = myFrameLoader.getGrawFrame(tmpFilePath, iEntry+1, myDataFrame, readFullEvent); // HOTFIX!!!!! => fills myDataFrame
     ///FIXME getGrawFrame counts frames from 1 (WRRR!)
   } else {
@@ -201,7 +237,6 @@ bool EventSourceMultiGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent
     return false;
   }
 #endif
-  std::cout.clear();
 
   if(!dataFrameRead){
     std::cerr <<KRED<<__FUNCTION__
@@ -226,6 +261,25 @@ bool EventSourceMultiGRAW::loadGrawFrame(unsigned int iEntry, bool readFullEvent
   return dataFrameRead;
 }
 /////////////////////////////////////////////////////////
+// Reads full frame into the frame buffer of the stream,
+// with the frame loader of the stream. Can be called from
+// the decoding threads: the GET calls are serialized.
+/////////////////////////////////////////////////////////
+bool EventSourceMultiGRAW::readStreamFrame(unsigned int iEntry, unsigned int streamIndex, std::string & filePath){
+
+  filePath = myFilePathList[streamIndex];
+#ifndef EVENTSOURCEGRAW_NEXT_FILE_DISABLE  
+  if(iEntry>=nEntries){
+    filePath = myNextFilePathList[streamIndex];
+    iEntry -= nEntries;
+  }
+#else
+  if(iEntry>=nEntries) return false;
+#endif
+  GrawReadGuard aGuard;
+  return myStreamLoaderList[streamIndex]->getGrawFrame(filePath, iEntry+1, *myStreamFrameList[streamIndex], true);///FIXME getGrawFrame counts frames from 1 (WRRR!)
+}
+/////////////////////////////////////////////////////////
 // Checks all GRAW files for frames with eventId.
 // On success uptades myCurrentEvent object.
 /////////////////////////////////////////////////////////
@@ -297,6 +351,7 @@ void EventSourceMultiGRAW::loadEventId(unsigned long int eventId){
 /////////////////////////////////////////////////////////
 void EventSourceMultiGRAW::loadFileEntry(unsigned long int iEntry){
 
+  TPCRECO_TIME_SCOPE("EventSourceMultiGRAW::loadFileEntry");
   #ifdef DEBUG
   std::cout<<__FUNCTION__<<KBLU
 	   <<": Start looking for the file entry: "<<RST<<iEntry
@@ -416,32 +471,86 @@ void EventSourceMultiGRAW::checkEntryForFragments(unsigned int iEntry, unsigned
   myReadEntriesSetList[streamIndex].insert(iEntry);
 }
 /////////////////////////////////////////////////////////
-// Fills myCurrentEvent object using existing GRAW frame mapping
+// Fills myCurrentEvent object using existing GRAW frame mapping.
+// Frames of all streams are read, pedestal subtracted and decoded
+// in parallel, one thread per stream; the GET reads themselves are
+// serialized, see GrawReadGuard. The decoded samples are added
+// to the event in the stream order afterwards, so the result does not
+// depend on the thread scheduling.
 /////////////////////////////////////////////////////////
 void EventSourceMultiGRAW::collectEventFragments(unsigned int eventId){
 
+  TPCRECO_TIME_SCOPE("EventSourceMultiGRAW::collectEventFragments");
+  std::vector<unsigned int> streams; // streams with a fragment of this event
+  std::set<std::pair<unsigned int, unsigned int> > coboAsadSet;
+  bool uniqueAsads = true;
+  for(unsigned int streamIndex=0; streamIndex<myFramesMapList.size(); streamIndex++) {
+    if(myFramesMapList[streamIndex].find(eventId)==myFramesMapList[streamIndex].end()) continue;
+    streams.push_back(streamIndex);
+    auto it2 = myAsadMapList[streamIndex].find(eventId);
+    auto it3 = myCoboMapList[streamIndex].find(eventId);
+    if(it2==myAsadMapList[streamIndex].end() || it3==myCoboMapList[streamIndex].end() ||
+       !coboAsadSet.insert(std::make_pair(it3->second, it2->second)).second) uniqueAsads = false;
+  }
+  // pedestal tables are kept per {COBO, ASAD}, frames of the same ASAD are decoded sequentially
+  bool decodeInThreads = parallelDecoding && fillEventType==EventType::tpc && uniqueAsads;
+
+  std::vector<std::vector<StripSample> > samples(streams.size());
+  std::vector<std::string> filePaths(streams.size());
+  std::vector<char> frameRead(streams.size(), false), frameDecoded(streams.size(), false);
+  {
+    TPCRECO_TIME_SCOPE("EventSourceMultiGRAW::collectEventFragments::parallel");
+    auto readAndDecode = [&](unsigned int iStream){
+      unsigned int streamIndex = streams[iStream];
+      frameRead[iStream] = readStreamFrame(myFramesMapList[streamIndex].find(eventId)->second, streamIndex, filePaths[iStream]);
+      if(frameRead[iStream] && decodeInThreads) {
+	frameDecoded[iStream] = decodeFrame(*myStreamFrameList[streamIndex], samples[iStream]);
+      }
+    };
+    if(decodeInThreads) {
+      std::vector<std::thread> threads;
+      for(unsigned int iStream=0; iStream<streams.size(); ++iStream) threads.emplace_back(readAndDecode, iStream);
+      for(auto & aThread: threads) aThread.join();
+    }
+    else {
+      for(unsigned int iStream=0; iStream<streams.size(); ++iStream) readAndDecode(iStream);
+    }
+  }
+
   unsigned int nFragments=0;
   std::set<int> asadCounter;
-  for(unsigned int streamIndex=0; streamIndex<myFramesMapList.size(); streamIndex++) {
-    auto it = myFramesMapList[streamIndex].find(eventId);
-    if(it==myFramesMapList[streamIndex].end()) continue;
+  for(unsigned int iStream=0; iStream<streams.size(); ++iStream) {
+    unsigned int streamIndex = streams[iStream];
+    auto aFragment = myFramesMapList[streamIndex].find(eventId)->second;
 
     if(nFragments==0) {
       myCurrentPEvent->Clear();
 	  	
       std::cout<<KYEL<<"Creating a new PEventTPC/Raw with event id: "<<eventId<<RST<<std::endl;
     }
-    auto aFragment = it->second;
-    loadGrawFrame(aFragment, true, streamIndex);
+    if(!frameRead[iStream]){
+      std::cerr <<KRED<<__FUNCTION__
+		<<": ERROR: cannot read file entry: " <<RST<<aFragment
+		<<KRED<<"from file: "<<std::endl
+		<<RST<<filePaths[iStream]
+		<< std::endl;
+      std::cerr <<KRED
+		<<"Please check if you are running the application from the resources directory."
+		<<std::endl<<"or if the data file is missing."
+		<<RST
+		<<std::endl;
+      exit(1);
+    }
+    GET::GDataFrame & aDataFrame = *myStreamFrameList[streamIndex];
 	    
-    int ASAD_idx = myDataFrame.fHeader.fAsadIdx;
-    int COBO_idx = myDataFrame.fHeader.fCoboIdx;
-    unsigned long int eventId_fromFrame = myDataFrame.fHeader.fEventIdx; // HOTFIX !!!
+    int ASAD_idx = aDataFrame.fHeader.fAsadIdx;
+    int COBO_idx = aDataFrame.fHeader.fCoboIdx;
+    unsigned long int eventId_fromFrame = aDataFrame.fHeader.fEventIdx; // HOTFIX !!!
     myCurrentEntry=aFragment; 
     asadCounter.insert(ASAD_idx);
 
     myCurrentEventInfo.SetEventId(eventId);      
-    myCurrentEventInfo.SetEventTimestamp(myDataFrame.fHeader.fEventTime);
+    myCurrentEventInfo.SetEventTimestamp(aDataFrame.fHeader.fEventTime);
     RunIdParser runParser(myFilePathList.front());
     myCurrentEventInfo.SetRunId(runParser.runId());
 
@@ -462,8 +571,13 @@ void EventSourceMultiGRAW::collectEventFragments(unsigned int eventId){
 	     <<KBLU<<", GRAW stream id: "<<RST<<streamIndex
 	     <<std::endl;
     
-    if(fillEventType==EventType::tpc) fillEventFromFrame(myDataFrame);
-    else if(fillEventType==EventType::raw) fillEventRawFromFrame(myDataFrame);
+    if(fillEventType==EventType::tpc) {
+      myCurrentEventInfo.SetPedestalSubtracted(removePedestal);
+      if(!decodeInThreads) frameDecoded[iStream] = decodeFrame(aDataFrame, samples[iStream]);
+      if(frameDecoded[iStream]) addSamples(samples[iStream]);
+      else reportSkippedFrame(aDataFrame);
+    }
+    else if(fillEventType==EventType::raw) fillEventRawFromFrame(aDataFrame);
     nFragments++; 
   }
   fillEventTPC();
@@ -7,6 +7,7 @@
 #include "TPCReco/colorText.h"
 #include "TPCReco/EventSourceROOT.h"
 #include "TPCReco/PedestalCalculator.h"
+#include "TPCReco/PerfMonitor.h"
 
 #include "TPCReco/ConfigManager.h"
 
@@ -38,16 +39,22 @@ void EventSourceROOT::setRemovePedestal(bool aFlag){
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void EventSourceROOT::configurePedestal(const tpcreco::config::PedestalConfig &config){
+
+  removePedestal = config.remove;
+
+  myPedestalCalculator.SetMinPedestalCell(config.minPedestalCell);
+  myPedestalCalculator.SetMaxPedestalCell(config.maxPedestalCell);
+  myPedestalCalculator.SetMinSignalCell(config.minSignalCell);
+  myPedestalCalculator.SetMaxSignalCell(config.maxSignalCell);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 void EventSourceROOT::configurePedestal(const boost::property_tree::ptree &config){
-  auto parser=[this, &config](std::string &&parameter, void (PedestalCalculator::*setter)(int)){
-    if(config.find(parameter)!=config.not_found()){
-      (this->myPedestalCalculator.*setter)(config.get<int>(parameter));
-    }
-  };
-  parser("pedestal.minPedestalCell", &PedestalCalculator::SetMinPedestalCell);
-  parser("pedestal.maxPedestalCell", &PedestalCalculator::SetMaxPedestalCell);
-  parser("pedestal.minSignalCell", &PedestalCalculator::SetMinSignalCell);
-  parser("pedestal.maxSignalCell", &PedestalCalculator::SetMaxSignalCell);
+
+  boost::property_tree::ptree aConfig;
+  aConfig.put_child("pedestal", config);
+  configurePedestal(tpcreco::config::PedestalConfig::fromConfig(aConfig));
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -72,7 +79,7 @@ void EventSourceROOT::loadDataFile(const std::string & fileName){
   }
 
     myTree->SetBranchAddress("Event", &aPtr);
-    myTree->BuildIndex("myEventInfo.runId", "myEventInfo.eventId");
+    myEventIndex = tpcreco::utilities::EventIndex::attach(myTree.get(), "myEventInfo.runId", "myEventInfo.eventId");
 
   nEntries = myTree->GetEntries();
 }
@@ -80,6 +87,7 @@ void EventSourceROOT::loadDataFile(const std::string & fileName){
 /////////////////////////////////////////////////////////
 void EventSourceROOT::loadFileEntry(unsigned long int iEntry){
 
+  TPCRECO_TIME_SCOPE("EventSourceROOT::loadFileEntry");
   if(!myTree){
     std::cerr<<"ROOT tree not available!"<<std::endl;
     return;
@@ -120,10 +128,20 @@ void EventSourceROOT::loadEventId(unsigned long int iEvent){
     std::cerr<<"ROOT tree not available!"<<std::endl;
     return;
   }
-  // primary method: assumes that TTree::BuildIndex() was performed while storing/reading myTree
-  loadFileEntry(myTree->GetEntryNumberWithIndex(getCurrentEvent()->GetEventInfo().GetRunId(), iEvent));
+  // primary method: binary search in the {runId, eventId} index, current run first
+  if(!myEventIndex.empty()){
+    Long64_t iEntry = myEventIndex.find(getCurrentEvent()->GetEventInfo().GetRunId(), iEvent);
+    if(iEntry<0) iEntry = myEventIndex.findMinor(iEvent);
+    if(iEntry<0){
+      std::cerr<<KRED<<"EventSourceROOT::loadEventId: "<<RST
+	       <<"event "<<iEvent<<" not found"<<std::endl;
+      return;
+    }
+    loadFileEntry(iEntry);
+    return;
+  }
 
-  // secondary (failover) method: when TTree::BuildIndex() did not work properly
+  // secondary (failover) method: when the index could not be built
   unsigned long int iEntry = 0;
   while(currentEventNumber()!=iEvent && iEntry<nEntries){  
     loadFileEntry(iEntry);
@@ -3,10 +3,20 @@
 
 #include <cstdlib>
 #include <cstddef>  // for: NULL
+#include <cmath>
+#include <cstdio>
 #include <iostream> // for: cout, cerr, endl
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <map>
 
+#include <sys/stat.h> // for: fchmod
+#include <unistd.h> // for: close
+#include <boost/filesystem.hpp>
+
 #include <TROOT.h>
 #include <TGraph.h>
 #include <TH2.h>
@@ -28,11 +38,15 @@
 // constructor
 UVWprojector::UVWprojector(std::shared_ptr<GeometryTPC> geo, int n, int nx, int ny) 
   : area_npoints(1), 
+    area_cache_dir(std::getenv("TPCRECO_CACHE_DIR") ? std::getenv("TPCRECO_CACHE_DIR") : ""),
+    area_nthreads(0),
     isOK_AreaMapping(false),    
     isOK_TimeMapping(false), 
     geo_ptr(geo),
     input_hist(NULL),
     is_input_2D(false),
+    isOK_ProjectionMatrix(false),
+    proj_nybins(0),
     _debug(false)
 { 
   SetAreaNpoints(n);
@@ -47,9 +61,21 @@ UVWprojector::~UVWprojector() {
   if(input_hist) input_hist->Delete();
 }
     
-// change number of points used for random probing of TH2Poly bins
+// number of points used formerly for random probing of TH2Poly bins,
+// the area mapping is now calculated exactly and does not depend on it
 void UVWprojector::SetAreaNpoints(int n) {
-  if(n>0 && n!=area_npoints) { area_npoints=n; isOK_AreaMapping=false; }
+  if(n>0) area_npoints=n;
+}
+
+// directory for cached area mappings, empty string disables caching,
+// by default caching is enabled only by the TPCRECO_CACHE_DIR environment variable
+void UVWprojector::SetAreaCacheDir(const std::string &dir) {
+  area_cache_dir=dir;
+}
+
+// number of threads used for area mapping, 0 = all available cores
+void UVWprojector::SetNthreads(unsigned int n) {
+  area_nthreads=n;
 }
 
 // 3D ionization map: (x [mm], y [mm], z [mm], Q [arb.u.])
@@ -172,21 +198,68 @@ void UVWprojector::SetBinContent(Int_t bin, Double_t w) {
   ((TH2PolyBin*) tp->GetBins()->At(bin-1))->SetContent( w );
 }
 
+namespace {
+
+  struct PolyPoint { double x, y; };
+  typedef std::vector<PolyPoint> Polygon;
+
+  // Sutherland-Hodgman clipping of a polygon by half-plane {axis coordinate >= value} (keepAbove=true)
+  // or {axis coordinate <= value} (keepAbove=false). The input polygon can be non-convex,
+  // degenerate edges along the clipping line do not contribute to the area.
+  void clipPolygon(const Polygon &in, Polygon &out, bool axisX, double value, bool keepAbove) {
+    out.clear();
+    const size_t n=in.size();
+    if(n<3) return;
+    auto coord=[axisX](const PolyPoint &p) { return axisX ? p.x : p.y; };
+    auto inside=[&](const PolyPoint &p) { return keepAbove ? coord(p)>=value : coord(p)<=value; };
+    for(size_t i=0; i<n; i++) {
+      const PolyPoint &a=in[i];
+      const PolyPoint &b=in[(i+1)%n];
+      const bool aIn=inside(a), bIn=inside(b);
+      if(aIn) out.push_back(a);
+      if(aIn!=bIn) {
+	const double t=(value-coord(a))/(coord(b)-coord(a));
+	PolyPoint p={a.x+t*(b.x-a.x), a.y+t*(b.y-a.y)};
+	if(axisX) p.x=value; else p.y=value;
+	out.push_back(p);
+      }
+    }
+    if(out.size()<3) out.clear();
+  }
+
+  double polygonArea(const Polygon &poly) {
+    double sum=0.0;
+    const size_t n=poly.size();
+    for(size_t i=0; i<n; i++) {
+      const PolyPoint &a=poly[i];
+      const PolyPoint &b=poly[(i+1)%n];
+      sum+=a.x*b.y-b.x*a.y;
+    }
+    return 0.5*std::fabs(sum);
+  }
+
+  struct AreaEntry { int ix, iy, ibin; double fraction; };
+
+  const uint32_t areaCacheMagic=0x41575655;   // "UVWA"
+  const uint32_t areaCacheVersion=1;
+}
+
 bool UVWprojector::InitAreaMapping() {
 
   TH2D *h2 = (TH2D*)input_hist;
 
   isOK_AreaMapping=false;
+  isOK_ProjectionMatrix=false;
   fAreaFractionMap.clear();
 
   // sanity checks
   TH2Poly *tp=NULL;
-  if( area_npoints<1 || !h2 || !geo_ptr || !(geo_ptr->IsOK()) || !(tp=geo_ptr->GetTH2Poly())) {
+  if( !h2 || !geo_ptr || !(geo_ptr->IsOK()) || !(tp=geo_ptr->GetTH2Poly())) {
 
     // DEBUG
     if(_debug) {
       std::cerr << "InitAreaMapping: ERROR: Failed sanity checks (1): " 
-		<< "NPOINTS=" << area_npoints << ", HIST_PTR=" << h2 << ", TH2POLY=" << tp << ", GEO_PTR=" << geo_ptr << std::endl;
+		<< "HIST_PTR=" << h2 << ", TH2POLY=" << tp << ", GEO_PTR=" << geo_ptr << std::endl;
     }
     // DEBUG
 
@@ -213,46 +286,83 @@ bool UVWprojector::InitAreaMapping() {
     return false;
   }
 
+  // try cached result first
+  const uint64_t key = GetAreaMappingKey();
+  std::string cacheFile;
+  if(!area_cache_dir.empty()) {
+    std::ostringstream name;
+    name << area_cache_dir << "/UVWprojector_area_" << std::hex << key << ".bin";
+    cacheFile = name.str();
+    if(ReadAreaMapping(cacheFile, key)) {
+      isOK_AreaMapping = fAreaFractionMap.size()>0;
+      if(_debug) {
+	std::cout << "InitAreaMapping: Loaded from cache: " << cacheFile << ", fAreaFractionMap.size()=" << fAreaFractionMap.size() << std::endl;
+      }
+      return isOK_AreaMapping;
+    }
+  }
+
   const double dx = (xmax-xmin)/nxbins;
   const double dy = (ymax-ymin)/nybins;
 
-  // create list of sampling points within [0, dx[ x [0, dy[ rectangle,
-  // always include the bin centre and randomly distribute the rest
-  std::vector<TVector2> offset;
-  offset.push_back(TVector2(0.5*dx, 0.5*dy)); 
-  TRandom3 *rand = new TRandom3(); 
-  for(int ipoint=1; ipoint<area_npoints; ipoint++) {
-    offset.push_back(TVector2(rand->Rndm()*dx, rand->Rndm()*dy)); 
+  // copy TH2Poly bin polygons
+  std::vector<std::pair<int, Polygon> > strips;
+  TIter next(tp->GetBins());
+  while(TH2PolyBin *bin = (TH2PolyBin*)next()) {
+    TGraph *g = dynamic_cast<TGraph*>(bin->GetPolygon());
+    if(bin->GetBinNumber()<1 || !g || g->GetN()<3) continue; // skip underflow/overflow/sea bins
+    Polygon poly(g->GetN());
+    for(int ipoint=0; ipoint<g->GetN(); ipoint++) {
+      poly[ipoint].x = g->GetX()[ipoint];
+      poly[ipoint].y = g->GetY()[ipoint];
+    }
+    strips.push_back(std::make_pair(bin->GetBinNumber(), poly));
   }
-  
-  // for each cartesian (X,Y) bin of the event histogram prepare:
-  // - list of TH2Poly bins partially enclosed in the cartesian bin
-  // - for each TH2Poly bin of the list estimate ratio of the enclosed surface
-  //   to the total surface of the cartesian bin
-  double weight = 1. / area_npoints;
-  for(int ibinx=0; ibinx<nxbins; ibinx++) {
-    for(int ibiny=0; ibiny<nybins; ibiny++) {
-      TVector2 pos(xmin + ibinx * dx, ymin + ibiny * dy);
-      for(int ipoint=0; ipoint<area_npoints; ipoint++) {
-	TVector2 probe=pos+offset[ipoint];
-	int ibin = tp->FindBin(probe.X(), probe.Y()); // TH2Poly bin index
-
-	// DEBUG - VERY VERBOSE
-	//	if(_debug) {
-	//	  std::cout << "InitAreaMapping: Probing (X=" << probe.X() << ", Y=" << probe.Y() <<"): TH2POLY_BIN=" << ibin << std::endl;
-	//	}
-	// DEBUG - VERY VERBOSE
-	
-	if(ibin<1) continue; // skip underflow/overflow/sea bins
-	BinFracMap &bmap = fAreaFractionMap[MultiKey2(ibinx,ibiny)];
-	if( bmap.FracMap.find(ibin)==bmap.FracMap.end() ) {
-	  bmap.FracMap[ibin] = weight;  // assign weight to a new strip
-	} else {
-	  bmap.FracMap[ibin] += weight; // increase weight of existing strip 
+
+  // For each TH2Poly bin and each cartesian (X,Y) bin of the event histogram
+  // calculate the exact ratio of the overlap area to the total surface of the cartesian bin.
+  // The polygon is clipped first to the column of X bins and then to each Y bin of that column.
+  // TH2Poly bins are distributed among threads, each thread collects its own list of results.
+  const unsigned int nThreads = std::max(1U, std::min((unsigned int)strips.size(),
+						      area_nthreads ? area_nthreads : std::thread::hardware_concurrency()));
+  std::vector<std::vector<AreaEntry> > results(nThreads);
+  std::atomic<size_t> nextStrip(0);
+  auto worker = [&](unsigned int ithread) {
+    Polygon column, tmp, cell;
+    for(size_t istrip=nextStrip++; istrip<strips.size(); istrip=nextStrip++) {
+      const int ibin = strips[istrip].first;
+      const Polygon &poly = strips[istrip].second;
+      double pxmin=poly[0].x, pxmax=poly[0].x;
+      for(auto &p: poly) { pxmin=std::min(pxmin, p.x); pxmax=std::max(pxmax, p.x); }
+      const int ix1 = std::max(0, (int)std::floor((pxmin-xmin)/dx));
+      const int ix2 = std::min(nxbins-1, (int)std::floor((pxmax-xmin)/dx));
+      for(int ibinx=ix1; ibinx<=ix2; ibinx++) {
+	clipPolygon(poly, tmp, true, xmin+ibinx*dx, true);
+	clipPolygon(tmp, column, true, xmin+(ibinx+1)*dx, false);
+	if(column.empty()) continue;
+	double pymin=column[0].y, pymax=column[0].y;
+	for(auto &p: column) { pymin=std::min(pymin, p.y); pymax=std::max(pymax, p.y); }
+	const int iy1 = std::max(0, (int)std::floor((pymin-ymin)/dy));
+	const int iy2 = std::min(nybins-1, (int)std::floor((pymax-ymin)/dy));
+	for(int ibiny=iy1; ibiny<=iy2; ibiny++) {
+	  clipPolygon(column, tmp, false, ymin+ibiny*dy, true);
+	  clipPolygon(tmp, cell, false, ymin+(ibiny+1)*dy, false);
+	  const double fraction = polygonArea(cell)/(dx*dy);
+	  if(fraction>1e-9) results[ithread].push_back({ibinx, ibiny, ibin, std::min(fraction, 1.0)});
 	}
-      } // end of random sampling loop      
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for(unsigned int ithread=1; ithread<nThreads; ithread++) threads.emplace_back(worker, ithread);
+  worker(0);
+  for(auto &aThread: threads) aThread.join();
+
+  for(auto &aList: results) {
+    for(auto &aEntry: aList) {
+      fAreaFractionMap[MultiKey2(aEntry.ix, aEntry.iy)].FracMap[aEntry.ibin] = aEntry.fraction;
     }
-  } // end of loop over all (X,Y) bins
+  }
   
   // DEBUG
   if(_debug) {
@@ -271,6 +381,7 @@ bool UVWprojector::InitAreaMapping() {
 
   // final result
   if(fAreaFractionMap.size()>0) isOK_AreaMapping=true;
+  if(isOK_AreaMapping && !cacheFile.empty()) WriteAreaMapping(cacheFile, key);
 
   // DEBUG
   if(_debug) {
@@ -282,6 +393,93 @@ bool UVWprojector::InitAreaMapping() {
   return isOK_AreaMapping;
 }
 
+// FNV-1a hash of the XY binning of the input histogram and all TH2Poly strip polygons
+uint64_t UVWprojector::GetAreaMappingKey() {
+
+  uint64_t hash=14695981039346656037ULL;
+  auto add=[&hash](const void *data, size_t size) {
+    const unsigned char *bytes=(const unsigned char*)data;
+    for(size_t i=0; i<size; i++) { hash^=bytes[i]; hash*=1099511628211ULL; }
+  };
+  add(&areaCacheVersion, sizeof(areaCacheVersion));
+  const double binning[4]={input_hist->GetXaxis()->GetXmin(), input_hist->GetXaxis()->GetXmax(),
+			   input_hist->GetYaxis()->GetXmin(), input_hist->GetYaxis()->GetXmax()};
+  const int nbins[2]={input_hist->GetNbinsX(), input_hist->GetNbinsY()};
+  add(binning, sizeof(binning));
+  add(nbins, sizeof(nbins));
+  TIter next(geo_ptr->GetTH2Poly()->GetBins());
+  while(TH2PolyBin *bin = (TH2PolyBin*)next()) {
+    const int ibin=bin->GetBinNumber();
+    add(&ibin, sizeof(ibin));
+    TGraph *g = dynamic_cast<TGraph*>(bin->GetPolygon());
+    if(!g) continue;
+    add(g->GetX(), g->GetN()*sizeof(double));
+    add(g->GetY(), g->GetN()*sizeof(double));
+  }
+  return hash;
+}
+
+// binary cache file: magic, version, key, number of entries, entries {IX, IY, TH2Poly bin, fraction}
+bool UVWprojector::ReadAreaMapping(const std::string &fname, uint64_t key) {
+
+  std::ifstream file(fname, std::ios::binary);
+  if(!file) return false;
+  uint32_t magic=0, version=0;
+  uint64_t fileKey=0, nEntries=0;
+  file.read((char*)&magic, sizeof(magic));
+  file.read((char*)&version, sizeof(version));
+  file.read((char*)&fileKey, sizeof(fileKey));
+  file.read((char*)&nEntries, sizeof(nEntries));
+  if(!file || magic!=areaCacheMagic || version!=areaCacheVersion || fileKey!=key) return false;
+  // the entries must fill the rest of the file, protects against truncated or corrupted files
+  const std::streampos dataStart=file.tellg();
+  file.seekg(0, std::ios::end);
+  const std::streamoff dataSize=file.tellg()-dataStart;
+  if(!file || dataSize<0 || (uint64_t)dataSize!=nEntries*sizeof(AreaEntry) ||
+     nEntries>(uint64_t)dataSize) return false;
+  file.seekg(dataStart);
+  std::vector<AreaEntry> entries(nEntries);
+  file.read((char*)entries.data(), nEntries*sizeof(AreaEntry));
+  if(!file) return false;
+  fAreaFractionMap.clear();
+  for(auto &aEntry: entries) {
+    fAreaFractionMap[MultiKey2(aEntry.ix, aEntry.iy)].FracMap[aEntry.ibin] = aEntry.fraction;
+  }
+  return true;
+}
+
+void UVWprojector::WriteAreaMapping(const std::string &fname, uint64_t key) {
+
+  std::vector<AreaEntry> entries;
+  for(auto &it: fAreaFractionMap) {
+    for(auto &it2: it.second.FracMap) {
+      entries.push_back({std::get<0>(it.first), std::get<1>(it.first), it2.first, it2.second});
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(area_cache_dir, ec);
+
+  // write to a temporary file first, concurrent jobs may read the same cache.
+  // The temporary name is unique for every writer, also for threads of the same job.
+  std::string tmpName = fname+".XXXXXX";
+  int fd=::mkstemp(&tmpName[0]);
+  if(fd<0) return;
+  ::fchmod(fd, 0644); // readable as a file written by ofstream
+  ::close(fd);
+  {
+    std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+    if(!file) { std::remove(tmpName.c_str()); return; }
+    const uint64_t nEntries=entries.size();
+    file.write((const char*)&areaCacheMagic, sizeof(areaCacheMagic));
+    file.write((const char*)&areaCacheVersion, sizeof(areaCacheVersion));
+    file.write((const char*)&key, sizeof(key));
+    file.write((const char*)&nEntries, sizeof(nEntries));
+    file.write((const char*)entries.data(), nEntries*sizeof(AreaEntry));
+    if(!file) { file.close(); std::remove(tmpName.c_str()); return; }
+  }
+  if(std::rename(tmpName.c_str(), fname.c_str())!=0) std::remove(tmpName.c_str());
+}
+
 bool UVWprojector::InitTimeMapping() {
 
   if(is_input_2D) return false; // input event contains only time-intergral 
@@ -289,6 +487,7 @@ bool UVWprojector::InitTimeMapping() {
   TH3D *h3 = (TH3D*)input_hist;
 
   isOK_TimeMapping=false;
+  isOK_ProjectionMatrix=false;
   fTimeFractionMap.clear();
 
   // sanity checks
@@ -446,6 +645,77 @@ bool UVWprojector::InitTimeMapping() {
   return isOK_TimeMapping;
 }
 
+bool UVWprojector::InitProjectionMatrix() {
+
+  isOK_ProjectionMatrix=false;
+  if(!isOK_TimeMapping || !isOK_AreaMapping || !input_hist) return false;
+
+  const int nxbins = input_hist->GetNbinsX();
+  const int nybins = input_hist->GetNbinsY();
+  const int nzbins = input_hist->GetNbinsZ();
+  proj_nybins = nybins;
+
+  // XY row -> strip index, keeping the order of fAreaFractionMap
+  std::map<int /* TH2Poly bin index */, int /* index in fProjStrips */> stripIndex;
+  fProjStrips.clear();
+  fAreaRowStart.assign(nxbins*nybins+1, 0);
+  fAreaStrip.clear();
+  fAreaWeight.clear();
+  int row=0;
+  for(auto &it: fAreaFractionMap) {
+    const int ix = std::get<0>(it.first);
+    const int iy = std::get<1>(it.first);
+    if(ix<0 || ix>=nxbins || iy<0 || iy>=nybins) continue;
+    for(; row<=ix*nybins+iy; row++) fAreaRowStart[row]=fAreaStrip.size();
+    for(auto &it2: it.second.FracMap) {
+      const int ibin = it2.first; // TH2Poly bin index
+      const double weight = it2.second;
+      if(weight<=0.0) continue;
+      auto itS = stripIndex.find(ibin);
+      if(itS==stripIndex.end()) {
+	std::shared_ptr<StripTPC> s = geo_ptr->GetTH2PolyStrip(ibin);
+	if(!s) continue;
+	itS = stripIndex.insert(std::make_pair(ibin, (int)fProjStrips.size())).first;
+	fProjStrips.push_back(s);
+      }
+      fAreaStrip.push_back(itS->second);
+      fAreaWeight.push_back(weight);
+    }
+  }
+  for(; row<=nxbins*nybins; row++) fAreaRowStart[row]=fAreaStrip.size();
+
+  // Z-slice -> time cell
+  fTimeRowStart.assign(nzbins+3, 0);
+  fTimeCell.clear();
+  fTimeWeight.clear();
+  row=0;
+  for(auto &it: fTimeFractionMap) {
+    const int iz = it.first;
+    if(iz<0 || iz>nzbins+1) continue;
+    for(; row<=iz; row++) fTimeRowStart[row]=fTimeCell.size();
+    for(auto &it2: it.second.FracMap) {
+      fTimeCell.push_back(it2.first);
+      fTimeWeight.push_back(it2.second);
+    }
+  }
+  for(; row<=nzbins+2; row++) fTimeRowStart[row]=fTimeCell.size();
+
+  const int time_nbins = geo_ptr->GetAgetNtimecells();
+  fStripTimeBuffer.assign(fProjStrips.size()*time_nbins, 0.0);
+  fStripTimeTouched.clear();
+
+  // DEBUG
+  if(_debug) {
+    std::cout << "InitProjectionMatrix: Final result: "
+	      << "NSTRIPS=" << fProjStrips.size() << ", AREA_NNZ=" << fAreaStrip.size()
+	      << ", TIME_NNZ=" << fTimeCell.size() << std::endl;
+  }
+  // DEBUG
+
+  isOK_ProjectionMatrix=true;
+  return isOK_ProjectionMatrix;
+}
+
 // Getter methods
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -453,41 +723,48 @@ void UVWprojector::fillPEventTPC(std::shared_ptr<PEventTPC> aEvent){
 
   // sanity checks
   if(is_input_2D || !geo_ptr || !(geo_ptr->IsOK()) || !isOK_TimeMapping || !isOK_AreaMapping) return;
+  if(!isOK_ProjectionMatrix && !InitProjectionMatrix()) return;
 
   TH3D *h3 = (TH3D*)input_hist;
-  // loop over all Z-slices
-  std::map<int, BinFracMap>::const_iterator it;
-  std::map<int, double>::const_iterator it2;
-  for(it=fTimeFractionMap.cbegin(); it!=fTimeFractionMap.cend(); it++) {
-    int iz = it->first; // Z-slice
- 
-    // loop over all mapped time cells for a give Z-slice
-    for(it2=(it->second).FracMap.cbegin(); it2!=(it->second).FracMap.cend(); it2++) {	
-      
-      const double time_ibin = it2->first;
-      const double weightT = it2->second;
-
-      // loop over all mapped X,Y bins and project TH3D to TH2D using proper weights
-      std::map<MultiKey2, BinFracMap>::const_iterator it3;
-      std::map<int, double>::const_iterator it4;
-      for(it3=fAreaFractionMap.cbegin(); it3!=fAreaFractionMap.cend(); it3++) {
-	for(it4=(it3->second).FracMap.cbegin(); it4!=(it3->second).FracMap.cend(); it4++) {
-	  int ix = std::get<0>(it3->first);
-	  int iy = std::get<1>(it3->first);
-	  int ibin = it4->first;       // TH2Poly bin index
-	  
-	  std::shared_ptr<StripTPC> s = geo_ptr->GetTH2PolyStrip(ibin);
-	  if(s) { 
-	    const double weight = it4->second;
-	    if(weight<=0.0) continue;
-	    aEvent->AddValByStrip(s,
-				  time_ibin,
-				  h3->GetBinContent(ix, iy, iz)*weight*weightT);
+  const int nxbins = h3->GetNbinsX();
+  const int time_nbins = geo_ptr->GetAgetNtimecells();
+  const double *content = h3->GetArray();
+
+  // Loop over non-empty voxels of mapped Z-slices and accumulate strip x time cell sums.
+  // For a given strip and time cell the terms are added in the same order
+  // as in the loop over all mapped (Z, time, X, Y, strip) combinations.
+  // NOTE: mapping keys are used directly as (X, Y) bin numbers of the input histogram.
+  for(int iz=0; iz+1<(int)fTimeRowStart.size(); iz++) {
+    const int timeBegin = fTimeRowStart[iz];
+    const int timeEnd = fTimeRowStart[iz+1];
+    if(timeBegin==timeEnd) continue;
+    for(int ix=0; ix<nxbins; ix++) {
+      for(int iy=0; iy<proj_nybins; iy++) {
+	const double value = content[h3->GetBin(ix, iy, iz)];
+	if(value==0.0) continue;
+	const int row = ix*proj_nybins+iy;
+	for(int k=fAreaRowStart[row]; k<fAreaRowStart[row+1]; k++) {
+	  const double valueXY = value*fAreaWeight[k];
+	  double *cells = &fStripTimeBuffer[fAreaStrip[k]*time_nbins];
+	  for(int t=timeBegin; t<timeEnd; t++) {
+	    const int time_ibin = fTimeCell[t];
+	    if(time_ibin<0 || time_ibin>=time_nbins) continue;
+	    if(cells[time_ibin]==0.0) fStripTimeTouched.push_back(fAreaStrip[k]*time_nbins+time_ibin);
+	    cells[time_ibin] += valueXY*fTimeWeight[t];
 	  }
 	}
-      }  
+      }
     }
   }
+
+  // transfer non-empty cells to the event and reset the buffer
+  for(auto index: fStripTimeTouched) {
+    double &cell = fStripTimeBuffer[index];
+    if(cell==0.0) continue; // already transferred
+    aEvent->AddValByStrip(fProjStrips[index/time_nbins], index%time_nbins, cell);
+    cell = 0.0;
+  }
+  fStripTimeTouched.clear();
 }
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
@@ -56,8 +56,8 @@ int convertGRAWFile(boost::property_tree::ptree & aConfig){
   }
   
   aTree.Print();
-  // build index based on: majorname=EventId, minorname=NONE
-  //aTree.BuildIndex("Event.myEventInfo.eventId");
+  // index stored with the tree, see EventIndex::attach()
+  aTree.BuildIndex("myEventInfo.runId", "myEventInfo.eventId");
   aTree.Write("", TObject::kOverwrite); // save only the new version of the tree
   aFile.Close();
 
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <memory>
+#include <unistd.h>
+#include "gtest/gtest.h"
+
+#include "TPCReco/ConfigManager.h"
+
+#ifdef WITH_GET
+#include "TPCReco/EventSourceMultiGRAW.h"
+
+class EventSourceMultiGRAWTest : public ::testing::Test {
+public:
+  static boost::property_tree::ptree myConfig;
+
+  static void SetUpTestSuite() {
+
+    std::string testJSON = std::string(std::getenv("HOME"))+"/.tpcreco/config/test.json";
+    int argc = 3;
+    char *argv[] = {(char*)"ConfigManager_tst",
+                  (char*)"--meta.configJson",const_cast<char *>(testJSON.data())};
+
+    ConfigManager cm;
+    myConfig = cm.getConfig(argc, argv);
+    int status = chdir("../../resources");
+    (void)status;
+  }
+
+  static std::shared_ptr<EventSourceMultiGRAW> makeEventSource(bool parallelDecoding) {
+    auto aEventSource = std::make_shared<EventSourceMultiGRAW>(myConfig.get<std::string>("input.geometryFile"));
+    aEventSource->configurePedestal(myConfig.get_child("pedestal"));
+    aEventSource->setParallelDecoding(parallelDecoding);
+    aEventSource->loadDataFile(myConfig.get<std::string>("input.dataFile"));
+    return aEventSource;
+  }
+};
+
+boost::property_tree::ptree EventSourceMultiGRAWTest::myConfig;
+
+TEST_F(EventSourceMultiGRAWTest, ParallelDecodingMatchesSequential) {
+  auto aParallelSource = makeEventSource(true);
+  auto aSequentialSource = makeEventSource(false);
+  ASSERT_EQ(aParallelSource->numberOfEntries(), aSequentialSource->numberOfEntries());
+  ASSERT_GT(aParallelSource->numberOfEntries(), 0U);
+  auto nEntries = std::min(aParallelSource->numberOfEntries(), 5UL);
+  for(unsigned long iEntry=0; iEntry<nEntries; ++iEntry) {
+    aParallelSource->loadFileEntry(iEntry);
+    aSequentialSource->loadFileEntry(iEntry);
+    auto aParallelEvent = aParallelSource->getCurrentPEvent();
+    auto aSequentialEvent = aSequentialSource->getCurrentPEvent();
+    EXPECT_EQ(aParallelEvent->GetEventInfo().GetEventId(), aSequentialEvent->GetEventInfo().GetEventId());
+    EXPECT_FALSE(aParallelEvent->GetChargeMap().empty()) << "entry " << iEntry;
+    EXPECT_EQ(aParallelEvent->GetChargeMap(), aSequentialEvent->GetChargeMap()) << "entry " << iEntry;
+  }
+}
+#endif
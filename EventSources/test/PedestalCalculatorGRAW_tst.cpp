@@ -0,0 +1,118 @@
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <unistd.h>
+#include "gtest/gtest.h"
+
+#include "TPCReco/ConfigManager.h"
+
+#ifdef WITH_GET
+#include "TPCReco/EventSourceGRAW.h"
+
+namespace {
+// access to the frame loader and the pedestal calculator of the event source
+class PedestalProbe : public EventSourceGRAW {
+public:
+  using EventSourceGRAW::EventSourceGRAW;
+
+  // frames are counted from 0
+  const GET::GDataFrame & readFrame(const std::string & fileName, unsigned int iFrame) {
+    GrawReadGuard aGuard;
+    EXPECT_TRUE(myFrameLoader.getGrawFrame(fileName, iFrame+1, myDataFrame, false));
+    return myDataFrame;
+  }
+
+  PedestalCalculatorGRAW & getPedestalCalculator() { return myPedestalCalculator; }
+};
+} // namespace
+
+class PedestalCalculatorGRAWTest : public ::testing::Test {
+public:
+  static boost::property_tree::ptree myConfig;
+
+  static void SetUpTestSuite() {
+
+    std::string testJSON = std::string(std::getenv("HOME"))+"/.tpcreco/config/test.json";
+    int argc = 3;
+    char *argv[] = {(char*)"ConfigManager_tst",
+                  (char*)"--meta.configJson",const_cast<char *>(testJSON.data())};
+
+    ConfigManager cm;
+    myConfig = cm.getConfig(argc, argv);
+    int status = chdir("../../resources");
+    (void)status;
+  }
+};
+
+boost::property_tree::ptree PedestalCalculatorGRAWTest::myConfig;
+
+TEST_F(PedestalCalculatorGRAWTest, TableMatchesEventPedestals) {
+  PedestalProbe aProbe(myConfig.get<std::string>("input.geometryFile"));
+  auto & aCalculator = aProbe.getPedestalCalculator();
+  aCalculator.SetMinPedestalCell(myConfig.get<int>("pedestal.minPedestalCell"));
+  aCalculator.SetMaxPedestalCell(myConfig.get<int>("pedestal.maxPedestalCell"));
+  aCalculator.SetMinSignalCell(myConfig.get<int>("pedestal.minSignalCell"));
+  aCalculator.SetMaxSignalCell(myConfig.get<int>("pedestal.maxSignalCell"));
+  aCalculator.ResetRunAverages();
+  const int firstCell = aCalculator.GetFirstSignalCell();
+  const int lastCell = aCalculator.GetLastSignalCell();
+  const int nAgets = aProbe.getGeometry()->GetAgetNchips();
+  const int nChannels = aProbe.getGeometry()->GetAgetNchannels();
+
+  // per event corrections summed over frames, key=[cobo, asad, aget, channel, cell]
+  std::map<std::tuple<int, int, int, int, int>, double> correctionSums;
+  std::map<std::tuple<int, int>, unsigned long> nFrames; // key=[cobo, asad]
+  const unsigned int nFramesPerFile = 5;
+  std::stringstream aFileList(myConfig.get<std::string>("input.dataFile"));
+  std::string aFileName;
+  while(std::getline(aFileList, aFileName, ',')) {
+    for(unsigned int iFrame=0; iFrame<nFramesPerFile; ++iFrame) {
+      const auto & aFrame = aProbe.readFrame(aFileName, iFrame);
+      int coboId = aFrame.fHeader.fCoboIdx;
+      int asadId = aFrame.fHeader.fAsadIdx;
+      aCalculator.CalculateEventPedestals(aFrame);
+      aCalculator.AddToRunAverages(coboId, asadId);
+      ++nFrames[std::make_tuple(coboId, asadId)];
+      for(int agetId=0; agetId<nAgets; ++agetId) {
+	for(int chanId=0; chanId<nChannels; ++chanId) {
+	  for(int cellId=firstCell; cellId<=lastCell; ++cellId) {
+	    correctionSums[std::make_tuple(coboId, asadId, agetId, chanId, cellId)] +=
+	      aCalculator.GetPedestalCorrection(coboId, asadId, agetId, chanId, cellId);
+	  }
+	}
+      }
+    }
+  }
+  ASSERT_FALSE(nFrames.empty());
+
+  auto aTable = aCalculator.GetRunAverages(1);
+  EXPECT_EQ(aTable.GetMinCell(), firstCell);
+  EXPECT_EQ(aTable.GetMaxCell(), lastCell);
+  for(const auto & aItem : nFrames) {
+    EXPECT_EQ(aTable.GetNFrames(std::get<0>(aItem.first), std::get<1>(aItem.first)), aItem.second);
+  }
+
+  aCalculator.LoadPedestalTable(aTable);
+  ASSERT_TRUE(aCalculator.HasPedestalTable());
+  for(const auto & aItem : correctionSums) {
+    int coboId, asadId, agetId, chanId, cellId;
+    std::tie(coboId, asadId, agetId, chanId, cellId) = aItem.first;
+    double aMean = aItem.second/nFrames.at(std::make_tuple(coboId, asadId));
+    EXPECT_NEAR(aCalculator.GetPedestalCorrection(coboId, asadId, agetId, chanId, cellId), aMean, 1E-3)
+      << "COBO=" << coboId << " ASAD=" << asadId << " AGET=" << agetId
+      << " CHANNEL=" << chanId << " CELL=" << cellId;
+  }
+
+  // FPN shape is not calibrated outside the signal time-window of the pedestal run
+  aCalculator.ClearPedestalTable();
+  aCalculator.SetMaxSignalCell(lastCell+1);
+  EXPECT_THROW(aCalculator.LoadPedestalTable(aTable), std::runtime_error);
+  aCalculator.SetMaxSignalCell(lastCell-1);
+  aCalculator.SetMinSignalCell(firstCell+1);
+  EXPECT_NO_THROW(aCalculator.LoadPedestalTable(aTable));
+}
+#endif
@@ -0,0 +1,125 @@
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/UVWprojector.h"
+#include "gtest/gtest.h"
+#include <TH2D.h>
+#include <boost/filesystem.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+const std::string geometryFile =
+    std::string(TPCRECO_RESOURCE_DIR) + "geometry_ELITPC_250mbar_12.5MHz.dat";
+
+// access to the area mapping of the projector
+class AreaMappingProbe : public UVWprojector {
+public:
+  using UVWprojector::UVWprojector;
+  const std::map<MultiKey2, BinFracMap> &getAreaFractionMap() const {
+    return fAreaFractionMap;
+  }
+};
+} // namespace
+
+class UVWprojectorTest : public ::testing::Test {
+public:
+  static std::shared_ptr<GeometryTPC> myGeometryPtr;
+
+  static void SetUpTestSuite() {
+    GeometryTPC::SetCompiledGeometryDir("");
+    myGeometryPtr = std::make_shared<GeometryTPC>(geometryFile.c_str(), false);
+  }
+  static void TearDownTestSuite() { myGeometryPtr.reset(); }
+
+  static TH2D makeHistogram() {
+    double xmin, xmax, ymin, ymax;
+    std::tie(xmin, xmax, ymin, ymax) = myGeometryPtr->rangeXY();
+    TH2D histo("hXY", "", 100, xmin - 5, xmax + 5, 100, ymin - 5, ymax + 5);
+    histo.SetDirectory(nullptr);
+    return histo;
+  }
+
+  // sums of strip fractions of each XY bin, separately for U, V and W strips
+  static std::map<MultiKey2, std::vector<double>>
+  getDirectionSums(const AreaMappingProbe &aProjector) {
+    std::map<MultiKey2, std::vector<double>> sums;
+    for (const auto &aItem : aProjector.getAreaFractionMap()) {
+      auto &aSums = sums[aItem.first];
+      aSums.assign(3, 0.0);
+      for (const auto &aFraction : aItem.second.FracMap) {
+        auto aStrip = myGeometryPtr->GetTH2PolyStrip(aFraction.first);
+        EXPECT_TRUE(aStrip);
+        if (aStrip) {
+          aSums.at(aStrip->Dir()) += aFraction.second;
+        }
+      }
+    }
+    return sums;
+  }
+};
+
+std::shared_ptr<GeometryTPC> UVWprojectorTest::myGeometryPtr;
+
+TEST_F(UVWprojectorTest, StripFractionsSumToOne) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  AreaMappingProbe aProjector(myGeometryPtr);
+  aProjector.SetAreaCacheDir("");
+  auto histo = makeHistogram();
+  aProjector.SetEvent2D(histo);
+  auto sums = getDirectionSums(aProjector);
+  ASSERT_FALSE(sums.empty());
+
+  // strips of each direction tile the active area, bins far from its edge
+  // are fully covered by strips of every direction
+  const double margin = 2 * myGeometryPtr->GetPadSize();
+  int nInside = 0;
+  for (const auto &aItem : sums) {
+    int ix = std::get<0>(aItem.first);
+    int iy = std::get<1>(aItem.first);
+    double x1 = histo.GetXaxis()->GetBinLowEdge(ix + 1) - margin;
+    double x2 = histo.GetXaxis()->GetBinUpEdge(ix + 1) + margin;
+    double y1 = histo.GetYaxis()->GetBinLowEdge(iy + 1) - margin;
+    double y2 = histo.GetYaxis()->GetBinUpEdge(iy + 1) + margin;
+    bool isInside = myGeometryPtr->IsInsideActiveArea(x1, y1) &&
+                    myGeometryPtr->IsInsideActiveArea(x1, y2) &&
+                    myGeometryPtr->IsInsideActiveArea(x2, y1) &&
+                    myGeometryPtr->IsInsideActiveArea(x2, y2);
+    nInside += isInside;
+    for (int dir = definitions::projection_type::DIR_U;
+         dir <= definitions::projection_type::DIR_W; ++dir) {
+      EXPECT_LE(aItem.second[dir], 1.0 + 1E-9)
+          << "IX=" << ix << " IY=" << iy << " DIR=" << dir;
+      if (isInside) {
+        EXPECT_NEAR(aItem.second[dir], 1.0, 1E-9)
+            << "IX=" << ix << " IY=" << iy << " DIR=" << dir;
+      }
+    }
+  }
+  EXPECT_GT(nInside, 0);
+}
+
+TEST_F(UVWprojectorTest, SameMappingFromCache) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  auto cacheDir = boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("UVWprojector_tst_%%%%%%%%");
+  auto histo = makeHistogram();
+  AreaMappingProbe aProjector(myGeometryPtr);
+  aProjector.SetAreaCacheDir(cacheDir.string());
+  aProjector.SetEvent2D(histo); // writes the cache
+  AreaMappingProbe aCachedProjector(myGeometryPtr);
+  aCachedProjector.SetAreaCacheDir(cacheDir.string());
+  aCachedProjector.SetEvent2D(histo);
+  boost::filesystem::remove_all(cacheDir);
+
+  const auto &aMap = aProjector.getAreaFractionMap();
+  const auto &aCachedMap = aCachedProjector.getAreaFractionMap();
+  ASSERT_EQ(aMap.size(), aCachedMap.size());
+  auto it = aCachedMap.begin();
+  for (const auto &aItem : aMap) {
+    EXPECT_EQ(aItem.first, it->first);
+    EXPECT_EQ(aItem.second.FracMap, it->second.FracMap);
+    ++it;
+  }
+}
@@ -0,0 +1,86 @@
+#ifndef EventLoader_H
+#define EventLoader_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <TTimer.h>
+#include <RQ_OBJECT.h>
+
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+// Runs event loading and reconstruction of the GUI in a worker thread.
+// Load tasks (next event, go to entry, new file, ...) are executed in the
+// order of submission. When no more load tasks are queued the prepare task
+// (e.g. reconstruction) is run and the EventLoaded() signal is emitted from
+// the GUI thread. A request submitted meanwhile makes the result stale:
+// the prepare task can check hasNewRequest() to stop early, and stale
+// results are never delivered.
+// The worker holds getMutex() while running tasks, the GUI thread takes
+// it before using the objects shared with the tasks.
+class EventLoader {
+
+	RQ_OBJECT("EventLoader")
+
+public:
+
+	typedef std::function<void()> Task;
+
+	EventLoader(int pollInterval = 50); // [ms]
+	virtual ~EventLoader();
+
+	void setPrepareTask(const Task& aTask) { myPrepareTask = aTask; }
+
+	// can be called from any thread
+	void submit(const Task& aLoadTask);
+
+	// true until the result of the last submitted task is delivered
+	bool isBusy() const { return myDeliveredRequest != mySubmittedRequest; }
+
+	// true when the work in progress is already stale, for the prepare task
+	bool hasNewRequest() const { return myWorkerRequest != mySubmittedRequest; }
+
+	std::mutex& getMutex() { return myMutex; }
+
+	void stop();
+
+	void EventLoaded(); //*SIGNAL*
+
+private:
+
+	class ResultTimer : public TTimer {
+	public:
+		ResultTimer(EventLoader* aLoader, int pollInterval) : TTimer(pollInterval), myLoader(aLoader) {}
+		virtual Bool_t Notify() { myLoader->deliverResult(); Reset(); return kTRUE; }
+	private:
+		EventLoader* myLoader;
+	};
+
+	void run();
+	void deliverResult(); // GUI thread
+
+	Task myPrepareTask;
+	std::deque<Task> myTaskQueue;
+	std::mutex myQueueMutex;
+	std::condition_variable myQueueCondition;
+	std::mutex myMutex;
+	bool isStopped{ false };
+
+	// request counters: submitted by the GUI, taken by the worker,
+	// finished by the worker and delivered to the GUI
+	std::atomic<unsigned long> mySubmittedRequest{ 0 };
+	std::atomic<unsigned long> myWorkerRequest{ 0 };
+	std::atomic<unsigned long> myFinishedRequest{ 0 };
+	std::atomic<unsigned long> myDeliveredRequest{ 0 };
+
+	std::unique_ptr<ResultTimer> myTimer;
+	std::thread myWorkerThread;
+};
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+#endif
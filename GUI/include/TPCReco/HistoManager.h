@@ -21,6 +21,7 @@
 #include "TPCReco/IonRangeCalculator.h"
 
 #include "TPCReco/CommonDefinitions.h"
+#include "TPCReco/TypedConfig.h"
 
 class TH2D;
 class TH3D;
@@ -66,12 +67,14 @@ public:
 
   void drawRecoFromMarkers(TCanvas *aCanvas, std::vector<double> * segmentsXY);
 
-  void clearCanvas(TCanvas *aCanvas, bool isLogScaleOn);
+  // clears all pads, with update=false the canvas is repainted by the next draw call
+  void clearCanvas(TCanvas *aCanvas, bool isLogScaleOn, bool update=true);
 
   void clearTracks();
 
   void clearObjects();
 
+  // reconstructs the current event, once per setEvent() call
   void reconstruct();
 
   void reconstructSegmentsFromMarkers(std::vector<double> * segmentsXY);
@@ -121,6 +124,7 @@ private:
   void setDetLayoutVetoBand(double distance); // [mm]
 
   boost::property_tree::ptree myConfig;
+  tpcreco::config::HitFilterConfig myHitFilterConfig; // made once from myConfig
 
   IonRangeCalculator myRangeCalculator;
   std::vector<TH2D*> projectionsInCartesianCoords;
@@ -143,6 +147,7 @@ private:
   std::vector<TObject*> fTrackLines;
 
   bool doAutozoom{false};
+  bool isReconstructed{false};
   bool openOutputStreamInitialized{false};
 
   Long64_t previousEventTime{-1};
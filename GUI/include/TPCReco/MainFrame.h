@@ -2,7 +2,6 @@
 #define MainFrame_H
 
 #include <thread>
-#include <mutex>
 #include <string>
 
 #include <TGDockableFrame.h>
@@ -35,6 +34,7 @@
 
 #include "TPCReco/HistoManager.h"
 #include "TPCReco/DirectoryWatch.h"
+#include "TPCReco/EventLoader.h"
 
 #include <boost/property_tree/json_parser.hpp>
 
@@ -63,6 +63,9 @@ public:
 
 	void DoButton();
 
+	// slot for EventLoader::EventLoaded(), called in the GUI thread
+	void HandleEventLoaded();
+
 private:
 
 	void InitializeEventSource();
@@ -84,7 +87,10 @@ private:
 
 	void SetCursorTheme();
 
-	void ClearCanvases();
+	void ClearCanvases(bool update = true);
+	// loads an event in the worker thread, the canvases are redrawn when it is ready
+	void RequestEvent(const EventLoader::Task& aLoadTask = EventLoader::Task());
+	void PrepareEvent(); // worker thread
 	void Update();
 	unsigned long UpdateEventLog();
 
@@ -99,7 +105,7 @@ private:
 	HistoManager myHistoManager;
 
 	std::thread fileWatchThread;
-	std::mutex myMutex;
+	EventLoader myEventLoader;
 
 	TGCompositeFrame* fFrame{ 0 };
 	TRootEmbeddedCanvas* embeddedCanvas{ 0 };
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <exception>
+
+#include "TPCReco/EventLoader.h"
+#include "TPCReco/colorText.h"
+
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+EventLoader::EventLoader(int pollInterval) {
+
+	myWorkerThread = std::thread(&EventLoader::run, this);
+	// results are picked up by the GUI event loop
+	myTimer.reset(new ResultTimer(this, pollInterval));
+	myTimer->TurnOn();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+EventLoader::~EventLoader() {
+
+	stop();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventLoader::stop() {
+
+	if (myTimer) myTimer->TurnOff();
+	{
+		std::lock_guard<std::mutex> lock(myQueueMutex);
+		isStopped = true;
+		myTaskQueue.clear();
+	}
+	myQueueCondition.notify_all();
+	if (myWorkerThread.joinable()) myWorkerThread.join();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventLoader::submit(const Task& aLoadTask) {
+
+	{
+		std::lock_guard<std::mutex> lock(myQueueMutex);
+		if (isStopped) return;
+		myTaskQueue.push_back(aLoadTask);
+		++mySubmittedRequest;
+	}
+	myQueueCondition.notify_one();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventLoader::run() {
+
+	while (true) {
+		Task aTask;
+		unsigned long request = 0;
+		{
+			std::unique_lock<std::mutex> lock(myQueueMutex);
+			myQueueCondition.wait(lock, [this]() { return isStopped || !myTaskQueue.empty(); });
+			if (isStopped) return;
+			aTask = std::move(myTaskQueue.front());
+			myTaskQueue.pop_front();
+			request = ++myWorkerRequest;
+		}
+		std::lock_guard<std::mutex> lock(myMutex);
+		try {
+			if (aTask) aTask();
+			// intermediate events of a skip ahead are not prepared
+			if (hasNewRequest() || !myPrepareTask) continue;
+			myPrepareTask();
+		}
+		catch (const std::exception& e) {
+			std::cerr << __FUNCTION__ << KRED << ": Event loading failed: " << RST << e.what() << std::endl;
+		}
+		myFinishedRequest = request;
+	}
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventLoader::deliverResult() {
+
+	unsigned long finished = myFinishedRequest;
+	if (finished == myDeliveredRequest || finished != mySubmittedRequest) return;
+	myDeliveredRequest = finished;
+	EventLoaded();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void EventLoader::EventLoaded() {
+
+	Emit("EventLoaded()");
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
@@ -56,6 +56,7 @@ void HistoManager::setPressure(double aPressure){
 void HistoManager::setConfig(const boost::property_tree::ptree &aConfig){
   
   myConfig = aConfig;
+  myHitFilterConfig = tpcreco::config::HitFilterConfig::fromConfig(myConfig);
 
 }
 /////////////////////////////////////////////////////////
@@ -71,13 +72,16 @@ void HistoManager::setEvent(std::shared_ptr<EventTPC> aEvent){
   
   if(!aEvent) return;
   myEventPtr = aEvent;
-  myEventPtr->setHitFilterConfig(filter_type::threshold, myConfig);
+  myEventPtr->setHitFilterConfig(filter_type::threshold, myHitFilterConfig);
   myTkBuilder.setEvent(myEventPtr);
+  isReconstructed = false;
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 void HistoManager::reconstruct(){
+  if(isReconstructed) return;
   if(myEventPtr->GetEventInfo().GetPedestalSubtracted()) myTkBuilder.reconstruct();
+  isReconstructed = true;
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -97,26 +101,24 @@ void HistoManager::drawRawHistos(TCanvas *aCanvas, bool isRateDisplayOn){
     TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+strip_dir+1);
     if(!aPad) return;
     aPad->cd();
-    aCanvas->Modified();
-    aCanvas->Update();
     auto projType = get2DProjectionType(strip_dir);
     aPad->SetFrameFillColor(kAzure-6);
     get2DProjection(projType, filter_type::none, scale_type::raw)->DrawCopy("colz");
     aPad->RedrawAxis();
+    aPad->Modified();
   }
 
   int strip_dir=3;
   TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+strip_dir+1);
   if(!aPad) return;
   aPad->cd();
-  aCanvas->Modified();
-  aCanvas->Update();
   if(isRateDisplayOn){
     getEventRateGraph()->DrawClone("AP");
   } else{
     get1DProjection(definitions::projection_type::DIR_TIME, filter_type::none, scale_type::raw)->DrawCopy("hist");
   }
-  aCanvas->Modified();
+  aPad->Modified();
+  // repaints the modified pads only
   aCanvas->Update();
 }
 /////////////////////////////////////////////////////////
@@ -130,14 +132,12 @@ void HistoManager::drawTechnicalHistos(TCanvas *aCanvas, int nAgetChips){
   auto cobo_id=0;
   for( int aget_id = 0; aget_id <nAgetChips; ++aget_id ){
     TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+aget_id+1);
-    if(!aPad) return;
+    if(!aPad) break;
     aPad->cd();
-    aCanvas->Modified();
-    aCanvas->Update();
     getChannels(cobo_id, aget_id)->DrawCopy("colz");
-    aCanvas->Modified();
-    aCanvas->Update();
+    aPad->Modified();
   }
+  aCanvas->Update();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -149,20 +149,18 @@ void HistoManager::drawRecoHistos(TCanvas *aCanvas){
   
   //reco disabled for clicking campaign reconstruct();
   filter_type filterType = filter_type::threshold;
-  if(!myConfig.get<bool>("hitFilter.recoClusterEnable")) filterType = filter_type::none;
+  if(!myHitFilterConfig.enable) filterType = filter_type::none;
 
    for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
      TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+strip_dir+1);
      if(!aPad) return;
      aPad->cd();
-     aCanvas->Modified();
-     aCanvas->Update();
 
      auto projType = get2DProjectionType(strip_dir);     
      auto histo2D = get2DProjection(projType, filterType, scale_type::mm);
      aPad->SetFrameFillColor(kAzure-6);
      /*
-     if(myConfig.get<bool>("hitFilter.recoClusterEnable")){
+     if(myHitFilterConfig.enable){
        histo2D->SetMinimum(0.0);
        histo2D->DrawCopy("colz");
        if(aPad->GetLogz()) histo2D->SetMinimum(1.0);
@@ -172,17 +170,16 @@ void HistoManager::drawRecoHistos(TCanvas *aCanvas){
        drawTrack3DProjectionTimeStrip(strip_dir, aPad, false);	    
      }
      else */histo2D->DrawCopy("colz");
+     aPad->Modified();
    }
    int strip_dir=3;
    TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+strip_dir+1);
    if(!aPad) return;
    aPad->cd();
-   aCanvas->Modified();
-   aCanvas->Update();
-   /*   if(myConfig.get<bool>("hitFilter.recoClusterEnable")) drawChargeAlongTrack3D(aPad);
+   /*   if(myHitFilterConfig.enable) drawChargeAlongTrack3D(aPad);
 	else  */get1DProjection(definitions::projection_type::DIR_TIME, filterType, scale_type::mm)->DrawCopy("hist");
 
-   aCanvas->Modified();
+   aPad->Modified();
    aCanvas->Update(); 
 }
 /////////////////////////////////////////////////////////
@@ -193,18 +190,15 @@ void HistoManager::drawRecoFromMarkers(TCanvas *aCanvas, std::vector<double> * s
   
   for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
     TVirtualPad *aPad = aCanvas->cd(strip_dir+1);
-    aCanvas->Modified();
-    aCanvas->Update();
     drawTrack3DProjectionTimeStrip(strip_dir, aPad, false);
+    if(aPad) aPad->Modified();
   }
    int strip_dir=3;
    TVirtualPad *aPad = aCanvas->GetPad(strip_dir+1);
    if(!aPad) return;   
    aPad->cd();
-   aCanvas->Modified();
-   aCanvas->Update();
    drawTrack3DProjectionXY(aPad);
-   aCanvas->Modified();
+   aPad->Modified();
    aCanvas->Update();
 }
 /////////////////////////////////////////////////////////
@@ -215,16 +209,14 @@ void HistoManager::drawDevelHistos(TCanvas *aCanvas){
   int padNumberOffset = 0;
   if(std::string(aCanvas->GetName())=="Histograms") padNumberOffset = 0;
   
-  reconstruct();
+  reconstruct(); // no-op when already done for this event
   //TEST filter_type filterType = filter_type::threshold;
-  //TEST if(!myConfig.get<bool>("hitFilter.recoClusterEnable")) filterType = filter_type::none;
+  //TEST if(!myHitFilterConfig.enable) filterType = filter_type::none;
 
    for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
      TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+strip_dir+1);
      if(!aPad) return;
      aPad->cd();
-     aCanvas->Modified();
-     aCanvas->Update();
      
      //TEST auto projType = get2DProjectionType(strip_dir);     
      //TEST auto histo2D = get2DProjection(projType, filterType, scale_type::mm);
@@ -233,7 +225,7 @@ void HistoManager::drawDevelHistos(TCanvas *aCanvas){
 
      aPad->SetFrameFillColor(kAzure-6);
      
-     if(myConfig.get<bool>("hitFilter.recoClusterEnable")){
+     if(myHitFilterConfig.enable){
        histo2D->SetMinimum(0.0);
        histo2D->DrawCopy("colz");
        if(aPad->GetLogz()) histo2D->SetMinimum(1.0);
@@ -246,23 +238,22 @@ void HistoManager::drawDevelHistos(TCanvas *aCanvas){
      }
      
      drawTrack3DProjectionTimeStrip(strip_dir, aPad, false);
+     aPad->Modified();
    }
    int strip_dir=3;
    TVirtualPad *aPad = aCanvas->GetPad(padNumberOffset+strip_dir+1);
    if(!aPad) return;
    aPad->cd();
-   aCanvas->Modified();
-   aCanvas->Update();
 
    if(myTkBuilder.getTrack3D(0).getSegments().front().getPID()==pid_type::DOT) drawTrack3DProjectionXY(aPad);
    else drawChargeAlongTrack3D(aPad);
 
-   aCanvas->Modified();
+   aPad->Modified();
    aCanvas->Update();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
-void HistoManager::clearCanvas(TCanvas *aCanvas, bool isLogScaleOn){
+void HistoManager::clearCanvas(TCanvas *aCanvas, bool isLogScaleOn, bool update){
 
   if(!aCanvas) return; 
   TList *aList = aCanvas->GetListOfPrimitives();
@@ -274,9 +265,9 @@ void HistoManager::clearCanvas(TCanvas *aCanvas, bool isLogScaleOn){
     aPad->cd();
     aMessage.DrawTextNDC(0.3, 0.5,"Waiting for data.");
     aPad->SetLogz(isLogScaleOn);
+    aPad->Modified();
   }
-  aCanvas->Modified();  
-  aCanvas->Update();
+  if(update) aCanvas->Update();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -35,6 +35,10 @@ MainFrame::MainFrame(const TGWindow* p, UInt_t w, UInt_t h, const boost::propert
 
 	myConfig = aConfig;
 
+	// events are loaded and reconstructed in the worker thread of myEventLoader
+	myEventLoader.setPrepareTask([this]() { PrepareEvent(); });
+	myEventLoader.Connect("EventLoaded()", "MainFrame", this, "HandleEventLoaded()");
+
 	fSelectionBox = 0;
 	InitializeEventSource();
 	InitializeWindows();
@@ -53,7 +57,7 @@ MainFrame::MainFrame(const TGWindow* p, UInt_t w, UInt_t h, const boost::propert
 		modeLabel = "OFFLINE from GRAW";
 	}
 	fFileInfoFrame->updateModeLabel(modeLabel);
-	Update();
+	RequestEvent();
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -511,23 +515,51 @@ void MainFrame::AddLogos() {
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
 void MainFrame::CloseWindow() {
+	myEventLoader.stop();
 	myHistoManager.~HistoManager();
 	gApplication->Terminate(0);
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
-void MainFrame::ClearCanvases() {
+void MainFrame::ClearCanvases(bool update) {
 
-	myHistoManager.clearCanvas(fMainCanvas, isLogScaleOn);
-	myHistoManager.clearCanvas(fRawHistosCanvas, isLogScaleOn);
-	myHistoManager.clearCanvas(fTechHistosCanvas, isLogScaleOn);
+	myHistoManager.clearCanvas(fMainCanvas, isLogScaleOn, update);
+	myHistoManager.clearCanvas(fRawHistosCanvas, isLogScaleOn, update);
+	myHistoManager.clearCanvas(fTechHistosCanvas, isLogScaleOn, update);
 	myHistoManager.clearObjects();
 
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void MainFrame::RequestEvent(const EventLoader::Task& aLoadTask) {
+
+	myEventLoader.submit(aLoadTask);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void MainFrame::PrepareEvent() {
+
+	if (!myEventSource || !myEventSource->numberOfEvents()) return;
+	myHistoManager.setEvent(myEventSource->getCurrentEvent());
+	// tracks are drawn in the development mode only
+	if (myConfig.get<bool>("display.develMode") && !myEventLoader.hasNewRequest()) {
+		myHistoManager.reconstruct();
+	}
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void MainFrame::HandleEventLoaded() {
+
+	Update();
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 void MainFrame::Update() {
 
+	// an event being loaded is drawn when ready
+	std::unique_lock<std::mutex> lock(myEventLoader.getMutex(), std::try_to_lock);
+	if (!lock.owns_lock() || myEventLoader.isBusy()) return;
+
 	if (!myEventSource || !myEventSource->numberOfEvents() ||
 		!fFileInfoFrame || !fMarkersManager) {
 		return;
@@ -536,10 +568,9 @@ void MainFrame::Update() {
 	fFileInfoFrame->updateEventNumbers(myEventSource->numberOfEvents(),
 									   myEventSource->currentEventNumber(),
 									   myEventSource->currentEntryNumber());
-	myHistoManager.setEvent(myEventSource->getCurrentEvent());
 	fMarkersManager->reset();
 	fMarkersManager->setEnabled(isRecoModeOn);
-	ClearCanvases();
+	ClearCanvases(false);
 	
 	if (isRecoModeOn) myHistoManager.drawRecoHistos(fMainCanvas);
 	else if(myConfig.get<bool>("display.develMode")) {
@@ -555,6 +586,9 @@ void MainFrame::Update() {
 /////////////////////////////////////////////////////////
 void MainFrame::processSegmentData(std::vector<double>* segmentsXY) {
 
+	// markers belong to the displayed event
+	std::unique_lock<std::mutex> lock(myEventLoader.getMutex(), std::try_to_lock);
+	if (!lock.owns_lock() || myEventLoader.isBusy()) return;
 	myHistoManager.drawRecoFromMarkers(fMainCanvas, segmentsXY);
 
 }
@@ -611,14 +645,14 @@ void MainFrame::updateRunConditions(std::vector<double>* runParams) {
 	if (!runParams || !myEventSource ||
 		!myEventSource->getGeometry() ||
 		runParams->size() < 3) return;
-	myEventSource->getGeometry()->setDriftVelocity(runParams->at(0));
-	myEventSource->getGeometry()->setSamplingRate(runParams->at(1));
-	myEventSource->getGeometry()->setTriggerDelay(runParams->at(2));
-	std::cout << myEventSource->getGeometry()->getRunConditions() << _endl_;
-	if (isRecoModeOn) {
-		ClearCanvases();
-		Update();
-	}
+	// geometry is used by the worker thread, the event is reconstructed again
+	std::vector<double> aRunParams = *runParams;
+	RequestEvent([this, aRunParams]() {
+		myEventSource->getGeometry()->setDriftVelocity(aRunParams.at(0));
+		myEventSource->getGeometry()->setSamplingRate(aRunParams.at(1));
+		myEventSource->getGeometry()->setTriggerDelay(aRunParams.at(2));
+		std::cout << myEventSource->getGeometry()->getRunConditions() << _endl_;
+	});
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
@@ -663,11 +697,12 @@ Bool_t MainFrame::ProcessMessage(const char* msg) {
 #ifdef DEBUG
 	std::cout << __FUNCTION__ << " msg: " << msg << _endl_;
 #endif
-	myMutex.lock();
-	myEventSource->loadDataFile(std::string(msg));
-	myEventSource->getLastEvent();
-	Update();
-	myMutex.unlock();
+	// called from the DirectoryWatch thread
+	std::string fileName(msg);
+	RequestEvent([this, fileName]() {
+		myEventSource->loadDataFile(fileName);
+		myEventSource->getLastEvent();
+	});
 	return kTRUE;
 }
 /////////////////////////////////////////////////////////
@@ -689,8 +724,14 @@ void MainFrame::HandleMenu(Int_t id) {
 		// this is very naive and risky implementation of extracting dir from path
 		// but we don't have std::filesystem c++17 and ROOT 6.08 doesn't have TSystem::GetDirName
 		// this will cause problem if we add changing directories in ONLINE mode 
-		auto currentFilePath = myEventSource->getCurrentPath();
-		auto dirPath = currentFilePath.substr(0, currentFilePath.find_last_of('/'));
+		std::string dirPath = ".";
+		{
+			std::unique_lock<std::mutex> lock(myEventLoader.getMutex(), std::try_to_lock);
+			if (lock.owns_lock()) {
+				auto currentFilePath = myEventSource->getCurrentPath();
+				dirPath = currentFilePath.substr(0, currentFilePath.find_last_of('/'));
+			}
+		}
 		TGFileInfo fi;
 		fi.fFileTypes = filetypes;
 		fi.fIniDir = StrDup(dirPath.c_str());
@@ -701,9 +742,10 @@ void MainFrame::HandleMenu(Int_t id) {
 		if (fi.fFilename) fileName.append(fi.fFilename);
 		else return;
 		gSystem->cd(oldDirectory.c_str());
-		myEventSource->loadDataFile(fileName);
-		myEventSource->loadFileEntry(0);
-		Update();
+		RequestEvent([this, fileName]() {
+			myEventSource->loadDataFile(fileName);
+			myEventSource->loadFileEntry(0);
+		});
 	}
 	break;
 
@@ -721,22 +763,27 @@ void MainFrame::HandleMenu(Int_t id) {
 
 	case M_NEXT_EVENT:
 	{
-		unsigned int eventType = UpdateEventLog();
-		if (isRecoModeOn) myHistoManager.writeRecoData(eventType);
-		myEventSource->getNextEventLoop();
-		Update();
+		// only the displayed event is logged, not the ones skipped before they were drawn
+		std::unique_lock<std::mutex> lock(myEventLoader.getMutex(), std::try_to_lock);
+		if (lock.owns_lock() && !myEventLoader.isBusy()) {
+			unsigned int eventType = UpdateEventLog();
+			if (isRecoModeOn) myHistoManager.writeRecoData(eventType);
+		}
+		if (lock.owns_lock()) lock.unlock();
+		RequestEvent([this]() { myEventSource->getNextEventLoop(); });
 	}
 	break;
 	case M_PREVIOUS_EVENT:
 	{
-		UpdateEventLog();
-		myEventSource->getPreviousEventLoop();
-		Update();
+		std::unique_lock<std::mutex> lock(myEventLoader.getMutex(), std::try_to_lock);
+		if (lock.owns_lock() && !myEventLoader.isBusy()) UpdateEventLog();
+		if (lock.owns_lock()) lock.unlock();
+		RequestEvent([this]() { myEventSource->getPreviousEventLoop(); });
 	}
 	break;
 	case M_RESET_EVENT:
 	{
-		Update();
+		RequestEvent();
 	}
 	break;
 	case M_RESET_RATE:
@@ -774,20 +821,18 @@ void MainFrame::HandleMenu(Int_t id) {
 	case M_GOTO_EVENT:
 	{
 		int eventId = fEventIdEntry->GetIntNumber();
-		myEventSource->loadEventId(eventId);
-		Update();
+		RequestEvent([this, eventId]() { myEventSource->loadEventId(eventId); });
 	}
 	break;
 	case M_GOTO_ENTRY:
 	{
 		int fileEntry = fFileEntryEntry->GetIntNumber();
-		myEventSource->loadFileEntry(fileEntry);
-		Update();
+		RequestEvent([this, fileEntry]() { myEventSource->loadFileEntry(fileEntry); });
 	}
 	break;
 	case M_DIR_WATCH:
 	{
-		Update();
+		RequestEvent();
 	}
 	break;
 	case M_FILE_EXIT:
@@ -160,8 +160,8 @@ int main(int argc, char *argv[]) {
   */
   aTree.Print();
 
-  // build index based on: majorname=EventId, minorname=NONE
-  //aTree.BuildIndex("eventId");
+  // index stored with the tree, see EventIndex::attach()
+  aTree.BuildIndex("EventInfo.runId", "EventInfo.eventId");
   aTree.Write("", TObject::kOverwrite); // save only the new version of the tree
   aFile.Close();
 
@@ -71,17 +71,18 @@ void PedestalCalculatorGRAW::CalculateEventPedestals(const GET::GDataFrame & dat
   calculateMean = false;
   ProcessDataFrame(dataFrame, calculateMean);
 
-  // update vector with pedestals
+  // update vector with pedestals of this frame {COBO, ASAD} only,
+  // so that frames of different ASADs can be processed concurrently
   //  pedestals.clear();
-  for(int coboId = 0; coboId < myGeometryPtr->GetCoboNboards(); coboId++) {
-    for(int asadId = 0; asadId < myGeometryPtr->GetAsadNboards(coboId); asadId++) {
-      MultiKey2 mkey(coboId, asadId);
-      auto it=prof_pedestal_map.find(mkey);
-      if(it==prof_pedestal_map.end()) continue;
-      pedestals[coboId][asadId].clear();
-      for(Int_t ibin=1; ibin<=(it->second)->GetNbinsX(); ibin++) {
-	pedestals[coboId][asadId].push_back( (it->second)->GetBinContent(ibin) ); //mean
-      }
+  int coboId = dataFrame.fHeader.fCoboIdx;
+  int asadId = dataFrame.fHeader.fAsadIdx;
+  auto it=prof_pedestal_map.find(MultiKey2(coboId, asadId));
+  if(it!=prof_pedestal_map.end()) {
+    pedestals[coboId][asadId].clear();
+    pedestalRMS[coboId][asadId].clear();
+    for(Int_t ibin=1; ibin<=(it->second)->GetNbinsX(); ibin++) {
+      pedestals[coboId][asadId].push_back( (it->second)->GetBinContent(ibin) ); //mean
+      pedestalRMS[coboId][asadId].push_back( (it->second)->GetBinError(ibin) ); //rms
     }
   }
   /*
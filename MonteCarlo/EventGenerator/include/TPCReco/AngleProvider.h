@@ -2,8 +2,7 @@
 #define TPCSOFT_ANGLEPROVIDER_H
 
 #include "TPCReco/Provider.h"
-
-class TF1;
+#include "TPCReco/SamplingTable.h"
 
 class AngleProvider : public Provider {
 public:
@@ -27,9 +26,10 @@ public:
     double GetAngle() override;
 protected:
     void ValidateParamValues() override;
+    void Init() override;
 private:
-    double Theta(double *x, double *par);
-    std::unique_ptr<TF1> thetaEmissionTF1;
+    double Theta(double theta);
+    utl::InverseCDFTable thetaEmissionTable;
 
 REGISTER_PROVIDER(AngleProviderE1E2)
 };
@@ -48,12 +48,13 @@ class AngleProviderPhi : public AngleProvider {
 public:
     AngleProviderPhi();
     double GetAngle() override;
-    double Phi(double *x, double *par);
+    double Phi(double phi);
 protected:
     void ValidateParamValues() override;
+    void Init() override;
 private:
 
-    std::unique_ptr<TF1> phiEmissionTF1;
+    utl::InverseCDFTable phiEmissionTable;
 REGISTER_PROVIDER(AngleProviderPhi)
 };
 
@@ -20,6 +20,9 @@ public:
 
     SimEvent GenerateEvent();
 
+    //Sets the engine used by all providers and reactions of this generator (by default gRandom).
+    //Generators running in parallel need separate engines, e.g. TRandom3 with different seeds.
+    void SetRandomEngine(TRandom *engine);
 
 
 private:
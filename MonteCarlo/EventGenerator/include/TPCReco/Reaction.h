@@ -9,6 +9,8 @@
 #include "Math/Boost.h"
 #include "Math/Rotation3D.h"
 
+class TRandom;
+
 class Reaction {
 public:
     Reaction();
@@ -18,8 +20,12 @@ public:
     virtual PrimaryParticles
     GeneratePrimaries(double gammaMom, const ROOT::Math::Rotation3D &beamToDetRotation) = 0;
 
+    //engine used by the reaction and its providers, by default gRandom
+    virtual void SetRandomEngine(TRandom *engine) { randEngine = engine; }
+
 protected:
     std::shared_ptr<IonProperties> ionProp;
+    TRandom *randEngine;
 
     void GetKinematics(double gammaMom, const double &targetMass);
     static void CheckStoichiometry(const std::vector<pid_type> &substrates, const std::vector<pid_type> &products);
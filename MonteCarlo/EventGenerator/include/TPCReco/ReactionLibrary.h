@@ -4,8 +4,9 @@
 #include <memory>
 #include "Reaction.h"
 #include "TPCReco/CommonDefinitions.h"
-#include "TH1D.h"
+#include "TPCReco/SamplingTable.h"
 #include "Math/Vector3D.h"
+#include "TRandom.h"
 
 class ReactionLibrary {
 public:
@@ -17,6 +18,9 @@ public:
 
     void Init();
 
+    //engine used to select reactions and by the reactions themselves, by default gRandom
+    void SetRandomEngine(TRandom *engine);
+
 private:
     struct ReactionEntry {
         std::unique_ptr<Reaction> aReaction;
@@ -25,7 +29,8 @@ private:
     };
 
     std::vector<ReactionEntry> reactions;
-    std::unique_ptr<TH1D> selectionHelperHisto;
+    utl::DiscreteSamplingTable selectionTable;
+    TRandom *randEngine{gRandom};
     bool initialized = false;
 };
 
@@ -16,6 +16,8 @@ public:
     PrimaryParticles
     GeneratePrimaries(double v, const ROOT::Math::Rotation3D &beamToDetRotation) override;
 
+    void SetRandomEngine(TRandom *engine) override;
+
 private:
     double particleMass;
     pid_type particleId;
@@ -5,8 +5,7 @@
 
 #include "Reaction.h"
 #include "AngleProvider.h"
-#include "TH1D.h"
-#include "TF1.h"
+#include "TPCReco/SamplingTable.h"
 
 class ReactionThreeProngIntermediate: public Reaction{
 public:
@@ -25,10 +24,11 @@ public:
                 :thetaFirst{std::move(thetaFirstDecay)}, thetaSecond{std::move(thetaSecondDecay)},
                  phiFirst{std::move(phiFirstDecay)}, phiSecond{std::move(phiSecondDecay)},
                  intermediateStates{std::move(intermediateStates)} {
-        bwTF1=std::make_unique<TF1>("","TMath::BreitWigner(x, 0, 1)",-10,10);
+        InitSamplingTables();
     }
     PrimaryParticles
     GeneratePrimaries(double gammaMom, const ROOT::Math::Rotation3D &beamToDetRotation) override;
+    void SetRandomEngine(TRandom *engine) override;
     std::pair<double, double> SelectIntermediateState();
 private:
     std::unique_ptr<AngleProvider> thetaFirst;
@@ -36,9 +36,9 @@ private:
     std::unique_ptr<AngleProvider> phiFirst;
     std::unique_ptr<AngleProvider> phiSecond;
     std::vector<IntermediateState> intermediateStates;
-    bool isBrInitialized{false};
-    std::unique_ptr<TH1D> brHelperHisto;
-    std::unique_ptr<TF1> bwTF1;
+    utl::DiscreteSamplingTable brTable;
+    utl::InverseCDFTable bwTable;
+    void InitSamplingTables();
     double BreitWignerRandom();
 };
 
@@ -16,6 +16,8 @@ public:
     PrimaryParticles
     GeneratePrimaries(double gammaMom, const ROOT::Math::Rotation3D &beamToDetRotation) override;
 
+    void SetRandomEngine(TRandom *engine) override;
+
 private:
     std::unique_ptr<AngleProvider> thetaProv;
     std::unique_ptr<AngleProvider> phiProv;
@@ -2,10 +2,9 @@
 #define TPCSOFT_XYPROVIDER_H
 
 #include "TPCReco/Provider.h"
+#include "TPCReco/SamplingTable.h"
 #include <utility>
 
-class TF2;
-
 class XYProvider : public Provider {
 public:
     typedef std::pair<double, double> xyVal;
@@ -19,9 +18,10 @@ public:
     xyVal GetXY() override;
 protected:
     void ValidateParamValues() override;
+    void Init() override;
 private:
-    double Profile(double *x, double *par);
-    std::unique_ptr<TF2> profileTF2;
+    double Profile(double x, double y);
+    utl::InverseCDFTable2D profileTable;
 
 REGISTER_PROVIDER(XYProviderGaussTail)
 };
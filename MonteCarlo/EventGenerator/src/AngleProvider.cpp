@@ -1,7 +1,6 @@
 #include "TPCReco/AngleProvider.h"
 #include "TMath.h"
 #include "Math/SpecFuncMathMore.h"
-#include "TF1.h"
 #include "Math/Math.h"
 
 
@@ -13,7 +12,7 @@ AngleProviderCosIso::AngleProviderCosIso() {
 double AngleProviderCosIso::GetAngle() {
     auto aCosMin = paramVals["minCos"];
     auto aCosMax = paramVals["maxCos"];
-    auto cos = randGen->Uniform(aCosMin, aCosMax);
+    auto cos = randEngine->Uniform(aCosMin, aCosMax);
     return TMath::ACos(cos);
 }
 
@@ -30,24 +29,26 @@ AngleProviderE1E2::AngleProviderE1E2() {
     paramVals["sigmaE2"] = 0;
     paramVals["phaseE1E2"] = ROOT::Math::Pi() / 2.;
     paramVals["phaseCosSign"] = 1;
-    std::string fName = "AngleProviderE1E2TF1_" + std::to_string(nInstances++);
-    thetaEmissionTF1 = std::make_unique<TF1>(
-            fName.c_str(), this, &AngleProviderE1E2::Theta,
-            0., ROOT::Math::Pi(), 0);
+    Init();
 }
 
-// 1D angular distribution to be used with TF1::GetRandom
+void AngleProviderE1E2::Init() {
+    thetaEmissionTable = utl::InverseCDFTable([this](double theta) { return Theta(theta); },
+                                              0., ROOT::Math::Pi());
+}
+
+// 1D angular distribution to be sampled with the inverse CDF table
 // Non-isotropic angular distribution of alpha-particle emission angle wrt gamma beam
 // with E1 abd E2 components for Oxygen-16 photo disintegration reaction.
 // Ref: M.Assuncao et al., PRC 73 055801 (2006).
 
-double AngleProviderE1E2::Theta(double *x, double *par) {
+double AngleProviderE1E2::Theta(double theta) {
     auto norm = 1.;
     auto s1 = paramVals["sigmaE1"];
     auto s2 = paramVals["sigmaE2"];
     auto ph12 = paramVals["phaseE1E2"];
     auto sgn = paramVals["phaseCosSign"];
-    double c = cos(x[0]);
+    double c = cos(theta);
     double L[5];
     for (auto i = 0; i <= 4; i++) L[i] = ROOT::Math::legendre(i, c);
     auto WE1 = L[0] - L[2];
@@ -60,17 +61,18 @@ double AngleProviderE1E2::Theta(double *x, double *par) {
 void AngleProviderE1E2::ValidateParamValues() {
     CheckCondition(paramVals["sigmaE1"] >= 0, "sigmaE1 is smaller than 0!");
     CheckCondition(paramVals["sigmaE2"] >= 0, "sigmaE2 is smaller than 0!");
+    CheckCondition(paramVals["sigmaE1"] + paramVals["sigmaE2"] > 0, "sigmaE1 and sigmaE2 are both 0!");
     CheckCondition(paramVals["phaseCosSign"]==1 || paramVals["phaseCosSign"]==-1,
                    "PhaseCosSign is not 1 or -1!");
 }
 
 double AngleProviderE1E2::GetAngle() {
-    return thetaEmissionTF1->GetRandom();
+    return thetaEmissionTable.Sample(*randEngine);
 }
 
 
 double AngleProviderIso::GetAngle() {
-    return randGen->Uniform(paramVals["minAngle"], paramVals["maxAngle"]);
+    return randEngine->Uniform(paramVals["minAngle"], paramVals["maxAngle"]);
 }
 
 void AngleProviderIso::ValidateParamValues() {
@@ -89,14 +91,16 @@ AngleProviderIso::AngleProviderIso() {
 AngleProviderPhi::AngleProviderPhi() {
     paramVals["polDegree"] = 0;
     paramVals["polAngle"] = 0;
-    std::string fName = "AngleProviderPhiTF1_" + std::to_string(nInstances++);
-    phiEmissionTF1 = std::make_unique<TF1>(
-            fName.c_str(), this, &AngleProviderPhi::Phi,
-            -ROOT::Math::Pi(), ROOT::Math::Pi(), 0);
+    Init();
+}
+
+void AngleProviderPhi::Init() {
+    phiEmissionTable = utl::InverseCDFTable([this](double phi) { return Phi(phi); },
+                                            -ROOT::Math::Pi(), ROOT::Math::Pi());
 }
 
-double AngleProviderPhi::Phi(double *x, double *par) {
-    return 1 + paramVals["polDegree"] * cos(2 * (x[0] - paramVals["polAngle"]));
+double AngleProviderPhi::Phi(double phi) {
+    return 1 + paramVals["polDegree"] * cos(2 * (phi - paramVals["polAngle"]));
 }
 
 void AngleProviderPhi::ValidateParamValues() {
@@ -108,5 +112,5 @@ void AngleProviderPhi::ValidateParamValues() {
 }
 
 double AngleProviderPhi::GetAngle() {
-    return phiEmissionTF1->GetRandom();
+    return phiEmissionTable.Sample(*randEngine);
 }
\ No newline at end of file
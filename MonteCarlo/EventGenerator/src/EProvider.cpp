@@ -18,7 +18,7 @@ EProviderGaus::EProviderGaus() {
 }
 
 double EProviderGaus::GetEnergy() {
-    auto r = randGen->Gaus(paramVals["meanE"], paramVals["sigmaE"]);
+    auto r = randEngine->Gaus(paramVals["meanE"], paramVals["sigmaE"]);
     if (r < 0) r = 0;
     return r;
 }
@@ -23,6 +23,13 @@ void EventGenerator::Init() {
     beamPosition = g.beamPos;
 }
 
+void EventGenerator::SetRandomEngine(TRandom *engine) {
+    lib.SetRandomEngine(engine);
+    zProv->SetRandomEngine(engine);
+    xyProv->SetRandomEngine(engine);
+    eProv->SetRandomEngine(engine);
+}
+
 ROOT::Math::XYZPoint EventGenerator::GenerateVertexPosition() {
     double x,y,z;
     z=zProv->GetZ();
@@ -1,8 +1,9 @@
 #include "TPCReco/Reaction.h"
 #include "Math/Boost.h"
 #include "Math/AxisAngle.h"
+#include "TRandom.h"
 
-Reaction::Reaction() : ionProp{IonProperties::GetInstance()} {}
+Reaction::Reaction() : ionProp{IonProperties::GetInstance()}, randEngine{gRandom} {}
 
 void Reaction::GetKinematics(const double gammaMom, const double &targetMass) {
     ROOT::Math::PxPyPzEVector tot4Mom{0, 0, gammaMom, targetMass + gammaMom};
@@ -1,6 +1,7 @@
 #include "TPCReco/ReactionLibrary.h"
 #include <stdexcept>
 #include "Math/Rotation3D.h"
+#include "TRandom.h"
 
 void ReactionLibrary::RegisterReaction(std::unique_ptr<Reaction> reaction, double branchingRatio,
                                        reaction_type reactionType) {
@@ -8,21 +9,28 @@ void ReactionLibrary::RegisterReaction(std::unique_ptr<Reaction> reaction, doubl
 }
 
 void ReactionLibrary::Init() {
-    auto nReactions = reactions.size();
-    selectionHelperHisto = std::make_unique<TH1D>("", "", nReactions, 0, nReactions);
-    for (auto i = 0U; i < reactions.size(); i++) {
-        selectionHelperHisto->SetBinContent(i + 1, reactions[i].BR);
-    }
-    if(selectionHelperHisto->Integral()==0)
+    std::vector<double> branchingRatios;
+    for (const auto &r: reactions)
+        branchingRatios.push_back(r.BR);
+    try {
+        selectionTable = utl::DiscreteSamplingTable(branchingRatios);
+    } catch (const std::invalid_argument &) {
         throw std::runtime_error("At least one reaction has to have non-zero branching ratio!");
+    }
     initialized = true;
 }
 
+void ReactionLibrary::SetRandomEngine(TRandom *engine) {
+    randEngine = engine;
+    for (auto &r: reactions)
+        r.aReaction->SetRandomEngine(engine);
+}
+
 std::pair<PrimaryParticles, reaction_type>
 ReactionLibrary::Generate(double gammaMom, ROOT::Math::Rotation3D &beamToDetRotation) const {
     if (!initialized)
         throw std::runtime_error("ReactionLibrary is not initialized! Call ReactionLibrary::Init() first!");
-    auto reactionId = selectionHelperHisto->FindBin(selectionHelperHisto->GetRandom()) - 1;
+    auto reactionId = selectionTable.Sample(*randEngine);
     auto primaries = reactions[reactionId].aReaction->GeneratePrimaries(gammaMom, beamToDetRotation);
     auto type = reactions[reactionId].type;
     return {primaries, type};
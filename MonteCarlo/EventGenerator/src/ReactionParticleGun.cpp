@@ -7,6 +7,13 @@ ReactionParticleGun::ReactionParticleGun(std::unique_ptr<AngleProvider> theta, s
     particleMass=ionProp->GetAtomMass(ionType);
 }
 
+void ReactionParticleGun::SetRandomEngine(TRandom *engine) {
+    Reaction::SetRandomEngine(engine);
+    thetaProv->SetRandomEngine(engine);
+    phiProv->SetRandomEngine(engine);
+    eProv->SetRandomEngine(engine);
+}
+
 PrimaryParticles ReactionParticleGun::GeneratePrimaries(double v, const ROOT::Math::Rotation3D &beamToDetRotation) {
     auto theta = thetaProv->GetAngle();
     auto phi = phiProv->GetAngle();
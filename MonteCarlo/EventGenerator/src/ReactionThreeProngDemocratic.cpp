@@ -9,7 +9,7 @@ PrimaryParticles
 ReactionThreeProngDemocratic::GeneratePrimaries(double gammaMom, const ROOT::Math::Rotation3D &beamToDetRotation) {
     //Basically a copy-paste from Mikolaj's generateFakeRecoEvents.cxx
     //slightly modified geometry definitions and adjusted to work with Reaction interface.
-    auto r = gRandom; //random engine
+    auto r = randEngine; //random engine
     //For the moment fix target and products nuclei, if needed we can generalize it.
     auto target = pid_type::CARBON_12;
     auto product = pid_type::ALPHA;
@@ -1,6 +1,7 @@
 #include "TPCReco/ReactionThreeProngIntermediate.h"
 #include "Math/EulerAngles.h"
 #include "Math/LorentzRotation.h"
+#include "TMath.h"
 
 using namespace std::string_literals;
 
@@ -14,7 +15,6 @@ ReactionThreeProngIntermediate::GeneratePrimaries(double gammaMom, const ROOT::M
     //sanity check, it will work for hard-coded particles, to keep good practise
     CheckStoichiometry({target}, {product, product, product});
     GetKinematics(gammaMom,targetMass);
-    //TODO: make dedicated BR handler to avoid code duplication with ReactionLibrary
     //mass of the intermediate state, from Breit-Wigner distribution
     auto intMass = BreitWignerRandom();
 
@@ -82,28 +82,35 @@ ReactionThreeProngIntermediate::GeneratePrimaries(double gammaMom, const ROOT::M
     return result;
 }
 
+void ReactionThreeProngIntermediate::InitSamplingTables() {
+    if (intermediateStates.empty())
+        throw std::runtime_error(
+                "ReactionThreeProngIntermediate: at least one intermediate state has to be provided!");
+    std::vector<double> branchingRatios;
+    for (const auto &state: intermediateStates)
+        branchingRatios.push_back(state.branchingRatio);
+    brTable = utl::DiscreteSamplingTable(branchingRatios);
+    //unit width Breit-Wigner, truncated to [-10, 10] widths
+    bwTable = utl::InverseCDFTable([](double x) { return TMath::BreitWigner(x, 0, 1); }, -10, 10);
+}
+
+void ReactionThreeProngIntermediate::SetRandomEngine(TRandom *engine) {
+    Reaction::SetRandomEngine(engine);
+    thetaFirst->SetRandomEngine(engine);
+    phiFirst->SetRandomEngine(engine);
+    thetaSecond->SetRandomEngine(engine);
+    phiSecond->SetRandomEngine(engine);
+}
+
 std::pair<double, double> ReactionThreeProngIntermediate::SelectIntermediateState() {
-    if (!isBrInitialized)
-    {
-        auto nStates = intermediateStates.size();
-        if (nStates == 0)
-            throw std::runtime_error(
-                    "ReactionThreeProngIntermediate: at least one intermediate state has to be provided!");
-        brHelperHisto = std::make_unique<TH1D>("hLibraryHelper", "", nStates, 0, nStates);
-        for (auto i = 0U; i < intermediateStates.size(); i++)
-        {
-            brHelperHisto->SetBinContent(i + 1, intermediateStates[i].branchingRatio);
-            isBrInitialized = true;
-        }
-    }
-    auto stateId = brHelperHisto->FindBin(brHelperHisto->GetRandom()) - 1;
+    auto stateId = brTable.Sample(*randEngine);
     return {intermediateStates[stateId].mass,intermediateStates[stateId].width};
 }
 
 double ReactionThreeProngIntermediate::BreitWignerRandom() {
     double intMass, intWidth;
     std::tie(intMass,intWidth)=SelectIntermediateState();
-    auto r=bwTF1->GetRandom();
+    auto r=bwTable.Sample(*randEngine);
     return 0.5*r*intWidth+intMass;
 
 }
@@ -14,6 +14,12 @@ ReactionTwoProng::ReactionTwoProng(std::unique_ptr<AngleProvider> theta, std::un
     prod2Mass = ionProp->GetAtomMass(prod2Ion);
 }
 
+void ReactionTwoProng::SetRandomEngine(TRandom *engine) {
+    Reaction::SetRandomEngine(engine);
+    thetaProv->SetRandomEngine(engine);
+    phiProv->SetRandomEngine(engine);
+}
+
 PrimaryParticles
 ReactionTwoProng::GeneratePrimaries(double gammaMom, const ROOT::Math::Rotation3D &beamToDetRotation) {
     GetKinematics(gammaMom, targetMass);
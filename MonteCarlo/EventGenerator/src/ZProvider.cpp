@@ -6,7 +6,7 @@ ZProviderUniform::ZProviderUniform() {
 }
 
 double ZProviderUniform::GetZ() {
-    return randGen->Uniform(paramVals["minZ"], paramVals["maxZ"]);
+    return randEngine->Uniform(paramVals["minZ"], paramVals["maxZ"]);
 }
 
 void ZProviderUniform::ValidateParamValues() {
@@ -1,12 +1,14 @@
 #include <CLHEP/Random/Random.h>
 #include "GeantSim.h"
 #include "G4RunManager.hh"
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+#endif
+#include "G4Threading.hh"
 #include "GELIDetectorConstruction.hh"
 #include "GELIPhysicsList.hh"
-#include "GELIPrimaryGeneratorAction.hh"
-#include "GELISteppingAction.hh"
-#include "GELITrackingAction.hh"
-#include "GELIEventAction.hh"
+#include "GELIActionInitialization.hh"
+#include "CentralConfig.hh"
 #include "G4PhysListFactory.hh"
 #include "TRandom.h"
 
@@ -15,15 +17,27 @@ fwk::VModule::EResultFlag GeantSim::Init(boost::property_tree::ptree config) {
     cc->SetTopNode(config);
     CLHEP::HepRandom::setTheEngine(&fCLHEPRandomEngine);
 
-    fRunManager = new G4RunManager;
+    //0 - use all available cores
+    auto nThreads = config.get<int>("NumberOfThreads", 1);
+    if (nThreads <= 0)
+        nThreads = G4Threading::G4GetNumberOfCores();
+#ifdef G4MULTITHREADED
+    if (nThreads > 1) {
+        //master random engine has to be set before, it provides seeds for the events
+        auto mtRunManager = new G4MTRunManager;
+        mtRunManager->SetNumberOfThreads(nThreads);
+        fRunManager = mtRunManager;
+    }
+#else
+    if (nThreads > 1)
+        std::cout << "GeantSim: Geant4 was built without multi-threading, running sequentially." << std::endl;
+#endif
+    if (!fRunManager)
+        fRunManager = new G4RunManager;
     // set mandatory initialization classes
     fRunManager->SetUserInitialization(new GELIDetectorConstruction);
     fRunManager->SetUserInitialization(new GELIPhysicsList);
-
-    fRunManager->SetUserAction(new GELIPrimaryGeneratorAction(buffer));
-    fRunManager->SetUserAction(new GELISteppingAction(buffer));
-    fRunManager->SetUserAction(new GELITrackingAction());
-    fRunManager->SetUserAction(new GELIEventAction(buffer));
+    fRunManager->SetUserInitialization(new GELIActionInitialization(fBatch));
 
     fRunManager->Initialize();
 
@@ -36,14 +50,21 @@ fwk::VModule::EResultFlag GeantSim::Init(boost::property_tree::ptree config) {
 }
 
 fwk::VModule::EResultFlag GeantSim::Process(ModuleExchangeSpace &event) {
+    return ProcessBatch({&event}).front();
+}
+
+std::vector<fwk::VModule::EResultFlag> GeantSim::ProcessBatch(const std::vector<ModuleExchangeSpace *> &events) {
+    fBatch.clear();
+    for (auto event: events)
+        fBatch.push_back(&event->simEvt);
     //Random seed 'magic' works here because there are no calls to gRandom in Geant code
     //pass by the seed to Geant
     CLHEP::HepRandom::setTheSeed(gRandom->GetSeed());
-    buffer.simEv = &event.simEvt;
-    fRunManager->BeamOn(1);
+    //G4Event IDs of the run are the indices in fBatch
+    fRunManager->BeamOn(static_cast<G4int>(fBatch.size()));
     //return the seed to gRandom
     gRandom->SetSeed(CLHEP::HepRandom::getTheSeed());
-    return fwk::VModule::eSuccess;
+    return std::vector<fwk::VModule::EResultFlag>(events.size(), fwk::VModule::eSuccess);
 }
 
 fwk::VModule::EResultFlag GeantSim::Finish() {
@@ -2,10 +2,12 @@
 #define TPCSOFT_GEANTSIM_H
 
 #include "TPCReco/VModule.h"
-#include "DataBuffer.h"
+#include "TPCReco/SimEvent.h"
 
 #include <CLHEP/Random/MTwistEngine.h>
 
+#include <vector>
+
 class G4RunManager;
 
 class G4VUserPhysicsList;
@@ -21,6 +23,13 @@ public:
 
     fwk::VModule::EResultFlag Process(ModuleExchangeSpace &event) override;
 
+    /** Simulates all events of the batch with a single BeamOn call.
+        With NumberOfThreads > 1 the events are distributed among Geant worker
+        threads. In that mode per-event seeds are drawn from the master engine
+        in the order of events, so the result does not depend on the number
+        of worker threads. */
+    std::vector<fwk::VModule::EResultFlag> ProcessBatch(const std::vector<ModuleExchangeSpace *> &events) override;
+
     fwk::VModule::EResultFlag Finish() override;
 
 private:
@@ -32,7 +41,7 @@ private:
     G4RunManager *fRunManager{};
     G4UIExecutive *fUserInterface{};
     G4VisManager *fVisManager{};
-    DataBuffer buffer{};
+    std::vector<SimEvent *> fBatch; ///< events of the current BeamOn call, indexed by G4Event ID
 
 
 REGISTER_MODULE(GeantSim)
@@ -3,10 +3,19 @@
 
 #include "TPCReco/SimEvent.h"
 
+#include <vector>
+
 
 //so far it is (almost)identical to ModuleExchangeSpace, we keep it separate to have flexibility
+//Each Geant thread has its own DataBuffer, all of them share the batch of events of the current BeamOn call
 struct DataBuffer {
-    SimEvent *simEv;
+    explicit DataBuffer(const std::vector<SimEvent *> &events) : batch{events} {}
+
+    //selects the SimEvent corresponding to the Geant event being simulated by this thread
+    void SelectEvent(int eventID) { simEv = batch.at(eventID); }
+
+    SimEvent *simEv{};
+    const std::vector<SimEvent *> &batch; ///< events of the current BeamOn call, indexed by G4Event ID
 };
 
 #endif //TPCSOFT_DATABUFFER_H
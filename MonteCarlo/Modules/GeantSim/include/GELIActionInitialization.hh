@@ -0,0 +1,44 @@
+/**
+ * @file GELIActionInitialization.hh
+ * @brief      Definition of GELIActionInitialization class
+ */
+
+#ifndef GELIActionInitialization_h
+#define GELIActionInitialization_h 1
+
+#include "G4VUserActionInitialization.hh"
+#include "DataBuffer.h"
+
+/// \cond
+#include <list>
+#include <mutex>
+#include <vector>
+/// \endcond
+
+
+/**
+ * @class      GELIActionInitialization
+ *
+ * @brief      Creates user actions for each Geant thread
+ *
+ * @details    Each worker thread (or the sequential run manager) gets its own
+ *             set of actions sharing a thread-local DataBuffer. All buffers
+ *             point to the same batch of SimEvents, each Geant event writes
+ *             only to the SimEvent with its event ID.
+ */
+class GELIActionInitialization : public G4VUserActionInitialization {
+public:
+    explicit GELIActionInitialization(const std::vector<SimEvent *> &events) : batch{events} {}
+
+    /**
+     * @brief      Creates actions of a worker thread
+     */
+    void Build() const override;
+
+private:
+    const std::vector<SimEvent *> &batch;
+    mutable std::list<DataBuffer> buffers; ///< one per thread, std::list keeps references valid
+    mutable std::mutex buffersMutex;
+};
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file GELIActionInitialization.cc
+ * @brief      Implementation of GELIActionInitialization class
+ */
+
+#include "GELIActionInitialization.hh"
+#include "GELIPrimaryGeneratorAction.hh"
+#include "GELISteppingAction.hh"
+#include "GELITrackingAction.hh"
+#include "GELIEventAction.hh"
+
+
+void GELIActionInitialization::Build() const {
+    DataBuffer *buffer;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.emplace_back(batch);
+        buffer = &buffers.back();
+    }
+    SetUserAction(new GELIPrimaryGeneratorAction(*buffer));
+    SetUserAction(new GELISteppingAction(*buffer));
+    SetUserAction(new GELITrackingAction());
+    SetUserAction(new GELIEventAction(*buffer));
+}
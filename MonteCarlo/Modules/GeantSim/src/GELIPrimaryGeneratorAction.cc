@@ -26,6 +26,8 @@ void GELIPrimaryParticleInfo::Print() const {
 
 
 void GELIPrimaryGenerator::GeneratePrimaryVertex(G4Event *evt) {
+    //primaries are generated first in each event, from now on this thread works on the matching SimEvent
+    buffer.SelectEvent(evt->GetEventID());
     auto vtxPos = buffer.simEv->GetTrueVertexPosition();
     auto tracks = buffer.simEv->GetTracks();
     auto vtx = new G4PrimaryVertex(vtxPos.X(), vtxPos.Y(), vtxPos.Z(), 0);
@@ -25,20 +25,20 @@ fwk::VModule::EResultFlag TPCDigitizerRandom::Process(ModuleExchangeSpace &event
     diffSigmaXY = gRandom->Uniform(diffSigmaXYmin, diffSigmaXYmax);
     diffSigmaZ = gRandom->Uniform(diffSigmaZmin, diffSigmaZmax);
     for (auto &t: currentSimEvent.GetTracks()) {
+        auto &hits = t.GetHits();
+        hits.ClassifyInside([this](double x, double y, double z) { return geometry->IsInsideActiveVolume(x, y, z); });
         //loop over hits
-        for (auto &h: t.GetHits()) {
-            auto pos = h.GetPosition();
-            auto edep = h.GetEnergy();
-            auto isIn = geometry->IsInsideActiveVolume(pos);
-            h.SetInside(isIn);
-            if(isIn) {
+        for (size_t iHit = 0; iHit < hits.size(); ++iHit) {
+            auto pos = hits.GetPosition(iHit);
+            auto edep = hits.GetEnergy(iHit);
+            if(hits.IsInside(iHit)) {
                 for (unsigned int i = 0; i < nSamplesPerHit; i++) {
                     auto smearedPosition = TVector3(
                             gRandom->Gaus(pos.X(), diffSigmaXY),
                             gRandom->Gaus(pos.Y(), diffSigmaXY),
                             gRandom->Gaus(pos.Z(), diffSigmaZ)
                     );
-                    auto iPolyBin = geometry->GetTH2Poly()->FindBin(smearedPosition.X(), smearedPosition.Y());
+                    auto iPolyBin = geometry->FindTH2PolyBin(smearedPosition.X(), smearedPosition.Y());
                     auto iCell = static_cast<int>(geometry->Pos2timecell(smearedPosition.Z(), err_flag));
                     auto strip = geometry->GetTH2PolyStrip(iPolyBin);
                     if (strip && !err_flag) {
@@ -47,14 +47,12 @@ fwk::VModule::EResultFlag TPCDigitizerSRC::Process(ModuleExchangeSpace &event) {
     currentPEventTPC->Clear();
     //loop over tracks
     for (auto &t: currentSimEvent.GetTracks()) {
+        auto &hits = t.GetHits();
+        hits.ClassifyInside([this](double x, double y, double z) { return geometry->IsInsideActiveVolume(x, y, z); });
         //loop over hits
-        for (auto &h: t.GetHits()) {
-            auto pos = h.GetPosition();
-            auto edep = h.GetEnergy();
-            auto isIn = geometry->IsInsideActiveVolume(pos);
-            h.SetInside(isIn);
-            if(isIn)
-                calculator->addCharge(pos, edep * MeVToChargeScale, currentPEventTPC);
+        for (size_t i = 0; i < hits.size(); ++i) {
+            if(hits.IsInside(i))
+                calculator->addCharge(hits.GetPosition(i), hits.GetEnergy(i) * MeVToChargeScale, currentPEventTPC);
         }
     }
     currentPEventTPC->SetEventInfo(*aEventInfo);
@@ -14,6 +14,7 @@ public:
 private:
     std::unique_ptr<IonRangeCalculator> rangeCalc;
     double pointsPerMm{1};
+    std::vector<double> braggCurve; // reused between tracks
     REGISTER_MODULE(ToyIonizationSimulator)
 };
 
@@ -1,4 +1,5 @@
 #include "TriggerSimulator.h"
+#include <algorithm>
 
 fwk::VModule::EResultFlag TriggerSimulator::Init(boost::property_tree::ptree config) {
     triggerArrival = config.get<double>("TriggerArrival");
@@ -23,20 +24,19 @@ fwk::VModule::EResultFlag TriggerSimulator::Finish() {
 
 //take into account only points in active area
 double TriggerSimulator::findMinZ(SimEvent &ev) {
-    std::vector<double> zPoints;
+    auto isInside = [this](double x, double y, double z) { return geometry->IsInsideActiveVolume(x, y, z); };
+    bool anyInside = false;
+    double minZ = 0;
     for(auto& t: ev.GetTracks() ){
-        bool trackInside = false;
-        for(const auto& h: t.GetHits()){
-            auto pos = h.GetPosition();
-            if(geometry->IsInsideActiveVolume(pos)) {
-                zPoints.push_back(pos.Z());
-                trackInside =true;
-            }
-        }
+        auto& hits = t.GetHits();
+        bool trackInside = hits.ClassifyInside(isInside) > 0;
         t.SetOutOfActiveVolume(!trackInside);
+        double trackMinZ;
+        if(trackInside && hits.GetMinZInside(trackMinZ)) {
+            minZ = anyInside ? std::min(minZ, trackMinZ) : trackMinZ;
+            anyInside = true;
+        }
     }
     //if there are no energy deposits inside the active volume we return zero here
-    if(zPoints.empty())
-        return 0;
-    return *std::min_element(zPoints.begin(), zPoints.end());
+    return minZ;
 }
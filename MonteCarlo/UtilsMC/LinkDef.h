@@ -7,7 +7,11 @@
 #pragma link C++ class SimEvent+;
 #pragma link C++ class SimHit+;
 #pragma link C++ class vector<SimHit>+;
+#pragma link C++ class SimHitCollection+;
 #pragma link C++ class SimTrack+;
+#pragma read sourceClass="SimTrack" targetClass="SimTrack" version="[1]" \
+    source="std::vector<SimHit> hits" target="hits" \
+    code="{ hits.clear(); hits.reserve(onfile.hits.size()); for (const auto &hit: onfile.hits) hits.push_back(hit); }"
 #pragma link C++ class vector<SimTrack>+;
 #pragma link C++ class PrimaryParticle+;
 #pragma link C++ class vector<PrimaryPArticle>+;
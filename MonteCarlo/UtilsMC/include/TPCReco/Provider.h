@@ -54,12 +54,20 @@ public:
 
     virtual std::string GetName() = 0;
 
+    //engine used for sampling, by default the shared one (gRandom);
+    //providers used in different threads need their own engines
+    void SetRandomEngine(TRandom *engine) { randEngine = engine; }
+
 protected:
     static std::unique_ptr<TRandom> randGen;
+    TRandom *randEngine{randGen.get()};
     paramMapType paramVals;
 
     virtual void ValidateParamValues() = 0;
 
+    //called after new parameter values are validated, precomputes sampling tables
+    virtual void Init() {}
+
     static unsigned int nInstances;
 
     void CheckCondition(bool cond, const std::string &message);
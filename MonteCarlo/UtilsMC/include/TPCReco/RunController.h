@@ -4,6 +4,8 @@
 #include <string>
 #include <list>
 #include <map>
+#include <memory>
+#include <vector>
 #include "VModule.h"
 #include "boost/property_tree/ptree.hpp"
 #include "ModuleExchangeSpace.h"
@@ -41,6 +43,9 @@ namespace fwk {
 
         virtual void Init(const boost::property_tree::ptree &config);
         virtual EBreakStatus RunSingle();
+        /// Run the module sequence on a batch of BatchSize events. Each module
+        /// processes the whole batch (in order) before the next module is called.
+        virtual EBreakStatus RunBatch();
         virtual void RunFull();
         virtual void Finish();
 
@@ -53,6 +58,8 @@ namespace fwk {
         std::vector<std::string> fModuleSequence;
 
         ModuleExchangeSpace *fCurrentEvent;
+        std::vector<std::unique_ptr<ModuleExchangeSpace>> fEventBatch;
+        unsigned int fBatchSize;
 
         bool fTiming;
         utl::Stopwatch fStopwatch;
@@ -0,0 +1,108 @@
+#ifndef TPCSOFT_SAMPLINGTABLE_H
+#define TPCSOFT_SAMPLINGTABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+class TRandom;
+
+namespace utl {
+
+    /**
+       \class DiscreteSamplingTable
+
+       \brief Inverse-CDF sampling of indices 0..n-1 with given weights
+
+       The cumulative distribution is computed once, sampling is a binary
+       search with a uniform number supplied by the caller. The table is
+       never modified after construction, so it can be shared by threads
+       using their own random engines.
+    */
+    class DiscreteSamplingTable {
+
+    public:
+        DiscreteSamplingTable() = default;
+
+        /// Weights do not have to be normalized, but have to be non-negative with a positive sum
+        explicit DiscreteSamplingTable(const std::vector<double> &weights);
+
+        /// Index for u uniformly distributed in [0,1)
+        std::size_t Sample(double u) const;
+
+        /// Index for u uniformly distributed in [0,1) and the position of u inside
+        /// the probability interval of the index, uniformly distributed in [0,1)
+        std::size_t Sample(double u, double &fraction) const;
+
+        std::size_t Sample(TRandom &engine) const;
+
+        std::size_t GetSize() const { return fCDF.size(); }
+
+    private:
+        std::vector<double> fCDF;
+    };
+
+    /**
+       \class InverseCDFTable
+
+       \brief Sampling of a 1D probability density by a precomputed inverse CDF
+
+       The density is evaluated in the centers of nBins bins of [xMin, xMax]
+       and treated as constant inside each bin, so the inverse CDF is linear
+       inside a bin. It replaces TF1::GetRandom, without its lazy integration
+       and global state.
+    */
+    class InverseCDFTable {
+
+    public:
+        InverseCDFTable() = default;
+
+        InverseCDFTable(const std::function<double(double)> &density, double xMin, double xMax,
+                        std::size_t nBins = 10000);
+
+        /// Random value for u uniformly distributed in [0,1)
+        double Sample(double u) const;
+
+        double Sample(TRandom &engine) const;
+
+    private:
+        DiscreteSamplingTable fBins;
+        double fXMin{0};
+        double fBinWidth{0};
+    };
+
+    /**
+       \class InverseCDFTable2D
+
+       \brief Sampling of a 2D probability density, a replacement of TF2::GetRandom2
+
+       The density is evaluated in the centers of nBinsX x nBinsY cells, a cell is
+       chosen by inverse CDF and the point is uniformly distributed inside it.
+    */
+    class InverseCDFTable2D {
+
+    public:
+        InverseCDFTable2D() = default;
+
+        InverseCDFTable2D(const std::function<double(double, double)> &density,
+                          double xMin, double xMax, std::size_t nBinsX,
+                          double yMin, double yMax, std::size_t nBinsY);
+
+        /// Random point for u and v independent and uniformly distributed in [0,1)
+        std::pair<double, double> Sample(double u, double v) const;
+
+        std::pair<double, double> Sample(TRandom &engine) const;
+
+    private:
+        DiscreteSamplingTable fCells;
+        std::size_t fNBinsX{0};
+        double fXMin{0};
+        double fYMin{0};
+        double fBinWidthX{0};
+        double fBinWidthY{0};
+    };
+
+}
+
+#endif //TPCSOFT_SAMPLINGTABLE_H
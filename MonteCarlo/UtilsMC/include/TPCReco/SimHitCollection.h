@@ -0,0 +1,146 @@
+/**
+ * @file SimHitCollection.h
+ * @brief      Definition of SimHitCollection class
+ */
+
+#ifndef SIMHITCOLLECTION_H
+#define SIMHITCOLLECTION_H
+
+#include "TObject.h"
+#include "TVector3.h"
+#include "SimHit.h"
+/// \cond
+#include <cstddef>
+#include <iterator>
+#include <vector>
+/// \endcond
+
+
+/**
+ * @brief      Hits of a single track stored as a structure of arrays
+ *
+ * Coordinates (mm) and energy deposits (MeV) are kept in separate float arrays, so that
+ * operations on all hits of a track (shift, sorting, active volume classification)
+ * run over contiguous memory. Single hits are read and inserted as SimHit values.
+ */
+class SimHitCollection {
+public:
+    /**
+     * @brief      Read-only iterator returning hits by value
+     */
+    class const_iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef SimHit value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const SimHit *pointer;
+        typedef SimHit reference;
+
+        const_iterator(const SimHitCollection *collection, size_t index) : fCollection{collection}, fIndex{index} {}
+
+        SimHit operator*() const { return (*fCollection)[fIndex]; }
+
+        const_iterator &operator++() {
+            ++fIndex;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto previous = *this;
+            ++fIndex;
+            return previous;
+        }
+
+        bool operator==(const const_iterator &other) const { return fIndex == other.fIndex; }
+
+        bool operator!=(const const_iterator &other) const { return fIndex != other.fIndex; }
+
+    private:
+        const SimHitCollection *fCollection;
+        size_t fIndex;
+    };
+
+    SimHitCollection() = default;
+
+    virtual ~SimHitCollection() = default;
+
+    void push_back(const SimHit &hit);
+
+    void reserve(size_t n);
+
+    void clear();
+
+    size_t size() const { return fEnergy.size(); }
+
+    bool empty() const { return fEnergy.empty(); }
+
+    SimHit operator[](size_t i) const;
+
+    SimHit back() const { return (*this)[size() - 1]; }
+
+    const_iterator begin() const { return {this, 0}; }
+
+    const_iterator end() const { return {this, size()}; }
+
+    float X(size_t i) const { return fX[i]; }
+
+    float Y(size_t i) const { return fY[i]; }
+
+    float Z(size_t i) const { return fZ[i]; }
+
+    float GetEnergy(size_t i) const { return fEnergy[i]; }
+
+    TVector3 GetPosition(size_t i) const { return {fX[i], fY[i], fZ[i]}; }
+
+    bool IsInside(size_t i) const { return fFlags[i] & kInside; }
+
+    void SetInside(size_t i, bool in);
+
+    /**
+     * @brief      Sets the inside flag of every hit from isInside(x, y, z)
+     * @return     number of hits inside
+     */
+    template<class Predicate>
+    size_t ClassifyInside(Predicate isInside) {
+        size_t nInside = 0;
+        for (size_t i = 0; i < size(); ++i) {
+            bool in = isInside(fX[i], fY[i], fZ[i]);
+            fFlags[i] = in ? (fFlags[i] | kInside) : (fFlags[i] & ~kInside);
+            nInside += in;
+        }
+        return nInside;
+    }
+
+    /**
+     * @brief      Finds the lowest Z coordinate of the hits flagged as inside
+     * @return     false if no hit is inside
+     */
+    bool GetMinZInside(double &minZ) const;
+
+    /**
+     * @brief      Sum of energy deposits of all hits
+     */
+    double GetEnergySum() const;
+
+    void Shift(const TVector3 &offset);
+
+    /**
+     * @brief      Sorts hits by the distance from a given point
+     */
+    void SortByDistance(const TVector3 &origin);
+
+private:
+    enum : unsigned char {
+        kInside = 1
+    };
+
+    std::vector<float> fX; ///< X coordinates of hits in mm
+    std::vector<float> fY; ///< Y coordinates of hits in mm
+    std::vector<float> fZ; ///< Z coordinates of hits in mm
+    std::vector<float> fEnergy; ///< Energy deposits of hits in MeV
+    std::vector<unsigned char> fFlags; ///< Bit flags of hits
+
+ClassDef(SimHitCollection, 1); ///< ROOT macro to register SimHitCollection class
+};
+
+#endif
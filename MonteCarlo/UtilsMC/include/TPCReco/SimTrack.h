@@ -10,6 +10,7 @@
 #include "TObject.h"
 #include "TVector3.h"
 #include "SimHit.h"
+#include "SimHitCollection.h"
 #include "TVector3.h"
 #include "TPCReco/CommonDefinitions.h"
 #include "PrimaryParticle.h"
@@ -56,6 +57,9 @@ public:
      */
     void InsertHit(const SimHit &hit);
 
+    /**
+     * @brief      Sorts hits by the distance from the start position
+     */
     void SortHits();
 
     void RecalculateStopPosition();
@@ -76,13 +80,15 @@ public:
     double GetEnergyDeposit() const; ///< Energy deposit in gas volume of a given track
     unsigned int GetNHits() const { return hits.size(); }
 
-    SimHits GetHits() const { return hits; }
+    const SimHitCollection &GetHits() const { return hits; }
+
+    SimHitCollection &GetHits() { return hits; }
 
     const PrimaryParticle &GetPrimaryParticle() const { return prim; }
 
-    SimHitsIterator HitsBegin() { return hits.begin(); }
+    SimHitCollection::const_iterator HitsBegin() const { return hits.begin(); }
 
-    SimHitsIterator HitsEnd() { return hits.end(); }
+    SimHitCollection::const_iterator HitsEnd() const { return hits.end(); }
 
     bool IsOutOfActiveVolume() const { return isOutOfActiveVolume; }
 
@@ -94,13 +100,13 @@ private:
     //Same just truncated to active volume:
     TVector3 truncatedStopPos;
     TVector3 truncatedStartPos;
-    SimHits hits; ///<Vector of simulated hits in detector volume
+    SimHitCollection hits; ///<Simulated hits in detector volume
     PrimaryParticle prim;
     bool hasStopPos{false};
     bool isOutOfActiveVolume{false};
     bool isFullyContained{false};
 
-ClassDef(SimTrack, 1); ///< ROOT macro to register SimTrack class
+ClassDef(SimTrack, 2); ///< ROOT macro to register SimTrack class
 
 };
 
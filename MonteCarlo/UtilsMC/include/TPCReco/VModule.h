@@ -113,6 +113,15 @@ private:                                                                 \
         */
         virtual EResultFlag Process(ModuleExchangeSpace &event) = 0;
 
+        /// ProcessBatch: invoked once per batch of events
+        /** Used by RunController when events are processed in batches.
+            Returns one flag per event, in the order of events. The default
+            implementation calls Process for each event and stops at the first
+            event that breaks the loop, so the returned vector may be shorter.
+            Modules that gain from handling several events at once override it.
+        */
+        virtual std::vector<EResultFlag> ProcessBatch(const std::vector<ModuleExchangeSpace *> &events);
+
         /// Finish: invoked at end of the run (NOT end of the event)
         /** This method is for things that should be done at the end of the run (for
             example, closing files or writing out histograms)
@@ -135,6 +144,16 @@ private:                                                                 \
             return flag;
         }
 
+        std::vector<EResultFlag>
+        ProcessBatchWithTiming(const std::vector<ModuleExchangeSpace *> &events) {
+            fRealTimeStopwatch.Start();
+            fStopwatch.Start();
+            auto flags = ProcessBatch(events);
+            fStopwatch.Stop();
+            fRealTimeStopwatch.Stop();
+            return flags;
+        }
+
         utl::Stopwatch &GetStopwatch() { return fStopwatch; }
 
         const utl::Stopwatch &GetStopwatch() const { return fStopwatch; }
@@ -11,6 +11,7 @@ void Provider::SetSingleParam(const std::string &pname, const double &pval) {
     ValidateParamName(pname);
     paramVals[pname] = pval;
     ValidateParamValues();
+    Init();
 }
 
 double Provider::GetParam(const std::string &pname) {
@@ -43,6 +44,7 @@ void Provider::SetParams(const paramMapType &pars) {
     }
 
     ValidateParamValues();
+    Init();
 }
 
 
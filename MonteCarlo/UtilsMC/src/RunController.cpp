@@ -12,7 +12,7 @@ namespace pt = boost::property_tree;
 namespace fwk {
 
     RunController::RunController() :
-            fTiming(false) {
+            fBatchSize(1), fTiming(false) {
         fCurrentEvent = new ModuleExchangeSpace;
     }
 
@@ -36,6 +36,14 @@ namespace fwk {
     void
     RunController::Init(const boost::property_tree::ptree &config) {
         fTiming = config.get<bool>("EnableTiming");
+        fBatchSize = config.get<unsigned int>("BatchSize", 1);
+        if (fBatchSize == 0)
+            throw std::runtime_error("BatchSize has to be positive!");
+        fEventBatch.clear();
+        if (fBatchSize > 1) {
+            for (unsigned int i = 0; i < fBatchSize; ++i)
+                fEventBatch.push_back(std::make_unique<ModuleExchangeSpace>());
+        }
         auto geom = std::make_shared<GeometryTPC>(config.get<std::string>("GeometryConfig").c_str());
         BuildModules(config.get_child("ModuleSequence"));
         InitModules(config.get_child("ModuleConfiguration"), geom);
@@ -58,9 +66,39 @@ namespace fwk {
         return eBreak;
     }
 
+    RunController::EBreakStatus
+    RunController::RunBatch() {
+        std::vector<ModuleExchangeSpace *> events;
+        for (auto &event: fEventBatch)
+            events.push_back(event.get());
+        auto status = eNoBreak;
+        std::vector<ModuleExchangeSpace *> passed;
+        for (const auto &m: fModuleSequence) {
+            if (events.empty())
+                break;
+            auto flags = fTiming ? fModules[m]->ProcessBatchWithTiming(events)
+                                 : fModules[m]->ProcessBatch(events);
+            //events skipped by the module do not go further, the ones after a break are dropped
+            passed.clear();
+            for (size_t i = 0; i < flags.size() && i < events.size(); ++i) {
+                if (flags[i] == fwk::VModule::eSuccess)
+                    passed.push_back(events[i]);
+                else if (flags[i] != fwk::VModule::eContinueLoop) {
+                    status = eBreak;
+                    break;
+                }
+            }
+            events.swap(passed);
+        }
+        return status;
+    }
+
     void
     RunController::RunFull() {
-        while (RunSingle() == eNoBreak);
+        if (fBatchSize > 1)
+            while (RunBatch() == eNoBreak);
+        else
+            while (RunSingle() == eNoBreak);
     }
 
 
@@ -0,0 +1,108 @@
+#include "TPCReco/SamplingTable.h"
+#include "TRandom.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace utl {
+
+    DiscreteSamplingTable::DiscreteSamplingTable(const std::vector<double> &weights) {
+        fCDF.reserve(weights.size());
+        double sum = 0;
+        for (auto w: weights) {
+            if (!(w >= 0) || std::isinf(w))
+                throw std::invalid_argument("DiscreteSamplingTable: weights have to be finite and non-negative!");
+            sum += w;
+            fCDF.push_back(sum);
+        }
+        if (!(sum > 0))
+            throw std::invalid_argument("DiscreteSamplingTable: sum of weights has to be positive!");
+        //the last non-zero weight ends exactly at 1
+        for (auto &c: fCDF)
+            c /= sum;
+    }
+
+    std::size_t DiscreteSamplingTable::Sample(double u, double &fraction) const {
+        if (fCDF.empty())
+            throw std::logic_error("DiscreteSamplingTable: sampling from an empty table!");
+        u = std::min(std::max(u, 0.), std::nextafter(1., 0.));
+        //first index with CDF > u, its interval [CDF[i-1], CDF[i]) is not empty
+        auto it = std::upper_bound(fCDF.begin(), fCDF.end(), u);
+        auto index = static_cast<std::size_t>(it - fCDF.begin());
+        auto lower = index ? fCDF[index - 1] : 0.;
+        fraction = (u - lower) / (fCDF[index] - lower);
+        return index;
+    }
+
+    std::size_t DiscreteSamplingTable::Sample(double u) const {
+        double fraction;
+        return Sample(u, fraction);
+    }
+
+    std::size_t DiscreteSamplingTable::Sample(TRandom &engine) const {
+        return Sample(engine.Rndm());
+    }
+
+    /////////////////////////////////////////////////////////
+
+    namespace {
+        void CheckRange(double min, double max, std::size_t nBins, const char *name) {
+            if (!(min < max) || nBins == 0)
+                throw std::invalid_argument(std::string(name) + ": empty range or no bins!");
+        }
+    }
+
+    InverseCDFTable::InverseCDFTable(const std::function<double(double)> &density, double xMin, double xMax,
+                                     std::size_t nBins)
+            : fXMin{xMin}, fBinWidth{(xMax - xMin) / nBins} {
+        CheckRange(xMin, xMax, nBins, "InverseCDFTable");
+        std::vector<double> weights(nBins);
+        for (std::size_t i = 0; i < nBins; ++i)
+            weights[i] = density(fXMin + (i + 0.5) * fBinWidth);
+        fBins = DiscreteSamplingTable(weights);
+    }
+
+    double InverseCDFTable::Sample(double u) const {
+        double fraction;
+        auto bin = fBins.Sample(u, fraction);
+        return fXMin + (bin + fraction) * fBinWidth;
+    }
+
+    double InverseCDFTable::Sample(TRandom &engine) const {
+        return Sample(engine.Rndm());
+    }
+
+    /////////////////////////////////////////////////////////
+
+    InverseCDFTable2D::InverseCDFTable2D(const std::function<double(double, double)> &density,
+                                         double xMin, double xMax, std::size_t nBinsX,
+                                         double yMin, double yMax, std::size_t nBinsY)
+            : fNBinsX{nBinsX}, fXMin{xMin}, fYMin{yMin},
+              fBinWidthX{(xMax - xMin) / nBinsX}, fBinWidthY{(yMax - yMin) / nBinsY} {
+        CheckRange(xMin, xMax, nBinsX, "InverseCDFTable2D");
+        CheckRange(yMin, yMax, nBinsY, "InverseCDFTable2D");
+        std::vector<double> weights(nBinsX * nBinsY);
+        for (std::size_t iy = 0; iy < nBinsY; ++iy) {
+            auto y = fYMin + (iy + 0.5) * fBinWidthY;
+            for (std::size_t ix = 0; ix < nBinsX; ++ix)
+                weights[iy * nBinsX + ix] = density(fXMin + (ix + 0.5) * fBinWidthX, y);
+        }
+        fCells = DiscreteSamplingTable(weights);
+    }
+
+    std::pair<double, double> InverseCDFTable2D::Sample(double u, double v) const {
+        double fraction;
+        auto cell = fCells.Sample(u, fraction);
+        auto ix = cell % fNBinsX;
+        auto iy = cell / fNBinsX;
+        return {fXMin + (ix + fraction) * fBinWidthX, fYMin + (iy + v) * fBinWidthY};
+    }
+
+    std::pair<double, double> InverseCDFTable2D::Sample(TRandom &engine) const {
+        double u = engine.Rndm();
+        double v = engine.Rndm();
+        return Sample(u, v);
+    }
+
+}
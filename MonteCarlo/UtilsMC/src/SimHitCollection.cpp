@@ -0,0 +1,103 @@
+#include "TPCReco/SimHitCollection.h"
+
+/// \cond
+#include <algorithm>
+#include <limits>
+#include <numeric>
+/// \endcond
+
+namespace {
+    template<class T>
+    void applyPermutation(std::vector<T> &values, const std::vector<size_t> &order, std::vector<T> &buffer) {
+        buffer.resize(values.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            buffer[i] = values[order[i]];
+        }
+        values.swap(buffer);
+    }
+}
+
+void SimHitCollection::push_back(const SimHit &hit) {
+    auto position = hit.GetPosition();
+    fX.push_back(position.X());
+    fY.push_back(position.Y());
+    fZ.push_back(position.Z());
+    fEnergy.push_back(hit.GetEnergy());
+    fFlags.push_back(hit.IsInside() ? kInside : 0);
+}
+
+void SimHitCollection::reserve(size_t n) {
+    fX.reserve(n);
+    fY.reserve(n);
+    fZ.reserve(n);
+    fEnergy.reserve(n);
+    fFlags.reserve(n);
+}
+
+void SimHitCollection::clear() {
+    fX.clear();
+    fY.clear();
+    fZ.clear();
+    fEnergy.clear();
+    fFlags.clear();
+}
+
+SimHit SimHitCollection::operator[](size_t i) const {
+    SimHit hit{fX[i], fY[i], fZ[i], fEnergy[i]};
+    hit.SetInside(IsInside(i));
+    return hit;
+}
+
+void SimHitCollection::SetInside(size_t i, bool in) {
+    if (in)
+        fFlags[i] |= kInside;
+    else
+        fFlags[i] &= ~kInside;
+}
+
+bool SimHitCollection::GetMinZInside(double &minZ) const {
+    // branchless over the hits, hits outside are pushed to +infinity
+    const float infinity = std::numeric_limits<float>::infinity();
+    float minimum = infinity;
+    for (size_t i = 0; i < size(); ++i) {
+        float z = (fFlags[i] & kInside) ? fZ[i] : infinity;
+        minimum = std::min(minimum, z);
+    }
+    if (minimum == infinity)
+        return false;
+    minZ = minimum;
+    return true;
+}
+
+double SimHitCollection::GetEnergySum() const {
+    return std::accumulate(fEnergy.begin(), fEnergy.end(), 0.0);
+}
+
+void SimHitCollection::Shift(const TVector3 &offset) {
+    const float dx = offset.X(), dy = offset.Y(), dz = offset.Z();
+    for (auto &x: fX) x += dx;
+    for (auto &y: fY) y += dy;
+    for (auto &z: fZ) z += dz;
+}
+
+void SimHitCollection::SortByDistance(const TVector3 &origin) {
+    // distances are computed once per hit, then all arrays are reordered by the same permutation
+    const float x0 = origin.X(), y0 = origin.Y(), z0 = origin.Z();
+    std::vector<float> distance2(size());
+    for (size_t i = 0; i < size(); ++i) {
+        float dx = fX[i] - x0, dy = fY[i] - y0, dz = fZ[i] - z0;
+        distance2[i] = dx * dx + dy * dy + dz * dz;
+    }
+    std::vector<size_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&distance2](size_t a, size_t b) { return distance2[a] < distance2[b]; });
+
+    std::vector<float> buffer;
+    applyPermutation(fX, order, buffer);
+    applyPermutation(fY, order, buffer);
+    applyPermutation(fZ, order, buffer);
+    applyPermutation(fEnergy, order, buffer);
+    std::vector<unsigned char> flagBuffer;
+    applyPermutation(fFlags, order, flagBuffer);
+}
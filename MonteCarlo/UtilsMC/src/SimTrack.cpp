@@ -27,11 +27,7 @@ void SimTrack::InsertHit(const SimHit &hit) {
 }
 
 double SimTrack::GetEnergyDeposit() const {
-    double edep = 0;
-    for (const auto &hit: hits) {
-        edep += hit.GetEnergy();
-    }
-    return edep;
+    return hits.GetEnergySum();
 }
 
 double SimTrack::GetRange() const {
@@ -48,20 +44,13 @@ double SimTrack::GetTruncatedRange() const {
 
 void SimTrack::SortHits() {
     //sort by distance from the emission point
-    auto hitCompare = [=](const SimHit &a, const SimHit &b) -> bool {
-        auto dsta = (a.GetPosition() - startPos).Mag();
-        auto dstb = (b.GetPosition() - startPos).Mag();
-        return dsta < dstb;
-    };
-
-    std::sort(HitsBegin(), HitsEnd(), hitCompare);
-
+    hits.SortByDistance(startPos);
 }
 
 void SimTrack::RecalculateStopPosition() {
     //set stop position to be equal to the position of the last hit
     if (!hits.empty())
-        SetStop(hits[hits.size() - 1].GetPosition());
+        SetStop(hits.GetPosition(hits.size() - 1));
 }
 
 void SimTrack::Shift(TVector3 &offset) {
@@ -69,7 +58,5 @@ void SimTrack::Shift(TVector3 &offset) {
     stopPos += offset;
     truncatedStartPos += offset;
     truncatedStopPos += offset;
-    for (auto &h: hits) {
-        h.SetPosition(h.GetPosition() + offset);
-    }
+    hits.Shift(offset);
 }
\ No newline at end of file
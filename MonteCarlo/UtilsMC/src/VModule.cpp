@@ -24,4 +24,18 @@ namespace fwk {
 
     }
 
+
+    vector<VModule::EResultFlag>
+    VModule::ProcessBatch(const vector<ModuleExchangeSpace *> &events)
+    {
+        vector<EResultFlag> flags;
+        flags.reserve(events.size());
+        for (auto event: events) {
+            flags.push_back(Process(*event));
+            if (flags.back() == eBreakLoop || flags.back() == eFailure)
+                break;
+        }
+        return flags;
+    }
+
 }
@@ -0,0 +1,75 @@
+#include "TPCReco/SamplingTable.h"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace utl;
+
+TEST(SamplingTableTest, DiscreteIndices) {
+    DiscreteSamplingTable table({1, 0, 3, 0});
+    EXPECT_EQ(table.GetSize(), 4u);
+    EXPECT_EQ(table.Sample(0.), 0u);
+    EXPECT_EQ(table.Sample(0.2499), 0u);
+    EXPECT_EQ(table.Sample(0.25), 2u);
+    EXPECT_EQ(table.Sample(0.9999), 2u);
+    //zero weights are never selected, also at the edges of the interval
+    EXPECT_EQ(table.Sample(1.), 2u);
+    double fraction;
+    EXPECT_EQ(table.Sample(0.625, fraction), 2u);
+    EXPECT_DOUBLE_EQ(fraction, 0.5);
+}
+
+TEST(SamplingTableTest, DiscreteFrequencies) {
+    std::vector<double> weights = {0.5, 2, 1.5};
+    DiscreteSamplingTable table(weights);
+    std::vector<int> counts(weights.size());
+    const int n = 40000;
+    for (int i = 0; i < n; ++i)
+        ++counts[table.Sample((i + 0.5) / n)];
+    EXPECT_EQ(counts[0], 5000);
+    EXPECT_EQ(counts[1], 20000);
+    EXPECT_EQ(counts[2], 15000);
+}
+
+TEST(SamplingTableTest, InvalidWeights) {
+    EXPECT_THROW(DiscreteSamplingTable({0, 0}), std::invalid_argument);
+    EXPECT_THROW(DiscreteSamplingTable({1, -1}), std::invalid_argument);
+    EXPECT_THROW(DiscreteSamplingTable(std::vector<double>{}), std::invalid_argument);
+    EXPECT_THROW(InverseCDFTable([](double) { return 1.; }, 1, 0), std::invalid_argument);
+    EXPECT_THROW(DiscreteSamplingTable().Sample(0.5), std::logic_error);
+}
+
+TEST(SamplingTableTest, InverseCDF) {
+    //uniform density: identity up to the range transformation
+    InverseCDFTable uniform([](double) { return 2.; }, -1, 3, 100);
+    EXPECT_DOUBLE_EQ(uniform.Sample(0.), -1);
+    EXPECT_NEAR(uniform.Sample(0.5), 1, 1e-12);
+    EXPECT_NEAR(uniform.Sample(0.8), 2.2, 1e-12);
+
+    //linear density on [0,1]: CDF = x^2
+    InverseCDFTable linear([](double x) { return x; }, 0, 1, 10000);
+    for (auto u: {0.01, 0.25, 0.5, 0.81}) {
+        EXPECT_NEAR(linear.Sample(u), std::sqrt(u), 1e-4) << u;
+    }
+
+    //no samples where the density vanishes
+    InverseCDFTable gap([](double x) { return std::abs(x) < 1 ? 0. : 1.; }, -2, 2, 400);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_GE(std::abs(gap.Sample(i / 1000.)), 1.);
+    }
+}
+
+TEST(SamplingTableTest, InverseCDF2D) {
+    InverseCDFTable2D table([](double x, double y) { return x < 0 && y > 0 ? 1. : 0.; },
+                            -1, 1, 20, -1, 1, 10);
+    for (int i = 0; i < 100; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            auto xy = table.Sample(i / 100., j / 10.);
+            EXPECT_LE(xy.first, 0);
+            EXPECT_GE(xy.second, 0);
+            EXPECT_GE(xy.first, -1);
+            EXPECT_LE(xy.second, 1);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+// header for unit test of SimHitCollection and SimTrack hit operations
+
+#include "TPCReco/SimHitCollection.h"
+#include "TPCReco/SimTrack.h"
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+    SimHitCollection MakeHits() {
+        SimHitCollection hits;
+        hits.push_back({3, 0, 5, 0.3});
+        hits.push_back({1, 0, -2, 0.1});
+        hits.push_back({-2, 0, 4, 0.2});
+        hits.push_back({0, 0, 7, 0.4});
+        return hits;
+    }
+}
+
+
+TEST(SimHitCollectionTest, InsertAndRead) {
+    auto hits = MakeHits();
+    ASSERT_EQ(hits.size(), 4u);
+    auto hit = hits[2];
+    EXPECT_FLOAT_EQ(hit.GetPosition().X(), -2);
+    EXPECT_FLOAT_EQ(hit.GetPosition().Z(), 4);
+    EXPECT_FLOAT_EQ(hit.GetEnergy(), 0.2);
+    EXPECT_FALSE(hit.IsInside());
+    double sum = 0;
+    for (const auto &h: hits) {
+        sum += h.GetEnergy();
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-6);
+    EXPECT_NEAR(hits.GetEnergySum(), 1.0, 1e-6);
+}
+
+
+TEST(SimHitCollectionTest, ClassifyAndMinZ) {
+    auto hits = MakeHits();
+    double minZ = 0;
+    EXPECT_FALSE(hits.GetMinZInside(minZ));
+    auto nInside = hits.ClassifyInside([](double x, double, double) { return x >= 0; });
+    EXPECT_EQ(nInside, 3u);
+    EXPECT_TRUE(hits.IsInside(0));
+    EXPECT_FALSE(hits.IsInside(2));
+    EXPECT_TRUE(hits[1].IsInside());
+    ASSERT_TRUE(hits.GetMinZInside(minZ));
+    EXPECT_FLOAT_EQ(minZ, -2);
+    hits.SetInside(1, false);
+    ASSERT_TRUE(hits.GetMinZInside(minZ));
+    EXPECT_FLOAT_EQ(minZ, 5);
+}
+
+
+TEST(SimHitCollectionTest, SortKeepsHitsTogether) {
+    auto hits = MakeHits();
+    hits.SetInside(3, true);
+    hits.SortByDistance({0, 0, 0});
+    std::vector<float> expectedZ{-2, 4, 5, 7};
+    std::vector<float> expectedEnergy{0.1, 0.2, 0.3, 0.4};
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_FLOAT_EQ(hits.Z(i), expectedZ[i]);
+        EXPECT_FLOAT_EQ(hits.GetEnergy(i), expectedEnergy[i]);
+        EXPECT_EQ(hits.IsInside(i), i == 3);
+    }
+}
+
+
+TEST(SimHitCollectionTest, TrackShiftAndStop) {
+    SimTrack track;
+    track.SetStart({0, 0, 0});
+    for (const auto &h: MakeHits()) {
+        track.InsertHit(h);
+    }
+    track.SortHits();
+    track.RecalculateStopPosition();
+    EXPECT_FLOAT_EQ(track.GetStop().Z(), 7);
+    TVector3 offset{1, 2, 3};
+    track.Shift(offset);
+    EXPECT_FLOAT_EQ(track.GetStop().Z(), 10);
+    EXPECT_FLOAT_EQ(track.GetHits().X(0), 2);
+    EXPECT_FLOAT_EQ(track.GetHits().Y(0), 2);
+    EXPECT_FLOAT_EQ(track.GetHits().Z(0), 1);
+    EXPECT_EQ(track.GetNHits(), 4u);
+}
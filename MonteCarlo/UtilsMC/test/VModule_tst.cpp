@@ -0,0 +1,62 @@
+// header for unit test of VModule batch processing
+
+#include "TPCReco/VModule.h"
+#include <memory>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+using namespace fwk;
+using namespace std;
+
+namespace {
+    // Module returning a predefined sequence of flags, one per Process call
+    class FlagModule : public VModule {
+    public:
+        explicit FlagModule(vector<EResultFlag> flags) : fFlags(std::move(flags)) {}
+
+        EResultFlag Init(boost::property_tree::ptree) override { return eSuccess; }
+
+        EResultFlag Process(ModuleExchangeSpace &event) override {
+            fProcessed.push_back(&event);
+            return fFlags.at(fProcessed.size() - 1);
+        }
+
+        EResultFlag Finish() override { return eSuccess; }
+
+        std::string GetName() const override { return "FlagModule"; }
+
+        vector<ModuleExchangeSpace *> fProcessed;
+    private:
+        vector<EResultFlag> fFlags;
+    };
+
+    vector<ModuleExchangeSpace *> MakeBatch(vector<unique_ptr<ModuleExchangeSpace>> &storage, size_t n) {
+        vector<ModuleExchangeSpace *> batch;
+        for (size_t i = 0; i < n; ++i) {
+            storage.push_back(make_unique<ModuleExchangeSpace>());
+            batch.push_back(storage.back().get());
+        }
+        return batch;
+    }
+}
+
+
+TEST(VModuleTest, ProcessBatchKeepsOrder) {
+    vector<unique_ptr<ModuleExchangeSpace>> storage;
+    auto batch = MakeBatch(storage, 3);
+    FlagModule module({VModule::eSuccess, VModule::eContinueLoop, VModule::eSuccess});
+    auto flags = module.ProcessBatch(batch);
+    EXPECT_EQ(flags, (vector<VModule::EResultFlag>{VModule::eSuccess, VModule::eContinueLoop, VModule::eSuccess}));
+    EXPECT_EQ(module.fProcessed, batch);
+}
+
+
+TEST(VModuleTest, ProcessBatchStopsAtBreak) {
+    vector<unique_ptr<ModuleExchangeSpace>> storage;
+    auto batch = MakeBatch(storage, 4);
+    FlagModule module({VModule::eSuccess, VModule::eBreakLoop, VModule::eSuccess, VModule::eSuccess});
+    auto flags = module.ProcessBatch(batch);
+    EXPECT_EQ(flags, (vector<VModule::EResultFlag>{VModule::eSuccess, VModule::eBreakLoop}));
+    EXPECT_EQ(module.fProcessed.size(), 2u);
+}
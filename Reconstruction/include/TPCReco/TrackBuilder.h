@@ -15,6 +15,7 @@
 #include "TPCReco/Track3D.h"
 #include "TPCReco/RecHitBuilder.h"
 #include "TPCReco/dEdxFitter.h"
+#include "TPCReco/TrackLineFitter.h"
 
 #include "TPCReco/EventTPC.h"
 #include "TPCReco/EventInfo.h"
@@ -40,6 +41,14 @@ public:
 
   void setPressure(double aPressure);
 
+  /// Select the 3D track fit:
+  /// TANGENT_BIAS_ANALYTIC - joint bias and tangent fit with analytic gradient,
+  /// tracks with more than one segment are fitted as for the other values,
+  /// any other value - sequence of TANGENT, BIAS_XY, BIAS_Z fits with Minuit2.
+  void setFitType(definitions::fit_type aFitType) { myFitType = aFitType;}
+
+  definitions::fit_type getFitType() const { return myFitType;}
+
   void reconstruct();
 
   const TH2D & getCluster2D(int iDir) const;
@@ -137,6 +146,9 @@ private:
   /// BIAS_TANGENT - both bias and tangent are fitted
   void fitTrack3DInSelectedDir(Track3D & aTrackCandidate, definitions::fit_type fitType);
 
+  /// Fit bias and tangent of a single segment track jointly with TrackLineFitter
+  void fitTrack3DAnalytic(Track3D & aTrackCandidate);
+
   Track3D fitTrack3D(const Track3D & aTrackCandidate);
 
   Track3D fitEventHypothesis(const Track3D & aTrackCandidate);
@@ -149,6 +161,8 @@ private:
   std::shared_ptr<GeometryTPC> myGeometryPtr;
   RecHitBuilder myRecHitBuilder;
   dEdxFitter mydEdxFitter;
+  TrackLineFitter myLineFitter;
+  definitions::fit_type myFitType{definitions::fit_type::TANGENT};
   double myPressure{190};
   
   std::vector<double> phiPitchDirection;
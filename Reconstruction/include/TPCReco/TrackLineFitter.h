@@ -0,0 +1,65 @@
+#ifndef _TrackLineFitter_H_
+#define _TrackLineFitter_H_
+
+#include <vector>
+
+#include <TVector3.h>
+
+#include "TPCReco/TrackSegment3D.h"
+
+/// Joint fit of the straight line (bias and tangent) of a 3D track segment
+/// to its rec-hits. The loss is the charge weighted point-to-line distance
+/// of TrackSegment2D::getHitDistanceLoss() summed over the U, V, W projections.
+/// The loss is evaluated together with its analytic gradient and the
+/// Gauss-Newton approximation of the Hessian, and minimised with the
+/// Levenberg-Marquardt method in a single pass over all four line parameters.
+class TrackLineFitter{
+
+public:
+
+  struct Result{
+    double initialLoss{0};
+    double loss{0};
+    unsigned int nIterations{0};
+    unsigned int nLossCalls{0};
+    bool converged{false};
+  };
+
+  TrackLineFitter(){};
+
+  void setMaxIterations(unsigned int aValue){ maxIterations = aValue;}
+
+  void setTolerance(double aValue){ tolerance = aValue;}
+
+  /// Fit the segment bias and tangent. The segment is updated
+  /// only if the loss improved.
+  Result fit(TrackSegment3D & aSegment) const;
+
+  /// Return the loss of the line through aBias along aTangent and its gradient
+  /// with respect to the local line parameters: bias shifts along e1, e2
+  /// and tangent rotations towards e1, e2, where {e1, e2} are unit vectors
+  /// perpendicular to the tangent, see getPerpendicularBase().
+  double getLossAndGradient(const TrackSegment3D & aSegment,
+			    const TVector3 & aBias, const TVector3 & aTangent,
+			    double *gradient) const;
+
+  /// Unit vectors perpendicular to the tangent and to each other.
+  static void getPerpendicularBase(const TVector3 & aTangent, TVector3 & e1, TVector3 & e2);
+
+private:
+
+  static constexpr unsigned int nParams{4};
+
+  /// Accumulate loss, J^T*J and J^T*r of the residuals
+  /// r = sqrt(charge/projectionCharge)*distance.
+  double accumulate(const TrackSegment3D & aSegment,
+		    const TVector3 & aBias, const TVector3 & aTangent,
+		    double JtJ[nParams][nParams], double Jtr[nParams]) const;
+
+  unsigned int maxIterations{50};
+  double tolerance{1E-6};    // relative loss change for convergence
+  double maxDistance{20.0};  // same as in TrackSegment2D::getHitDistanceLoss()
+  double dummyLoss{999.0};   // same as in TrackSegment2D::getHitDistanceLoss()
+};
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "TPCReco/GeometryTPC.h"
 #include "TPCReco/RecHitBuilder.h"
+#include "TPCReco/PerfMonitor.h"
 
 #include "TPCReco/colorText.h"
 #ifndef M_PI
@@ -31,6 +32,7 @@ void RecHitBuilder::setGeometry(std::shared_ptr<GeometryTPC> aGeometryPtr){
 /////////////////////////////////////////////////////////
 const TH2D & RecHitBuilder::makeRecHits(const TH2D & hProjection){
 
+  TPCRECO_TIME_SCOPE("RecHitBuilder::makeRecHits");
   hRecHits = hProjection;
   hRecHits.Reset();
   hRecHits.SetTitle(adaptHistoTitle(hProjection.GetTitle()).c_str());
@@ -259,6 +261,7 @@ double RecHitBuilder::getKernelSum(const std::vector<int> & kernelBins, const TH
 /////////////////////////////////////////////////////////
 TH2D RecHitBuilder::makeCleanCluster(const TH2D & aHisto){
 
+  TPCRECO_TIME_SCOPE("RecHitBuilder::makeCleanCluster");
   kernelSumThreshold = 300;//parameter to moved to configuration
 
   TH2D aClusterHisto(aHisto);
@@ -544,7 +544,7 @@ std::vector<int> StripResponseCalculator::getReferenceStripNode(TVector2 positio
 
 std::vector<int> StripResponseCalculator::getReferenceStripNode(double x, double y, TVector2 *refNodePosInMM) const {
     std::vector<int> result;
-    auto strip = myGeometryPtr->GetTH2PolyStrip(myGeometryPtr->GetTH2Poly()->FindBin(x, y));
+    auto strip = myGeometryPtr->FindStrip(x, y);
     if (!strip) {
         if (debug_flag)
             std::cout << __FUNCTION__
@@ -579,8 +579,7 @@ std::vector<int> StripResponseCalculator::getReferenceStripNode(double x, double
         for (auto isign = -1; isign <= 1; isign += 2) { // probe 2 adjacent pads for each direction index
             const auto checkPos =
                     nodePos + myGeometryPtr->GetStripUnitVector(check_dir) * 0.5 * myGeometryPtr->GetPadPitch() * isign;
-            const auto check_strip = myGeometryPtr->GetTH2PolyStrip(
-                    myGeometryPtr->GetTH2Poly()->FindBin(checkPos.X(), checkPos.Y()));
+            const auto check_strip = myGeometryPtr->FindStrip(checkPos.X(), checkPos.Y());
             if (!check_strip) continue;
             stripMap[check_dir] = check_strip->Num();
 
@@ -727,8 +726,7 @@ void StripResponseCalculator::initializeStripResponse(unsigned long NpointsXY, i
                 if (c1 * c1 + c2 * c2 > R2) continue; // stay within radius of (PAD SIZE + epsilon)
                 const auto x = c1 + delta_x; // [mm] wrt reference strip node
                 const auto y = c2 + delta_y; // [mm] wrt reference strip node
-                const auto strip = myGeometryPtr->GetTH2PolyStrip(
-                        myGeometryPtr->GetTH2Poly()->FindBin(refNodePosInMM.X() + x, refNodePosInMM.Y() + y));
+                const auto strip = myGeometryPtr->FindStrip(refNodePosInMM.X() + x, refNodePosInMM.Y() + y);
                 if (!strip) continue;
 
                 // fill charge fraction for merged strips
@@ -18,6 +18,7 @@
 #include "TPCReco/GeometryTPC.h"
 
 #include "TPCReco/TrackBuilder.h"
+#include "TPCReco/PerfMonitor.h"
 #include "TPCReco/colorText.h"
 
 #ifndef M_PI
@@ -201,6 +202,7 @@ void TrackBuilder::setEvent(std::shared_ptr<EventTPC> aEvent){
 /////////////////////////////////////////////////////////
 void TrackBuilder::reconstruct(){
 
+  TPCRECO_TIME_SCOPE("TrackBuilder::reconstruct");
   hTimeProjection.Reset();  
   for(int iDir=definitions::projection_type::DIR_U;iDir<=definitions::projection_type::DIR_W;++iDir){
     makeRecHits(iDir);
@@ -208,7 +210,10 @@ void TrackBuilder::reconstruct(){
     //my2DSeeds[iDir] = findSegment2DCollection(iDir);    
   }
   myZRange = getProjectionEdges(hTimeProjection);
-  myTrack3DSeed = buildSegment3D();
+  {
+    TPCRECO_TIME_SCOPE("TrackBuilder::buildSegment3D");
+    myTrack3DSeed = buildSegment3D();
+  }
   
   Track3D aTrackCandidate;
   aTrackCandidate.addSegment(myTrack3DSeed);
@@ -220,6 +225,7 @@ void TrackBuilder::reconstruct(){
 /////////////////////////////////////////////////////////
 void TrackBuilder::makeRecHits(int iDir){
 
+  TPCRECO_TIME_SCOPE("TrackBuilder::makeRecHits");
   std::shared_ptr<TH2D> hProj = myEventPtr->get2DProjection(get2DProjectionType(iDir),
 							    filter_type::threshold,
 //							    filter_type::fraction,
@@ -281,6 +287,7 @@ const Track3D & TrackBuilder::getTrack3D(unsigned int iSegment) const{return myF
 /////////////////////////////////////////////////////////
 void TrackBuilder::fillHoughAccumulator(int iDir){
 
+  TPCRECO_TIME_SCOPE("TrackBuilder::fillHoughAccumulator");
   myAccumulators[iDir].Reset();
   
   const TH2D & hRecHits  = getRecHits2D(iDir);
@@ -782,6 +789,16 @@ Track3D TrackBuilder::fitDot(Track3D & aFittedTrack){
 /////////////////////////////////////////////////////////
 void TrackBuilder::fitTrack3DInSelectedDir(Track3D & aFittedTrack, definitions::fit_type fitType){
 
+  ///one timing stage per Minuit2 fit type, indexed by definitions::fit_type
+  static auto & perfMonitor = tpcreco::utilities::PerfMonitor::instance();
+  static std::vector<tpcreco::utilities::PerfMonitor::Stage*> fitStages = {
+    &perfMonitor.getStage("TrackBuilder::fitTrack3D[TANGENT]"),
+    &perfMonitor.getStage("TrackBuilder::fitTrack3D[BIAS_Z]"),
+    &perfMonitor.getStage("TrackBuilder::fitTrack3D[BIAS_XY]"),
+    &perfMonitor.getStage("TrackBuilder::fitTrack3D[TANGENT_BIAS]"),
+    &perfMonitor.getStage("TrackBuilder::fitTrack3D[START_STOP]")};
+  tpcreco::utilities::ScopedTimer aTimer(*fitStages.at(static_cast<int>(fitType)));
+
   double chamberRadius = 300; //mm parameter to be moved to configuration
 
   aFittedTrack.setFitMode(fitType);
@@ -790,6 +807,7 @@ void TrackBuilder::fitTrack3DInSelectedDir(Track3D & aFittedTrack, definitions::
   double initialLoss = aFittedTrack.getLoss();
   auto fitResult = fitTrackNodesBiasTangent(aFittedTrack, fitType);
   double afterFitLoss = fitResult.MinFcnValue();
+  TPCRECO_COUNT("TrackBuilder::fitTrack3D.nFcnCalls", fitResult.NCalls());
    if(initialLoss>1.01*afterFitLoss){
     aFittedTrack.updateAndGetLoss(fitResult.GetParams());
   }  
@@ -805,15 +823,41 @@ Track3D TrackBuilder::fitTrack3D(const Track3D & aTrackCandidate){
     return aFittedTrack;
   }
 
-  fitTrack3DInSelectedDir(aFittedTrack, definitions::fit_type::TANGENT);
-  fitTrack3DInSelectedDir(aFittedTrack, definitions::fit_type::BIAS_XY);
-  fitTrack3DInSelectedDir(aFittedTrack, definitions::fit_type::BIAS_Z);
+  ///the analytic fit handles a single straight segment only
+  if(myFitType==definitions::fit_type::TANGENT_BIAS_ANALYTIC &&
+     aFittedTrack.getSegments().size()==1){
+    fitTrack3DAnalytic(aFittedTrack);
+  }
+  else{
+    fitTrack3DInSelectedDir(aFittedTrack, definitions::fit_type::TANGENT);
+    fitTrack3DInSelectedDir(aFittedTrack, definitions::fit_type::BIAS_XY);
+    fitTrack3DInSelectedDir(aFittedTrack, definitions::fit_type::BIAS_Z);
+  }
   aFittedTrack.shrinkToHits();
 
   return aFittedTrack;
 }
 /////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////
+void TrackBuilder::fitTrack3DAnalytic(Track3D & aFittedTrack){
+
+  TPCRECO_TIME_SCOPE("TrackBuilder::fitTrack3D[TANGENT_BIAS_ANALYTIC]");
+  double chamberRadius = 300; //mm parameter to be moved to configuration
+
+  aFittedTrack.setFitMode(definitions::fit_type::TANGENT_BIAS_ANALYTIC);
+  aFittedTrack.extendToChamberRange(chamberRadius);
+
+  auto fitResult = myLineFitter.fit(aFittedTrack.getSegments().front());
+  TPCRECO_COUNT("TrackBuilder::fitTrack3D.nFcnCalls", fitResult.nLossCalls);
+  if(!fitResult.converged){
+    std::cout<<KRED<<"Track3D analytic fit did not converge after "<<RST
+	     <<fitResult.nIterations<<KRED<<" iterations."<<RST<<std::endl;
+  }
+  aFittedTrack.update();
+  aFittedTrack.extendToChamberRange(chamberRadius);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
 ROOT::Fit::FitResult TrackBuilder::fitTrackNodesBiasTangent(const Track3D & aTrack, 
                     definitions::fit_type fitType) const{
 
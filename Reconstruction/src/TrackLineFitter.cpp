@@ -0,0 +1,196 @@
+#include <cmath>
+#include <algorithm>
+
+#include "TPCReco/TrackLineFitter.h"
+#include "TPCReco/GeometryTPC.h"
+
+namespace {
+
+/// Solve A*x = b for small dense matrices with partial pivoting.
+/// Returns false for a singular matrix.
+template<unsigned int N>
+bool solve(double A[N][N], double b[N], double x[N]){
+
+  for(unsigned int iCol=0;iCol<N;++iCol){
+    unsigned int iPivot = iCol;
+    for(unsigned int iRow=iCol+1;iRow<N;++iRow){
+      if(std::abs(A[iRow][iCol])>std::abs(A[iPivot][iCol])) iPivot = iRow;
+    }
+    if(std::abs(A[iPivot][iCol])<1E-300) return false;
+    if(iPivot!=iCol){
+      for(unsigned int k=0;k<N;++k) std::swap(A[iCol][k], A[iPivot][k]);
+      std::swap(b[iCol], b[iPivot]);
+    }
+    for(unsigned int iRow=iCol+1;iRow<N;++iRow){
+      double factor = A[iRow][iCol]/A[iCol][iCol];
+      for(unsigned int k=iCol;k<N;++k) A[iRow][k] -= factor*A[iCol][k];
+      b[iRow] -= factor*b[iCol];
+    }
+  }
+  for(int iRow=N-1;iRow>=0;--iRow){
+    double sum = b[iRow];
+    for(unsigned int k=iRow+1;k<N;++k) sum -= A[iRow][k]*x[k];
+    x[iRow] = sum/A[iRow][iRow];
+  }
+  return true;
+}
+
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+void TrackLineFitter::getPerpendicularBase(const TVector3 & aTangent, TVector3 & e1, TVector3 & e2){
+
+  e1 = aTangent.Orthogonal().Unit();
+  e2 = aTangent.Unit().Cross(e1);
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+double TrackLineFitter::accumulate(const TrackSegment3D & aSegment,
+				   const TVector3 & aBias, const TVector3 & aTangent,
+				   double JtJ[nParams][nParams], double Jtr[nParams]) const{
+
+  for(unsigned int i=0;i<nParams;++i){
+    Jtr[i] = 0.0;
+    for(unsigned int j=0;j<nParams;++j) JtJ[i][j] = 0.0;
+  }
+
+  TVector3 e1, e2;
+  getPerpendicularBase(aTangent, e1, e2);
+
+  double loss = 0.0;
+  const std::vector<Hit2DCollection> & aRecHits = aSegment.getRecHits();
+  for(int strip_dir=definitions::projection_type::DIR_U;strip_dir<=definitions::projection_type::DIR_W;++strip_dir){
+    const Hit2DCollection & aHits = aRecHits.at(strip_dir);
+    if(aHits.empty()) continue;
+    const TVector3 stripPitchDirection = aSegment.getGeometry()->GetStripPitchVector3D(strip_dir);
+
+    // line projected on the (time, strip) plane: b + lambda*v
+    double b1 = aBias.Z(), b2 = aBias*stripPitchDirection;
+    double v1 = aTangent.Z(), v2 = aTangent*stripPitchDirection;
+    double n = std::sqrt(v1*v1 + v2*v2);
+    if(n<1E-9){
+      loss += dummyLoss;
+      continue;
+    }
+    // projections of the parameter directions
+    double w1[2] = {e1.Z(), e1*stripPitchDirection};
+    double w2[2] = {e2.Z(), e2*stripPitchDirection};
+
+    double projectionLoss = 0.0, chargeSum = 0.0;
+    double projectionJtJ[nParams][nParams] = {};
+    double projectionJtr[nParams] = {};
+    for(const auto & aHit: aHits){
+      double dx = aHit.getPosTime() - b1;
+      double dy = aHit.getPosStrip() - b2;
+      double c = dx*v2 - dy*v1;
+      double distance = c/n;
+      if(std::abs(distance)>maxDistance) continue;
+      double charge = std::abs(aHit.getCharge());
+      chargeSum += charge;
+      projectionLoss += charge*distance*distance;
+
+      // d(distance)/d(b) and d(distance)/d(v)
+      double dDdb1 = -v2/n, dDdb2 = v1/n;
+      double dDdv1 = -dy/n - c*v1/(n*n*n);
+      double dDdv2 =  dx/n - c*v2/(n*n*n);
+      double dD[nParams] = {dDdb1*w1[0] + dDdb2*w1[1],
+			    dDdb1*w2[0] + dDdb2*w2[1],
+			    dDdv1*w1[0] + dDdv2*w1[1],
+			    dDdv1*w2[0] + dDdv2*w2[1]};
+      for(unsigned int i=0;i<nParams;++i){
+	projectionJtr[i] += charge*distance*dD[i];
+	for(unsigned int j=0;j<=i;++j) projectionJtJ[i][j] += charge*dD[i]*dD[j];
+      }
+    }
+    if(chargeSum<1){
+      loss += dummyLoss;
+      continue;
+    }
+    loss += projectionLoss/chargeSum;
+    for(unsigned int i=0;i<nParams;++i){
+      Jtr[i] += projectionJtr[i]/chargeSum;
+      for(unsigned int j=0;j<=i;++j) JtJ[i][j] += projectionJtJ[i][j]/chargeSum;
+    }
+  }
+  for(unsigned int i=0;i<nParams;++i){
+    for(unsigned int j=i+1;j<nParams;++j) JtJ[i][j] = JtJ[j][i];
+  }
+  return loss;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+double TrackLineFitter::getLossAndGradient(const TrackSegment3D & aSegment,
+					   const TVector3 & aBias, const TVector3 & aTangent,
+					   double *gradient) const{
+
+  double JtJ[nParams][nParams], Jtr[nParams];
+  double loss = accumulate(aSegment, aBias, aTangent.Unit(), JtJ, Jtr);
+  for(unsigned int i=0;i<nParams;++i) gradient[i] = 2*Jtr[i];
+  return loss;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
+TrackLineFitter::Result TrackLineFitter::fit(TrackSegment3D & aSegment) const{
+
+  Result aResult;
+  if(!aSegment.getGeometry()) return aResult;
+  std::size_t nHits = 0;
+  for(const auto & aHits: aSegment.getRecHits()) nHits += aHits.size();
+  if(nHits<3) return aResult;
+
+  TVector3 aBias = aSegment.getBias();
+  TVector3 aTangent = aSegment.getTangent().Unit();
+  double JtJ[nParams][nParams], Jtr[nParams];
+  double loss = accumulate(aSegment, aBias, aTangent, JtJ, Jtr);
+  ++aResult.nLossCalls;
+  aResult.initialLoss = loss;
+
+  double lambda = 1E-3;
+  double A[nParams][nParams], b[nParams], step[nParams];
+  double trialJtJ[nParams][nParams], trialJtr[nParams];
+  TVector3 e1, e2;
+  while(aResult.nIterations<maxIterations){
+    ++aResult.nIterations;
+    for(unsigned int i=0;i<nParams;++i){
+      for(unsigned int j=0;j<nParams;++j) A[i][j] = JtJ[i][j];
+      A[i][i] += lambda*std::max(JtJ[i][i], 1E-12);
+      b[i] = -Jtr[i];
+    }
+    if(!solve<nParams>(A, b, step)){
+      lambda *= 10;
+      if(lambda>1E10) break;
+      continue;
+    }
+    getPerpendicularBase(aTangent, e1, e2);
+    TVector3 trialBias = aBias + step[0]*e1 + step[1]*e2;
+    TVector3 trialTangent = (aTangent + step[2]*e1 + step[3]*e2).Unit();
+    double trialLoss = accumulate(aSegment, trialBias, trialTangent, trialJtJ, trialJtr);
+    ++aResult.nLossCalls;
+    if(trialLoss<loss){
+      double change = loss - trialLoss;
+      aBias = trialBias;
+      aTangent = trialTangent;
+      loss = trialLoss;
+      std::copy(&trialJtJ[0][0], &trialJtJ[0][0]+nParams*nParams, &JtJ[0][0]);
+      std::copy(trialJtr, trialJtr+nParams, Jtr);
+      lambda = std::max(lambda/10, 1E-9);
+      if(change<tolerance*std::max(loss, 1E-12)){
+	aResult.converged = true;
+	break;
+      }
+    }
+    else{
+      lambda *= 10;
+      // no step decreases the loss: at the minimum within numerical precision
+      if(lambda>1E10){
+	aResult.converged = true;
+	break;
+      }
+    }
+  }
+  aResult.loss = loss;
+  if(loss<aResult.initialLoss) aSegment.setBiasTangent(aBias, aTangent);
+  return aResult;
+}
+/////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////
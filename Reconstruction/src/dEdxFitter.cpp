@@ -1,5 +1,6 @@
 #include "TPCReco/dEdxFitter.h"
 #include "TPCReco/colorText.h"
+#include "TPCReco/PerfMonitor.h"
 
 #include <TFitResultPtr.h>
 #include <Math/MinimizerOptions.h>
@@ -255,6 +256,7 @@ TFitResult dEdxFitter::fitHypothesis(TF1 *fModel, TH1F & aHisto){
 ////////////////////////////////////////////////
 TFitResult dEdxFitter::fitHisto(const TH1F & aHisto){
 
+  TPCRECO_TIME_SCOPE("dEdxFitter::fitHisto");
   /// C12+alpha hypothesis
   TH1F fittedHisto_for_C12_alpha = aHisto;
   bool reflection_for_C12_alpha = false;
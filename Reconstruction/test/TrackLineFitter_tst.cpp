@@ -0,0 +1,113 @@
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/TrackLineFitter.h"
+#include "TPCReco/TrackSegment3D.h"
+#include "gtest/gtest.h"
+#include <TRandom3.h>
+#include <TVector3.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+const std::string geometryFile =
+    std::string(TPCRECO_RESOURCE_DIR) + "geometry_ELITPC_250mbar_12.5MHz.dat";
+} // namespace
+
+class TrackLineFitterTest : public ::testing::Test {
+public:
+  static std::shared_ptr<GeometryTPC> myGeometryPtr;
+
+  static void SetUpTestSuite() {
+    GeometryTPC::SetCompiledGeometryDir("");
+    myGeometryPtr = std::make_shared<GeometryTPC>(geometryFile.c_str(), false);
+  }
+  static void TearDownTestSuite() { myGeometryPtr.reset(); }
+
+  // rec-hits of a straight track, spread around the line
+  TrackSegment3D makeSegment(const TVector3 &aStart, const TVector3 &aEnd,
+                             unsigned int seed) {
+    TrackSegment3D aSegment;
+    aSegment.setGeometry(myGeometryPtr);
+    TRandom3 aRndm(seed);
+    std::vector<Hit2DCollection> aRecHits(3);
+    TVector3 aStep = (aEnd - aStart).Unit() * 0.5;
+    int nSteps = (aEnd - aStart).Mag() / 0.5;
+    for (int strip_dir = definitions::projection_type::DIR_U;
+         strip_dir <= definitions::projection_type::DIR_W; ++strip_dir) {
+      TVector3 stripPitchDirection =
+          myGeometryPtr->GetStripPitchVector3D(strip_dir);
+      for (int iStep = 0; iStep <= nSteps; ++iStep) {
+        TVector3 aPoint = aStart + iStep * aStep;
+        aRecHits[strip_dir].push_back(
+            Hit2D(aPoint.Z() + aRndm.Gaus(0, 1.0),
+                  aPoint * stripPitchDirection + aRndm.Gaus(0, 1.0),
+                  aRndm.Uniform(10, 100)));
+      }
+    }
+    aSegment.setRecHits(aRecHits);
+    aSegment.setStartEnd(aStart, aEnd);
+    return aSegment;
+  }
+};
+
+std::shared_ptr<GeometryTPC> TrackLineFitterTest::myGeometryPtr;
+
+TEST_F(TrackLineFitterTest, GradientMatchesFiniteDifferences) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  TrackLineFitter aFitter;
+  TRandom3 aRndm(1);
+  const double h = 1E-5;
+  for (unsigned int iTrack = 0; iTrack < 20; ++iTrack) {
+    TVector3 aStart(aRndm.Uniform(-50, 50), aRndm.Uniform(-50, 50),
+                    aRndm.Uniform(-50, 50));
+    TVector3 aDirection;
+    aRndm.Sphere(aDirection, aRndm.Uniform(50, 150));
+    auto aSegment = makeSegment(aStart, aStart + aDirection, iTrack);
+
+    // line close to, but not at the minimum of the loss
+    TVector3 e1, e2;
+    TrackLineFitter::getPerpendicularBase(aDirection, e1, e2);
+    TVector3 aBias = aStart + 0.5 * aDirection + 0.3 * e1 - 0.2 * e2;
+    TVector3 aTangent = (aDirection.Unit() + 0.01 * e1 + 0.02 * e2).Unit();
+
+    double gradient[4];
+    double loss = aFitter.getLossAndGradient(aSegment, aBias, aTangent, gradient);
+    ASSERT_GT(loss, 0.0);
+
+    // local parameters: bias shifts along e1, e2, tangent rotations towards e1, e2
+    TrackLineFitter::getPerpendicularBase(aTangent, e1, e2);
+    double dummy[4];
+    std::vector<std::pair<TVector3, TVector3>> aSteps = {
+        {e1, TVector3()}, {e2, TVector3()}, {TVector3(), e1}, {TVector3(), e2}};
+    for (unsigned int iParam = 0; iParam < aSteps.size(); ++iParam) {
+      const auto &aStep = aSteps[iParam];
+      double lossUp = aFitter.getLossAndGradient(
+          aSegment, aBias + h * aStep.first, aTangent + h * aStep.second, dummy);
+      double lossDown = aFitter.getLossAndGradient(
+          aSegment, aBias - h * aStep.first, aTangent - h * aStep.second, dummy);
+      double numerical = (lossUp - lossDown) / (2 * h);
+      EXPECT_NEAR(gradient[iParam], numerical,
+                  1E-4 * std::max(1.0, std::abs(numerical)))
+          << "track " << iTrack << " parameter " << iParam;
+    }
+  }
+}
+
+TEST_F(TrackLineFitterTest, FitNeedsThreeHits) {
+  ASSERT_TRUE(myGeometryPtr->IsOK());
+  TrackLineFitter aFitter;
+  TVector3 aStart(-30, 10, -20), aEnd(40, -20, 30);
+  auto aSegment = makeSegment(aStart, aEnd, 1);
+  std::vector<Hit2DCollection> aRecHits(3);
+  aRecHits[definitions::projection_type::DIR_U].push_back(
+      aSegment.getRecHits()[definitions::projection_type::DIR_U].front());
+  aRecHits[definitions::projection_type::DIR_V].push_back(
+      aSegment.getRecHits()[definitions::projection_type::DIR_V].front());
+  aSegment.setRecHits(aRecHits);
+  auto aResult = aFitter.fit(aSegment);
+  EXPECT_EQ(aResult.nIterations, 0U);
+  EXPECT_EQ(aResult.nLossCalls, 0U);
+  EXPECT_FALSE(aResult.converged);
+}
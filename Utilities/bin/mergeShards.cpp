@@ -0,0 +1,148 @@
+#include "TPCReco/EntryRange.h"
+#include <TFile.h>
+#include <TFileMerger.h>
+#include <TKey.h>
+#include <TTree.h>
+#include <TTreeIndex.h>
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+boost::optional<boost::program_options::variables_map>
+parseCmdLineArgs(int argc, char **argv) {
+
+  boost::program_options::options_description cmdLineOptDesc(
+      "Allowed command line options");
+
+  cmdLineOptDesc.add_options()("help", "produce help message")(
+      "output,o", boost::program_options::value<std::string>()->required(),
+      "output root file")(
+      "input,i",
+      boost::program_options::value<std::vector<std::string>>()->required(),
+      "input root files");
+
+  boost::program_options::positional_options_description cmdLinePosDesc;
+  cmdLinePosDesc.add("input", -1);
+  boost::program_options::variables_map varMap;
+
+  try {
+    boost::program_options::store(
+        boost::program_options::command_line_parser(argc, argv)
+            .options(cmdLineOptDesc)
+            .positional(cmdLinePosDesc)
+            .run(),
+        varMap);
+    if (varMap.count("help")) {
+      std::cout << "mergeShards [--help] --output <output> <inputs>..."
+                << "\nMerge histograms and trees of jobs run with "
+                   "'shard' option.\nInputs named <name>_shard<i>of<N>.root "
+                   "are merged in the shard order, other inputs in the "
+                   "given order.\nTree indices of the first input are "
+                   "rebuilt in the output\n"
+                << cmdLineOptDesc << '\n';
+      return boost::none;
+    }
+    boost::program_options::notify(varMap);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << '\n' << cmdLineOptDesc << '\n';
+    return boost::none;
+  }
+  return varMap;
+}
+
+int main(int argc, char **argv) {
+  auto varMap = parseCmdLineArgs(argc, argv);
+  if (!varMap) {
+    return 1;
+  };
+  auto inputNames = (*varMap)["input"].as<std::vector<std::string>>();
+  auto outputName = (*varMap)["output"].as<std::string>();
+
+  // deterministic order: shard index, then position on the command line
+  std::vector<std::tuple<unsigned int, std::size_t, std::string>> inputs;
+  unsigned int nShardsExpected = 0;
+  for (std::size_t i = 0; i < inputNames.size(); ++i) {
+    unsigned int shardIndex = 0, nShards = 0;
+    if (tpcreco::utilities::EntryRange::parseDecorated(inputNames[i],
+                                                       shardIndex, nShards)) {
+      if (nShardsExpected && nShards != nShardsExpected) {
+        std::cerr << "Inputs with different number of shards: "
+                  << inputNames[i] << '\n';
+        return 1;
+      }
+      nShardsExpected = nShards;
+    }
+    inputs.emplace_back(shardIndex, i, inputNames[i]);
+  }
+  std::sort(inputs.begin(), inputs.end());
+  if (nShardsExpected && inputs.size() != nShardsExpected) {
+    std::cerr << "Warning: " << inputs.size() << " inputs for "
+              << nShardsExpected << " shards\n";
+  }
+
+  // indices to be rebuilt after merging
+  std::vector<std::tuple<std::string, std::string, std::string>> indices;
+  auto *firstFile = TFile::Open(std::get<2>(inputs.front()).c_str(), "READ");
+  if (!firstFile) {
+    std::cerr << "Can't open input file " << std::get<2>(inputs.front())
+              << '\n';
+    return 1;
+  }
+  for (auto *key : *firstFile->GetListOfKeys()) {
+    auto *aKey = static_cast<TKey *>(key);
+    if (std::string(aKey->GetClassName()) != "TTree") {
+      continue;
+    }
+    auto *aTree = static_cast<TTree *>(aKey->ReadObj());
+    auto *aIndex = dynamic_cast<TTreeIndex *>(aTree->GetTreeIndex());
+    if (aIndex && std::none_of(indices.begin(), indices.end(),
+                               [aTree](const auto &aItem) {
+                                 return std::get<0>(aItem) == aTree->GetName();
+                               })) {
+      indices.emplace_back(aTree->GetName(), aIndex->GetMajorName(),
+                           aIndex->GetMinorName());
+    }
+  }
+  firstFile->Close();
+
+  TFileMerger aMerger(false, false);
+  aMerger.SetPrintLevel(0);
+  if (!aMerger.OutputFile(outputName.c_str(), "RECREATE")) {
+    std::cerr << "Can't open output file " << outputName << '\n';
+    return 1;
+  }
+  for (const auto &aInput : inputs) {
+    std::cout << "Adding " << std::get<2>(aInput) << '\n';
+    if (!aMerger.AddFile(std::get<2>(aInput).c_str())) {
+      std::cerr << "Can't open input file " << std::get<2>(aInput) << '\n';
+      return 1;
+    }
+  }
+  if (!aMerger.Merge()) {
+    std::cerr << "Merging failed\n";
+    return 1;
+  }
+
+  if (!indices.empty()) {
+    auto *outputFile = TFile::Open(outputName.c_str(), "UPDATE");
+    for (const auto &aItem : indices) {
+      auto *aTree = static_cast<TTree *>(
+          outputFile->Get(std::get<0>(aItem).c_str()));
+      if (!aTree) {
+        continue;
+      }
+      std::cout << "Building index of " << std::get<0>(aItem) << " on "
+                << std::get<1>(aItem) << ", " << std::get<2>(aItem) << '\n';
+      aTree->BuildIndex(std::get<1>(aItem).c_str(),
+                        std::get<2>(aItem).c_str());
+      aTree->Write("", TObject::kOverwrite);
+    }
+    outputFile->Close();
+  }
+  std::cout << "Merged " << inputs.size() << " files into " << outputName
+            << '\n';
+  return 0;
+}
@@ -40,7 +40,8 @@ enum class fit_type{
   BIAS_Z,       // Fit only track segment bias. Move along time direction. 
   BIAS_XY,       // Fit only track segment bias. Move in the strip plane.
   TANGENT_BIAS, // Fit both track segment bias and tangent
-  START_STOP // Fit both track segment start and stop
+  START_STOP, // Fit both track segment start and stop
+  TANGENT_BIAS_ANALYTIC // Fit both track segment bias and tangent in a single pass with analytic gradient
 };
 
 } //namespace definitions
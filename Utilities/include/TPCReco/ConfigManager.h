@@ -25,6 +25,7 @@
 #include <TString.h>
 
 #include "TPCReco/CommonDefinitions.h"
+#include "TPCReco/TypedConfig.h"
 #include "TPCReco/colorText.h"
 
 class ConfigManager
@@ -36,6 +37,9 @@ public:
     
     const boost::property_tree::ptree & getConfig(int argc, char** argv);
     static const boost::property_tree::ptree & getConfig();
+
+    // typed and validated groups of the final configuration, made once for use inside event loops
+    const tpcreco::config::TypedConfig & getTypedConfig();
     
     void dumpConfig(const std::string & jsonName);
 
@@ -95,6 +99,7 @@ public:
     boost::program_options::variables_map varMap;
     std::map<std::string, string_code> varTypeMap;
     boost::property_tree::ptree configTree;
+    boost::optional<tpcreco::config::TypedConfig> typedConfig;
     std::string allowedOptPath{""};
     std::set<std::string> allowedOptionsSet;
     bool helpMode{false};
@@ -0,0 +1,66 @@
+#ifndef TPCRECO_UTILITIES_ENTRY_RANGE_H_
+#define TPCRECO_UTILITIES_ENTRY_RANGE_H_
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+#include <Rtypes.h>
+#include <boost/property_tree/ptree.hpp>
+
+namespace tpcreco {
+namespace utilities {
+
+// Range [first, last) of input entries processed by a single job.
+// The selection is made of:
+//  * firstEntry - position of the first entry,
+//  * maxEntries - number of entries to process (-1 = all),
+//  * shard      - "i/N" selects the i-th (0-based) out of N consecutive,
+//                 equal-size parts of the range given by the two above.
+// Consecutive shards cover the selected range without gaps or overlaps,
+// so outputs merged in the shard order reproduce a single job output.
+class EntryRange {
+public:
+  EntryRange(Long64_t nEntries, Long64_t firstEntry = 0,
+             Long64_t maxEntries = -1, const std::string &shard = "");
+
+  // uses input.firstEntry, input.readNEvents and input.shard
+  static EntryRange fromConfig(Long64_t nEntries,
+                               const boost::property_tree::ptree &aConfig);
+
+  Long64_t first() const { return myFirst; }
+  Long64_t last() const { return myLast; }
+  Long64_t size() const { return myLast - myFirst; }
+  bool contains(Long64_t iEntry) const {
+    return iEntry >= myFirst && iEntry < myLast;
+  }
+
+  bool isSharded() const { return myNShards > 1; }
+  unsigned int shardIndex() const { return myShardIndex; }
+  unsigned int nShards() const { return myNShards; }
+
+  // Moves shard boundaries forward so that neighbouring positions
+  // belonging to the same group, e.g. duplicates of an event in a sorted
+  // tree, are never split between shards.
+  EntryRange
+  alignedTo(const std::function<bool(Long64_t, Long64_t)> &sameGroup) const;
+
+  // Inserts "_shard<i>of<N>" before the extension of a sharded job output file.
+  std::string decorate(const std::string &fileName) const;
+
+  // Extracts shard index and number of shards from a name made by decorate().
+  // Returns false for undecorated names.
+  static bool parseDecorated(const std::string &fileName,
+                             unsigned int &shardIndex, unsigned int &nShards);
+
+private:
+  Long64_t mySelectedFirst{0}, mySelectedLast{0}; // before sharding
+  Long64_t myFirst{0}, myLast{0};
+  unsigned int myShardIndex{0}, myNShards{1};
+};
+
+std::ostream &operator<<(std::ostream &out, const EntryRange &aRange);
+
+} // namespace utilities
+} // namespace tpcreco
+#endif // TPCRECO_UTILITIES_ENTRY_RANGE_H_
@@ -0,0 +1,74 @@
+#ifndef TPCRECO_UTILITIES_EVENT_INDEX_H_
+#define TPCRECO_UTILITIES_EVENT_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Rtypes.h>
+
+class TTree;
+
+namespace tpcreco {
+namespace utilities {
+
+// Sorted {major, minor} -> entry index of a TTree, usually {runId, eventId}.
+// attach() installs the index as the TTreeIndex of the tree, so that
+// GetEntryWithIndex(), getTreeIndexRange() and cloneUnique() can be used
+// afterwards. The index is taken from:
+//  * the TTreeIndex stored with the tree (written by our tools),
+//  * the on-disk cache, for older files opened read-only,
+//  * TTree::BuildIndex(), which reads all entries; the result is cached.
+// The cache is disabled unless enabled by the TPCRECO_CACHE_DIR environment
+// variable or SetCacheDir().
+// Lookups are binary searches in the sorted index.
+class EventIndex {
+public:
+  EventIndex() = default;
+
+  // minorName = "0" gives an index on the major value only,
+  // as in TTree::BuildIndex()
+  static EventIndex attach(TTree *tree, const std::string &majorName,
+                           const std::string &minorName = "0");
+
+  // directory for cached indices, empty = no cache
+  static void SetCacheDir(const std::string &dir);
+
+  bool empty() const { return myEntries.empty(); }
+  Long64_t size() const { return myEntries.size(); }
+
+  // entry number, -1 if not found. For duplicated keys the last one
+  // in the index order is returned, the one kept by filterDuplicates().
+  Long64_t find(Long64_t majorValue, Long64_t minorValue = 0) const;
+
+  // entry with given minor value for the lowest major value having it
+  // (e.g. eventId in any run), -1 if not found
+  Long64_t findMinor(Long64_t minorValue) const;
+
+  // entry numbers in ascending {major, minor} order
+  const std::vector<Long64_t> &entries() const { return myEntries; }
+  Long64_t getMajor(Long64_t position) const { return myMajors[position]; }
+  Long64_t getMinor(Long64_t position) const { return myMinors[position]; }
+
+private:
+  // position of the last key equal to {majorValue, minorValue}, -1 if none
+  Long64_t findPosition(Long64_t majorValue, Long64_t minorValue) const;
+
+  bool fromTreeIndex(TTree *tree, const std::string &majorName,
+                     const std::string &minorName);
+  void toTreeIndex(TTree *tree, const std::string &majorName,
+                   const std::string &minorName) const;
+  bool readCache(const std::string &fileName, uint64_t checksum,
+                 Long64_t nEntries);
+  void writeCache(const std::string &fileName, uint64_t checksum) const;
+
+  // {major, minor} keys in ascending order, as in the TTreeIndex
+  // of ROOT 6: GetIndexValues() and GetIndexValuesMinor()
+  std::vector<Long64_t> myMajors;
+  std::vector<Long64_t> myMinors;
+  std::vector<Long64_t> myEntries; // entry numbers
+};
+
+} // namespace utilities
+} // namespace tpcreco
+#endif // TPCRECO_UTILITIES_EVENT_INDEX_H_
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <tuple>
 
 #include <TH1D.h>
@@ -45,14 +46,21 @@ class IonRangeCalculator{
 
   std::tuple<gas_mixture_type, double, double> getGasConditions(); // get current set of: GAS index, pressure [mbar], temperature [K]
 
-  double getIonRangeMM(pid_type ion, double E_MeV); // interpolated result in [mm] for the current {gas, p, T}
+  double getIonRangeMM(pid_type ion, double E_MeV) const; // interpolated result in [mm] for the current {gas, p, T}
 
-  double getIonEnergyMeV(pid_type ion, double range_mm); // interpolated result in [MeV] for the current {gas, p, T}
+  double getIonEnergyMeV(pid_type ion, double range_mm) const; // interpolated result in [MeV] for the current {gas, p, T}
 
   double getIonMassMeV(pid_type ion); // particle or isotope mass in [MeV/c^2]
 
   TGraph getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, int Npoints=1000); // dE/dx curve in [MeV/mm] for the current {gas, p, T}
 
+  // dE/dx curve in [MeV/mm] for the current {gas, p, T} sampled at Npoints equidistant positions x_i=range*i/(Npoints-1),
+  // where range=getIonRangeMM(ion, E_MeV); the output vector is resized as needed, so it can be reused between calls
+  void getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, std::vector<double> &dEdx_MeVPerMM, int Npoints=1000) const;
+
+  // linear interpolation of a curve sampled at equidistant positions in [0, xmax] (e.g. the Bragg curve from above)
+  static double evalEquidistantCurve(const std::vector<double> &y, double xmax, double x);
+
   double getIonBraggCurveIntegralMeV(pid_type ion, double E_MeV, int Npoints=1000); // integral of dE/dx curve for the current {gas, p, T}
 
   double getEffectiveLengthCorrectionScale(pid_type ion);
@@ -63,6 +71,21 @@ class IonRangeCalculator{
 
   inline void setDebug(bool flag) { _debug=flag; }
 
+  // Piecewise-linear curve y(x) with x sorted in ascending order.
+  // Eval() gives the same result as TGraph::Eval() with linear interpolation,
+  // but it locates the segment in constant time using a uniform grid of bins.
+  class LookupTable {
+  public:
+    LookupTable(const TGraph &aGraph, int binsPerPoint=4);
+    double Eval(double x) const;
+    double GetXmax() const { return myX.back(); }
+    double GetYlast() const { return myY.back(); }
+  private:
+    std::vector<double> myX, myY;
+    std::vector<int> myFirstPoint; // index of the last point with x<=lower edge of each bin
+    double myBinScale{0}; // 1/bin width
+  };
+
  private:
 
   std::map<std::tuple<gas_mixture_type,pid_type>, TGraph*> refGasRangeCurveMap;       // reference Range(E_kin) curve at given {gas, ion}
@@ -79,6 +102,24 @@ class IonRangeCalculator{
   double myGasTemperature{0}; // Kelvins
   double myGasPressure{0};    // mbar
 
+  // lookup tables built from the reference curves at given {gas, ion}, shared by copies of this object
+  std::map<std::tuple<gas_mixture_type,pid_type>, std::shared_ptr<const LookupTable> > refRangeTableMap;  //!
+  std::map<std::tuple<gas_mixture_type,pid_type>, std::shared_ptr<const LookupTable> > refEnergyTableMap; //!
+  std::map<std::tuple<gas_mixture_type,pid_type>, std::shared_ptr<const LookupTable> > refBraggTableMap;  //!
+
+  // lookup tables and conversion factors for the current {gas, p, T} indexed by pid_type,
+  // rebuilt only when gas conditions or effective length corrections change
+  struct IonTables {
+    std::shared_ptr<const LookupTable> range, energy, bragg;
+    double rangeTemperatureRatio{1}, rangePressureRatio{1}; // T/T_ref and p_ref/p for Range(E_kin) curve
+    double refTemperatureRatio{1}, refPressureRatio{1};     // T_ref/T and p/p_ref for Range(E_kin) curve
+    double braggScale{1}; // range(reference {p_ref, T_ref}) / range(current {p, T}) for dE/dx(x) curve
+    double lengthScale{1}, lengthOffset_mm{0}; // effective length correction
+  };
+  std::vector<IonTables> myIonTables; //!
+  void updateIonTables();
+  const IonTables &getIonTables(pid_type ion) const;
+
   void addIonRangeCurve(pid_type ion, gas_mixture_type gas, double p_mbar, double T_Kelvin, const std::string &datafile); // range(E_kin) corresponding to {gas, p, T}
   void addIonBraggCurve(pid_type ion, gas_mixture_type gas, double p_mbar, double T_Kelvin, const std::string &datafile); // dE/dx(x) corresponding to {gas, p, T}
   TGraph invertTGraph(const TGraph &aGraph) const;
@@ -0,0 +1,130 @@
+#ifndef TPCRECO_UTILITIES_MERGE_JOIN_H_
+#define TPCRECO_UTILITIES_MERGE_JOIN_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <TTree.h>
+
+#include "TPCReco/EventIndex.h"
+
+namespace tpcreco {
+namespace utilities {
+
+// Row of a join of several trees on {major, minor} keys, usually
+// {runId, eventId}. entries[i] is the entry of the i-th tree with this key,
+// -1 if the key is missing there.
+struct JoinRow {
+  Long64_t major;
+  Long64_t minor;
+  std::vector<Long64_t> entries;
+};
+
+// Sort-merge of the sorted indices of several trees, rows in ascending key
+// order. Only the index arrays are used, no tree entry is read.
+// Duplicated keys are paired in the index order.
+std::vector<JoinRow> makeJoinPlan(const std::vector<EventIndex> &indices);
+
+// Sets up TTreeCache of all branches, so that entries read in ascending
+// order are prefetched in large blocks.
+void enablePrefetch(TTree *tree, Long64_t cacheSize = 64 * 1024 * 1024);
+
+// Order of the rows in which the trees are read sequentially: by the entry
+// of the first tree, rows missing there by the entry of the next trees.
+bool storageOrderLess(const JoinRow &a, const JoinRow &b);
+
+// Sorts the rows of a join plan in storage order, see storageOrderLess().
+void sortByStorageOrder(std::vector<JoinRow> &plan);
+
+// Visits rows [first, last) of a join plan reading every tree only in
+// ascending entry order. The rows are visited in storage order, see
+// storageOrderLess(), in one or more passes. During a pass each tree is read
+// once from the beginning: entries of the first tree are read as the rows
+// are visited, entries of the other trees needed by later rows are read on
+// the way to the current one and cached, up to maxCached entries per tree.
+// Rows whose entries were passed, but not cached, are visited in the next
+// pass. snapshot(iTree) copies out the data loaded by the last GetEntry() of
+// the iTree-th tree. visit(row, data) gets pointers to these copies, nullptr
+// for trees missing the key of the row.
+template <class Iterator, class Snapshot, class Visit>
+void streamJoin(const std::vector<TTree *> &trees, Iterator first,
+                Iterator last, Snapshot &&snapshot, Visit &&visit,
+                std::size_t maxCached = 10000) {
+  using Data = typename std::decay<decltype(snapshot(0U))>::type;
+  std::vector<const JoinRow *> pending, deferred;
+  for (auto it = first; it != last; ++it) {
+    pending.push_back(&*it);
+  }
+  std::stable_sort(pending.begin(), pending.end(),
+                   [](const JoinRow *a, const JoinRow *b) {
+                     return storageOrderLess(*a, *b);
+                   });
+  std::vector<std::map<Long64_t, Data>> cache(trees.size());
+  std::vector<std::set<Long64_t>> needed(trees.size());
+  std::vector<Long64_t> cursor(trees.size());
+  std::vector<Data *> pointers(trees.size());
+  while (!pending.empty()) {
+    for (unsigned int iTree = 0; iTree < trees.size(); ++iTree) {
+      cache[iTree].clear();
+      needed[iTree].clear();
+      cursor[iTree] = -1;
+      for (const auto *aRow : pending) {
+        if (aRow->entries[iTree] >= 0) {
+          needed[iTree].insert(aRow->entries[iTree]);
+        }
+      }
+    }
+    deferred.clear();
+    for (const auto *aRow : pending) {
+      bool isReadable = true;
+      for (unsigned int iTree = 0; iTree < trees.size(); ++iTree) {
+        auto entry = aRow->entries[iTree];
+        isReadable &= entry < 0 || entry > cursor[iTree] ||
+                      cache[iTree].count(entry);
+      }
+      if (!isReadable) {
+        for (unsigned int iTree = 0; iTree < trees.size(); ++iTree) {
+          cache[iTree].erase(aRow->entries[iTree]);
+          needed[iTree].erase(aRow->entries[iTree]);
+        }
+        deferred.push_back(aRow);
+        continue;
+      }
+      for (unsigned int iTree = 0; iTree < trees.size(); ++iTree) {
+        auto entry = aRow->entries[iTree];
+        if (entry <= cursor[iTree]) {
+          continue;
+        }
+        for (auto it = needed[iTree].upper_bound(cursor[iTree]);
+             it != needed[iTree].end() && *it < entry &&
+             cache[iTree].size() < maxCached;
+             ++it) {
+          trees[iTree]->GetEntry(*it);
+          cache[iTree].emplace(*it, snapshot(iTree));
+        }
+        trees[iTree]->GetEntry(entry);
+        cache[iTree].emplace(entry, snapshot(iTree));
+        cursor[iTree] = entry;
+      }
+      for (unsigned int iTree = 0; iTree < trees.size(); ++iTree) {
+        auto entry = aRow->entries[iTree];
+        pointers[iTree] = entry < 0 ? nullptr : &cache[iTree].at(entry);
+      }
+      visit(*aRow, pointers);
+      for (unsigned int iTree = 0; iTree < trees.size(); ++iTree) {
+        cache[iTree].erase(aRow->entries[iTree]);
+      }
+    }
+    pending.swap(deferred);
+  }
+}
+
+} // namespace utilities
+} // namespace tpcreco
+#endif // TPCRECO_UTILITIES_MERGE_JOIN_H_
@@ -0,0 +1,150 @@
+#ifndef TPCRECO_UTILITIES_PERF_MONITOR_H_
+#define TPCRECO_UTILITIES_PERF_MONITOR_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace tpcreco {
+namespace utilities {
+
+// Process-wide registry of named processing stages and counters.
+// Stages and counters are created once (first use) and live until the end
+// of the process, so references to them can be cached in static variables.
+// All updates are lock-free, the registry mutex is taken only when a new
+// stage/counter is created or when the summary is printed.
+class PerfMonitor {
+public:
+  // log2 duration histogram: bin i holds calls with 2^i <= t[ns] < 2^(i+1)
+  static constexpr int nHistoBins = 40;
+
+  class Stage {
+  public:
+    explicit Stage(const std::string &name) : name(name) {}
+    Stage(const Stage &) = delete;
+    Stage &operator=(const Stage &) = delete;
+
+    void add(uint64_t ns) noexcept;
+
+    const std::string name;
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> minNs{UINT64_MAX};
+    std::atomic<uint64_t> maxNs{0};
+    std::array<std::atomic<uint64_t>, nHistoBins> histo{};
+  };
+
+  class Counter {
+  public:
+    explicit Counter(const std::string &name) : name(name) {}
+    Counter(const Counter &) = delete;
+    Counter &operator=(const Counter &) = delete;
+
+    void add(uint64_t n = 1) noexcept {
+      value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    const std::string name;
+    std::atomic<uint64_t> value{0};
+  };
+
+  static PerfMonitor &instance();
+
+  Stage &getStage(const std::string &name);
+  Counter &getCounter(const std::string &name);
+
+  inline bool isEnabled() const noexcept {
+    return enabled.load(std::memory_order_relaxed);
+  }
+  void setEnabled(bool flag) noexcept {
+    enabled.store(flag, std::memory_order_relaxed);
+  }
+
+  // zero all stages and counters, registered names are kept
+  void reset();
+
+  // reads "profiling.enable" node, missing node leaves the current setting
+  void configure(const boost::property_tree::ptree &config);
+
+  // per-stage table followed by duration histograms
+  void print(std::ostream &os = std::cout) const;
+
+  void writeJSON(const std::string &fileName) const;
+  void writeJSON(std::ostream &os) const;
+
+  // end-of-job helper: print summary and write JSON file
+  // if "profiling.jsonFile" node is not empty
+  void report(const boost::property_tree::ptree &config,
+              std::ostream &os = std::cout) const;
+
+private:
+  PerfMonitor() = default;
+  PerfMonitor(const PerfMonitor &) = delete;
+  PerfMonitor &operator=(const PerfMonitor &) = delete;
+
+  mutable std::mutex mutex;
+  std::deque<Stage> stages;     // deque keeps element addresses stable
+  std::deque<Counter> counters; // deque keeps element addresses stable
+  std::atomic<bool> enabled{true};
+};
+
+// RAII timer adding wall time of the enclosing scope to a stage.
+// Does nothing (apart from one relaxed load) when monitoring is disabled.
+class ScopedTimer {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit ScopedTimer(PerfMonitor::Stage &aStage) noexcept
+      : stage(PerfMonitor::instance().isEnabled() ? &aStage : nullptr) {
+    if (stage) {
+      start = clock::now();
+    }
+  }
+
+  ~ScopedTimer() {
+    if (stage) {
+      stage->add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     clock::now() - start)
+                     .count());
+    }
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  PerfMonitor::Stage *stage;
+  clock::time_point start;
+};
+
+} // namespace utilities
+} // namespace tpcreco
+
+#define TPCRECO_PERF_CONCAT_IMPL(a, b) a##b
+#define TPCRECO_PERF_CONCAT(a, b) TPCRECO_PERF_CONCAT_IMPL(a, b)
+
+// Times the enclosing scope. The stage lookup is done once per call site.
+#define TPCRECO_TIME_SCOPE(stageName)                                          \
+  static auto &TPCRECO_PERF_CONCAT(perfStage_, __LINE__) =                     \
+      tpcreco::utilities::PerfMonitor::instance().getStage(stageName);         \
+  tpcreco::utilities::ScopedTimer TPCRECO_PERF_CONCAT(perfTimer_, __LINE__)(   \
+      TPCRECO_PERF_CONCAT(perfStage_, __LINE__))
+
+// Increments a named counter. The counter lookup is done once per call site.
+#define TPCRECO_COUNT(counterName, n)                                          \
+  do {                                                                         \
+    static auto &perfCounter_ =                                                \
+        tpcreco::utilities::PerfMonitor::instance().getCounter(counterName);   \
+    if (tpcreco::utilities::PerfMonitor::instance().isEnabled()) {             \
+      perfCounter_.add(n);                                                     \
+    }                                                                          \
+  } while (0)
+
+#endif // TPCRECO_UTILITIES_PERF_MONITOR_H_
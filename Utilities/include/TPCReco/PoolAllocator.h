@@ -0,0 +1,114 @@
+#ifndef TPCRECO_UTILITIES_POOL_ALLOCATOR_H_
+#define TPCRECO_UTILITIES_POOL_ALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace tpcreco {
+namespace utilities {
+
+// Arena of fixed-size memory blocks with a free list per thread.
+// Blocks are carved out of chunks of chunkBytes allocated on demand.
+// Released blocks go to the free list of the releasing thread and are
+// reused before any new chunk is requested, so a container that is
+// cleared and refilled with a similar number of elements does not call
+// malloc in the steady state, and threads do not contend for a lock.
+// Chunks are kept until the end of the program.
+template <std::size_t Size, std::size_t Align> class NodeArena {
+public:
+  static void *allocate() {
+    auto &freeList = head();
+    if (!freeList) {
+      grow(freeList);
+    }
+    auto *block = freeList;
+    freeList = block->next;
+    return block;
+  }
+
+  static void deallocate(void *pointer) noexcept {
+    auto *block = static_cast<FreeBlock *>(pointer);
+    auto &freeList = head();
+    block->next = freeList;
+    freeList = block;
+  }
+
+  // number of chunks requested by the calling thread
+  static std::size_t chunks() { return chunkCount(); }
+
+  static constexpr std::size_t chunkBytes = 64 * 1024;
+
+private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  static constexpr std::size_t align = std::max(Align, alignof(FreeBlock));
+  static constexpr std::size_t blockSize =
+      (std::max(Size, sizeof(FreeBlock)) + align - 1) / align * align;
+  static constexpr std::size_t blocksPerChunk =
+      std::max<std::size_t>(chunkBytes / blockSize, 1);
+
+  static FreeBlock *&head() {
+    static thread_local FreeBlock *freeList = nullptr;
+    return freeList;
+  }
+
+  static std::size_t &chunkCount() {
+    static thread_local std::size_t count = 0;
+    return count;
+  }
+
+  static void grow(FreeBlock *&freeList) {
+    auto *chunk =
+        static_cast<char *>(::operator new(blocksPerChunk * blockSize));
+    ++chunkCount();
+    for (std::size_t iBlock = blocksPerChunk; iBlock-- > 0;) {
+      auto *block = reinterpret_cast<FreeBlock *>(chunk + iBlock * blockSize);
+      block->next = freeList;
+      freeList = block;
+    }
+  }
+};
+
+// Allocator of node based containers (std::map, std::set, std::list)
+// backed by NodeArena. Allocations of more than one element, which node
+// based containers do not make, are passed to the global operator new.
+template <class T> class PoolAllocator {
+public:
+  using value_type = T;
+  using arena_type = NodeArena<sizeof(T), alignof(T)>;
+
+  PoolAllocator() noexcept = default;
+  template <class U> PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (n == 1) {
+      return static_cast<T *>(arena_type::allocate());
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *pointer, std::size_t n) noexcept {
+    if (n == 1) {
+      arena_type::deallocate(pointer);
+    } else {
+      ::operator delete(pointer);
+    }
+  }
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &) {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &) {
+  return false;
+}
+
+} // namespace utilities
+} // namespace tpcreco
+#endif // TPCRECO_UTILITIES_POOL_ALLOCATOR_H_
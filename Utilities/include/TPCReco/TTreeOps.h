@@ -73,6 +73,27 @@ TTree *cloneUnique(TTree *tree, TFile *file, bool verbose = false) {
   return clonedTree;
 }
 
+// positions [first, last) refer to entries sorted by the TTreeIndex
+auto filterDuplicates(TTree *tree, Long64_t first, Long64_t last,
+                      bool verbose = false) {
+  return filterDuplicates(getTreeIndexRange(tree) |
+                              boost::adaptors::sliced(first, last),
+                          verbose);
+}
+
+TTree *cloneUnique(TTree *tree, TFile *file, Long64_t first, Long64_t last,
+                   bool verbose = false) {
+  if (file) {
+    file->cd();
+  }
+  auto clonedTree = tree->CloneTree(0);
+  for (auto entry : filterDuplicates(tree, first, last, verbose)) {
+    tree->GetEntry(entry);
+    clonedTree->Fill();
+  }
+  return clonedTree;
+}
+
 template <int n, class T> struct Dispatched {
   static_assert(n == 0 || n == 1, "");
   T data;
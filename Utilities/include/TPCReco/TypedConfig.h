@@ -0,0 +1,91 @@
+#ifndef TPCRECO_UTILITIES_TYPED_CONFIG_H_
+#define TPCRECO_UTILITIES_TYPED_CONFIG_H_
+
+#include <cstddef>
+#include <set>
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace tpcreco {
+namespace config {
+
+// Typed and validated copies of the configuration groups used inside event
+// loops. They are made once from the configuration tree, so that no string
+// keyed ptree lookup is done per event. fromConfig() takes the full tree
+// with the group node at the top level, e.g. "hitFilter.recoClusterThreshold".
+// Missing values get the defaults of Utilities/config/allowedOptions.json,
+// values out of their valid range throw std::invalid_argument.
+
+// "hitFilter" group
+struct HitFilterConfig {
+  bool enable{false};            // recoClusterEnable
+  double threshold{35.0};        // recoClusterThreshold [ADC units]
+  double fractionThreshold{0.1}; // recoClusterConstantFractionThreshold
+  int deltaStrips{2};            // recoClusterDeltaStrips
+  int deltaTimeCells{5};         // recoClusterDeltaTimeCells
+
+  static HitFilterConfig fromConfig(const boost::property_tree::ptree &aConfig);
+
+  bool operator==(const HitFilterConfig &other) const;
+  bool operator!=(const HitFilterConfig &other) const {
+    return !(*this == other);
+  }
+};
+
+// "pedestal" group
+struct PedestalConfig {
+  bool remove{true};
+  int minPedestalCell{5};
+  int maxPedestalCell{25};
+  int minSignalCell{5};
+  int maxSignalCell{506};
+  std::string database;     // pedestalDatabase, empty = pedestals calculated per event
+  boost::optional<long> runId; // pedestalRunId, unset = last pedestal run before the data run
+  // zero suppression of GRAW samples: cells above max(nSigma * pedestal RMS, threshold)
+  // are kept together with guardCells cells on each side
+  bool zeroSuppression{false};       // zeroSuppressionEnable
+  double zeroSuppressionNSigma{4.0};
+  double zeroSuppressionThreshold{0.0};
+  int zeroSuppressionGuardCells{3};
+
+  static PedestalConfig fromConfig(const boost::property_tree::ptree &aConfig);
+};
+
+// "conditions" group
+struct ConditionsConfig {
+  double pressure{190.0};     // [mbar]
+  double temperature{293.15}; // [K]
+  double samplingRate{25.0};  // [MHz]
+  double driftV{0.646};       // [cm/us]
+
+  static ConditionsConfig
+  fromConfig(const boost::property_tree::ptree &aConfig);
+};
+
+// "eventFilter" group, unset bounds are not applied
+struct EventFilterConfig {
+  bool enabled{false};
+  boost::optional<double> maxChargeUpperBound;
+  boost::optional<double> maxChargeLowerBound;
+  boost::optional<double> totalChargeLowerBound;
+  boost::optional<double> totalChargeUpperBound;
+  std::set<std::size_t> events; // accepted event IDs, empty = all events
+
+  static EventFilterConfig
+  fromConfig(const boost::property_tree::ptree &aConfig);
+};
+
+struct TypedConfig {
+  HitFilterConfig hitFilter;
+  PedestalConfig pedestal;
+  ConditionsConfig conditions;
+  EventFilterConfig eventFilter;
+
+  static TypedConfig fromConfig(const boost::property_tree::ptree &aConfig);
+};
+
+} // namespace config
+} // namespace tpcreco
+#endif // TPCRECO_UTILITIES_TYPED_CONFIG_H_
@@ -761,12 +761,20 @@ const boost::property_tree::ptree & ConfigManager::getConfig(int argc, char **ar
 
     // finally apply changes from command line options
     updateWithCmdLineArgs(varMap);
+    typedConfig.reset();
 
     std::cout<<std::endl<<KBLU<<"List of final configuration tree to be used:"<<RST<<std::endl;
     ConfigManager::printTree(configTree);
 
     return configTree;
 }
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const tpcreco::config::TypedConfig & ConfigManager::getTypedConfig(){
+
+    if(!typedConfig) typedConfig = tpcreco::config::TypedConfig::fromConfig(configTree);
+    return *typedConfig;
+}
 // /////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // /////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // //
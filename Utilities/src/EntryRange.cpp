@@ -0,0 +1,101 @@
+#include "TPCReco/EntryRange.h"
+
+#include <algorithm>
+#include <ostream>
+#include <regex>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+namespace tpcreco {
+namespace utilities {
+
+EntryRange::EntryRange(Long64_t nEntries, Long64_t firstEntry,
+                       Long64_t maxEntries, const std::string &shard) {
+  if (firstEntry < 0) {
+    throw std::invalid_argument("Negative first entry: " +
+                                std::to_string(firstEntry));
+  }
+  mySelectedFirst = std::min(firstEntry, nEntries);
+  mySelectedLast = maxEntries < 0
+                       ? nEntries
+                       : std::min(nEntries, mySelectedFirst + maxEntries);
+
+  if (!shard.empty()) {
+    std::smatch match;
+    if (!std::regex_match(shard, match,
+                          std::regex(R"(^\s*(\d+)\s*/\s*(\d+)\s*$)"))) {
+      throw std::invalid_argument("Wrong shard specification: \"" + shard +
+                                  "\", expected i/N");
+    }
+    myShardIndex = std::stoul(match[1]);
+    myNShards = std::stoul(match[2]);
+    if (myNShards == 0 || myShardIndex >= myNShards) {
+      throw std::invalid_argument("Wrong shard specification: \"" + shard +
+                                  "\", expected 0 <= i < N");
+    }
+  }
+  auto size = mySelectedLast - mySelectedFirst;
+  myFirst = mySelectedFirst + size * myShardIndex / myNShards;
+  myLast = mySelectedFirst + size * (myShardIndex + 1) / myNShards;
+}
+
+EntryRange
+EntryRange::fromConfig(Long64_t nEntries,
+                       const boost::property_tree::ptree &aConfig) {
+  return EntryRange(nEntries, aConfig.get<Long64_t>("input.firstEntry", 0),
+                    aConfig.get<Long64_t>("input.readNEvents", -1),
+                    aConfig.get<std::string>("input.shard", ""));
+}
+
+EntryRange EntryRange::alignedTo(
+    const std::function<bool(Long64_t, Long64_t)> &sameGroup) const {
+  auto align = [&](Long64_t boundary) {
+    if (boundary <= mySelectedFirst) {
+      return boundary;
+    }
+    while (boundary < mySelectedLast && sameGroup(boundary - 1, boundary)) {
+      ++boundary;
+    }
+    return boundary;
+  };
+  EntryRange aligned = *this;
+  aligned.myFirst = align(myFirst);
+  aligned.myLast = align(myLast);
+  return aligned;
+}
+
+std::string EntryRange::decorate(const std::string &fileName) const {
+  if (!isSharded()) {
+    return fileName;
+  }
+  auto path = boost::filesystem::path(fileName);
+  auto decorated = path.stem().string() + "_shard" +
+                   std::to_string(myShardIndex) + "of" +
+                   std::to_string(myNShards) + path.extension().string();
+  return (path.parent_path() / decorated).string();
+}
+
+bool EntryRange::parseDecorated(const std::string &fileName,
+                                unsigned int &shardIndex,
+                                unsigned int &nShards) {
+  std::smatch match;
+  auto stem = boost::filesystem::path(fileName).stem().string();
+  if (!std::regex_search(stem, match, std::regex(R"(_shard(\d+)of(\d+)$)"))) {
+    return false;
+  }
+  shardIndex = std::stoul(match[1]);
+  nShards = std::stoul(match[2]);
+  return true;
+}
+
+std::ostream &operator<<(std::ostream &out, const EntryRange &aRange) {
+  out << "entries [" << aRange.first() << ", " << aRange.last() << ")";
+  if (aRange.isSharded()) {
+    out << ", shard " << aRange.shardIndex() << "/" << aRange.nShards();
+  }
+  return out;
+}
+
+} // namespace utilities
+} // namespace tpcreco
@@ -0,0 +1,258 @@
+#include "TPCReco/EventIndex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <sys/stat.h> // for: fchmod
+#include <unistd.h> // for: close
+#include <boost/filesystem.hpp>
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TTreeIndex.h>
+
+#include "TPCReco/colorText.h"
+
+namespace tpcreco {
+namespace utilities {
+
+namespace {
+
+const uint32_t eventIndexMagic = 0x58444945; // "EIDX"
+const uint32_t eventIndexVersion = 2;
+
+struct CacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t checksum;
+  int64_t nEntries;
+};
+
+// caching is disabled unless enabled by TPCRECO_CACHE_DIR or SetCacheDir()
+std::string &cacheDir() {
+  static std::string dir(std::getenv("TPCRECO_CACHE_DIR") ? std::getenv("TPCRECO_CACHE_DIR") : "");
+  return dir;
+}
+
+uint64_t getChecksum(const std::string &text) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Cache key of a tree stored in a file opened read-only, empty if the index
+// should not be cached. The file UUID, size and modification date change
+// whenever the file content does.
+std::string getCacheKey(TTree *tree, const std::string &majorName,
+                        const std::string &minorName) {
+  auto *file = tree->GetCurrentFile();
+  if (cacheDir().empty() || !file || file->IsWritable()) {
+    return "";
+  }
+  std::ostringstream key;
+  key << file->GetUUID().AsString() << '\n'
+      << file->GetSize() << '\n'
+      << file->GetModificationDate().AsSQLString() << '\n'
+      << tree->GetName() << '\n'
+      << tree->GetEntries() << '\n'
+      << majorName << '\n'
+      << minorName;
+  return key.str();
+}
+
+std::string getCacheFileName(uint64_t checksum) {
+  std::ostringstream name;
+  name << cacheDir() << "/eventIndex_" << std::hex << checksum << ".bin";
+  return name.str();
+}
+
+// TTreeIndex filled with already sorted values
+class SortedTreeIndex : public TTreeIndex {
+public:
+  SortedTreeIndex(TTree *tree, const std::string &majorName,
+                  const std::string &minorName,
+                  const std::vector<Long64_t> &majors,
+                  const std::vector<Long64_t> &minors,
+                  const std::vector<Long64_t> &entries) {
+    fTree = tree;
+    fMajorName = majorName.c_str();
+    fMinorName = minorName.c_str();
+    fN = entries.size();
+    fIndexValues = new Long64_t[fN];
+    fIndexValuesMinor = new Long64_t[fN];
+    fIndex = new Long64_t[fN];
+    std::copy(majors.begin(), majors.end(), fIndexValues);
+    std::copy(minors.begin(), minors.end(), fIndexValuesMinor);
+    std::copy(entries.begin(), entries.end(), fIndex);
+  }
+};
+
+} // namespace
+
+void EventIndex::SetCacheDir(const std::string &dir) { cacheDir() = dir; }
+
+EventIndex EventIndex::attach(TTree *tree, const std::string &majorName,
+                              const std::string &minorName) {
+  EventIndex aIndex;
+  if (!tree || aIndex.fromTreeIndex(tree, majorName, minorName)) {
+    return aIndex;
+  }
+  auto key = getCacheKey(tree, majorName, minorName);
+  auto checksum = getChecksum(key);
+  if (!key.empty() &&
+      aIndex.readCache(getCacheFileName(checksum), checksum,
+                       tree->GetEntries())) {
+    aIndex.toTreeIndex(tree, majorName, minorName);
+    return aIndex;
+  }
+  if (tree->BuildIndex(majorName.c_str(), minorName.c_str()) !=
+          tree->GetEntries() ||
+      !aIndex.fromTreeIndex(tree, majorName, minorName)) {
+    std::cerr << KRED << "EventIndex::attach: " << RST
+              << "can't build index: \"" << majorName << "\",\"" << minorName
+              << "\" on tree " << tree->GetName() << std::endl;
+    return EventIndex();
+  }
+  if (!key.empty()) {
+    aIndex.writeCache(getCacheFileName(checksum), checksum);
+  }
+  return aIndex;
+}
+
+Long64_t EventIndex::findPosition(Long64_t majorValue,
+                                  Long64_t minorValue) const {
+  // first position with a key greater than {majorValue, minorValue}
+  auto key = std::make_pair(majorValue, minorValue);
+  Long64_t first = 0, count = myMajors.size();
+  while (count > 0) {
+    auto step = count / 2;
+    auto position = first + step;
+    if (!(key < std::make_pair(myMajors[position], myMinors[position]))) {
+      first = position + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  if (first > 0 && myMajors[first - 1] == majorValue &&
+      myMinors[first - 1] == minorValue) {
+    return first - 1;
+  }
+  return -1;
+}
+
+Long64_t EventIndex::find(Long64_t majorValue, Long64_t minorValue) const {
+  auto position = findPosition(majorValue, minorValue);
+  return position < 0 ? -1 : myEntries[position];
+}
+
+Long64_t EventIndex::findMinor(Long64_t minorValue) const {
+  // one binary search per distinct major value
+  auto it = myMajors.begin();
+  while (it != myMajors.end()) {
+    auto majorValue = *it;
+    auto position = findPosition(majorValue, minorValue);
+    if (position >= 0) {
+      return myEntries[position];
+    }
+    it = std::upper_bound(it, myMajors.end(), majorValue);
+  }
+  return -1;
+}
+
+bool EventIndex::fromTreeIndex(TTree *tree, const std::string &majorName,
+                               const std::string &minorName) {
+  auto *treeIndex = dynamic_cast<TTreeIndex *>(tree->GetTreeIndex());
+  if (!treeIndex || majorName != treeIndex->GetMajorName() ||
+      minorName != treeIndex->GetMinorName() ||
+      treeIndex->GetN() != tree->GetEntries()) {
+    return false;
+  }
+  auto n = treeIndex->GetN();
+  myMajors.assign(treeIndex->GetIndexValues(),
+                  treeIndex->GetIndexValues() + n);
+  myMinors.assign(treeIndex->GetIndexValuesMinor(),
+                  treeIndex->GetIndexValuesMinor() + n);
+  myEntries.assign(treeIndex->GetIndex(), treeIndex->GetIndex() + n);
+  return true;
+}
+
+void EventIndex::toTreeIndex(TTree *tree, const std::string &majorName,
+                             const std::string &minorName) const {
+  auto *oldIndex = tree->GetTreeIndex();
+  tree->SetTreeIndex(new SortedTreeIndex(tree, majorName, minorName, myMajors,
+                                         myMinors, myEntries));
+  delete oldIndex;
+}
+
+bool EventIndex::readCache(const std::string &fileName, uint64_t checksum,
+                           Long64_t nEntries) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) return false;
+  CacheHeader header;
+  file.read((char *)&header, sizeof(header));
+  if (!file || header.magic != eventIndexMagic ||
+      header.version != eventIndexVersion || header.checksum != checksum ||
+      header.nEntries != nEntries) {
+    return false;
+  }
+  std::vector<Long64_t> majors(nEntries), minors(nEntries), entries(nEntries);
+  file.read((char *)majors.data(), nEntries * sizeof(Long64_t));
+  file.read((char *)minors.data(), nEntries * sizeof(Long64_t));
+  file.read((char *)entries.data(), nEntries * sizeof(Long64_t));
+  if (!file) return false;
+  myMajors.swap(majors);
+  myMinors.swap(minors);
+  myEntries.swap(entries);
+  return true;
+}
+
+void EventIndex::writeCache(const std::string &fileName,
+                            uint64_t checksum) const {
+  CacheHeader header;
+  header.magic = eventIndexMagic;
+  header.version = eventIndexVersion;
+  header.checksum = checksum;
+  header.nEntries = myEntries.size();
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(
+      boost::filesystem::path(fileName).parent_path(), ec);
+
+  // write to a temporary file first, concurrent jobs may read the same file.
+  // The temporary name is unique for every writer, also for threads of the same job.
+  std::string tmpName = fileName + ".XXXXXX";
+  int fd = ::mkstemp(&tmpName[0]);
+  if (fd < 0) return;
+  ::fchmod(fd, 0644); // readable as a file written by ofstream
+  ::close(fd);
+  {
+    std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      std::remove(tmpName.c_str());
+      return;
+    }
+    file.write((const char *)&header, sizeof(header));
+    file.write((const char *)myMajors.data(), myMajors.size() * sizeof(Long64_t));
+    file.write((const char *)myMinors.data(), myMinors.size() * sizeof(Long64_t));
+    file.write((const char *)myEntries.data(), myEntries.size() * sizeof(Long64_t));
+    if (!file) {
+      file.close();
+      std::remove(tmpName.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpName.c_str());
+  }
+}
+
+} // namespace utilities
+} // namespace tpcreco
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <tuple>
 #include "TPCReco/IonRangeCalculator.h"
@@ -64,10 +65,10 @@ void IonRangeCalculator::setGasMixture(gas_mixture_type gas){ // GAS index
     exit(-1);
   }
 
+  myGasMixture=gas;
+
   // Reset effective length corrections
   resetEffectiveLengthCorrections();
-
-  myGasMixture=gas;
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
@@ -144,11 +145,11 @@ double IonRangeCalculator::getGasRangeReferenceTemperature(pid_type ion) { // ge
 
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
-double IonRangeCalculator::getIonRangeMM(pid_type ion, double E_MeV){ // interpolated result in [mm] for current {gas, p, T}
+double IonRangeCalculator::getIonRangeMM(pid_type ion, double E_MeV) const{ // interpolated result in [mm] for current {gas, p, T}
 
   // sanity checks
-  auto it=refGasRangeCurveMap.find(std::make_tuple(myGasMixture, ion));
-  if(it==refGasRangeCurveMap.end()) {
+  const auto &tables=getIonTables(ion);
+  if(!tables.range) {
     std::cerr<<__FUNCTION__<<": ERROR: Reference range/energy curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
     exit(-1);
   }
@@ -158,34 +159,30 @@ double IonRangeCalculator::getIonRangeMM(pid_type ion, double E_MeV){ // interpo
   }
 
   // rescale output range to current {p, T} values assuming ideal gas pV=nRT formula
-  double ref_range=(it->second)->Eval(E_MeV); // mm
+  double ref_range=tables.range->Eval(E_MeV); // mm
 
   // DEBUG
   if(_debug) {
     std::cout<<__FUNCTION__<<": non-scaled range="<<ref_range<<" mm, "
-	     <<"T_ref="<<refGasRangeTemperatureMap[it->first]<<" K, "
-	     <<"p_ref="<<refGasRangePressureMap[it->first]<<" mbar"<<std::endl;
+	     <<"T/T_ref="<<tables.rangeTemperatureRatio<<", "
+	     <<"p_ref/p="<<tables.rangePressureRatio<<std::endl;
   }
   // DEBUG
 
-  auto range_mm = ref_range*(myGasTemperature/refGasRangeTemperatureMap[it->first])*(refGasRangePressureMap[it->first]/myGasPressure); // result in [mm]
+  auto range_mm = ref_range*tables.rangeTemperatureRatio*tables.rangePressureRatio; // result in [mm]
 
   // apply effective range correction for the current gas conditions (if any)
-  auto range_corr_mm=range_mm;
-  auto it2=effectiveLengthCorrectionMap.find(ion);
-  if(it2!=effectiveLengthCorrectionMap.end()) {
-    range_corr_mm = std::get<0>(it2->second)*range_mm + std::get<1>(it2->second);
-  }
+  auto range_corr_mm = tables.lengthScale*range_mm + tables.lengthOffset_mm;
 
   return range_corr_mm;
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
-double IonRangeCalculator::getIonEnergyMeV(pid_type ion, double range_mm){ // interpolated result in [MeV] for current {gas, p, T}
+double IonRangeCalculator::getIonEnergyMeV(pid_type ion, double range_mm) const{ // interpolated result in [MeV] for current {gas, p, T}
 
   // sanity checks
-  auto it=refEnergyCurveMap.find(std::make_tuple(myGasMixture, ion));
-  if(it==refEnergyCurveMap.end()) {
+  const auto &tables=getIonTables(ion);
+  if(!tables.energy) {
     std::cerr<<__FUNCTION__<<": ERROR: Reference range/energy curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
     exit(-1);
   }
@@ -195,23 +192,20 @@ double IonRangeCalculator::getIonEnergyMeV(pid_type ion, double range_mm){ // in
   }
 
   // apply effective range correction for the current gas conditions (if any)
-  auto range_corr_mm=range_mm;
-  auto it2=effectiveLengthCorrectionMap.find(ion);
-  if(it2!=effectiveLengthCorrectionMap.end()) {
-    range_corr_mm = std::get<0>(it2->second)*range_mm + std::get<1>(it2->second);
-  }
+  auto range_corr_mm = tables.lengthScale*range_mm + tables.lengthOffset_mm;
+
   // rescale input range to reference {p_ref, T_ref} values assuming ideal gas pV=nRT formula
-  double ref_range=range_corr_mm*(refGasRangeTemperatureMap[it->first]/myGasTemperature)*(myGasPressure/refGasRangePressureMap[it->first]); // mm
+  double ref_range=range_corr_mm*tables.refTemperatureRatio*tables.refPressureRatio; // mm
 
   // DEBUG
   if(_debug) {
     std::cout<<__FUNCTION__<<": non-scaled range="<<ref_range<<" mm, "
-	     <<"T_ref="<<refGasRangeTemperatureMap[it->first]<<" K, "
-	     <<"p_ref="<<refGasRangePressureMap[it->first]<<" mbar"<<std::endl;
+	     <<"T/T_ref="<<tables.rangeTemperatureRatio<<", "
+	     <<"p_ref/p="<<tables.rangePressureRatio<<std::endl;
   }
   // DEBUG
 
-  return (it->second)->Eval(ref_range); // result in [MeV]
+  return tables.energy->Eval(ref_range); // result in [MeV]
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
@@ -252,6 +246,8 @@ void IonRangeCalculator::addIonRangeCurve(pid_type ion, gas_mixture_type gas, do
       }
     refGasRangePressureMap[key]=p_mbar; // reference pressure [mbar]
     refGasRangeTemperatureMap[key]=T_Kelvin; // reference tempereature T[K]
+    refRangeTableMap[key]=std::make_shared<const LookupTable>(*refGasRangeCurveMap[key]);
+    refEnergyTableMap[key]=std::make_shared<const LookupTable>(*refEnergyCurveMap[key]);
 
     // DEBUG
     if(_debug) {
@@ -324,18 +320,43 @@ void IonRangeCalculator::zeroSuppressTGraph(TGraph *aGraph){
 ////////////////////////////////////////////////
 TGraph IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, int Npoints){
 
+  std::vector<double> dEdx;
+  getIonBraggCurveMeVPerMM(ion, E_MeV, dEdx, Npoints);
+  auto range_mm=getIonRangeMM(ion, E_MeV); // current {p, T}
+
+  TGraph aGraph(Npoints);
+  for(int ipoint=0; ipoint<Npoints; ipoint++){
+    aGraph.SetPoint(ipoint, range_mm*ipoint/(Npoints-1), dEdx[ipoint]); // current {p, T}
+  }
+
+  // DEBUG
+  if(_debug) {
+    std::cout<<__FUNCTION__<<": Gas index="<<getGasMixture()<<", Ion index="<<ion<<", Npoints="<<aGraph.GetN()<<std::endl;
+    for(auto iPoint=0; iPoint<aGraph.GetN(); iPoint++) {
+      double x, y;
+      aGraph.GetPoint(iPoint, x, y);
+      std::cout<<__FUNCTION__<<": point="<<iPoint<<"  x[mm]="<<x<<"  dE/dx[MeV/mm]="<<y<<std::endl;
+    }
+  }
+  // DEBUG
+
+  return aGraph;
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+void IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV, std::vector<double> &dEdx_MeVPerMM, int Npoints) const{
+
   // sanity checks
   if(Npoints<2) {
     std::cerr<<__FUNCTION__<<": ERROR: Requested Bragg curve with insufficient number of points for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
     exit(-1);
   }
-  auto itB=refBraggCurveMap.find(std::make_tuple(myGasMixture,ion));
-  if(itB==refBraggCurveMap.end()) {
+  const auto &tables=getIonTables(ion);
+  if(!tables.bragg) {
     std::cerr<<__FUNCTION__<<": ERROR: Reference Bragg curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
     exit(-1);
   }
-  auto itR=refGasRangeCurveMap.find(std::make_tuple(myGasMixture,ion));
-  if(itR==refGasRangeCurveMap.end()) {
+  if(!tables.range) {
     std::cerr<<__FUNCTION__<<": ERROR: Reference range curve is missing for: gas index="<<myGasMixture<<", ion="<<ion<<"!"<<std::endl;
     exit(-1);
   }
@@ -344,55 +365,43 @@ TGraph IonRangeCalculator::getIonBraggCurveMeVPerMM(pid_type ion, double E_MeV,
     exit(-1);
   }
 
-  TGraph aGraph(Npoints);
-
   // multiplicative factor for rescaling current range to the reference {p_ref, T_ref} conditions
-  const auto factor=(refBraggTemperatureMap[itB->first]/myGasTemperature)*(myGasPressure/refBraggPressureMap[itB->first]); // Bragg curve reference {p_ref, T_ref}
+  const auto factor=tables.braggScale; // Bragg curve reference {p_ref, T_ref}
   auto range_mm=getIonRangeMM(ion, E_MeV); // current {p, T}
-  double ref_xmax_mm, ref_y;
-  itB->second->GetPoint(itB->second->GetN()-1, ref_xmax_mm, ref_y); // Bragg curve reference {p_ref, T_ref}
-
-  // DEBUG
-  if(_debug) {
-    double xmin, xmax, ymin, ymax;
-    itB->second->ComputeRange(xmin, ymin, xmax, ymax);
-    std::cout<<__FUNCTION__<<": Bragg x-check: Xmax(last-point)[mm]="<<ref_xmax_mm<<", Xmax(ComputeRange)="<<xmax<<std::endl;
-  }
-  // DEBUG
+  auto ref_xmax_mm=tables.bragg->GetXmax(); // Bragg curve reference {p_ref, T_ref}
 
+  // the curve starts at the end of the reference Bragg curve shifted by the current range:
+  // dE/dx(x) = dE/dx_ref(ref_xmax - (range - x)*factor)*factor
+  dEdx_MeVPerMM.resize(Npoints);
   for(int ipoint=0; ipoint<Npoints; ipoint++){
-    auto x_mm = range_mm*ipoint/(Npoints-1); // current {p, T}
+    auto x_mm = range_mm*(Npoints-1-ipoint)/(Npoints-1); // distance to the end of the track for current {p, T}
     auto ref_x_mm = x_mm * factor; // reference Bragg curve {p_ref, T_ref}
-    aGraph.SetPoint(ipoint, x_mm, itB->second->Eval(ref_xmax_mm-ref_x_mm) * factor ); // current {p, T}
-  }
-  aGraph=horizontalFlipTGraph(aGraph);
-  aGraph.Sort();
-
-  // DEBUG
-  if(_debug) {
-    std::cout<<__FUNCTION__<<": Gas index="<<getGasMixture()<<", Ion index="<<ion<<", Npoints="<<aGraph.GetN()<<std::endl;
-    for(auto iPoint=0; iPoint<aGraph.GetN(); iPoint++) {
-      double x, y;
-      aGraph.GetPoint(iPoint, x, y);
-      std::cout<<__FUNCTION__<<": point="<<iPoint<<"  x[mm]="<<x<<"  dE/dx[MeV/mm]="<<y<<std::endl;
-    }
+    dEdx_MeVPerMM[ipoint] = tables.bragg->Eval(ref_xmax_mm-ref_x_mm) * factor; // current {p, T}
   }
-  // DEBUG
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+double IonRangeCalculator::evalEquidistantCurve(const std::vector<double> &y, double xmax, double x){
 
-  return aGraph;
+  // same as TGraph::Eval() for points x_i=xmax*i/(N-1), including linear extrapolation outside [0, xmax]
+  const int N=y.size();
+  if(N<2 || xmax<=0.0) return N ? y[0] : 0.0;
+  const double step=xmax/(N-1);
+  int low=std::min(std::max(int(x/step), 0), N-2);
+  return y[low] + (x - low*step) * (y[low+1] - y[low]) / step;
 }
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
 double IonRangeCalculator::getIonBraggCurveIntegralMeV(pid_type ion, double E_MeV, int Npoints){ // integral of dE/dx curve for the current {gas, p, T}
 
   // assume that all dE/dx values are non-negative
-  TGraph aGraph(getIonBraggCurveMeVPerMM(ion, E_MeV, Npoints));
-  double xmin, xmax, ymin, ymax;
-  aGraph.ComputeRange(xmin, ymin, xmax, ymax);
-  aGraph.SetPoint(aGraph.GetN(), xmin, 0.0);
-  aGraph.SetPoint(aGraph.GetN(), xmax, 0.0);
-  aGraph.Sort();
-  double area=aGraph.Integral();
+  std::vector<double> dEdx;
+  getIonBraggCurveMeVPerMM(ion, E_MeV, dEdx, Npoints);
+  const auto step=getIonRangeMM(ion, E_MeV)/(Npoints-1);
+  double area=0.0;
+  for(int ipoint=1; ipoint<Npoints; ipoint++){
+    area += 0.5*(dEdx[ipoint-1]+dEdx[ipoint])*step; // trapezoidal rule
+  }
   return area;
 }
 ////////////////////////////////////////////////
@@ -433,6 +442,7 @@ void IonRangeCalculator::addIonBraggCurve(pid_type ion, gas_mixture_type gas, do
     zeroSuppressTGraph(refBraggCurveMap[key]);
     refBraggPressureMap[key]=p_mbar; // reference pressure [mbar]
     refBraggTemperatureMap[key]=T_Kelvin; // reference tempereature T[K]
+    refBraggTableMap[key]=std::make_shared<const LookupTable>(*refBraggCurveMap[key]);
 
     // DEBUG
     if(_debug) {
@@ -474,6 +484,7 @@ void IonRangeCalculator::setEffectiveLengthCorrection(pid_type ion, double lengt
     exit(-1);
   }
   effectiveLengthCorrectionMap[ion]=std::make_tuple(lengthScale, lengthOffset_mm);
+  updateIonTables();
 
   // DEBUG
   if(_debug) {
@@ -499,6 +510,7 @@ void IonRangeCalculator::resetEffectiveLengthCorrection(pid_type ion){
 void IonRangeCalculator::resetEffectiveLengthCorrections(){
 
   effectiveLengthCorrectionMap.clear();
+  updateIonTables();
 
   // DEBUG
   if(_debug) {
@@ -538,3 +550,93 @@ double IonRangeCalculator::getEffectiveLengthCorrectionOffsetMM(pid_type ion){
   // DEBUG
   return result;
 }
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+void IonRangeCalculator::updateIonTables(){
+
+  myIonTables.assign(pid_type::PID_MAX+1, IonTables());
+  if(myGasPressure<=0.0 || myGasTemperature<=0.0) return; // gas conditions not set yet
+
+  for(auto ion=pid_type::PID_MIN; ion<=pid_type::PID_MAX; ion=pid_type(ion+1)) {
+    auto key=std::make_tuple(myGasMixture, ion);
+    auto &tables=myIonTables[ion];
+    auto itR=refRangeTableMap.find(key);
+    if(itR!=refRangeTableMap.end()) {
+      tables.range=itR->second;
+      tables.energy=refEnergyTableMap.at(key);
+      tables.rangeTemperatureRatio=myGasTemperature/refGasRangeTemperatureMap.at(key);
+      tables.rangePressureRatio=refGasRangePressureMap.at(key)/myGasPressure;
+      tables.refTemperatureRatio=refGasRangeTemperatureMap.at(key)/myGasTemperature;
+      tables.refPressureRatio=myGasPressure/refGasRangePressureMap.at(key);
+    }
+    auto itB=refBraggTableMap.find(key);
+    if(itB!=refBraggTableMap.end()) {
+      tables.bragg=itB->second;
+      tables.braggScale=(refBraggTemperatureMap.at(key)/myGasTemperature)*(myGasPressure/refBraggPressureMap.at(key));
+    }
+    auto itC=effectiveLengthCorrectionMap.find(ion);
+    if(itC!=effectiveLengthCorrectionMap.end()) {
+      tables.lengthScale=std::get<0>(itC->second);
+      tables.lengthOffset_mm=std::get<1>(itC->second);
+    }
+  }
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+const IonRangeCalculator::IonTables &IonRangeCalculator::getIonTables(pid_type ion) const{
+  static const IonTables missing;
+  const int index=ion;
+  if(index<0 || index>=(int)myIonTables.size()) return missing;
+  return myIonTables[index];
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+IonRangeCalculator::LookupTable::LookupTable(const TGraph &aGraph, int binsPerPoint){
+
+  // copy points sorted by X
+  std::vector<std::pair<double, double> > points;
+  for(int iPoint=0;iPoint<aGraph.GetN();++iPoint){
+    points.push_back(std::make_pair(aGraph.GetX()[iPoint], aGraph.GetY()[iPoint]));
+  }
+  std::stable_sort(points.begin(), points.end(),
+		   [](const std::pair<double, double> &a, const std::pair<double, double> &b){ return a.first<b.first; });
+  for(auto &aPoint: points) {
+    myX.push_back(aPoint.first);
+    myY.push_back(aPoint.second);
+  }
+  if(myX.size()<2 || myX.back()<=myX.front()) return; // degenerate curve, Eval() falls back to linear search
+
+  // for each uniform bin store the last point below its lower edge
+  const int nBins=binsPerPoint*myX.size();
+  myBinScale=nBins/(myX.back()-myX.front());
+  myFirstPoint.resize(nBins+1);
+  int iPoint=0;
+  for(int iBin=0; iBin<=nBins; ++iBin) {
+    const double xlow=myX.front()+iBin/myBinScale;
+    while(iPoint+1<(int)myX.size() && myX[iPoint+1]<=xlow) ++iPoint;
+    myFirstPoint[iBin]=iPoint;
+  }
+}
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+double IonRangeCalculator::LookupTable::Eval(double x) const{
+
+  // same as TGraph::Eval() for sorted points with linear interpolation and extrapolation
+  const int N=myX.size();
+  if(N==0) return 0.0;
+  if(N==1) return myY[0];
+  int low;
+  if(x<myX.front()) low=0;
+  else if(x>=myX.back()) low=N-2;
+  else {
+    low=0;
+    if(!myFirstPoint.empty()) {
+      low=myFirstPoint[std::min(int((x-myX.front())*myBinScale), (int)myFirstPoint.size()-1)];
+      while(low>0 && myX[low]>x) --low; // protection against rounding of the bin index
+    }
+    while(low+2<N && myX[low+1]<=x) ++low;
+  }
+  const int up=low+1;
+  if(myX[low]==myX[up]) return myY[low];
+  return myY[up] + (x - myX[up]) * (myY[low] - myY[up]) / (myX[low] - myX[up]);
+}
@@ -0,0 +1,73 @@
+#include "TPCReco/MergeJoin.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace tpcreco {
+namespace utilities {
+
+std::vector<JoinRow> makeJoinPlan(const std::vector<EventIndex> &indices) {
+  std::vector<JoinRow> plan;
+  std::vector<Long64_t> positions(indices.size(), 0);
+  while (true) {
+    // smallest key among the heads of the indices
+    bool found = false;
+    std::pair<Long64_t, Long64_t> key;
+    for (unsigned int i = 0; i < indices.size(); ++i) {
+      if (positions[i] >= indices[i].size()) {
+        continue;
+      }
+      auto aKey = std::make_pair(indices[i].getMajor(positions[i]),
+                                 indices[i].getMinor(positions[i]));
+      if (!found || aKey < key) {
+        key = aKey;
+        found = true;
+      }
+    }
+    if (!found) {
+      break;
+    }
+    JoinRow aRow{key.first, key.second,
+                 std::vector<Long64_t>(indices.size(), -1)};
+    for (unsigned int i = 0; i < indices.size(); ++i) {
+      auto &position = positions[i];
+      if (position < indices[i].size() &&
+          indices[i].getMajor(position) == key.first &&
+          indices[i].getMinor(position) == key.second) {
+        aRow.entries[i] = indices[i].entries()[position];
+        ++position;
+      }
+    }
+    plan.push_back(std::move(aRow));
+  }
+  return plan;
+}
+
+bool storageOrderLess(const JoinRow &a, const JoinRow &b) {
+  for (unsigned int i = 0; i < a.entries.size() && i < b.entries.size(); ++i) {
+    if (a.entries[i] == b.entries[i]) {
+      continue;
+    }
+    if (a.entries[i] < 0 || b.entries[i] < 0) {
+      return b.entries[i] < 0;
+    }
+    return a.entries[i] < b.entries[i];
+  }
+  return false;
+}
+
+void sortByStorageOrder(std::vector<JoinRow> &plan) {
+  std::stable_sort(plan.begin(), plan.end(), storageOrderLess);
+}
+
+void enablePrefetch(TTree *tree, Long64_t cacheSize) {
+  if (!tree->GetCurrentFile()) {
+    return;
+  }
+  tree->SetCacheSize(cacheSize);
+  tree->AddBranchToCache("*", true);
+  tree->StopCacheLearningPhase();
+}
+
+} // namespace utilities
+} // namespace tpcreco
@@ -0,0 +1,239 @@
+#include "TPCReco/PerfMonitor.h"
+#include "TPCReco/colorText.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace tpcreco {
+namespace utilities {
+
+namespace {
+
+int histoBin(uint64_t ns) {
+  int bin = 0;
+  while (ns > 1 && bin < PerfMonitor::nHistoBins - 1) {
+    ns >>= 1;
+    ++bin;
+  }
+  return bin;
+}
+
+std::string formatDuration(double ns) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(1);
+  if (ns < 1E3) {
+    os << ns << " ns";
+  } else if (ns < 1E6) {
+    os << ns / 1E3 << " us";
+  } else if (ns < 1E9) {
+    os << ns / 1E6 << " ms";
+  } else {
+    os << ns / 1E9 << " s";
+  }
+  return os.str();
+}
+
+std::string escapeJSON(const std::string &text) {
+  std::string result;
+  for (auto c : text) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+} // namespace
+
+void PerfMonitor::Stage::add(uint64_t ns) noexcept {
+  calls.fetch_add(1, std::memory_order_relaxed);
+  totalNs.fetch_add(ns, std::memory_order_relaxed);
+  histo[histoBin(ns)].fetch_add(1, std::memory_order_relaxed);
+  auto current = minNs.load(std::memory_order_relaxed);
+  while (ns < current &&
+         !minNs.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+  }
+  current = maxNs.load(std::memory_order_relaxed);
+  while (ns > current &&
+         !maxNs.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+  }
+}
+
+PerfMonitor &PerfMonitor::instance() {
+  static PerfMonitor theInstance;
+  return theInstance;
+}
+
+PerfMonitor::Stage &PerfMonitor::getStage(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = std::find_if(stages.begin(), stages.end(),
+                         [&name](const Stage &s) { return s.name == name; });
+  if (it != stages.end()) {
+    return *it;
+  }
+  stages.emplace_back(name);
+  return stages.back();
+}
+
+PerfMonitor::Counter &PerfMonitor::getCounter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it =
+      std::find_if(counters.begin(), counters.end(),
+                   [&name](const Counter &c) { return c.name == name; });
+  if (it != counters.end()) {
+    return *it;
+  }
+  counters.emplace_back(name);
+  return counters.back();
+}
+
+void PerfMonitor::reset() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto &stage : stages) {
+    stage.calls = 0;
+    stage.totalNs = 0;
+    stage.minNs = UINT64_MAX;
+    stage.maxNs = 0;
+    for (auto &bin : stage.histo) {
+      bin = 0;
+    }
+  }
+  for (auto &counter : counters) {
+    counter.value = 0;
+  }
+}
+
+void PerfMonitor::configure(const boost::property_tree::ptree &config) {
+  auto flag = config.get_optional<bool>("profiling.enable");
+  if (flag) {
+    setEnabled(*flag);
+  }
+}
+
+void PerfMonitor::print(std::ostream &os) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (stages.empty() && counters.empty()) {
+    return;
+  }
+  uint64_t grandTotal = 0;
+  size_t nameWidth = 10;
+  for (const auto &stage : stages) {
+    grandTotal += stage.totalNs;
+    nameWidth = std::max(nameWidth, stage.name.size());
+  }
+  for (const auto &counter : counters) {
+    nameWidth = std::max(nameWidth, counter.name.size());
+  }
+
+  os << KBLU << "Per-stage timing summary:" << RST << std::endl;
+  os << std::left << std::setw(nameWidth + 2) << "stage" << std::right
+     << std::setw(10) << "calls" << std::setw(12) << "total"
+     << std::setw(12) << "mean" << std::setw(12) << "min" << std::setw(12)
+     << "max" << std::setw(8) << "share" << std::endl;
+  for (const auto &stage : stages) {
+    uint64_t calls = stage.calls;
+    if (!calls) {
+      continue;
+    }
+    double total = stage.totalNs;
+    os << std::left << std::setw(nameWidth + 2) << stage.name << std::right
+       << std::setw(10) << calls << std::setw(12) << formatDuration(total)
+       << std::setw(12) << formatDuration(total / calls) << std::setw(12)
+       << formatDuration(stage.minNs) << std::setw(12)
+       << formatDuration(stage.maxNs) << std::setw(7) << std::fixed
+       << std::setprecision(1) << (grandTotal ? 100.0 * total / grandTotal : 0)
+       << "%" << std::endl;
+  }
+
+  const int barWidth = 40;
+  for (const auto &stage : stages) {
+    uint64_t calls = stage.calls;
+    if (!calls) {
+      continue;
+    }
+    os << KBLU << "Duration histogram: " << RST << stage.name << std::endl;
+    uint64_t maxCount = 0;
+    for (const auto &bin : stage.histo) {
+      maxCount = std::max(maxCount, bin.load());
+    }
+    for (int iBin = 0; iBin < nHistoBins; ++iBin) {
+      uint64_t count = stage.histo[iBin];
+      if (!count) {
+        continue;
+      }
+      os << "  [" << std::setw(9) << formatDuration(double(1ULL << iBin))
+         << ", " << std::setw(9) << formatDuration(double(1ULL << (iBin + 1)))
+         << ") " << std::setw(10) << count << " "
+         << std::string(std::max<uint64_t>(1, barWidth * count / maxCount),
+                        '#')
+         << std::endl;
+    }
+  }
+
+  if (!counters.empty()) {
+    os << KBLU << "Counters:" << RST << std::endl;
+    for (const auto &counter : counters) {
+      os << std::left << std::setw(nameWidth + 2) << counter.name
+         << std::right << std::setw(10) << counter.value.load() << std::endl;
+    }
+  }
+}
+
+void PerfMonitor::writeJSON(std::ostream &os) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  os << "{\n  \"stages\": [";
+  bool first = true;
+  for (const auto &stage : stages) {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    uint64_t calls = stage.calls;
+    os << "    {\"name\": \"" << escapeJSON(stage.name) << "\""
+       << ", \"calls\": " << calls << ", \"totalNs\": " << stage.totalNs.load()
+       << ", \"minNs\": " << (calls ? stage.minNs.load() : 0)
+       << ", \"maxNs\": " << stage.maxNs.load() << ", \"histoLog2Ns\": [";
+    for (int iBin = 0; iBin < nHistoBins; ++iBin) {
+      os << (iBin ? ", " : "") << stage.histo[iBin].load();
+    }
+    os << "]}";
+  }
+  os << "\n  ],\n  \"counters\": {";
+  first = true;
+  for (const auto &counter : counters) {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    os << "    \"" << escapeJSON(counter.name)
+       << "\": " << counter.value.load();
+  }
+  os << "\n  }\n}\n";
+}
+
+void PerfMonitor::writeJSON(const std::string &fileName) const {
+  std::ofstream out(fileName);
+  if (!out) {
+    std::cerr << KRED << "PerfMonitor: cannot open file: " << RST << fileName
+              << std::endl;
+    return;
+  }
+  writeJSON(out);
+}
+
+void PerfMonitor::report(const boost::property_tree::ptree &config,
+                         std::ostream &os) const {
+  if (!isEnabled()) {
+    return;
+  }
+  print(os);
+  auto fileName = config.get<std::string>("profiling.jsonFile", "");
+  if (!fileName.empty()) {
+    writeJSON(fileName);
+    os << KBLU << "Timing summary written to: " << RST << fileName
+       << std::endl;
+  }
+}
+
+} // namespace utilities
+} // namespace tpcreco
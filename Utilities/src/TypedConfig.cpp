@@ -0,0 +1,170 @@
+#include "TPCReco/TypedConfig.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace tpcreco {
+namespace config {
+
+namespace {
+void require(bool condition, const std::string &message) {
+  if (!condition) {
+    throw std::invalid_argument("Wrong configuration: " + message);
+  }
+}
+
+// value of an existing node must be convertible, missing node gives the default
+template <class T>
+T get(const boost::property_tree::ptree &aConfig, const std::string &path,
+      const T &defaultValue) {
+  return aConfig.get_child_optional(path) ? aConfig.get<T>(path)
+                                          : defaultValue;
+}
+
+template <class T>
+boost::optional<T> getOptional(const boost::property_tree::ptree &aConfig,
+                               const std::string &path) {
+  if (!aConfig.get_child_optional(path)) {
+    return boost::none;
+  }
+  return aConfig.get<T>(path);
+}
+
+void requireOrdered(const boost::optional<double> &lower,
+                    const boost::optional<double> &upper,
+                    const std::string &message) {
+  require(!lower || !upper || *lower <= *upper, message);
+}
+} // namespace
+
+HitFilterConfig
+HitFilterConfig::fromConfig(const boost::property_tree::ptree &aConfig) {
+  HitFilterConfig result;
+  result.enable = get(aConfig, "hitFilter.recoClusterEnable", result.enable);
+  result.threshold =
+      get(aConfig, "hitFilter.recoClusterThreshold", result.threshold);
+  result.fractionThreshold =
+      get(aConfig, "hitFilter.recoClusterConstantFractionThreshold",
+          result.fractionThreshold);
+  result.deltaStrips =
+      get(aConfig, "hitFilter.recoClusterDeltaStrips", result.deltaStrips);
+  result.deltaTimeCells = get(aConfig, "hitFilter.recoClusterDeltaTimeCells",
+                              result.deltaTimeCells);
+  require(result.fractionThreshold >= 0 && result.fractionThreshold <= 1,
+          "hitFilter.recoClusterConstantFractionThreshold outside [0, 1]");
+  require(result.deltaStrips >= 0,
+          "negative hitFilter.recoClusterDeltaStrips");
+  require(result.deltaTimeCells >= 0,
+          "negative hitFilter.recoClusterDeltaTimeCells");
+  return result;
+}
+
+bool HitFilterConfig::operator==(const HitFilterConfig &other) const {
+  return enable == other.enable && threshold == other.threshold &&
+         fractionThreshold == other.fractionThreshold &&
+         deltaStrips == other.deltaStrips &&
+         deltaTimeCells == other.deltaTimeCells;
+}
+
+PedestalConfig
+PedestalConfig::fromConfig(const boost::property_tree::ptree &aConfig) {
+  PedestalConfig result;
+  result.remove = get(aConfig, "pedestal.remove", result.remove);
+  result.minPedestalCell =
+      get(aConfig, "pedestal.minPedestalCell", result.minPedestalCell);
+  result.maxPedestalCell =
+      get(aConfig, "pedestal.maxPedestalCell", result.maxPedestalCell);
+  result.minSignalCell =
+      get(aConfig, "pedestal.minSignalCell", result.minSignalCell);
+  result.maxSignalCell =
+      get(aConfig, "pedestal.maxSignalCell", result.maxSignalCell);
+  require(result.minPedestalCell >= 0 &&
+              result.minPedestalCell <= result.maxPedestalCell,
+          "pedestal.minPedestalCell/maxPedestalCell");
+  require(result.minSignalCell >= 0 &&
+              result.minSignalCell <= result.maxSignalCell,
+          "pedestal.minSignalCell/maxSignalCell");
+  result.database = get(aConfig, "pedestal.pedestalDatabase", result.database);
+  // run ids do not fit into the int options, an empty string means unset
+  auto aRunId = get(aConfig, "pedestal.pedestalRunId", std::string());
+  if (!aRunId.empty()) {
+    std::size_t nParsed = 0;
+    try {
+      result.runId = std::stol(aRunId, &nParsed);
+    } catch (const std::exception &) {
+    }
+    require(result.runId && nParsed == aRunId.size() && *result.runId > 0,
+            "pedestal.pedestalRunId is not a run id");
+  }
+  result.zeroSuppression =
+      get(aConfig, "pedestal.zeroSuppressionEnable", result.zeroSuppression);
+  result.zeroSuppressionNSigma = get(aConfig, "pedestal.zeroSuppressionNSigma",
+                                     result.zeroSuppressionNSigma);
+  result.zeroSuppressionThreshold =
+      get(aConfig, "pedestal.zeroSuppressionThreshold",
+          result.zeroSuppressionThreshold);
+  result.zeroSuppressionGuardCells =
+      get(aConfig, "pedestal.zeroSuppressionGuardCells",
+          result.zeroSuppressionGuardCells);
+  require(result.zeroSuppressionNSigma >= 0,
+          "negative pedestal.zeroSuppressionNSigma");
+  require(result.zeroSuppressionGuardCells >= 0,
+          "negative pedestal.zeroSuppressionGuardCells");
+  return result;
+}
+
+ConditionsConfig
+ConditionsConfig::fromConfig(const boost::property_tree::ptree &aConfig) {
+  ConditionsConfig result;
+  result.pressure = get(aConfig, "conditions.pressure", result.pressure);
+  result.temperature =
+      get(aConfig, "conditions.temperature", result.temperature);
+  result.samplingRate =
+      get(aConfig, "conditions.samplingRate", result.samplingRate);
+  result.driftV = get(aConfig, "conditions.driftV", result.driftV);
+  require(result.pressure > 0, "conditions.pressure <= 0");
+  require(result.temperature > 0, "conditions.temperature <= 0");
+  require(result.samplingRate > 0, "conditions.samplingRate <= 0");
+  return result;
+}
+
+EventFilterConfig
+EventFilterConfig::fromConfig(const boost::property_tree::ptree &aConfig) {
+  EventFilterConfig result;
+  auto node = aConfig.get_child_optional("eventFilter");
+  if (!node) {
+    return result;
+  }
+  result.enabled = get(*node, "enabled", result.enabled);
+  result.maxChargeUpperBound =
+      getOptional<double>(*node, "maxChargeUpperBound");
+  result.maxChargeLowerBound =
+      getOptional<double>(*node, "maxChargeLowerBound");
+  result.totalChargeLowerBound =
+      getOptional<double>(*node, "totalChargeLowerBound");
+  result.totalChargeUpperBound =
+      getOptional<double>(*node, "totalChargeUpperBound");
+  auto events = node->get_child_optional("events");
+  if (events) {
+    for (const auto &index : *events) {
+      result.events.insert(index.second.get_value<std::size_t>());
+    }
+  }
+  requireOrdered(result.maxChargeLowerBound, result.maxChargeUpperBound,
+                 "eventFilter.maxChargeLowerBound > maxChargeUpperBound");
+  requireOrdered(result.totalChargeLowerBound, result.totalChargeUpperBound,
+                 "eventFilter.totalChargeLowerBound > totalChargeUpperBound");
+  return result;
+}
+
+TypedConfig TypedConfig::fromConfig(const boost::property_tree::ptree &aConfig) {
+  TypedConfig result;
+  result.hitFilter = HitFilterConfig::fromConfig(aConfig);
+  result.pedestal = PedestalConfig::fromConfig(aConfig);
+  result.conditions = ConditionsConfig::fromConfig(aConfig);
+  result.eventFilter = EventFilterConfig::fromConfig(aConfig);
+  return result;
+}
+
+} // namespace config
+} // namespace tpcreco
@@ -0,0 +1,39 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<bool> countAllocations{false};
+std::atomic<long> nAllocations{0};
+} // namespace
+
+void tpcreco::test::startCountingAllocations() {
+  nAllocations = 0;
+  countAllocations = true;
+}
+
+long tpcreco::test::stopCountingAllocations() {
+  countAllocations = false;
+  return nAllocations;
+}
+
+void *operator new(std::size_t size) {
+  if (countAllocations) {
+    ++nAllocations;
+  }
+  if (void *pointer = std::malloc(size ? size : 1)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+// not inlined, so that GCC does not pair the free() with the new expressions
+__attribute__((noinline)) void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+__attribute__((noinline)) void operator delete(void *pointer,
+                                              std::size_t) noexcept {
+  std::free(pointer);
+}
@@ -0,0 +1,20 @@
+#ifndef TPCRECO_TEST_ALLOCATION_COUNTER_H
+#define TPCRECO_TEST_ALLOCATION_COUNTER_H
+
+// Counter of the calls of the global operator new, for tests of code
+// expected not to allocate. Linking the AllocationCounter library replaces
+// the global operator new and operator delete of the test executable.
+
+namespace tpcreco {
+namespace test {
+
+// resets the counter and starts counting
+void startCountingAllocations();
+
+// stops counting and returns the number of allocations since the start
+long stopCountingAllocations();
+
+} // namespace test
+} // namespace tpcreco
+
+#endif
@@ -0,0 +1,73 @@
+#include "TPCReco/EntryRange.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <vector>
+
+using tpcreco::utilities::EntryRange;
+
+TEST(EntryRange, Defaults) {
+  EntryRange aRange(10);
+  EXPECT_EQ(aRange.first(), 0);
+  EXPECT_EQ(aRange.last(), 10);
+  EXPECT_FALSE(aRange.isSharded());
+  EXPECT_EQ(aRange.decorate("Histos.root"), "Histos.root");
+}
+
+TEST(EntryRange, FirstAndMaxEntries) {
+  EXPECT_EQ(EntryRange(10, 3).first(), 3);
+  EXPECT_EQ(EntryRange(10, 3).last(), 10);
+  EXPECT_EQ(EntryRange(10, 3, 4).last(), 7);
+  EXPECT_EQ(EntryRange(10, 3, 40).last(), 10);
+  EXPECT_EQ(EntryRange(10, 30).size(), 0);
+  EXPECT_THROW(EntryRange(10, -1), std::invalid_argument);
+}
+
+TEST(EntryRange, ShardsCoverRange) {
+  const Long64_t nEntries = 103;
+  for (unsigned int nShards = 1; nShards < 12; ++nShards) {
+    Long64_t expectedFirst = 5;
+    for (unsigned int i = 0; i < nShards; ++i) {
+      EntryRange aRange(nEntries, 5, 90,
+                        std::to_string(i) + "/" + std::to_string(nShards));
+      EXPECT_EQ(aRange.first(), expectedFirst);
+      EXPECT_LE(aRange.size(), 90 / nShards + 1);
+      expectedFirst = aRange.last();
+    }
+    EXPECT_EQ(expectedFirst, 95);
+  }
+}
+
+TEST(EntryRange, WrongShard) {
+  EXPECT_THROW(EntryRange(10, 0, -1, "2/2"), std::invalid_argument);
+  EXPECT_THROW(EntryRange(10, 0, -1, "1/0"), std::invalid_argument);
+  EXPECT_THROW(EntryRange(10, 0, -1, "1of2"), std::invalid_argument);
+}
+
+TEST(EntryRange, Decorate) {
+  EntryRange aRange(10, 0, -1, "1/4");
+  EXPECT_EQ(aRange.decorate("Histos.root"), "Histos_shard1of4.root");
+  EXPECT_EQ(aRange.decorate("dir/Reco_run.root"), "dir/Reco_run_shard1of4.root");
+  unsigned int shardIndex = 0, nShards = 0;
+  EXPECT_TRUE(EntryRange::parseDecorated(aRange.decorate("dir/Reco_run.root"),
+                                         shardIndex, nShards));
+  EXPECT_EQ(shardIndex, 1U);
+  EXPECT_EQ(nShards, 4U);
+  EXPECT_FALSE(EntryRange::parseDecorated("Histos.root", shardIndex, nShards));
+}
+
+TEST(EntryRange, AlignedToGroups) {
+  // groups of equal keys must not be split between shards
+  std::vector<int> keys = {0, 0, 1, 1, 1, 1, 2, 3, 3, 3, 4, 5};
+  auto sameGroup = [&keys](Long64_t a, Long64_t b) { return keys[a] == keys[b]; };
+  Long64_t expectedFirst = 0;
+  for (unsigned int i = 0; i < 5; ++i) {
+    auto aRange = EntryRange(keys.size(), 0, -1, std::to_string(i) + "/5")
+                      .alignedTo(sameGroup);
+    EXPECT_EQ(aRange.first(), expectedFirst);
+    if (aRange.first() > 0 && aRange.first() < (Long64_t)keys.size()) {
+      EXPECT_NE(keys[aRange.first() - 1], keys[aRange.first()]);
+    }
+    expectedFirst = aRange.last();
+  }
+  EXPECT_EQ(expectedFirst, (Long64_t)keys.size());
+}
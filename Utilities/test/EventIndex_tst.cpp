@@ -0,0 +1,147 @@
+#include "TPCReco/EventIndex.h"
+#include "gtest/gtest.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <TTreeIndex.h>
+#include <boost/filesystem.hpp>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using tpcreco::utilities::EventIndex;
+
+class EventIndexTest : public ::testing::Test {
+public:
+  // {runId, eventId} of consecutive entries
+  const std::vector<std::pair<int, int>> ids = {
+      {2, 5}, {1, 7}, {2, 1}, {1, 3}, {2, 5}, {3, 7}};
+  int runId = 0;
+  int eventId = 0;
+
+  void fill(TTree *tree) {
+    tree->Branch("runId", &runId);
+    tree->Branch("eventId", &eventId);
+    for (auto id : ids) {
+      runId = id.first;
+      eventId = id.second;
+      tree->Fill();
+    }
+  }
+};
+
+TEST_F(EventIndexTest, Lookup) {
+  TTree tree("tree", "");
+  tree.SetDirectory(nullptr);
+  fill(&tree);
+  auto aIndex = EventIndex::attach(&tree, "runId", "eventId");
+  ASSERT_EQ(aIndex.size(), (Long64_t)ids.size());
+  EXPECT_EQ(aIndex.find(1, 7), 1);
+  EXPECT_EQ(aIndex.find(2, 1), 2);
+  EXPECT_EQ(aIndex.find(3, 7), 5);
+  EXPECT_EQ(aIndex.find(1, 5), -1);
+  EXPECT_EQ(aIndex.find(4, 1), -1);
+  auto duplicate = aIndex.find(2, 5);
+  EXPECT_TRUE(duplicate == 0 || duplicate == 4);
+  EXPECT_EQ(aIndex.findMinor(3), 3);
+  EXPECT_EQ(aIndex.findMinor(7), 1);
+  EXPECT_EQ(aIndex.findMinor(2), -1);
+  for (Long64_t i = 0; i < aIndex.size(); ++i) {
+    tree.GetEntry(aIndex.entries()[i]);
+    EXPECT_EQ(aIndex.getMajor(i), runId);
+    EXPECT_EQ(aIndex.getMinor(i), eventId);
+    if (i) {
+      EXPECT_LE(std::make_pair(aIndex.getMajor(i - 1), aIndex.getMinor(i - 1)),
+                std::make_pair(aIndex.getMajor(i), aIndex.getMinor(i)));
+    }
+  }
+  EXPECT_EQ(tree.GetEntryNumberWithIndex(1, 7), 1);
+}
+
+TEST_F(EventIndexTest, FromTreeIndex) {
+  // index built by ROOT, with majors and minors in separate arrays
+  TTree tree("tree", "");
+  tree.SetDirectory(nullptr);
+  fill(&tree);
+  ASSERT_EQ(tree.BuildIndex("runId", "eventId"), (Int_t)ids.size());
+  auto *treeIndex = tree.GetTreeIndex();
+  auto aIndex = EventIndex::attach(&tree, "runId", "eventId");
+  EXPECT_EQ(tree.GetTreeIndex(), treeIndex); // taken over, not rebuilt
+  ASSERT_EQ(aIndex.size(), (Long64_t)ids.size());
+  EXPECT_EQ(aIndex.find(1, 3), 3);
+  EXPECT_EQ(aIndex.find(3, 7), 5);
+  EXPECT_EQ(aIndex.find(3, 5), -1);
+  EXPECT_EQ(aIndex.findMinor(1), 2);
+  EXPECT_EQ(aIndex.findMinor(7), 1);
+  std::vector<std::pair<Long64_t, Long64_t>> keys;
+  for (Long64_t i = 0; i < aIndex.size(); ++i) {
+    keys.emplace_back(aIndex.getMajor(i), aIndex.getMinor(i));
+  }
+  EXPECT_EQ(keys, (std::vector<std::pair<Long64_t, Long64_t>>{
+                      {1, 3}, {1, 7}, {2, 1}, {2, 5}, {2, 5}, {3, 7}}));
+}
+
+TEST_F(EventIndexTest, MajorOnly) {
+  TTree tree("tree", "");
+  tree.SetDirectory(nullptr);
+  fill(&tree);
+  auto aIndex = EventIndex::attach(&tree, "eventId");
+  EXPECT_EQ(aIndex.find(3), 3);
+  EXPECT_EQ(aIndex.find(4), -1);
+}
+
+TEST_F(EventIndexTest, StoredAndCachedIndex) {
+  auto dir = boost::filesystem::temp_directory_path() /
+             boost::filesystem::unique_path("EventIndex_tst_%%%%%%%%");
+  boost::filesystem::create_directories(dir);
+  EventIndex::SetCacheDir((dir / "cache").string());
+  auto fileName = (dir / "events.root").string();
+  {
+    TFile file(fileName.c_str(), "RECREATE");
+    auto *tree = new TTree("tree", "");
+    fill(tree);
+    tree->Write();
+    file.Close();
+  }
+  // index built on demand and cached
+  {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    auto *tree = static_cast<TTree *>(file->Get("tree"));
+    ASSERT_EQ(tree->GetTreeIndex(), nullptr);
+    auto aIndex = EventIndex::attach(tree, "runId", "eventId");
+    EXPECT_EQ(aIndex.find(1, 3), 3);
+  }
+  // a single cache file, no temporary files left
+  ASSERT_FALSE(boost::filesystem::is_empty(dir / "cache"));
+  EXPECT_EQ(std::distance(boost::filesystem::directory_iterator(dir / "cache"),
+                          boost::filesystem::directory_iterator()),
+            1);
+  // index read from the cache
+  {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    auto *tree = static_cast<TTree *>(file->Get("tree"));
+    auto aIndex = EventIndex::attach(tree, "runId", "eventId");
+    EXPECT_EQ(aIndex.find(1, 3), 3);
+    auto *treeIndex = dynamic_cast<TTreeIndex *>(tree->GetTreeIndex());
+    ASSERT_NE(treeIndex, nullptr);
+    EXPECT_EQ(treeIndex->GetN(), (Long64_t)ids.size());
+    EXPECT_EQ(tree->GetEntryNumberWithIndex(3, 7), 5);
+  }
+  // index stored with the tree
+  {
+    TFile file(fileName.c_str(), "UPDATE");
+    auto *tree = static_cast<TTree *>(file.Get("tree"));
+    tree->BuildIndex("runId", "eventId");
+    tree->Write("", TObject::kOverwrite);
+    file.Close();
+  }
+  {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    auto *tree = static_cast<TTree *>(file->Get("tree"));
+    ASSERT_NE(tree->GetTreeIndex(), nullptr);
+    auto aIndex = EventIndex::attach(tree, "runId", "eventId");
+    EXPECT_EQ(aIndex.find(2, 1), 2);
+  }
+  EventIndex::SetCacheDir("");
+  boost::filesystem::remove_all(dir);
+}
@@ -0,0 +1,58 @@
+#include "TPCReco/IonRangeCalculator.h"
+#include "gtest/gtest.h"
+#include <TGraph.h>
+#include <vector>
+
+TEST(IonRangeCalculator, LookupTableMatchesTGraph) {
+  TGraph graph;
+  const std::vector<double> x = {0.0, 0.5, 0.5, 1.0, 3.0, 3.1, 10.0};
+  const std::vector<double> y = {1.0, 2.0, 4.0, 3.0, 0.5, 7.0, 2.0};
+  for (size_t i = 0; i < x.size(); ++i) {
+    graph.SetPoint(i, x[i], y[i]);
+  }
+  graph.Sort();
+  IonRangeCalculator::LookupTable table(graph);
+  for (double value = -2.0; value < 12.0; value += 0.01) {
+    EXPECT_DOUBLE_EQ(table.Eval(value), graph.Eval(value)) << "x=" << value;
+  }
+  for (auto value : x) {
+    EXPECT_DOUBLE_EQ(table.Eval(value), graph.Eval(value)) << "x=" << value;
+  }
+}
+
+TEST(IonRangeCalculator, RangeEnergyRoundTrip) {
+  IonRangeCalculator calculator(gas_mixture_type::CO2, 190.0, 293.15);
+  for (auto ion : {pid_type::ALPHA, pid_type::CARBON_12, pid_type::PROTON}) {
+    for (double energy = 0.1; energy < 2.0; energy += 0.1) {
+      auto range = calculator.getIonRangeMM(ion, energy);
+      EXPECT_NEAR(calculator.getIonEnergyMeV(ion, range), energy, 1e-6);
+    }
+  }
+}
+
+TEST(IonRangeCalculator, RangeScalesWithGasConditions) {
+  IonRangeCalculator calculator(gas_mixture_type::CO2, 250.0, 293.15);
+  auto range = calculator.getIonRangeMM(pid_type::ALPHA, 5.0);
+  calculator.setGasPressure(125.0);
+  EXPECT_DOUBLE_EQ(calculator.getIonRangeMM(pid_type::ALPHA, 5.0), 2 * range);
+  calculator.setEffectiveLengthCorrection(pid_type::ALPHA, 1.0, 3.0);
+  EXPECT_DOUBLE_EQ(calculator.getIonRangeMM(pid_type::ALPHA, 5.0),
+                   2 * range + 3.0);
+}
+
+TEST(IonRangeCalculator, BraggCurveArray) {
+  IonRangeCalculator calculator(gas_mixture_type::CO2, 250.0, 293.15);
+  const int nPoints = 100;
+  auto graph =
+      calculator.getIonBraggCurveMeVPerMM(pid_type::ALPHA, 5.0, nPoints);
+  std::vector<double> curve;
+  calculator.getIonBraggCurveMeVPerMM(pid_type::ALPHA, 5.0, curve, nPoints);
+  ASSERT_EQ(curve.size(), (size_t)nPoints);
+  auto range = calculator.getIonRangeMM(pid_type::ALPHA, 5.0);
+  for (int i = 0; i < nPoints; ++i) {
+    EXPECT_DOUBLE_EQ(graph.GetY()[i], curve[i]);
+    double x = range * (i + 0.3) / nPoints;
+    EXPECT_NEAR(IonRangeCalculator::evalEquidistantCurve(curve, range, x),
+                graph.Eval(x), 1e-9);
+  }
+}
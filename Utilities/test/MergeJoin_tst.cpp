@@ -0,0 +1,184 @@
+#include "TPCReco/MergeJoin.h"
+#include "gtest/gtest.h"
+#include <TTree.h>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace tpcreco::utilities;
+
+class MergeJoinTest : public ::testing::Test {
+public:
+  // {runId, eventId} of consecutive entries
+  const std::vector<std::pair<int, int>> leftIds = {
+      {1, 4}, {1, 2}, {2, 1}, {1, 2}, {1, 9}};
+  const std::vector<std::pair<int, int>> rightIds = {
+      {1, 2}, {2, 1}, {1, 3}, {1, 9}};
+  std::unique_ptr<TTree> left, right;
+  int runId = 0;
+  int eventId = 0;
+  int entry = 0;
+
+  std::unique_ptr<TTree> makeTree(const std::vector<std::pair<int, int>> &ids) {
+    auto tree = std::make_unique<TTree>("tree", "");
+    tree->SetDirectory(nullptr);
+    tree->Branch("runId", &runId);
+    tree->Branch("eventId", &eventId);
+    tree->Branch("entry", &entry);
+    entry = 0;
+    for (auto id : ids) {
+      runId = id.first;
+      eventId = id.second;
+      tree->Fill();
+      ++entry;
+    }
+    return tree;
+  }
+  void SetUp() override {
+    left = makeTree(leftIds);
+    right = makeTree(rightIds);
+  }
+  std::vector<JoinRow> makePlan() {
+    return makeJoinPlan({EventIndex::attach(left.get(), "runId", "eventId"),
+                         EventIndex::attach(right.get(), "runId", "eventId")});
+  }
+};
+
+TEST_F(MergeJoinTest, Plan) {
+  auto plan = makePlan();
+  std::vector<std::pair<Long64_t, Long64_t>> keys;
+  for (const auto &aRow : plan) {
+    keys.emplace_back(aRow.major, aRow.minor);
+  }
+  EXPECT_EQ(keys, (std::vector<std::pair<Long64_t, Long64_t>>{
+                      {1, 2}, {1, 2}, {1, 3}, {1, 4}, {1, 9}, {2, 1}}));
+  ASSERT_EQ(plan.size(), 6U);
+  EXPECT_GE(plan[0].entries[1], 0);
+  EXPECT_EQ(plan[0].entries[1] + plan[1].entries[1], -1); // one match only
+  EXPECT_EQ(plan[2].entries, (std::vector<Long64_t>{-1, 2}));
+  EXPECT_EQ(plan[3].entries, (std::vector<Long64_t>{0, -1}));
+  EXPECT_EQ(plan[4].entries, (std::vector<Long64_t>{4, 3}));
+  EXPECT_EQ(plan[5].entries, (std::vector<Long64_t>{2, 1}));
+}
+
+TEST_F(MergeJoinTest, PlanFromTreeIndex) {
+  // indices taken over from TTree::BuildIndex, majors and minors are
+  // stored in separate arrays of TTreeIndex
+  ASSERT_GT(left->BuildIndex("runId", "eventId"), 0);
+  ASSERT_GT(right->BuildIndex("runId", "eventId"), 0);
+  auto plan = makePlan();
+  ASSERT_EQ(plan.size(), 6U);
+  std::vector<std::pair<Long64_t, Long64_t>> keys;
+  for (const auto &aRow : plan) {
+    keys.emplace_back(aRow.major, aRow.minor);
+  }
+  EXPECT_EQ(keys, (std::vector<std::pair<Long64_t, Long64_t>>{
+                      {1, 2}, {1, 2}, {1, 3}, {1, 4}, {1, 9}, {2, 1}}));
+  EXPECT_EQ(plan[3].entries, (std::vector<Long64_t>{0, -1}));
+  EXPECT_EQ(plan[4].entries, (std::vector<Long64_t>{4, 3}));
+  EXPECT_EQ(plan[5].entries, (std::vector<Long64_t>{2, 1}));
+}
+
+TEST_F(MergeJoinTest, StreamInStorageOrder) {
+  auto plan = makePlan();
+  std::vector<TTree *> trees = {left.get(), right.get()};
+  for (std::size_t maxCached : {1U, 2U, 100U}) {
+    std::vector<JoinRow> visited;
+    streamJoin(
+        trees, plan.begin(), plan.end(),
+        [&](unsigned int) { return std::make_pair(runId, eventId); },
+        [&](const JoinRow &aRow,
+            const std::vector<std::pair<int, int> *> &data) {
+          visited.push_back(aRow);
+          for (unsigned int i = 0; i < data.size(); ++i) {
+            ASSERT_EQ(data[i] != nullptr, aRow.entries[i] >= 0);
+            if (data[i]) {
+              EXPECT_EQ(data[i]->first, aRow.major);
+              EXPECT_EQ(data[i]->second, aRow.minor);
+            }
+          }
+        },
+        maxCached);
+    EXPECT_EQ(visited.size(), plan.size());
+    if (maxCached == 100U) {
+      EXPECT_TRUE(
+          std::is_sorted(visited.begin(), visited.end(), storageOrderLess));
+    }
+  }
+}
+
+TEST_F(MergeJoinTest, ReadsInStorageOrder) {
+  auto plan = makePlan();
+  std::vector<TTree *> trees = {left.get(), right.get()};
+  std::vector<std::vector<int>> reads(trees.size());
+  streamJoin(
+      trees, plan.begin(), plan.end(),
+      [&](unsigned int iTree) {
+        reads[iTree].push_back(entry);
+        return entry;
+      },
+      [](const JoinRow &, const std::vector<int *> &) {});
+  EXPECT_EQ(reads[0], (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(reads[1], (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(MergeJoinTest, ShuffledKeysReadInPasses) {
+  // key order differs from the entry order in both trees
+  const int nEvents = 2000;
+  std::vector<std::pair<int, int>> leftShuffled, rightShuffled;
+  for (int i = 0; i < nEvents; ++i) {
+    if (i % 7) {
+      leftShuffled.emplace_back(1, (i * 769) % nEvents);
+    }
+    if (i % 5) {
+      rightShuffled.emplace_back(1, (i * 1381) % nEvents);
+    }
+  }
+  left = makeTree(leftShuffled);
+  right = makeTree(rightShuffled);
+  auto plan = makePlan();
+  std::vector<TTree *> trees = {left.get(), right.get()};
+  for (std::size_t maxCached : {10U, 100U, 10000U}) {
+    std::vector<std::vector<int>> reads(trees.size());
+    std::size_t nVisited = 0;
+    streamJoin(
+        trees, plan.begin(), plan.end(),
+        [&](unsigned int iTree) {
+          reads[iTree].push_back(entry);
+          return std::make_pair(entry, eventId);
+        },
+        [&](const JoinRow &aRow,
+            const std::vector<std::pair<int, int> *> &data) {
+          ++nVisited;
+          for (unsigned int i = 0; i < data.size(); ++i) {
+            ASSERT_EQ(data[i] != nullptr, aRow.entries[i] >= 0);
+            if (data[i]) {
+              EXPECT_EQ(data[i]->first, aRow.entries[i]);
+              EXPECT_EQ(data[i]->second, aRow.minor);
+            }
+          }
+        },
+        maxCached);
+    EXPECT_EQ(nVisited, plan.size());
+    // every entry is read once, in ascending order within a pass
+    unsigned int nPasses = 1;
+    for (unsigned int i = 0; i < trees.size(); ++i) {
+      auto sortedReads = reads[i];
+      std::sort(sortedReads.begin(), sortedReads.end());
+      EXPECT_TRUE(std::adjacent_find(sortedReads.begin(), sortedReads.end()) ==
+                  sortedReads.end());
+      EXPECT_EQ(sortedReads.size(), (std::size_t)trees[i]->GetEntries());
+      unsigned int nRuns = 1;
+      for (std::size_t iRead = 1; iRead < reads[i].size(); ++iRead) {
+        nRuns += reads[i][iRead] < reads[i][iRead - 1];
+      }
+      nPasses = std::max(nPasses, nRuns);
+    }
+    if (maxCached == 10000U) {
+      EXPECT_EQ(nPasses, 1U) << "all entries fit in the cache";
+    } else {
+      EXPECT_GT(nPasses, 1U);
+    }
+  }
+}
@@ -0,0 +1,93 @@
+#include "TPCReco/PerfMonitor.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace tpcreco::utilities;
+
+class PerfMonitorTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    PerfMonitor::instance().setEnabled(true);
+    PerfMonitor::instance().reset();
+  }
+};
+
+TEST_F(PerfMonitorTest, SameStageForSameName) {
+  auto &stage1 = PerfMonitor::instance().getStage("test.stage");
+  auto &stage2 = PerfMonitor::instance().getStage("test.stage");
+  EXPECT_EQ(&stage1, &stage2);
+}
+
+TEST_F(PerfMonitorTest, StageStatistics) {
+  auto &stage = PerfMonitor::instance().getStage("test.statistics");
+  stage.add(100);
+  stage.add(1000);
+  stage.add(10);
+  EXPECT_EQ(stage.calls, 3u);
+  EXPECT_EQ(stage.totalNs, 1110u);
+  EXPECT_EQ(stage.minNs, 10u);
+  EXPECT_EQ(stage.maxNs, 1000u);
+  EXPECT_EQ(stage.histo[3], 1u); // 10 ns
+  EXPECT_EQ(stage.histo[6], 1u); // 100 ns
+  EXPECT_EQ(stage.histo[9], 1u); // 1000 ns
+}
+
+TEST_F(PerfMonitorTest, ScopedTimer) {
+  for (int i = 0; i < 5; ++i) {
+    TPCRECO_TIME_SCOPE("test.scoped");
+  }
+  EXPECT_EQ(PerfMonitor::instance().getStage("test.scoped").calls, 5u);
+}
+
+TEST_F(PerfMonitorTest, Disabled) {
+  PerfMonitor::instance().setEnabled(false);
+  {
+    TPCRECO_TIME_SCOPE("test.disabled");
+    TPCRECO_COUNT("test.disabledCounter", 1);
+  }
+  EXPECT_EQ(PerfMonitor::instance().getStage("test.disabled").calls, 0u);
+  EXPECT_EQ(PerfMonitor::instance().getCounter("test.disabledCounter").value,
+            0u);
+}
+
+TEST_F(PerfMonitorTest, ConcurrentCounters) {
+  const int nThreads = 4;
+  const int nIncrements = 10000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < nIncrements; ++j) {
+        TPCRECO_COUNT("test.concurrent", 1);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(PerfMonitor::instance().getCounter("test.concurrent").value,
+            uint64_t(nThreads * nIncrements));
+}
+
+TEST_F(PerfMonitorTest, Configure) {
+  boost::property_tree::ptree config;
+  config.put("profiling.enable", false);
+  PerfMonitor::instance().configure(config);
+  EXPECT_FALSE(PerfMonitor::instance().isEnabled());
+  config.put("profiling.enable", true);
+  PerfMonitor::instance().configure(config);
+  EXPECT_TRUE(PerfMonitor::instance().isEnabled());
+}
+
+TEST_F(PerfMonitorTest, JSON) {
+  PerfMonitor::instance().getStage("test.json").add(42);
+  PerfMonitor::instance().getCounter("test.jsonCounter").add(7);
+  std::ostringstream os;
+  PerfMonitor::instance().writeJSON(os);
+  auto text = os.str();
+  EXPECT_NE(text.find("\"name\": \"test.json\", \"calls\": 1, \"totalNs\": 42"),
+            std::string::npos);
+  EXPECT_NE(text.find("\"test.jsonCounter\": 7"), std::string::npos);
+}
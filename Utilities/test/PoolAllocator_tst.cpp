@@ -0,0 +1,90 @@
+#include "AllocationCounter.h"
+#include "TPCReco/PoolAllocator.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using tpcreco::utilities::PoolAllocator;
+
+namespace {
+
+using Key = std::tuple<int, int, int, int>;
+using PooledMap =
+    std::map<Key, double, std::less<Key>,
+             PoolAllocator<std::pair<const Key, double>>>;
+using PooledSet = std::set<int, std::less<int>, PoolAllocator<int>>;
+
+void fill(PooledMap &aMap, int nEntries, int seed) {
+  for (int i = 0; i < nEntries; ++i) {
+    aMap[std::make_tuple(i % 3, 0, (i * seed) % 1024, i % 512)] += i;
+  }
+}
+} // namespace
+
+TEST(PoolAllocatorTest, ContainerContent) {
+  PooledMap aMap;
+  std::map<Key, double> aReference;
+  for (int i = 0; i < 10000; ++i) {
+    auto key = std::make_tuple(i % 3, i % 2, (i * 7) % 1024, i % 512);
+    aMap[key] += i;
+    aReference[key] += i;
+  }
+  ASSERT_EQ(aMap.size(), aReference.size());
+  EXPECT_TRUE(std::equal(aMap.begin(), aMap.end(), aReference.begin()));
+  PooledMap aCopy(aMap);
+  aMap.clear();
+  EXPECT_TRUE(std::equal(aCopy.begin(), aCopy.end(), aReference.begin()));
+}
+
+TEST(PoolAllocatorTest, SteadyStateWithoutAllocations) {
+  PooledMap aMap;
+  PooledSet aSet;
+  // warm-up with the largest event
+  fill(aMap, 20000, 7);
+  for (const auto &item : aMap) {
+    aSet.insert(std::get<2>(item.first));
+  }
+  aMap.clear();
+  aSet.clear();
+
+  tpcreco::test::startCountingAllocations();
+  for (int iEvent = 0; iEvent < 10; ++iEvent) {
+    aMap.clear();
+    aSet.clear();
+    fill(aMap, 10000 + 1000 * iEvent, iEvent + 1);
+    for (const auto &item : aMap) {
+      aSet.insert(std::get<2>(item.first));
+    }
+    PooledMap aCopy(aMap);
+  }
+  EXPECT_EQ(tpcreco::test::stopCountingAllocations(), 0);
+  EXPECT_FALSE(aMap.empty());
+}
+
+TEST(PoolAllocatorTest, ThreadsUseOwnArenas) {
+  using Arena = PoolAllocator<std::pair<const Key, double>>::arena_type;
+  std::vector<std::size_t> chunks(4, 0);
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < chunks.size(); ++iThread) {
+    threads.emplace_back([iThread, &chunks]() {
+      PooledMap aMap;
+      for (int iEvent = 0; iEvent < 20; ++iEvent) {
+        aMap.clear();
+        fill(aMap, 5000, iThread + 1);
+      }
+      chunks[iThread] = Arena::chunks();
+    });
+  }
+  for (auto &aThread : threads) {
+    aThread.join();
+  }
+  // chunks are requested for the first event only
+  PooledMap aMap;
+  fill(aMap, 5000, 1);
+  for (auto nChunks : chunks) {
+    EXPECT_EQ(nChunks, Arena::chunks());
+  }
+}
@@ -57,6 +57,13 @@ TEST_F(TreeDuplicationTest, nonDuplicates) {
   }
 }
 
+TEST_F(TreeDuplicationTest, nonDuplicatesInRange) {
+  EXPECT_THAT(filterDuplicates(tree, 0, 2),
+              ::testing::ElementsAreArray({1, 0}));
+  EXPECT_THAT(filterDuplicates(tree, 2, 9),
+              ::testing::ElementsAreArray({8, 6, 7}));
+}
+
 TEST_F(TreeDuplicationTest, CloneUnique) {
   auto clone = cloneUnique(tree, nullptr);
   std::vector<double> expectedData = {.8, .6, .7, .1, .0};
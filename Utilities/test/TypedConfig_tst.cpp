@@ -0,0 +1,157 @@
+#include "TPCReco/TypedConfig.h"
+#include "gtest/gtest.h"
+#include <boost/property_tree/json_parser.hpp>
+#include <sstream>
+#include <stdexcept>
+
+using namespace tpcreco::config;
+namespace pt = boost::property_tree;
+
+namespace {
+pt::ptree readJson(const std::string &json) {
+  std::stringstream stream{json};
+  pt::ptree tree;
+  pt::read_json(stream, tree);
+  return tree;
+}
+} // namespace
+
+TEST(TypedConfigTest, Defaults) {
+  auto config = TypedConfig::fromConfig(pt::ptree{});
+  EXPECT_FALSE(config.hitFilter.enable);
+  EXPECT_DOUBLE_EQ(config.hitFilter.threshold, 35.0);
+  EXPECT_DOUBLE_EQ(config.hitFilter.fractionThreshold, 0.1);
+  EXPECT_EQ(config.hitFilter.deltaStrips, 2);
+  EXPECT_EQ(config.hitFilter.deltaTimeCells, 5);
+  EXPECT_TRUE(config.pedestal.remove);
+  EXPECT_EQ(config.pedestal.minPedestalCell, 5);
+  EXPECT_EQ(config.pedestal.maxPedestalCell, 25);
+  EXPECT_EQ(config.pedestal.minSignalCell, 5);
+  EXPECT_EQ(config.pedestal.maxSignalCell, 506);
+  EXPECT_DOUBLE_EQ(config.conditions.pressure, 190.0);
+  EXPECT_DOUBLE_EQ(config.conditions.samplingRate, 25.0);
+  EXPECT_FALSE(config.eventFilter.enabled);
+  EXPECT_FALSE(config.eventFilter.maxChargeUpperBound);
+  EXPECT_FALSE(config.eventFilter.totalChargeLowerBound);
+  EXPECT_TRUE(config.eventFilter.events.empty());
+}
+
+TEST(TypedConfigTest, Values) {
+  auto config = TypedConfig::fromConfig(readJson(R"(
+{
+  "hitFilter": {
+    "recoClusterEnable": true,
+    "recoClusterThreshold": 50.5,
+    "recoClusterConstantFractionThreshold": 0.25,
+    "recoClusterDeltaStrips": 3,
+    "recoClusterDeltaTimeCells": 10
+  },
+  "pedestal": {
+    "remove": false,
+    "minPedestalCell": 10,
+    "maxPedestalCell": 50
+  },
+  "conditions": {
+    "pressure": 250,
+    "temperature": 300,
+    "samplingRate": 12.5
+  },
+  "eventFilter": {
+    "enabled": true,
+    "totalChargeLowerBound": 1000,
+    "events": [3, 1, 3]
+  }
+}
+  )"));
+  EXPECT_TRUE(config.hitFilter.enable);
+  EXPECT_DOUBLE_EQ(config.hitFilter.threshold, 50.5);
+  EXPECT_DOUBLE_EQ(config.hitFilter.fractionThreshold, 0.25);
+  EXPECT_EQ(config.hitFilter.deltaStrips, 3);
+  EXPECT_EQ(config.hitFilter.deltaTimeCells, 10);
+  EXPECT_FALSE(config.pedestal.remove);
+  EXPECT_EQ(config.pedestal.minPedestalCell, 10);
+  EXPECT_EQ(config.pedestal.maxPedestalCell, 50);
+  EXPECT_EQ(config.pedestal.maxSignalCell, 506);
+  EXPECT_DOUBLE_EQ(config.conditions.pressure, 250);
+  EXPECT_DOUBLE_EQ(config.conditions.temperature, 300);
+  EXPECT_DOUBLE_EQ(config.conditions.samplingRate, 12.5);
+  EXPECT_TRUE(config.eventFilter.enabled);
+  ASSERT_TRUE(config.eventFilter.totalChargeLowerBound);
+  EXPECT_DOUBLE_EQ(*config.eventFilter.totalChargeLowerBound, 1000);
+  EXPECT_FALSE(config.eventFilter.totalChargeUpperBound);
+  EXPECT_EQ(config.eventFilter.events, (std::set<std::size_t>{1, 3}));
+}
+
+TEST(TypedConfigTest, PedestalDatabase) {
+  auto config = PedestalConfig::fromConfig(readJson(R"(
+{
+  "pedestal": {
+    "pedestalDatabase": "pedestals.pdb",
+    "pedestalRunId": "20220412080344"
+  }
+}
+)"));
+  EXPECT_EQ(config.database, "pedestals.pdb");
+  ASSERT_TRUE(config.runId);
+  EXPECT_EQ(*config.runId, 20220412080344L);
+  config = PedestalConfig::fromConfig(
+      readJson(R"({"pedestal": {"pedestalDatabase": "", "pedestalRunId": ""}})"));
+  EXPECT_TRUE(config.database.empty());
+  EXPECT_FALSE(config.runId);
+}
+
+TEST(TypedConfigTest, ZeroSuppression) {
+  auto config = PedestalConfig::fromConfig(pt::ptree{});
+  EXPECT_FALSE(config.zeroSuppression);
+  EXPECT_DOUBLE_EQ(config.zeroSuppressionNSigma, 4.0);
+  EXPECT_EQ(config.zeroSuppressionGuardCells, 3);
+  config = PedestalConfig::fromConfig(readJson(R"(
+{
+  "pedestal": {
+    "zeroSuppressionEnable": true,
+    "zeroSuppressionNSigma": 3.5,
+    "zeroSuppressionThreshold": 20,
+    "zeroSuppressionGuardCells": 5
+  }
+}
+)"));
+  EXPECT_TRUE(config.zeroSuppression);
+  EXPECT_DOUBLE_EQ(config.zeroSuppressionNSigma, 3.5);
+  EXPECT_DOUBLE_EQ(config.zeroSuppressionThreshold, 20);
+  EXPECT_EQ(config.zeroSuppressionGuardCells, 5);
+}
+
+TEST(TypedConfigTest, HitFilterComparison) {
+  HitFilterConfig config;
+  EXPECT_EQ(config, HitFilterConfig::fromConfig(pt::ptree{}));
+  auto other = config;
+  other.deltaTimeCells += 1;
+  EXPECT_NE(config, other);
+}
+
+TEST(TypedConfigTest, Validation) {
+  EXPECT_THROW(HitFilterConfig::fromConfig(readJson(
+                   R"({"hitFilter": {"recoClusterDeltaStrips": -1}})")),
+               std::invalid_argument);
+  EXPECT_THROW(HitFilterConfig::fromConfig(readJson(
+                   R"({"hitFilter": {"recoClusterConstantFractionThreshold": 2}})")),
+               std::invalid_argument);
+  EXPECT_THROW(PedestalConfig::fromConfig(readJson(
+                   R"({"pedestal": {"minSignalCell": 100, "maxSignalCell": 50}})")),
+               std::invalid_argument);
+  EXPECT_THROW(PedestalConfig::fromConfig(readJson(
+                   R"({"pedestal": {"pedestalRunId": "2022x"}})")),
+               std::invalid_argument);
+  EXPECT_THROW(PedestalConfig::fromConfig(readJson(
+                   R"({"pedestal": {"zeroSuppressionGuardCells": -1}})")),
+               std::invalid_argument);
+  EXPECT_THROW(ConditionsConfig::fromConfig(
+                   readJson(R"({"conditions": {"pressure": 0}})")),
+               std::invalid_argument);
+  EXPECT_THROW(EventFilterConfig::fromConfig(readJson(
+                   R"({"eventFilter": {"maxChargeLowerBound": 10, "maxChargeUpperBound": 5}})")),
+               std::invalid_argument);
+  EXPECT_THROW(HitFilterConfig::fromConfig(readJson(
+                   R"({"hitFilter": {"recoClusterDeltaStrips": "two"}})")),
+               pt::ptree_bad_data);
+}
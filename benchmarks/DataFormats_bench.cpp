@@ -0,0 +1,108 @@
+#include <memory>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "BenchmarkHarness.h"
+#include "BenchmarkInput.h"
+#include "TPCReco/ConfigManager.h"
+#include "TPCReco/EventTPC.h"
+#include "TPCReco/GeometryTPC.h"
+
+using namespace tpcreco::benchmarks;
+
+int main(int argc, char **argv) {
+
+  ConfigManager cm;
+  boost::property_tree::ptree config = cm.getConfig(argc, argv);
+  if (cm.isHelpMode()) {
+    return 0;
+  }
+
+  BenchmarkInput input(config);
+  Harness harness(config);
+
+  std::vector<std::shared_ptr<EventTPC>> events;
+  for (std::size_t iEvent = 0; iEvent < input.size(); ++iEvent) {
+    events.push_back(input.makeEventTPC(iEvent));
+    events.back()->setHitFilterConfig(filter_type::threshold,
+                                      input.getHitFilterConfig());
+  }
+  auto event = [&events](std::size_t iCall) {
+    return events[iCall % events.size()];
+  };
+
+  harness.add("EventTPC::SetChargeMap", [&](std::size_t iCall) {
+    EventTPC aEvent;
+    aEvent.SetChargeMap(input.getChargeMap(iCall));
+  });
+
+  // setHitFilterConfig() re-runs filterHits() only for changed parameters,
+  // so two configurations differing by a negligible threshold are alternated
+  std::vector<tpcreco::config::HitFilterConfig> alternateConfigs(
+      2, input.getHitFilterConfig());
+  alternateConfigs[1].threshold += 1E-6;
+  harness.add("EventTPC::filterHits[threshold]", [&](std::size_t iCall) {
+    event(iCall)->setHitFilterConfig(
+        filter_type::threshold,
+        alternateConfigs[(iCall / events.size()) % 2]);
+  });
+
+  // unchanged parameters, the filtered hits are reused
+  harness.add("EventTPC::setHitFilterConfig[unchanged]",
+              [&](std::size_t iCall) {
+                event(iCall)->setHitFilterConfig(filter_type::threshold,
+                                                 input.getHitFilterConfig());
+              });
+
+  // projections of already filtered hits, all three strip directions per call
+  for (auto scale : {scale_type::raw, scale_type::mm}) {
+    std::string scaleName = scale == scale_type::raw ? "raw" : "mm";
+    for (auto filter : {filter_type::none, filter_type::threshold}) {
+      std::string filterName = filter == filter_type::none ? "none" : "threshold";
+      harness.add("EventTPC::get2DProjection[UVW," + filterName + "," +
+                      scaleName + "]",
+                  [&, scale, filter](std::size_t iCall) {
+                    for (int iDir = definitions::projection_type::DIR_U;
+                         iDir <= definitions::projection_type::DIR_W; ++iDir) {
+                      event(iCall)->get2DProjection(
+                          definitions::get2DProjectionType(iDir), filter, scale);
+                    }
+                  });
+    }
+    harness.add("EventTPC::get1DProjection[TIME,threshold," + scaleName + "]",
+                [&, scale](std::size_t iCall) {
+                  event(iCall)->get1DProjection(
+                      definitions::projection_type::DIR_TIME,
+                      filter_type::threshold, scale);
+                });
+  }
+
+  // one call is a full scan of all electronics channels
+  auto aGeometryPtr = input.getGeometry();
+  uint64_t nChannels = 0;
+  for (int iCobo = 0; iCobo < aGeometryPtr->GetCoboNboards(); ++iCobo) {
+    nChannels += aGeometryPtr->GetAsadNboards(iCobo) *
+                 aGeometryPtr->GetAgetNchips() *
+                 aGeometryPtr->GetAgetNchannels();
+  }
+  harness.add(
+      "GeometryTPC::GetStripByAget",
+      [aGeometryPtr](std::size_t) {
+        for (int iCobo = 0; iCobo < aGeometryPtr->GetCoboNboards(); ++iCobo) {
+          for (int iAsad = 0; iAsad < aGeometryPtr->GetAsadNboards(iCobo);
+               ++iAsad) {
+            for (int iAget = 0; iAget < aGeometryPtr->GetAgetNchips();
+                 ++iAget) {
+              for (int iChannel = 0;
+                   iChannel < aGeometryPtr->GetAgetNchannels(); ++iChannel) {
+                aGeometryPtr->GetStripByAget(iCobo, iAsad, iAget, iChannel);
+              }
+            }
+          }
+        }
+      },
+      nChannels);
+
+  return harness.run();
+}
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <TH1F.h>
+#include <TH2D.h>
+#include <TRandom3.h>
+#include <TVector3.h>
+
+#include "BenchmarkHarness.h"
+#include "BenchmarkInput.h"
+#include "TPCReco/ConfigManager.h"
+#include "TPCReco/EventTPC.h"
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/PEventTPC.h"
+#include "TPCReco/RecHitBuilder.h"
+#include "TPCReco/StripResponseCalculator.h"
+#include "TPCReco/TrackBuilder.h"
+#include "TPCReco/dEdxFitter.h"
+
+using namespace tpcreco::benchmarks;
+
+int main(int argc, char **argv) {
+
+  ConfigManager cm;
+  boost::property_tree::ptree config = cm.getConfig(argc, argv);
+  if (cm.isHelpMode()) {
+    return 0;
+  }
+
+  BenchmarkInput input(config);
+  Harness harness(config);
+  auto aGeometryPtr = input.getGeometry();
+
+  std::vector<std::shared_ptr<EventTPC>> events;
+  for (std::size_t iEvent = 0; iEvent < input.size(); ++iEvent) {
+    events.push_back(input.makeEventTPC(iEvent));
+    events.back()->setHitFilterConfig(filter_type::threshold,
+                                      input.getHitFilterConfig());
+    events.back()->setHitFilterConfig(filter_type::fraction,
+                                      input.getHitFilterConfig());
+  }
+
+  // same input as in TrackBuilder::makeRecHits()
+  std::vector<std::shared_ptr<TH2D>> projections;
+  for (auto &aEvent : events) {
+    for (int iDir = definitions::projection_type::DIR_U;
+         iDir <= definitions::projection_type::DIR_W; ++iDir) {
+      projections.push_back(aEvent->get2DProjection(
+          definitions::get2DProjectionType(iDir), filter_type::threshold,
+          scale_type::mm));
+    }
+  }
+  RecHitBuilder aRecHitBuilder;
+  aRecHitBuilder.setGeometry(aGeometryPtr);
+  harness.add("RecHitBuilder::makeRecHits[UVW]", [&](std::size_t iCall) {
+    std::size_t iEvent = iCall % events.size();
+    for (int iDir = 0; iDir < 3; ++iDir) {
+      aRecHitBuilder.makeRecHits(*projections[3 * iEvent + iDir]);
+    }
+  });
+
+  TrackBuilder aTrackBuilder;
+  aTrackBuilder.setGeometry(aGeometryPtr);
+  aTrackBuilder.setPressure(input.getPressure());
+  harness.add("TrackBuilder::reconstruct", [&](std::size_t iCall) {
+    aTrackBuilder.setEvent(events[iCall % events.size()]);
+    aTrackBuilder.reconstruct();
+  });
+
+  TrackBuilder aAnalyticTrackBuilder;
+  aAnalyticTrackBuilder.setGeometry(aGeometryPtr);
+  aAnalyticTrackBuilder.setPressure(input.getPressure());
+  aAnalyticTrackBuilder.setFitType(
+      definitions::fit_type::TANGENT_BIAS_ANALYTIC);
+  harness.add("TrackBuilder::reconstruct[ANALYTIC]", [&](std::size_t iCall) {
+    aAnalyticTrackBuilder.setEvent(events[iCall % events.size()]);
+    aAnalyticTrackBuilder.reconstruct();
+  });
+
+  // validation of the analytic fit against the sequential Minuit2 fits
+  int nCompared = 0, nNotWorse = 0;
+  double sumLoss = 0, sumAnalyticLoss = 0, sumAngle = 0, maxAngle = 0;
+  for (auto &aEvent : events) {
+    aTrackBuilder.setEvent(aEvent);
+    aTrackBuilder.reconstruct();
+    aAnalyticTrackBuilder.setEvent(aEvent);
+    aAnalyticTrackBuilder.reconstruct();
+    const auto &aTrack = aTrackBuilder.getTrack3D(0);
+    const auto &aAnalyticTrack = aAnalyticTrackBuilder.getTrack3D(0);
+    if (aTrack.getSegments().empty() || aAnalyticTrack.getSegments().empty()) {
+      continue;
+    }
+    ++nCompared;
+    sumLoss += aTrack.getLoss();
+    sumAnalyticLoss += aAnalyticTrack.getLoss();
+    if (aAnalyticTrack.getLoss() <= 1.01 * aTrack.getLoss()) {
+      ++nNotWorse;
+    }
+    // tangent orientation is fixed later by the dE/dx fit, compare lines only
+    double cosAngle =
+        std::abs(aTrack.getSegments().front().getTangent().Unit().Dot(
+            aAnalyticTrack.getSegments().front().getTangent().Unit()));
+    double angle = std::acos(std::min(cosAngle, 1.0));
+    sumAngle += angle;
+    maxAngle = std::max(maxAngle, angle);
+  }
+  if (nCompared) {
+    std::cout << "Track fit validation, SEQUENTIAL vs ANALYTIC, " << nCompared
+              << " events:" << std::endl
+              << "\t mean line fit loss: " << sumLoss / nCompared << " vs "
+              << sumAnalyticLoss / nCompared << std::endl
+              << "\t events with ANALYTIC loss not worse than 1%: "
+              << nNotWorse << std::endl
+              << "\t tangent angle difference [rad]: mean "
+              << sumAngle / nCompared << ", max " << maxAngle << std::endl;
+  }
+
+  // charge profiles of the reconstructed tracks
+  std::vector<TH1F> chargeProfiles;
+  for (auto &aEvent : events) {
+    aTrackBuilder.setEvent(aEvent);
+    aTrackBuilder.reconstruct();
+    auto aProfile = aTrackBuilder.getTrack3D(0).getChargeProfile();
+    if (aProfile.GetEntries() > 0) {
+      chargeProfiles.push_back(aProfile);
+    }
+  }
+  dEdxFitter aFitter(input.getPressure());
+  if (!chargeProfiles.empty()) {
+    harness.add("dEdxFitter::fitHisto", [&](std::size_t iCall) {
+      aFitter.fitHisto(chargeProfiles[iCall % chargeProfiles.size()]);
+    });
+  }
+
+  // straight tracks of point-like deposits, as produced by TPCDigitizerSRC
+  // from Geant4 hits; parameters follow MonteCarlo/config/ModuleConfig.json
+  const int nDepositsPerTrack = 200;
+  const int nTracks = 50;
+  StripResponseCalculator aResponseCalculator(
+      aGeometryPtr, 6, 30, 12, 1.5, 1.5, 0,
+      config.get<std::string>("benchmark.stripResponseFile").c_str());
+  TRandom3 aRndm(config.get<unsigned int>("benchmark.randomSeed"));
+  std::vector<TVector3> deposits;
+  for (int iTrack = 0; iTrack < nTracks; ++iTrack) {
+    TVector3 vertex(aRndm.Uniform(-50, 50), aRndm.Uniform(-50, 50),
+                    aRndm.Uniform(-50, 50));
+    TVector3 direction;
+    aRndm.Sphere(direction, 1.0);
+    for (int iStep = 0; iStep < nDepositsPerTrack; ++iStep) {
+      deposits.push_back(vertex + 0.5 * iStep * direction);
+    }
+  }
+  auto aPEvent = std::make_shared<PEventTPC>();
+  harness.add(
+      "StripResponseCalculator::addCharge",
+      [&](std::size_t iCall) {
+        aPEvent->Clear();
+        std::size_t offset = (iCall % nTracks) * nDepositsPerTrack;
+        for (int iStep = 0; iStep < nDepositsPerTrack; ++iStep) {
+          aResponseCalculator.addCharge(deposits[offset + iStep], 100.0,
+                                        aPEvent);
+        }
+      },
+      nDepositsPerTrack);
+
+  return harness.run();
+}
@@ -0,0 +1,202 @@
+#include "BenchmarkHarness.h"
+#include "TPCReco/colorText.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <regex>
+
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+namespace {
+std::atomic<uint64_t> nAllocations{0};
+std::atomic<uint64_t> nAllocatedBytes{0};
+
+void *countedAlloc(std::size_t size) noexcept {
+  nAllocations.fetch_add(1, std::memory_order_relaxed);
+  nAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+} // namespace
+
+///////////////////////////////////////////////////////////////
+// Replacements of the global allocation functions. All allocations made by
+// the benchmark executable and the shared libraries it loads are counted.
+void *operator new(std::size_t size) {
+  void *ptr = countedAlloc(size);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAlloc(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAlloc(size);
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+///////////////////////////////////////////////////////////////
+
+namespace tpcreco {
+namespace benchmarks {
+
+uint64_t allocationCount() {
+  return nAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t allocatedBytes() {
+  return nAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+Harness::Harness(const boost::property_tree::ptree &config) {
+  minTime = config.get<double>("benchmark.minTime", minTime);
+  tolerance = config.get<double>("benchmark.tolerance", tolerance);
+  nameFilter = config.get<std::string>("benchmark.filter", "");
+  outputFile = config.get<std::string>("benchmark.outputFile", "");
+  baselineFile = config.get<std::string>("benchmark.baselineFile", "");
+}
+
+void Harness::add(const std::string &name, Function function,
+                  uint64_t itemsPerCall) {
+  entries.push_back({name, std::move(function), itemsPerCall});
+}
+
+Result Harness::measure(const Entry &entry) const {
+  using clock = std::chrono::steady_clock;
+
+  entry.function(0); // warm-up: lazy initialisation, caches
+
+  Result result;
+  result.name = entry.name;
+  auto allocsStart = allocationCount();
+  auto bytesStart = allocatedBytes();
+  auto start = clock::now();
+  double elapsed = 0;
+  do {
+    entry.function(result.calls);
+    ++result.calls;
+    elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  } while (elapsed < minTime);
+
+  result.items = result.calls * entry.itemsPerCall;
+  result.nsPerItem = 1E9 * elapsed / result.items;
+  result.itemsPerSecond = result.items / elapsed;
+  result.allocsPerItem =
+      double(allocationCount() - allocsStart) / result.items;
+  result.bytesPerItem = double(allocatedBytes() - bytesStart) / result.items;
+  return result;
+}
+
+void Harness::print(const Result &result) const {
+  std::cout << std::left << std::setw(45) << result.name << std::right
+            << std::setw(10) << result.calls << std::setw(14) << std::fixed
+            << std::setprecision(1) << result.nsPerItem << std::setw(14)
+            << std::setprecision(2) << result.itemsPerSecond << std::setw(12)
+            << std::setprecision(1) << result.allocsPerItem << std::setw(14)
+            << std::setprecision(0) << result.bytesPerItem << std::endl;
+}
+
+int Harness::run() {
+  std::regex filter(nameFilter);
+  std::cout << std::left << std::setw(45) << "benchmark" << std::right
+            << std::setw(10) << "calls" << std::setw(14) << "ns/item"
+            << std::setw(14) << "items/s" << std::setw(12) << "allocs/item"
+            << std::setw(14) << "bytes/item" << std::endl;
+  for (const auto &entry : entries) {
+    if (!nameFilter.empty() && !std::regex_search(entry.name, filter)) {
+      continue;
+    }
+    results.push_back(measure(entry));
+    print(results.back());
+  }
+  int nRegressions = 0;
+  if (!baselineFile.empty()) {
+    nRegressions = compareWithBaseline(baselineFile);
+  }
+  if (!outputFile.empty()) {
+    writeJSON(outputFile);
+  }
+  return nRegressions;
+}
+
+void Harness::writeJSON(const std::string &fileName) const {
+  boost::property_tree::ptree tree;
+  boost::property_tree::ptree list;
+  for (const auto &result : results) {
+    boost::property_tree::ptree node;
+    node.put("name", result.name);
+    node.put("calls", result.calls);
+    node.put("items", result.items);
+    node.put("nsPerItem", result.nsPerItem);
+    node.put("itemsPerSecond", result.itemsPerSecond);
+    node.put("allocsPerItem", result.allocsPerItem);
+    node.put("bytesPerItem", result.bytesPerItem);
+    list.push_back(std::make_pair("", node));
+  }
+  tree.add_child("benchmarks", list);
+  boost::property_tree::write_json(fileName, tree);
+  std::cout << KBLU << "Benchmark results written to: " << RST << fileName
+            << std::endl;
+}
+
+int Harness::compareWithBaseline(const std::string &fileName) const {
+  if (!boost::filesystem::exists(fileName)) {
+    std::cout << KRED << "Baseline file not found: " << RST << fileName
+              << std::endl;
+    return 0;
+  }
+  boost::property_tree::ptree tree;
+  boost::property_tree::read_json(fileName, tree);
+  std::map<std::string, std::pair<double, double>> baseline;
+  for (const auto &item : tree.get_child("benchmarks")) {
+    baseline[item.second.get<std::string>("name")] = {
+        item.second.get<double>("nsPerItem"),
+        item.second.get<double>("allocsPerItem")};
+  }
+
+  std::cout << KBLU << "Comparison with baseline: " << RST << fileName
+            << std::endl;
+  int nRegressions = 0;
+  for (const auto &result : results) {
+    auto it = baseline.find(result.name);
+    if (it == baseline.end() || it->second.first <= 0) {
+      std::cout << std::left << std::setw(45) << result.name
+                << " no baseline" << std::endl;
+      continue;
+    }
+    double ratio = result.nsPerItem / it->second.first;
+    bool isSlower = ratio > 1 + tolerance;
+    bool isFaster = ratio < 1 - tolerance;
+    nRegressions += isSlower;
+    std::cout << std::left << std::setw(45) << result.name << std::right
+              << (isSlower ? KRED : (isFaster ? KGRN : "")) << std::setw(10)
+              << std::fixed << std::setprecision(3) << ratio << " x time"
+              << RST << std::setw(12) << std::setprecision(1)
+              << result.allocsPerItem - it->second.second << " allocs/item"
+              << std::endl;
+  }
+  if (nRegressions) {
+    std::cout << KRED << "Benchmarks slower than baseline by more than "
+              << 100 * tolerance << "%: " << RST << nRegressions << std::endl;
+  }
+  return nRegressions;
+}
+
+} // namespace benchmarks
+} // namespace tpcreco
@@ -0,0 +1,75 @@
+#ifndef TPCRECO_BENCHMARKS_BENCHMARK_HARNESS_H_
+#define TPCRECO_BENCHMARKS_BENCHMARK_HARNESS_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace tpcreco {
+namespace benchmarks {
+
+// Number of operator new calls and bytes requested since program start.
+// The counting operator new/delete replacements live in BenchmarkHarness.cpp.
+uint64_t allocationCount();
+uint64_t allocatedBytes();
+
+struct Result {
+  std::string name;
+  uint64_t calls{0};
+  uint64_t items{0};
+  double nsPerItem{0};
+  double itemsPerSecond{0};
+  double allocsPerItem{0};
+  double bytesPerItem{0};
+};
+
+// Minimal benchmark runner.
+// Each benchmark is a function processing one call worth of work
+// (e.g. one event). The function is called repeatedly, cycling the call index,
+// until the "benchmark.minTime" wall time is exceeded. Results are printed,
+// optionally saved as JSON ("benchmark.outputFile") and compared with
+// a previously saved JSON file ("benchmark.baselineFile").
+class Harness {
+public:
+  using Function = std::function<void(std::size_t iCall)>;
+
+  explicit Harness(const boost::property_tree::ptree &config);
+
+  // itemsPerCall: number of items (events, hits, lookups, ...) processed
+  // in a single call, used to normalise the reported rates
+  void add(const std::string &name, Function function,
+           uint64_t itemsPerCall = 1);
+
+  // returns number of benchmarks slower than the baseline beyond tolerance
+  int run();
+
+  const std::vector<Result> &getResults() const { return results; }
+
+private:
+  struct Entry {
+    std::string name;
+    Function function;
+    uint64_t itemsPerCall;
+  };
+
+  Result measure(const Entry &entry) const;
+  void print(const Result &result) const;
+  void writeJSON(const std::string &fileName) const;
+  int compareWithBaseline(const std::string &fileName) const;
+
+  double minTime{1.0};
+  double tolerance{0.1};
+  std::string nameFilter;
+  std::string outputFile;
+  std::string baselineFile;
+  std::vector<Entry> entries;
+  std::vector<Result> results;
+};
+
+} // namespace benchmarks
+} // namespace tpcreco
+
+#endif // TPCRECO_BENCHMARKS_BENCHMARK_HARNESS_H_
@@ -0,0 +1,88 @@
+#include "BenchmarkInput.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "TPCReco/EventSourceMC.h"
+#include "TPCReco/EventSourceROOT.h"
+#include "TPCReco/colorText.h"
+
+namespace tpcreco {
+namespace benchmarks {
+
+BenchmarkInput::BenchmarkInput(const boost::property_tree::ptree &config) {
+
+  myTypedConfig = tpcreco::config::TypedConfig::fromConfig(config);
+
+  auto dataFileName = config.get<std::string>("input.dataFile", "");
+  auto geometryFileName = config.get<std::string>("input.geometryFile", "");
+  int nEvents = config.get<int>("input.readNEvents", -1);
+
+  if (!dataFileName.empty()) {
+    loadFile(dataFileName, geometryFileName, nEvents);
+  } else {
+    if (nEvents < 0) {
+      nEvents = config.get<int>("benchmark.syntheticEvents");
+    }
+    generateEvents(geometryFileName, nEvents,
+                   config.get<unsigned int>("benchmark.randomSeed"));
+  }
+  if (myEvents.empty()) {
+    throw std::runtime_error("No events available for benchmarks");
+  }
+  std::cout << KBLU << "Benchmark input: " << RST << myDescription << ", "
+            << myEvents.size() << " events" << std::endl;
+}
+
+std::shared_ptr<EventTPC>
+BenchmarkInput::makeEventTPC(std::size_t index) const {
+  const auto &event = myEvents.at(index % size());
+  auto aEvent = std::make_shared<EventTPC>();
+  aEvent->SetGeoPtr(myGeometryPtr);
+  aEvent->SetChargeMap(event.chargeMap);
+  aEvent->SetEventInfo(event.info);
+  return aEvent;
+}
+
+void BenchmarkInput::loadFile(const std::string &dataFileName,
+                              const std::string &geometryFileName,
+                              int nEvents) {
+  if (geometryFileName.empty()) {
+    throw std::runtime_error("input.geometryFile is required with input.dataFile");
+  }
+  EventSourceROOT aSource(geometryFileName);
+  aSource.loadDataFile(dataFileName);
+  unsigned long nEntries = aSource.numberOfEntries();
+  if (nEvents >= 0 && (unsigned long)nEvents < nEntries) {
+    nEntries = nEvents;
+  }
+  for (unsigned long iEntry = 0; iEntry < nEntries; ++iEntry) {
+    aSource.loadFileEntry(iEntry);
+    auto aPEvent = aSource.getCurrentPEvent();
+    myEvents.push_back({aPEvent->GetEventInfo(), aPEvent->GetChargeMap()});
+  }
+  myGeometryPtr = aSource.getGeometry();
+  myDescription = dataFileName;
+}
+
+void BenchmarkInput::generateEvents(const std::string &geometryFileName,
+                                    int nEvents, unsigned int seed) {
+  // EventSourceMC generates tracks for 250 mbar CO2
+  std::string geometry =
+      geometryFileName.empty()
+          ? std::string(TPCRECO_RESOURCE_DIR) + "geometry_ELITPC_250mbar_12.5MHz.dat"
+          : geometryFileName;
+  EventSourceMC aSource(geometry);
+  aSource.setRandomSeed(seed);
+  for (int iEvent = 0; iEvent < nEvents; ++iEvent) {
+    aSource.loadFileEntry(iEvent);
+    auto aPEvent = aSource.getCurrentPEvent();
+    myEvents.push_back({aPEvent->GetEventInfo(), aPEvent->GetChargeMap()});
+  }
+  myGeometryPtr = aSource.getGeometry();
+  myPressure = 250.0;
+  myDescription = "EventSourceMC, seed " + std::to_string(seed);
+}
+
+} // namespace benchmarks
+} // namespace tpcreco
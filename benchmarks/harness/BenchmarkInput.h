@@ -0,0 +1,69 @@
+#ifndef TPCRECO_BENCHMARKS_BENCHMARK_INPUT_H_
+#define TPCRECO_BENCHMARKS_BENCHMARK_INPUT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "TPCReco/EventInfo.h"
+#include "TPCReco/EventTPC.h"
+#include "TPCReco/GeometryTPC.h"
+#include "TPCReco/PEventTPC.h"
+#include "TPCReco/TypedConfig.h"
+
+namespace tpcreco {
+namespace benchmarks {
+
+// Fixed set of events kept in memory for the benchmarks.
+// Events are read from "input.dataFile" (TPCData tree with the PEventTPC
+// "Event" branch, e.g. converted GRAW data or output of mcRunController with
+// TPCDigitizerSRC and EventFileExporter modules).
+// Without an input file "benchmark.syntheticEvents" events are generated with
+// EventSourceMC seeded with "benchmark.randomSeed", so the input is identical
+// between runs.
+class BenchmarkInput {
+public:
+  explicit BenchmarkInput(const boost::property_tree::ptree &config);
+
+  std::shared_ptr<GeometryTPC> getGeometry() const { return myGeometryPtr; }
+
+  std::size_t size() const { return myEvents.size(); }
+
+  const PEventTPC::chargeMapType &getChargeMap(std::size_t index) const {
+    return myEvents.at(index % size()).chargeMap;
+  }
+
+  // new EventTPC filled with the event index % size()
+  std::shared_ptr<EventTPC> makeEventTPC(std::size_t index) const;
+
+  const tpcreco::config::HitFilterConfig &getHitFilterConfig() const {
+    return myTypedConfig.hitFilter;
+  }
+
+  double getPressure() const { return myTypedConfig.conditions.pressure; }
+
+  const std::string &getDescription() const { return myDescription; }
+
+private:
+  struct Event {
+    eventraw::EventInfo info;
+    PEventTPC::chargeMapType chargeMap;
+  };
+
+  void loadFile(const std::string &dataFileName,
+                const std::string &geometryFileName, int nEvents);
+  void generateEvents(const std::string &geometryFileName, int nEvents,
+                      unsigned int seed);
+
+  std::shared_ptr<GeometryTPC> myGeometryPtr;
+  std::vector<Event> myEvents;
+  tpcreco::config::TypedConfig myTypedConfig;
+  std::string myDescription;
+};
+
+} // namespace benchmarks
+} // namespace tpcreco
+
+#endif // TPCRECO_BENCHMARKS_BENCHMARK_INPUT_H_
@@ -0,0 +1,32 @@
+option(BUILD_BENCHMARKS "build benchmark suite" OFF)
+
+function(reco_add_benchmark_subdirectory SUBDIR)
+  if(CMAKE_PROJECT_NAME STREQUAL PROJECT_NAME AND BUILD_BENCHMARKS)
+    add_subdirectory(${SUBDIR})
+  endif()
+endfunction()
+
+if(CMAKE_PROJECT_NAME STREQUAL PROJECT_NAME AND BUILD_BENCHMARKS)
+
+  set(BENCHMARK_BASELINE_DIR
+      "${PROJECT_SOURCE_DIR}/benchmarks/baselines"
+      CACHE PATH "Directory with saved benchmark results used as reference")
+
+  macro(add_benchmark NAME)
+    reco_add_executable(${NAME} ${NAME}.cpp)
+    foreach(arg IN ITEMS ${ARGN})
+      target_link_libraries(${NAME} PRIVATE ${arg})
+    endforeach()
+    target_link_libraries(${NAME} PRIVATE BenchmarkHarness)
+    add_dependencies(benchmarks ${NAME})
+    add_custom_target(
+      run_${NAME}
+      COMMAND
+        ${NAME} --outputFile ${CMAKE_CURRENT_BINARY_DIR}/${NAME}.json
+        --baselineFile ${BENCHMARK_BASELINE_DIR}/${NAME}.json
+      DEPENDS ${NAME}
+      WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
+    add_dependencies(run_benchmarks run_${NAME})
+  endmacro()
+
+endif()